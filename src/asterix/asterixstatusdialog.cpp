@@ -7,15 +7,16 @@
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QGridLayout>
+#include <QStringList>
 
 #include <iomanip>
 
 using namespace std;
 using namespace Utils;
 
-ASTERIXStatusDialog::ASTERIXStatusDialog(const std::string& filename, bool test, bool mapping_stubs,
+ASTERIXStatusDialog::ASTERIXStatusDialog(const std::vector<std::string>& filenames, bool test, bool mapping_stubs,
                                          QWidget *parent, Qt::WindowFlags f)
-    : QDialog(parent, f), filename_(filename), test_(test), mapping_stubs_(mapping_stubs)
+    : QDialog(parent, f), filenames_(filenames), test_(test), mapping_stubs_(mapping_stubs)
 {
     setWindowFlags(Qt::Window | Qt::WindowTitleHint | Qt::CustomizeWindowHint);
 
@@ -44,8 +45,11 @@ ASTERIXStatusDialog::ASTERIXStatusDialog(const std::string& filename, bool test,
     {
         QGridLayout* general_grid = new QGridLayout();
 
+        assert (filenames_.size());
+
         general_grid->addWidget(new QLabel("Filename"), row, 0);
-        QLabel* filename_label = new QLabel(filename_.c_str());
+        QLabel* filename_label = new QLabel(filenames_.size() == 1 ? filenames_.at(0).c_str()
+                                                                   : (std::to_string(filenames_.size())+" files").c_str());
         filename_label->setAlignment(Qt::AlignRight);
         general_grid->addWidget(filename_label, row, 1);
 
@@ -58,6 +62,45 @@ ASTERIXStatusDialog::ASTERIXStatusDialog(const std::string& filename, bool test,
         main_layout->addLayout(general_grid);
     }
 
+    file_grid_ = new QGridLayout();
+
+    for (auto& filename : filenames_)
+    {
+        assert (!file_status_.count(filename));
+        int file_row = file_status_.size()+1; // header in first row
+        file_status_[filename].row_ = file_row;
+    }
+
+    if (filenames_.size() > 1) // per-file progress
+    {
+        QStringList headers {"File", "State", "Records", "Errors"};
+
+        for (int col=0; col < headers.size(); ++col)
+        {
+            QLabel* header_label = new QLabel(headers.at(col));
+            header_label->setFont(font_bold);
+            if (col)
+                header_label->setAlignment(Qt::AlignRight);
+            file_grid_->addWidget(header_label, 0, col);
+        }
+
+        for (auto& filename : filenames_)
+        {
+            int file_row = file_status_.at(filename).row_;
+
+            file_grid_->addWidget(new QLabel(filename.c_str()), file_row, 0);
+
+            for (int col=1; col < headers.size(); ++col)
+            {
+                QLabel* label = new QLabel(col == 1 ? "Queued" : "0");
+                label->setAlignment(Qt::AlignRight);
+                file_grid_->addWidget(label, file_row, col);
+            }
+        }
+    }
+
+    main_layout->addLayout(file_grid_);
+
     main_layout->addStretch();
 
     QLabel* read_label = new QLabel("File Reading Status");
@@ -154,6 +197,18 @@ ASTERIXStatusDialog::ASTERIXStatusDialog(const std::string& filename, bool test,
                 records_inserted_rate_label_ = new QLabel ();
                 records_inserted_rate_label_->setAlignment(Qt::AlignRight);
                 count2_grid->addWidget(records_inserted_rate_label_, row, 1);
+
+                ++row;
+                count2_grid->addWidget(new QLabel("Insert Queue Depth"), row, 0);
+                insert_queue_label_ = new QLabel ();
+                insert_queue_label_->setAlignment(Qt::AlignRight);
+                count2_grid->addWidget(insert_queue_label_, row, 1);
+
+                ++row;
+                count2_grid->addWidget(new QLabel("DB Write Rate"), row, 0);
+                write_rate_label_ = new QLabel ();
+                write_rate_label_->setAlignment(Qt::AlignRight);
+                count2_grid->addWidget(write_rate_label_, row, 1);
             }
 
             main_layout->addLayout(count2_grid);
@@ -198,40 +253,78 @@ void ASTERIXStatusDialog::setDone ()
     ok_button_->setVisible(true);
 }
 
-void ASTERIXStatusDialog::numFrames (unsigned int cnt)
+void ASTERIXStatusDialog::setFileCounts (const std::string& filename, size_t frames, size_t records, size_t errors,
+                                         const std::map<unsigned int, size_t>& category_counts)
 {
-    assert (num_frames_label_);
+    assert (file_status_.count(filename));
 
-    num_frames_ = cnt;
-    num_frames_label_->setText(QString::number(num_frames_));
+    FileStatus& status = file_status_.at(filename);
+    status.frames_ = frames;
+    status.records_ = records;
+    status.errors_ = errors;
+    status.category_counts_ = category_counts;
 
-    updateTime();
+    if (filenames_.size() > 1)
+    {
+        QLabel* records_label = dynamic_cast<QLabel*>(file_grid_->itemAtPosition(status.row_, 2)->widget());
+        assert (records_label);
+        records_label->setText(QString::number(records));
+
+        QLabel* errors_label = dynamic_cast<QLabel*>(file_grid_->itemAtPosition(status.row_, 3)->widget());
+        assert (errors_label);
+        errors_label->setText(QString::number(errors));
+    }
+
+    updateFileCounts();
+    updateCategoryGrid();
 }
-void ASTERIXStatusDialog::numRecords (unsigned int cnt)
-{
-    assert (num_records_label_);
-    assert (num_records_rate_label_);
 
-    num_records_ = cnt;
-    num_records_label_->setText(QString::number(num_records_));
+void ASTERIXStatusDialog::setFileState (const std::string& filename, const std::string& state)
+{
+    assert (file_status_.count(filename));
 
-    updateTime();
+    logdbg << "ASTERIXStatusDialog: setFileState: " << filename << " " << state;
 
-    double records_per_second = num_records_/(time_diff_.total_milliseconds()/1000.0);
-    std::string records_rate_str_ = std::to_string(static_cast<int>(records_per_second))+" (e/s)";
-    num_records_rate_label_->setText(records_rate_str_.c_str());
+    if (filenames_.size() > 1)
+    {
+        QLabel* state_label = dynamic_cast<QLabel*>(
+                    file_grid_->itemAtPosition(file_status_.at(filename).row_, 1)->widget());
+        assert (state_label);
+        state_label->setText(state.c_str());
+    }
 }
 
-void ASTERIXStatusDialog::numErrors (unsigned int cnt)
+void ASTERIXStatusDialog::updateFileCounts ()
 {
-    logdbg << "ASTERIXStatusDialog: addNumErrors: " << cnt;
-
+    assert (num_frames_label_);
+    assert (num_records_label_);
     assert (num_errors_label_);
+    assert (num_records_rate_label_);
 
-    num_errors_ = cnt;
+    num_frames_ = 0;
+    num_records_ = 0;
+    num_errors_ = 0;
+    category_read_counts_.clear();
+
+    for (auto& file_it : file_status_)
+    {
+        num_frames_ += file_it.second.frames_;
+        num_records_ += file_it.second.records_;
+        num_errors_ += file_it.second.errors_;
+
+        for (auto& cat_cnt_it : file_it.second.category_counts_)
+            category_read_counts_[cat_cnt_it.first] += cat_cnt_it.second;
+    }
+
+    num_frames_label_->setText(QString::number(num_frames_));
+    num_records_label_->setText(QString::number(num_records_));
     num_errors_label_->setText(QString::number(num_errors_));
 
     updateTime();
+
+    double records_per_second = num_records_/(time_diff_.total_milliseconds()/1000.0);
+    std::string records_rate_str_ = std::to_string(static_cast<int>(records_per_second))+" (e/s)";
+    num_records_rate_label_->setText(records_rate_str_.c_str());
 }
 
 void ASTERIXStatusDialog::addNumMapped (unsigned int cnt)
@@ -282,12 +375,18 @@ void ASTERIXStatusDialog::addNumInserted (const std::string& dbo_name, unsigned
     records_inserted_rate_label_->setText(records_rate_str_.c_str());
 }
 
-void ASTERIXStatusDialog::setCategoryCounts (const std::map<unsigned int, size_t>& counts)
+void ASTERIXStatusDialog::setInsertQueue (size_t depth, size_t max_depth, double write_rate)
 {
-    category_read_counts_ = counts;
+    assert (!(test_ || mapping_stubs_));
+    assert (insert_queue_label_);
+    assert (write_rate_label_);
 
-    updateCategoryGrid();
+    insert_queue_label_->setText((std::to_string(depth)+" / "+std::to_string(max_depth)).c_str());
+
+    std::string write_rate_str = std::to_string(static_cast<int>(write_rate))+" (e/s)";
+    write_rate_label_->setText(write_rate_str.c_str());
 }
+
 void ASTERIXStatusDialog::addMappedCounts (const std::map<unsigned int, std::pair<size_t,size_t>>& counts)
 {
     assert (!mapping_stubs_);
@@ -5,6 +5,9 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <map>
+#include <vector>
+
 class QLabel;
 class QPushButton;
 class QGridLayout;
@@ -20,25 +23,37 @@ public slots:
     void okClickedSlot();
 
 public:
-    explicit ASTERIXStatusDialog(const std::string& filename, bool test, bool mapping_stubs,
+    explicit ASTERIXStatusDialog(const std::vector<std::string>& filenames, bool test, bool mapping_stubs,
                                  QWidget* parent=nullptr, Qt::WindowFlags f=0);
 
     void markStartTime ();
     void setDone ();
 
-    void numFrames (unsigned int cnt);
-    void numRecords (unsigned int cnt);
-    void numErrors (unsigned int cnt);
+    /// @brief Sets decoding counts of file, totals are summed over all files
+    void setFileCounts (const std::string& filename, size_t frames, size_t records, size_t errors,
+                        const std::map<unsigned int, size_t>& category_counts);
+    /// @brief Sets state of file shown in the file list, e.g. "Decoding" or "Done"
+    void setFileState (const std::string& filename, const std::string& state);
     void addNumMapped (unsigned int cnt);
     void addNumNotMapped (unsigned int cnt);
     void addNumCreated (unsigned int cnt);
     void addNumInserted (const std::string& dbo_name, unsigned int cnt);
+    void setInsertQueue (size_t depth, size_t max_depth, double write_rate);
 
-    void setCategoryCounts (const std::map<unsigned int, size_t>& counts);
     void addMappedCounts (const std::map<unsigned int, std::pair<size_t,size_t>>& counts);
 
 private:
-    std::string filename_;
+    struct FileStatus
+    {
+        int row_ {0};
+        size_t frames_ {0};
+        size_t records_ {0};
+        size_t errors_ {0};
+        std::map<unsigned int, size_t> category_counts_;
+    };
+
+    std::vector<std::string> filenames_;
+    std::map<std::string, FileStatus> file_status_;
     bool test_ {false};
     bool mapping_stubs_ {false};
 
@@ -69,13 +84,17 @@ private:
     QLabel* records_created_label_ {nullptr};
     QLabel* records_inserted_label_ {nullptr};
     QLabel* records_inserted_rate_label_ {nullptr};
+    QLabel* insert_queue_label_ {nullptr};
+    QLabel* write_rate_label_ {nullptr};
 
     std::map<std::string, size_t> dbo_inserted_counts_;
 
+    QGridLayout* file_grid_ {nullptr};
     QGridLayout* cat_counters_grid_ {nullptr};
     QGridLayout* dbo_counters_grid_ {nullptr};
     QPushButton* ok_button_ {nullptr};
 
+    void updateFileCounts ();
     void updateCategoryGrid ();
     void updateDBObjectGrid ();
     void updateTime ();
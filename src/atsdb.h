@@ -108,6 +108,10 @@ public:
 
     bool ready ();
 
+    /// @brief Returns if running without user interaction (batch mode), in which case no modal dialogs are shown
+    bool headless () const { return headless_; }
+    void headless (bool value) { headless_ = value; }
+
     ///@brief Adds data to a DBO from a C struct data pointer.
     //void insert (const std::string &dbo_type, void *data);
     //void insert (Buffer *buffer, std::string table_name);
@@ -140,6 +144,7 @@ public:
 
 protected:
     bool initialized_;
+    bool headless_ {false};
 
     /// DB interface, encapsulating all database functionality.
     DBInterface* db_interface_;
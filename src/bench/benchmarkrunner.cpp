@@ -0,0 +1,115 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+#include "benchmarkrunner.h"
+#include "logger.h"
+
+BenchmarkRunner::BenchmarkRunner(unsigned int repetitions, const std::string& filter)
+    : repetitions_(repetitions), filter_(filter)
+{
+    assert (repetitions_);
+}
+
+bool BenchmarkRunner::selected (const std::string& name) const
+{
+    return !filter_.size() || name.find(filter_) != std::string::npos;
+}
+
+void BenchmarkRunner::run (const std::string& name, size_t items, std::function<void()> setup,
+                           std::function<void()> function)
+{
+    if (!selected(name))
+        return;
+
+    loginf << "BenchmarkRunner: run: " << name << " items " << items << " repetitions " << repetitions_;
+
+    std::vector<double> times;
+
+    for (unsigned int cnt=0; cnt < repetitions_; ++cnt)
+    {
+        if (setup)
+            setup();
+
+        boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::universal_time();
+
+        function();
+
+        times.push_back((boost::posix_time::microsec_clock::universal_time() - start_time).total_microseconds()
+                        / 1e6);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    double median = times.at(times.size()/2);
+
+    nlohmann::json result;
+    result["name"] = name;
+    result["items"] = items;
+    result["repetitions"] = repetitions_;
+    result["min_s"] = times.front();
+    result["median_s"] = median;
+    result["max_s"] = times.back();
+    result["items_per_s"] = median > 0 ? items / median : 0.0;
+
+    results_.push_back(result);
+
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(4) << std::setw(10) << median << " s"
+              << std::setprecision(0) << std::setw(14) << (median > 0 ? items / median : 0.0) << " items/s"
+              << std::endl;
+}
+
+void BenchmarkRunner::skip (const std::string& name, const std::string& reason)
+{
+    if (!selected(name))
+        return;
+
+    logwrn << "BenchmarkRunner: skip: " << name << ": " << reason;
+
+    nlohmann::json result;
+    result["name"] = name;
+    result["skipped"] = reason;
+
+    results_.push_back(result);
+
+    std::cout << std::left << std::setw(32) << name << " skipped: " << reason << std::endl;
+}
+
+void BenchmarkRunner::saveJSON (const std::string& filename, const nlohmann::json& info) const
+{
+    loginf << "BenchmarkRunner: saveJSON: file '" << filename << "'";
+
+    std::ofstream file (filename);
+
+    if (!file)
+    {
+        logerr << "BenchmarkRunner: saveJSON: unable to open file '" << filename << "'";
+        throw std::runtime_error ("BenchmarkRunner: saveJSON: unable to open file '"+filename+"'");
+    }
+
+    nlohmann::json j = info;
+    j["benchmarks"] = results_;
+
+    file << j.dump(4);
+}
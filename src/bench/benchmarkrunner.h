@@ -0,0 +1,59 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+/**
+ * @brief Times benchmark functions and collects the results
+ *
+ * Each benchmark is run a number of repetitions, with an untimed setup function before each repetition. Minimum,
+ * median and maximum time as well as the throughput at median time are recorded, and can be written as JSON for
+ * regression tracking.
+ */
+class BenchmarkRunner
+{
+public:
+    /// @brief Constructor, only benchmarks containing filter are run if set
+    BenchmarkRunner (unsigned int repetitions, const std::string& filter);
+    virtual ~BenchmarkRunner() {}
+
+    /// @brief Returns if benchmark with given name is selected by the filter
+    bool selected (const std::string& name) const;
+
+    /// @brief Runs benchmark processing items elements per repetition
+    void run (const std::string& name, size_t items, std::function<void()> setup, std::function<void()> function);
+    /// @brief Records benchmark as skipped
+    void skip (const std::string& name, const std::string& reason);
+
+    nlohmann::json results () const { return results_; }
+    void saveJSON (const std::string& filename, const nlohmann::json& info) const;
+
+protected:
+    unsigned int repetitions_ {1};
+    std::string filter_;
+
+    nlohmann::json results_ = nlohmann::json::array();
+};
+
+#endif // BENCHMARKRUNNER_H
@@ -0,0 +1,684 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QEventLoop>
+#include <QThread>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+#include "global.h"
+#include "logger.h"
+#include "client.h"
+#include "atsdb.h"
+#include "buffer.h"
+#include "buffertransformation.h"
+#include "dbinterface.h"
+#include "sqliteconnection.h"
+#include "mysqlppconnection.h"
+#include "dbobject.h"
+#include "dbobjectmanager.h"
+#include "dbovariable.h"
+#include "dbovariableset.h"
+#include "dbodatasource.h"
+#include "metadbtable.h"
+#include "dbtable.h"
+#include "projectionmanager.h"
+#include "rs2g.h"
+#include "taskmanager.h"
+#include "jsonimportertask.h"
+#include "jsonparsingschema.h"
+#include "jsonparsejob.h"
+#include "jsonmappingjob.h"
+#include "jsonutils.h"
+#include "jsonvalueconverter.h"
+#include "stringconv.h"
+#include "createartasassociationstask.h"
+#include "benchmarkrunner.h"
+#include "syntheticdatagenerator.h"
+
+namespace po = boost::program_options;
+
+using namespace std;
+
+static const vector<string> DBO_NAMES {"Radar", "ADSB", "MLAT", "Tracker"};
+static const size_t TARGETS_PER_JSON_RECORD = 100;
+
+static volatile double result_sink = 0; // prevents benchmarked loops from being optimized away
+
+void runBufferBenchmarks (BenchmarkRunner& runner, SyntheticDataGenerator& generator, size_t rows)
+{
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    for (auto& dbo_name : DBO_NAMES)
+    {
+        if (!object_man.existsObject(dbo_name))
+        {
+            runner.skip("buffer_fill_"+dbo_name, "object does not exist");
+            continue;
+        }
+
+        DBObject& object = object_man.object(dbo_name);
+
+        runner.run("buffer_fill_"+dbo_name, rows, nullptr,
+                   [&] () { generator.generate(object, rows); });
+    }
+
+    for (auto& dbo_name : DBO_NAMES)
+    {
+        if (!object_man.existsObject(dbo_name))
+        {
+            runner.skip("buffer_transform_"+dbo_name, "object does not exist");
+            continue;
+        }
+
+        DBObject& object = object_man.object(dbo_name);
+
+        DBOVariableSet set;
+        SyntheticDataGenerator::variables(object, set);
+
+        BufferTransformation to_db (set, false);
+        shared_ptr<Buffer> buffer;
+
+        runner.run("buffer_transform_"+dbo_name, rows, [&] () { buffer = generator.generate(object, rows); },
+                   [&] () { buffer->transformVariables(to_db); });
+    }
+
+    if (!object_man.existsObject("Radar"))
+    {
+        runner.skip("buffer_seize", "object does not exist");
+        runner.skip("nullable_vector_access", "object does not exist");
+        return;
+    }
+
+    DBObject& radar = object_man.object("Radar");
+
+    const size_t num_parts = 10;
+    vector<shared_ptr<Buffer>> parts;
+
+    runner.run("buffer_seize", rows, [&] ()
+    {
+        parts.clear();
+        for (size_t cnt=0; cnt < num_parts; ++cnt)
+            parts.push_back(generator.generate(radar, rows/num_parts, 1+cnt*(rows/num_parts)));
+    },
+    [&] ()
+    {
+        for (size_t cnt=1; cnt < num_parts; ++cnt)
+            parts.front()->seizeBuffer(*parts.at(cnt));
+    });
+
+    shared_ptr<Buffer> buffer = generator.generate(radar, rows);
+    size_t size = buffer->size();
+
+    runner.run("nullable_vector_access", size, nullptr, [&] ()
+    {
+        NullableVector<int>& rec_nums = buffer->get<int>("rec_num");
+        NullableVector<Timestamp>& tods = buffer->get<Timestamp>("tod");
+        NullableVector<double>& ranges = buffer->get<double>("pos_range_nm");
+        NullableVector<double>& azimuths = buffer->get<double>("pos_azm_deg");
+
+        double sum = 0;
+
+        for (size_t cnt=0; cnt < size; ++cnt)
+        {
+            if (!rec_nums.isNull(cnt))
+                sum += rec_nums.get(cnt);
+            if (!tods.isNull(cnt))
+                sum += tods.get(cnt).seconds();
+            if (!ranges.isNull(cnt) && !azimuths.isNull(cnt))
+                sum += ranges.get(cnt) * azimuths.get(cnt);
+        }
+
+        result_sink = sum;
+    });
+}
+
+void openDatabase (const string& filename)
+{
+    loginf << "main: openDatabase: '" << filename << "'";
+
+    if (boost::filesystem::exists(filename))
+        boost::filesystem::remove(filename);
+
+    DBInterface& db_interface = ATSDB::instance().interface();
+    db_interface.useConnection(SQLITE_IDENTIFIER);
+
+    SQLiteConnection* connection = dynamic_cast<SQLiteConnection*> (&db_interface.connection());
+    assert (connection);
+
+    connection->openFile(filename);
+
+    QCoreApplication::processEvents(); // database content changed
+}
+
+void runDatabaseBenchmarks (BenchmarkRunner& runner, SyntheticDataGenerator& generator, size_t rows)
+{
+    DBInterface& db_interface = ATSDB::instance().interface();
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    for (auto& dbo_name : DBO_NAMES)
+    {
+        if (!object_man.existsObject(dbo_name))
+        {
+            runner.skip("sqlite_insert_"+dbo_name, "object does not exist");
+            continue;
+        }
+
+        DBObject& object = object_man.object(dbo_name);
+        MetaDBTable& meta_table = object.currentMetaTable();
+
+        DBOVariableSet set;
+        SyntheticDataGenerator::variables(object, set);
+
+        shared_ptr<Buffer> buffer;
+
+        runner.run("sqlite_insert_"+dbo_name, rows, [&] ()
+        {
+            buffer = generator.generate(object, rows);
+
+            if (db_interface.existsTable(meta_table.mainTableName()))
+                db_interface.clearTableContent(meta_table.mainTableName());
+
+            for (auto& sub_it : meta_table.subTables())
+                if (db_interface.existsTable(sub_it.second.name()))
+                    db_interface.clearTableContent(sub_it.second.name());
+        },
+        [&] ()
+        {
+            buffer->transformVariables(set, false);
+            db_interface.insertBuffer(meta_table, buffer);
+        });
+    }
+
+    object_man.databaseContentChangedSlot();
+
+    for (auto& dbo_name : DBO_NAMES)
+    {
+        if (!object_man.existsObject(dbo_name) || !object_man.object(dbo_name).existsInDB())
+        {
+            runner.skip("sqlite_read_"+dbo_name, "object does not exist in database");
+            continue;
+        }
+
+        DBObject& object = object_man.object(dbo_name);
+
+        DBOVariableSet set;
+        SyntheticDataGenerator::variables(object, set);
+
+        runner.run("sqlite_read_"+dbo_name, rows, nullptr, [&] ()
+        {
+            db_interface.prepareRead(object, set, "", {});
+
+            size_t row_count = 0;
+
+            while (true)
+            {
+                shared_ptr<Buffer> buffer = db_interface.readDataChunk(object);
+                assert (buffer);
+
+                row_count += buffer->size();
+
+                if (buffer->lastOne())
+                    break;
+            }
+
+            db_interface.finalizeReadStatement(object);
+
+            result_sink = row_count;
+        });
+    }
+}
+
+void runJSONBenchmarks (BenchmarkRunner& runner, SyntheticDataGenerator& generator, size_t rows)
+{
+    size_t num_records = max<size_t>(rows / TARGETS_PER_JSON_RECORD, 1);
+    size_t items = num_records * TARGETS_PER_JSON_RECORD;
+
+    vector<string> records = generator.generateADSBExchangeJSON(num_records, TARGETS_PER_JSON_RECORD);
+    vector<string> records_copy;
+
+    runner.run("json_parse", items, [&] () { records_copy = records; }, [&] ()
+    {
+        JSONParseJob parse_job (move(records_copy));
+        parse_job.run();
+
+        result_sink = parse_job.objectsParsed();
+    });
+
+    JSONImporterTask* task = ATSDB::instance().taskManager().getJSONImporterTask();
+    assert (task);
+
+    const string schema_name = "ADSBExchange";
+
+    if (!task->hasSchema(schema_name))
+    {
+        runner.skip("json_mapping", "schema "+schema_name+" does not exist");
+        return;
+    }
+
+    task->currentSchemaName(schema_name);
+    JSONParsingSchema& schema = task->currentSchema();
+
+    for (auto& parser_it : schema)
+        if (!parser_it.second.initialized())
+            parser_it.second.initialize();
+
+    unique_ptr<vector<nlohmann::json>> json_objects;
+
+    runner.run("json_mapping", items, [&] ()
+    {
+        records_copy = records;
+
+        JSONParseJob parse_job (move(records_copy));
+        parse_job.run();
+
+        json_objects = move(parse_job.jsonObjects());
+    },
+    [&] ()
+    {
+        JSONMappingJob map_job (move(json_objects), schema.parsers(), 0);
+        map_job.run();
+
+        result_sink = map_job.numMapped();
+    });
+}
+
+void runFormatBenchmarks (BenchmarkRunner& runner, size_t rows)
+{
+    const long long start_epoch_ms = 1500000000000;
+
+    vector<nlohmann::json> epochs;
+    vector<nlohmann::json> mode3as;
+    vector<nlohmann::json> addresses;
+    vector<string> latitudes;
+
+    for (size_t cnt=0; cnt < rows; ++cnt)
+    {
+        epochs.push_back(start_epoch_ms + cnt*1000);
+        mode3as.push_back(Utils::String::octStringFromInt(cnt % 4096, 4, '0'));
+        addresses.push_back(Utils::String::hexStringFromInt(cnt % 0xFFFFFF, 6, '0'));
+        latitudes.push_back(Utils::String::intToString(cnt % 90, 2, '0')+Utils::String::intToString(cnt % 60, 2, '0')
+                            +Utils::String::intToString(cnt % 60, 2, '0')+".1234N");
+    }
+
+    // previous conversion through date time string, for comparison
+    runner.run("format_epoch_tod_ms_qdatetime", rows, nullptr, [&] ()
+    {
+        double sum = 0;
+
+        for (auto& epoch_it : epochs)
+        {
+            QDateTime date_time;
+            date_time.setMSecsSinceEpoch(stoul(Utils::JSON::toString(epoch_it)));
+            sum += Utils::String::timeFromString(date_time.toString("hh:mm:ss.zzz").toStdString());
+        }
+
+        result_sink = sum;
+    });
+
+    auto runConversion = [&] (const string& name, const vector<nlohmann::json>& values, Format::Type type)
+    {
+        JSONValueConverter<double>::Function converter = JSONValueConverter<double>::function(type);
+
+        runner.run(name, rows, nullptr, [&] ()
+        {
+            double sum = 0;
+
+            for (auto& value_it : values)
+                sum += converter(value_it);
+
+            result_sink = sum;
+        });
+    };
+
+    runConversion("format_epoch_tod_ms", epochs, Format::Type::EPOCH_TOD_MS);
+    runConversion("format_octal", mode3as, Format::Type::OCTAL);
+    runConversion("format_hexadecimal", addresses, Format::Type::HEXADECIMAL);
+
+    runner.run("format_latitude", rows, nullptr, [&] ()
+    {
+        double sum = 0;
+
+        for (auto& latitude_it : latitudes)
+            sum += Utils::String::doubleFromLatitudeString(latitude_it);
+
+        result_sink = sum;
+    });
+}
+
+void runProjectionBenchmark (BenchmarkRunner& runner, SyntheticDataGenerator& generator, size_t rows)
+{
+    const string name = "projection_rs2g";
+
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    if (!runner.selected(name))
+        return;
+
+    if (!object_man.existsObject("Radar"))
+    {
+        runner.skip(name, "object does not exist");
+        return;
+    }
+
+    DBObject& radar = object_man.object("Radar");
+
+    ProjectionManager& proj_man = ProjectionManager::instance();
+
+    bool use_ogr_proj = proj_man.useOGRProjection();
+    bool use_sdl_proj = proj_man.useSDLProjection();
+    bool use_rs2g_proj = proj_man.useRS2GProjection();
+
+    proj_man.useRS2GProjection(true);
+
+    DBODataSource data_source (radar, SyntheticDataGenerator::dataSourceId("Radar"), "BenchRadar");
+    data_source.latitude(generator.radarLatitude());
+    data_source.longitude(generator.radarLongitude());
+    data_source.altitude(generator.radarAltitude());
+    data_source.finalize();
+
+    if (!data_source.isFinalized())
+        runner.skip(name, "data source could not be finalized");
+    else
+    {
+        shared_ptr<Buffer> buffer = generator.generate(radar, rows);
+        size_t size = buffer->size();
+
+        runner.run(name, size, nullptr, [&] ()
+        {
+            NullableVector<double>& ranges = buffer->get<double>("pos_range_nm");
+            NullableVector<double>& azimuths = buffer->get<double>("pos_azm_deg");
+            NullableVector<int>& altitudes = buffer->get<int>("modec_code_ft");
+
+            double sum = 0;
+            double azimuth_rad, range_m;
+            VecB pos;
+
+            for (size_t cnt=0; cnt < size; ++cnt)
+            {
+                if (ranges.isNull(cnt) || azimuths.isNull(cnt))
+                    continue;
+
+                azimuth_rad = azimuths.get(cnt) * DEG2RAD;
+                range_m = NM2M * ranges.get(cnt);
+
+                if (!data_source.calculateRadSlt2Geocentric(
+                            range_m * sin(azimuth_rad), range_m * cos(azimuth_rad),
+                            altitudes.isNull(cnt) ? -1000.0 : altitudes.get(cnt) * FT2M, pos))
+                    continue;
+
+                if (geocentric2Geodesic(pos))
+                    sum += pos[0] + pos[1];
+            }
+
+            result_sink = sum;
+        });
+    }
+
+    // restore, last set flag resets the others
+    proj_man.useRS2GProjection(use_rs2g_proj);
+    proj_man.useOGRProjection(use_ogr_proj);
+    proj_man.useSDLProjection(use_sdl_proj);
+}
+
+void runAssociationBenchmark (BenchmarkRunner& runner, size_t rows)
+{
+    const string name = "artas_association";
+
+    if (!runner.selected(name))
+        return;
+
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    if (!object_man.existsObject("Tracker") || !object_man.object("Tracker").existsInDB())
+    {
+        runner.skip(name, "tracker object does not exist in database");
+        return;
+    }
+
+    DBObject& tracker = object_man.object("Tracker");
+
+    if (!tracker.hasCurrentDataSourceDefinition())
+    {
+        runner.skip(name, "tracker object has no data source definition");
+        return;
+    }
+
+    const string data_source_name = "BenchTracker";
+
+    tracker.addDataSource(SyntheticDataGenerator::dataSourceId("Tracker"), data_source_name);
+    QCoreApplication::processEvents(); // database content changed
+
+    CreateARTASAssociationsTask* task = ATSDB::instance().taskManager().getCreateARTASAssociationsTask();
+    assert (task);
+
+    task->currentDataSourceName(data_source_name);
+
+    if (!task->canRun())
+    {
+        runner.skip(name, "association task can not be run");
+        return;
+    }
+
+    runner.run(name, rows*DBO_NAMES.size(), nullptr, [&] ()
+    {
+        QEventLoop loop;
+        QObject::connect(task, &CreateARTASAssociationsTask::runDoneSignal, &loop, &QEventLoop::quit);
+
+        task->run();
+        loop.exec();
+    });
+}
+
+void runMySQLBenchmarks (BenchmarkRunner& runner, SyntheticDataGenerator& generator, size_t rows,
+                         const string& database)
+{
+    if (!database.size())
+    {
+        for (auto& dbo_name : DBO_NAMES)
+        {
+            runner.skip("mysql_insert_"+dbo_name, "no MySQL database given");
+            runner.skip("mysql_load_"+dbo_name, "no MySQL database given");
+        }
+        return;
+    }
+
+    loginf << "main: runMySQLBenchmarks: database '" << database << "'";
+
+    DBInterface& db_interface = ATSDB::instance().interface();
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    db_interface.connection().disconnect(); // SQLite benchmark database
+    db_interface.useConnection(MYSQL_IDENTIFIER);
+
+    MySQLppConnection* connection = dynamic_cast<MySQLppConnection*> (&db_interface.connection());
+    assert (connection);
+
+    connection->connectServer(); // uses the configured server
+
+    vector<string> databases = connection->getDatabases();
+    if (find(databases.begin(), databases.end(), database) != databases.end())
+        connection->deleteDatabase(database);
+
+    connection->createDatabase(database);
+    connection->openDatabase(database);
+
+    QCoreApplication::processEvents(); // database content changed
+
+    bool bulk_load = connection->bulkLoad();
+
+    for (auto& dbo_name : DBO_NAMES)
+    {
+        if (!object_man.existsObject(dbo_name))
+        {
+            runner.skip("mysql_insert_"+dbo_name, "object does not exist");
+            runner.skip("mysql_load_"+dbo_name, "object does not exist");
+            continue;
+        }
+
+        DBObject& object = object_man.object(dbo_name);
+        MetaDBTable& meta_table = object.currentMetaTable();
+
+        DBOVariableSet set;
+        SyntheticDataGenerator::variables(object, set);
+
+        shared_ptr<Buffer> buffer;
+
+        auto setup = [&] ()
+        {
+            buffer = generator.generate(object, rows);
+
+            if (db_interface.existsTable(meta_table.mainTableName()))
+                db_interface.clearTableContent(meta_table.mainTableName());
+
+            for (auto& sub_it : meta_table.subTables())
+                if (db_interface.existsTable(sub_it.second.name()))
+                    db_interface.clearTableContent(sub_it.second.name());
+        };
+
+        auto insert = [&] ()
+        {
+            buffer->transformVariables(set, false);
+            db_interface.insertBuffer(meta_table, buffer);
+        };
+
+        connection->bulkLoad(false); // one statement per row
+        runner.run("mysql_insert_"+dbo_name, rows, setup, insert);
+
+        connection->bulkLoad(true); // LOAD DATA LOCAL INFILE
+        runner.run("mysql_load_"+dbo_name, rows, setup, insert);
+    }
+
+    connection->bulkLoad(bulk_load);
+}
+
+int main (int argc, char **argv)
+{
+    unsigned int rows {0};
+    unsigned int targets {0};
+    unsigned int seed {0};
+    unsigned int repetitions {0};
+    string db_filename;
+    string output_filename;
+    string filter;
+    string mysql_database;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+            ("help", "produce help message")
+            ("rows", po::value<unsigned int>(&rows)->default_value(100000), "number of target reports per object")
+            ("targets", po::value<unsigned int>(&targets)->default_value(200), "number of simulated targets")
+            ("seed", po::value<unsigned int>(&seed)->default_value(42), "seed of synthetic data generator")
+            ("repetitions", po::value<unsigned int>(&repetitions)->default_value(3),
+             "number of repetitions per benchmark")
+            ("db", po::value<string>(&db_filename)->default_value("atsdb_bench.sqlite3"),
+             "SQLite3 database file, overwritten")
+            ("output", po::value<string>(&output_filename)->default_value("atsdb_bench.json"),
+             "JSON results file")
+            ("filter", po::value<string>(&filter), "only run benchmarks containing given string")
+            ("mysql_db", po::value<string>(&mysql_database),
+             "MySQL database on the configured server for insert benchmarks, overwritten")
+            ;
+
+    try
+    {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            cout << desc << endl;
+            return 0;
+        }
+    }
+    catch (exception& e)
+    {
+        cerr << "main: unable to parse command line parameters: " << e.what() << endl;
+        return -1;
+    }
+
+    if (!rows || !targets || !repetitions)
+    {
+        cerr << "main: rows, targets and repetitions must be larger than 0" << endl;
+        return -1;
+    }
+
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    bool atsdb_initialized = false;
+
+    try
+    {
+        int client_argc = 1; // own options are not passed on
+        Client client (client_argc, argv); // sets up configuration and logging
+
+        if (client.quitRequested())
+            return -1;
+
+        ATSDB::instance().initialize();
+        ATSDB::instance().headless(true);
+        atsdb_initialized = true;
+
+        BenchmarkRunner runner (repetitions, filter);
+        SyntheticDataGenerator generator (seed, targets);
+
+        runBufferBenchmarks(runner, generator, rows);
+        runFormatBenchmarks(runner, rows);
+
+        openDatabase(db_filename);
+
+        runDatabaseBenchmarks(runner, generator, rows);
+        runJSONBenchmarks(runner, generator, rows);
+        runProjectionBenchmark(runner, generator, rows);
+        runAssociationBenchmark(runner, rows);
+        runMySQLBenchmarks(runner, generator, rows, mysql_database); // switches connection, has to be last
+
+        nlohmann::json info;
+        info["version"] = VERSION;
+        info["time"] = boost::posix_time::to_iso_extended_string(boost::posix_time::second_clock::universal_time());
+        info["rows"] = rows;
+        info["targets"] = targets;
+        info["seed"] = seed;
+        info["repetitions"] = repetitions;
+        info["threads"] = QThread::idealThreadCount();
+
+        runner.saveJSON(output_filename, info);
+
+        ATSDB::instance().shutdown();
+    }
+    catch (exception& ex)
+    {
+        cerr << "main: caught exception '" << ex.what() << "'" << endl;
+
+        if (atsdb_initialized && ATSDB::instance().ready())
+            ATSDB::instance().shutdown();
+
+        return -1;
+    }
+
+    return 0;
+}
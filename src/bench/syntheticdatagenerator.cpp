@@ -0,0 +1,425 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "syntheticdatagenerator.h"
+#include "buffer.h"
+#include "dbobject.h"
+#include "dbovariable.h"
+#include "dbovariableset.h"
+#include "logger.h"
+#include "json.hpp"
+
+namespace
+{
+const double METERS_PER_DEGREE = 111320.0;
+const double NM2M = 1852.0;
+const long int EPOCH_START_MS = 1546300800000; // 2019-01-01 00:00:00 UTC
+}
+
+SyntheticDataGenerator::SyntheticDataGenerator(unsigned int seed, unsigned int num_targets)
+    : seed_(seed)
+{
+    assert (num_targets);
+
+    std::mt19937 generator (seed_);
+    std::uniform_real_distribution<double> position_offset (-1.5, 1.5);
+    std::uniform_real_distribution<double> heading (0, 2*M_PI);
+    std::uniform_real_distribution<double> speed (120.0, 250.0);
+    std::uniform_int_distribution<int> flight_level (50, 400);
+
+    for (unsigned int cnt=0; cnt < num_targets; ++cnt)
+    {
+        Target target;
+
+        target.latitude_ = center_latitude_ + position_offset(generator);
+        target.longitude_ = center_longitude_ + position_offset(generator);
+        target.heading_rad_ = heading(generator);
+        target.speed_mps_ = speed(generator);
+        target.altitude_ft_ = flight_level(generator)*100;
+        target.mode3a_ = (01000 + cnt) % 010000;
+        target.target_address_ = 0x3C0000 + static_cast<int>(cnt);
+
+        std::stringstream ss;
+        ss << "BNC" << std::setfill('0') << std::setw(4) << cnt;
+        target.callsign_ = ss.str();
+
+        targets_.push_back(target);
+    }
+}
+
+void SyntheticDataGenerator::variables (DBObject& object, DBOVariableSet& set)
+{
+    for (auto& var_it : object)
+        if (var_it.second.hasCurrentDBColumn())
+            set.add(var_it.second);
+}
+
+std::shared_ptr<Buffer> SyntheticDataGenerator::generate (DBObject& object, size_t rows, int first_rec_num)
+{
+    const std::string& dbo_name = object.name();
+
+    logdbg << "SyntheticDataGenerator: generate: " << dbo_name << " rows " << rows;
+
+    DBOVariableSet set;
+    variables(object, set);
+
+    PropertyList properties;
+    std::vector<Field> fields;
+
+    for (auto var_it : set.getSet())
+    {
+        properties.addProperty(var_it->name(), var_it->dataType());
+        fields.push_back(field(var_it->name()));
+    }
+
+    std::shared_ptr<Buffer> buffer = std::make_shared<Buffer> (properties, dbo_name);
+
+    std::mt19937 generator (seed_ + stringHash(dbo_name));
+
+    float sensor_period = period(dbo_name);
+    unsigned int num_targets = numTargets();
+    int ds_id = dataSourceId(dbo_name);
+    bool is_radar = dbo_name == "Radar";
+    bool is_tracker = dbo_name == "Tracker";
+
+    double latitude, longitude;
+    double x_m, y_m;
+    double range_nm {0}, azimuth_deg {0};
+
+    std::vector<DBOVariable*>& variables = set.getSet();
+    size_t num_variables = variables.size();
+
+    for (size_t row=0; row < rows; ++row)
+    {
+        unsigned int target_num = row % num_targets;
+        unsigned int scan = row / num_targets;
+        const Target& target = targets_.at(target_num);
+
+        // targets spread over the scan, tracker updates half a second after the plots
+        float tod = start_tod_ + scan*sensor_period + sensor_period*target_num/num_targets + (is_tracker ? 0.5f : 0);
+
+        position(target, tod, latitude, longitude);
+
+        if (is_radar)
+        {
+            x_m = (longitude - center_longitude_) * METERS_PER_DEGREE * cos(center_latitude_ * M_PI / 180.0);
+            y_m = (latitude - center_latitude_) * METERS_PER_DEGREE;
+
+            range_nm = sqrt(x_m*x_m + y_m*y_m) / NM2M;
+            azimuth_deg = atan2(x_m, y_m) * 180.0 / M_PI;
+            if (azimuth_deg < 0)
+                azimuth_deg += 360.0;
+        }
+
+        for (size_t var_cnt=0; var_cnt < num_variables; ++var_cnt)
+        {
+            const DBOVariable& var = *variables.at(var_cnt);
+
+            switch (fields.at(var_cnt))
+            {
+            case Field::REC_NUM:
+                setValue(*buffer, var, row, first_rec_num + row);
+                break;
+            case Field::DS_ID:
+                setValue(*buffer, var, row, ds_id);
+                break;
+            case Field::SAC:
+                setValue(*buffer, var, row, ds_id / 256);
+                break;
+            case Field::SIC:
+                setValue(*buffer, var, row, ds_id % 256);
+                break;
+            case Field::TOD:
+                setValue(*buffer, var, row, tod);
+                break;
+            case Field::LATITUDE:
+                if (!is_radar) // calculated later
+                    setValue(*buffer, var, row, latitude);
+                break;
+            case Field::LONGITUDE:
+                if (!is_radar)
+                    setValue(*buffer, var, row, longitude);
+                break;
+            case Field::RANGE:
+                if (is_radar)
+                    setValue(*buffer, var, row, range_nm);
+                break;
+            case Field::AZIMUTH:
+                if (is_radar)
+                    setValue(*buffer, var, row, azimuth_deg);
+                break;
+            case Field::ALTITUDE:
+                setValue(*buffer, var, row, target.altitude_ft_);
+                break;
+            case Field::MODE3A:
+                setValue(*buffer, var, row, target.mode3a_);
+                break;
+            case Field::TARGET_ADDRESS:
+                setValue(*buffer, var, row, target.target_address_);
+                break;
+            case Field::CALLSIGN:
+                setValue(*buffer, var, row, target.callsign_);
+                break;
+            case Field::TRACK_NUM:
+                setValue(*buffer, var, row, target_num+1);
+                break;
+            case Field::HASH:
+                if (is_radar || is_tracker)
+                    setValue(*buffer, var, row, hashCode(target_num, scan));
+                else
+                    setValue(*buffer, var, row, hashCode(target_num, scan)+dbo_name);
+                break;
+            case Field::TRACK_CREATED:
+                setValue(*buffer, var, row, scan == 0 ? "1" : "0");
+                break;
+            case Field::TRACK_END:
+            case Field::TRACK_COASTED:
+                setValue(*buffer, var, row, "0");
+                break;
+            case Field::OTHER:
+                if ((row + var_cnt) % 2 == 0) // every second value null
+                    setRandomValue(*buffer, var, row, generator);
+                break;
+            }
+        }
+    }
+
+    return buffer;
+}
+
+std::vector<std::string> SyntheticDataGenerator::generateADSBExchangeJSON (size_t num_records,
+                                                                           size_t targets_per_record)
+{
+    std::vector<std::string> records;
+
+    unsigned int num_targets = numTargets();
+    float sensor_period = period("ADSB");
+    double latitude, longitude;
+    size_t report_cnt = 0;
+
+    for (size_t record_cnt=0; record_cnt < num_records; ++record_cnt)
+    {
+        nlohmann::json record;
+        nlohmann::json& aircraft_list = record["acList"];
+        aircraft_list = nlohmann::json::array();
+
+        for (size_t cnt=0; cnt < targets_per_record; ++cnt, ++report_cnt)
+        {
+            unsigned int target_num = report_cnt % num_targets;
+            unsigned int scan = report_cnt / num_targets;
+            const Target& target = targets_.at(target_num);
+
+            float tod = start_tod_ + scan*sensor_period + sensor_period*target_num/num_targets;
+            position(target, tod, latitude, longitude);
+
+            std::stringstream ss;
+            ss << std::uppercase << std::hex << target.target_address_;
+
+            nlohmann::json aircraft;
+            aircraft["Icao"] = ss.str();
+            aircraft["Reg"] = target.callsign_;
+            aircraft["Alt"] = target.altitude_ft_;
+            aircraft["GAlt"] = target.altitude_ft_ + 100;
+            aircraft["Lat"] = latitude;
+            aircraft["Long"] = longitude;
+            aircraft["PosTime"] = EPOCH_START_MS + static_cast<long int>(tod*1000.0);
+
+            aircraft_list.push_back(aircraft);
+        }
+
+        records.push_back(record.dump());
+    }
+
+    return records;
+}
+
+int SyntheticDataGenerator::dataSourceId (const std::string& dbo_name)
+{
+    const int sac = 50;
+
+    if (dbo_name == "Radar")
+        return sac*256 + 1;
+    else if (dbo_name == "ADSB")
+        return sac*256 + 2;
+    else if (dbo_name == "MLAT")
+        return sac*256 + 3;
+    else if (dbo_name == "Tracker")
+        return sac*256 + 4;
+    else
+        return sac*256 + 5;
+}
+
+float SyntheticDataGenerator::period (const std::string& dbo_name)
+{
+    if (dbo_name == "Radar" || dbo_name == "Tracker")
+        return 4.0;
+    else
+        return 1.0;
+}
+
+SyntheticDataGenerator::Field SyntheticDataGenerator::field (const std::string& variable_name)
+{
+    if (variable_name == "rec_num")
+        return Field::REC_NUM;
+    if (variable_name == "ds_id")
+        return Field::DS_ID;
+    if (variable_name == "sac")
+        return Field::SAC;
+    if (variable_name == "sic")
+        return Field::SIC;
+    if (variable_name == "tod")
+        return Field::TOD;
+    if (variable_name == "pos_lat_deg")
+        return Field::LATITUDE;
+    if (variable_name == "pos_long_deg")
+        return Field::LONGITUDE;
+    if (variable_name == "pos_range_nm")
+        return Field::RANGE;
+    if (variable_name == "pos_azm_deg")
+        return Field::AZIMUTH;
+    if (variable_name == "alt_baro_ft" || variable_name == "modec_code_ft" || variable_name == "tracked_alt_baro_ft")
+        return Field::ALTITUDE;
+    if (variable_name == "mode3a_code" || variable_name == "tracked_mode3a_code")
+        return Field::MODE3A;
+    if (variable_name == "target_addr")
+        return Field::TARGET_ADDRESS;
+    if (variable_name == "callsign")
+        return Field::CALLSIGN;
+    if (variable_name == "track_num")
+        return Field::TRACK_NUM;
+    if (variable_name == "hash_code")
+        return Field::HASH;
+    if (variable_name == "track_created")
+        return Field::TRACK_CREATED;
+    if (variable_name == "track_end")
+        return Field::TRACK_END;
+    if (variable_name == "track_coasted")
+        return Field::TRACK_COASTED;
+
+    return Field::OTHER;
+}
+
+std::string SyntheticDataGenerator::hashCode (unsigned int target, unsigned int scan)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16)
+       << stringHash(std::to_string(target)+":"+std::to_string(scan));
+    return ss.str();
+}
+
+size_t SyntheticDataGenerator::stringHash (const std::string& value)
+{
+    // FNV-1a, since std::hash is not guaranteed to be equal between implementations
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (unsigned char character : value)
+    {
+        hash ^= character;
+        hash *= 1099511628211ULL;
+    }
+
+    return static_cast<size_t>(hash);
+}
+
+void SyntheticDataGenerator::position (const Target& target, float tod, double& latitude, double& longitude) const
+{
+    double seconds = tod - start_tod_;
+    double distance_m = target.speed_mps_ * seconds;
+
+    latitude = target.latitude_ + distance_m * cos(target.heading_rad_) / METERS_PER_DEGREE;
+    longitude = target.longitude_ + distance_m * sin(target.heading_rad_)
+            / (METERS_PER_DEGREE * cos(target.latitude_ * M_PI / 180.0));
+}
+
+void SyntheticDataGenerator::setValue (Buffer& buffer, const DBOVariable& var, size_t row, double value)
+{
+    const std::string& name = var.name();
+
+    switch (var.dataType())
+    {
+    case PropertyDataType::BOOL:
+        buffer.get<bool>(name).set(row, value != 0);
+        break;
+    case PropertyDataType::CHAR:
+        buffer.get<char>(name).set(row, static_cast<char>(value));
+        break;
+    case PropertyDataType::UCHAR:
+        buffer.get<unsigned char>(name).set(row, static_cast<unsigned char>(value));
+        break;
+    case PropertyDataType::SHORTINT:
+        buffer.get<short int>(name).set(row, static_cast<short int>(value));
+        break;
+    case PropertyDataType::USHORTINT:
+        buffer.get<unsigned short int>(name).set(row, static_cast<unsigned short int>(value));
+        break;
+    case PropertyDataType::INT:
+        buffer.get<int>(name).set(row, static_cast<int>(value));
+        break;
+    case PropertyDataType::UINT:
+        buffer.get<unsigned int>(name).set(row, static_cast<unsigned int>(value));
+        break;
+    case PropertyDataType::LONGINT:
+        buffer.get<long int>(name).set(row, static_cast<long int>(value));
+        break;
+    case PropertyDataType::ULONGINT:
+        buffer.get<unsigned long int>(name).set(row, static_cast<unsigned long int>(value));
+        break;
+    case PropertyDataType::FLOAT:
+        buffer.get<float>(name).set(row, static_cast<float>(value));
+        break;
+    case PropertyDataType::DOUBLE:
+        buffer.get<double>(name).set(row, value);
+        break;
+    case PropertyDataType::TIMESTAMP:
+        buffer.get<Timestamp>(name).set(row, Timestamp(value));
+        break;
+    case PropertyDataType::STRING:
+        buffer.get<std::string>(name).set(row, std::to_string(static_cast<long int>(value)));
+        break;
+    default:
+        logerr << "SyntheticDataGenerator: setValue: unknown property type "
+               << Property::asString(var.dataType());
+        throw std::domain_error ("SyntheticDataGenerator: setValue: unknown property data type");
+    }
+}
+
+void SyntheticDataGenerator::setValue (Buffer& buffer, const DBOVariable& var, size_t row, const std::string& value)
+{
+    if (var.dataType() == PropertyDataType::STRING)
+        buffer.get<std::string>(var.name()).set(row, value);
+    else
+        setValue(buffer, var, row, std::stod(value));
+}
+
+void SyntheticDataGenerator::setRandomValue (Buffer& buffer, const DBOVariable& var, size_t row,
+                                             std::mt19937& generator)
+{
+    unsigned int value = generator() % 1000;
+
+    if (var.dataType() == PropertyDataType::STRING)
+        buffer.get<std::string>(var.name()).set(row, "V"+std::to_string(value));
+    else if (var.dataType() == PropertyDataType::CHAR || var.dataType() == PropertyDataType::UCHAR)
+        setValue(buffer, var, row, value % 100);
+    else if (var.dataType() == PropertyDataType::BOOL)
+        setValue(buffer, var, row, value % 2);
+    else
+        setValue(buffer, var, row, value);
+}
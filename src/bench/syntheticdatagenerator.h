@@ -0,0 +1,104 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNTHETICDATAGENERATOR_H
+#define SYNTHETICDATAGENERATOR_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+class Buffer;
+class DBObject;
+class DBOVariable;
+class DBOVariableSet;
+
+/**
+ * @brief Deterministic generator of synthetic surveillance data
+ *
+ * Simulates a number of targets flying straight lines around a fixed center position, observed by one radar,
+ * an ADS-B and a MLAT receiver and tracked by a system tracker. Buffers are created from the DBOVariables of the
+ * given DBObject, so they follow the configured schema. Known variables (time, position, identification, hashes)
+ * are filled consistently, all other variables with pseudo-random values, every second row being null.
+ *
+ * The same seed always produces the same data. Radar plots and tracker updates of the same target and scan share
+ * the same hash code, so ARTAS associations can be created.
+ */
+class SyntheticDataGenerator
+{
+public:
+    SyntheticDataGenerator (unsigned int seed, unsigned int num_targets);
+    virtual ~SyntheticDataGenerator() {}
+
+    /// @brief Returns all variables of object which can be written to the database
+    static void variables (DBObject& object, DBOVariableSet& set);
+
+    /// @brief Returns new buffer with rows target reports in DBO variable names, rec_nums starting at first_rec_num
+    std::shared_ptr<Buffer> generate (DBObject& object, size_t rows, int first_rec_num=1);
+
+    /// @brief Returns ADSBExchange-style JSON documents, each containing targets_per_record aircraft
+    std::vector<std::string> generateADSBExchangeJSON (size_t num_records, size_t targets_per_record);
+
+    /// @brief Returns data source id (sac*256+sic) used for the given object
+    static int dataSourceId (const std::string& dbo_name);
+
+    double radarLatitude () const { return center_latitude_; }
+    double radarLongitude () const { return center_longitude_; }
+    double radarAltitude () const { return radar_altitude_m_; }
+
+    unsigned int numTargets () const { return static_cast<unsigned int>(targets_.size()); }
+
+protected:
+    /// @brief Content of a variable, determined by its name
+    enum class Field { REC_NUM, DS_ID, SAC, SIC, TOD, LATITUDE, LONGITUDE, RANGE, AZIMUTH, ALTITUDE, MODE3A,
+                       TARGET_ADDRESS, CALLSIGN, TRACK_NUM, HASH, TRACK_CREATED, TRACK_END, TRACK_COASTED, OTHER };
+
+    struct Target
+    {
+        double latitude_ {0};
+        double longitude_ {0};
+        double heading_rad_ {0};
+        double speed_mps_ {0};
+        int altitude_ft_ {0};
+        int mode3a_ {0};
+        int target_address_ {0};
+        std::string callsign_;
+    };
+
+    unsigned int seed_ {0};
+    std::vector<Target> targets_;
+
+    const double center_latitude_ {47.5};
+    const double center_longitude_ {14.0};
+    const double radar_altitude_m_ {500.0};
+    const float start_tod_ {6*3600.0f};
+
+    /// @brief Returns update period of sensor in seconds
+    static float period (const std::string& dbo_name);
+    static Field field (const std::string& variable_name);
+    static std::string hashCode (unsigned int target, unsigned int scan);
+    static size_t stringHash (const std::string& value);
+
+    void position (const Target& target, float tod, double& latitude, double& longitude) const;
+
+    void setValue (Buffer& buffer, const DBOVariable& var, size_t row, double value);
+    void setValue (Buffer& buffer, const DBOVariable& var, size_t row, const std::string& value);
+    void setRandomValue (Buffer& buffer, const DBOVariable& var, size_t row, std::mt19937& generator);
+};
+
+#endif // SYNTHETICDATAGENERATOR_H
@@ -18,6 +18,7 @@
 #include "boost/date_time/posix_time/posix_time.hpp"
 
 #include "buffer.h"
+#include "buffertransformation.h"
 #include "logger.h"
 #include "string.h"
 
@@ -114,6 +115,17 @@ void Buffer::addProperty (std::string id, PropertyDataType type)
                 std::shared_ptr<NullableVector<unsigned char>> (new NullableVector<unsigned char>(property,
                                                                                                         *this));
         break;
+    case PropertyDataType::SHORTINT:
+        assert (getArrayListMap<short int>().count(id) == 0);
+        getArrayListMap<short int>() [id] =
+                std::shared_ptr<NullableVector<short int>> (new NullableVector<short int>(property, *this));
+        break;
+    case PropertyDataType::USHORTINT:
+        assert (getArrayListMap<unsigned short int>().count(id) == 0);
+        getArrayListMap<unsigned short int>() [id] =
+                std::shared_ptr<NullableVector<unsigned short int>> (
+                    new NullableVector<unsigned short int>(property, *this));
+        break;
     case PropertyDataType::INT:
         assert (getArrayListMap<int>().count(id) == 0);
         getArrayListMap<int>() [id] =
@@ -145,6 +157,11 @@ void Buffer::addProperty (std::string id, PropertyDataType type)
         getArrayListMap<double>() [id] =
                 std::shared_ptr<NullableVector<double>> (new NullableVector<double>(property, *this));
         break;
+    case PropertyDataType::TIMESTAMP:
+        assert (getArrayListMap<Timestamp>().count(id) == 0);
+        getArrayListMap<Timestamp>() [id] =
+                std::shared_ptr<NullableVector<Timestamp>> (new NullableVector<Timestamp>(property, *this));
+        break;
     case PropertyDataType::STRING:
         assert (getArrayListMap<std::string>().count(id) == 0);
         getArrayListMap<std::string>() [id] =
@@ -176,12 +193,15 @@ void Buffer::seizeBuffer (Buffer &org_buffer)
     seizeArrayListMap<bool>(org_buffer);
     seizeArrayListMap<char>(org_buffer);
     seizeArrayListMap<unsigned char>(org_buffer);
+    seizeArrayListMap<short int>(org_buffer);
+    seizeArrayListMap<unsigned short int>(org_buffer);
     seizeArrayListMap<int>(org_buffer);
     seizeArrayListMap<unsigned int>(org_buffer);
     seizeArrayListMap<long int>(org_buffer);
     seizeArrayListMap<unsigned long int>(org_buffer);
     seizeArrayListMap<float>(org_buffer);
     seizeArrayListMap<double>(org_buffer);
+    seizeArrayListMap<Timestamp>(org_buffer);
     seizeArrayListMap<std::string>(org_buffer);
 
     data_size_ += org_buffer.data_size_;
@@ -205,6 +225,10 @@ void Buffer::cutToSize (size_t size)
         it.second->cutToSize(size);
     for (auto& it : getArrayListMap<unsigned char>())
         it.second->cutToSize(size);
+    for (auto& it : getArrayListMap<short int>())
+        it.second->cutToSize(size);
+    for (auto& it : getArrayListMap<unsigned short int>())
+        it.second->cutToSize(size);
     for (auto& it : getArrayListMap<int>())
         it.second->cutToSize(size);
     for (auto& it : getArrayListMap<unsigned int>())
@@ -217,6 +241,8 @@ void Buffer::cutToSize (size_t size)
         it.second->cutToSize(size);
     for (auto& it : getArrayListMap<double>())
         it.second->cutToSize(size);
+    for (auto& it : getArrayListMap<Timestamp>())
+        it.second->cutToSize(size);
     for (auto& it : getArrayListMap<std::string>())
         it.second->cutToSize(size);
 
@@ -249,6 +275,12 @@ bool Buffer::isNone (const Property& property, unsigned int row_cnt)
     case PropertyDataType::UCHAR:
         assert (getArrayListMap<unsigned char>().count(property.name()));
         return getArrayListMap<unsigned char>().at(property.name())->isNull(row_cnt);
+    case PropertyDataType::SHORTINT:
+        assert (getArrayListMap<short int>().count(property.name()));
+        return getArrayListMap<short int>().at(property.name())->isNull(row_cnt);
+    case PropertyDataType::USHORTINT:
+        assert (getArrayListMap<unsigned short int>().count(property.name()));
+        return getArrayListMap<unsigned short int>().at(property.name())->isNull(row_cnt);
     case PropertyDataType::INT:
         assert (getArrayListMap<int>().count(property.name()));
         return getArrayListMap<int>().at(property.name())->isNull(row_cnt);
@@ -267,6 +299,9 @@ bool Buffer::isNone (const Property& property, unsigned int row_cnt)
     case PropertyDataType::DOUBLE:
         assert (getArrayListMap<double>().count(property.name()));
         return getArrayListMap<double>().at(property.name())->isNull(row_cnt);
+    case PropertyDataType::TIMESTAMP:
+        assert (getArrayListMap<Timestamp>().count(property.name()));
+        return getArrayListMap<Timestamp>().at(property.name())->isNull(row_cnt);
     case PropertyDataType::STRING:
         assert (getArrayListMap<std::string>().count(property.name()));
         return getArrayListMap<std::string>().at(property.name())->isNull(row_cnt);
@@ -279,285 +314,12 @@ bool Buffer::isNone (const Property& property, unsigned int row_cnt)
 
 void Buffer::transformVariables (DBOVariableSet& list, bool tc2dbovar)
 {
-    // TODO add proper data type conversion
-    std::vector <DBOVariable*> &variables = list.getSet ();
-
-    for (auto var_it : variables)
-    {
-        logdbg << "Buffer: transformVariables: variable " << var_it->name() << " has representation "
-               << var_it->representationString();
-        assert (var_it->hasCurrentDBColumn());
-        const DBTableColumn &column = var_it->currentDBColumn ();
-
-        logdbg << "Buffer: transformVariables: variable " << var_it->name() << " col "
-               << column.name();
-
-        PropertyDataType data_type = var_it->dataType();
-
-        std::string current_var_name;
-        std::string transformed_var_name;
-
-        if (tc2dbovar)
-        {
-            assert (properties_.hasProperty(column.name()));
-            // TODO HACK should be column data type
-            assert (properties_.get(column.name()).dataType() == var_it->dataType());
-            current_var_name = column.name();
-            transformed_var_name = var_it->name();
-        }
-        else
-        {
-            assert (properties_.hasProperty(var_it->name()));
-            logdbg << "Buffer: transformVariables: var " << var_it->name()
-                   << " col " << column.name()
-                   << " prop dt " << Property::asString(properties_.get(var_it->name()).dataType())
-                   << " col dt " << Property::asString(column.propertyType());
-            // TODO HACK
-            //assert (properties_.get(var_it->name()).dataType() == column.propertyType());
-            current_var_name = var_it->name();
-            transformed_var_name = column.name();
-        }
-
-        if (column.dataFormat() != "") // do format conversion stuff
-        {
-            logdbg << "Buffer: transformVariables: column " << column.name()
-                   << " has to-be-removed format " << column.dataFormat();
-
-            switch (data_type)
-            {
-            case PropertyDataType::CHAR:
-            {
-                assert (has<char>(current_var_name));
-                NullableVector<char> &array_list = get<char> (current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            case PropertyDataType::UCHAR:
-            {
-                assert (has<unsigned char>(current_var_name));
-                NullableVector<unsigned char> &array_list = get<unsigned char> (current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            case PropertyDataType::INT:
-            {
-                assert (has<int>(current_var_name));
-                NullableVector<int> &array_list = get<int> (current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            case PropertyDataType::UINT:
-            {
-                assert (has<unsigned int>(current_var_name));
-                NullableVector<unsigned int> &array_list = get<unsigned int> (current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            case PropertyDataType::LONGINT:
-            {
-                assert (has<long int>(current_var_name));
-                NullableVector<long int> &array_list = get<long int>(current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            case PropertyDataType::ULONGINT:
-            {
-                assert (has<unsigned long>(current_var_name));
-                NullableVector<unsigned long> &array_list = get<unsigned long>(current_var_name);
-                array_list.convertToStandardFormat(column.dataFormat());
-                break;
-            }
-            default:
-                logerr  <<  "Buffer: transformVariables: format conversion impossible for property type "
-                         << Property::asString(data_type);
-                throw std::runtime_error ("Buffer: transformVariables: impossible property type "
-                                          + Property::asString(data_type));
-            }
-        }
-
-        if (column.dimension() != var_it->dimension())
-            logwrn << "Buffer: transformVariables:: variable " << var_it->name()
-                   << " has differing dimensions " << column.dimension() << " " << var_it->dimension();
-        else if (column.unit() != var_it->unit()) // do unit conversion stuff
-        {
-            logdbg << "Buffer: transformVariables: variable " << var_it->name()
-                   << " of same dimension has different units " << column.unit() << " " << var_it->unit();
-
-            if (!UnitManager::instance().hasDimension (var_it->dimension()))
-            {
-                logerr  <<  "Buffer: transformVariables: unknown dimension '" << var_it->dimension() << "'";
-                throw std::runtime_error ("Buffer: transformVariables: unknown dimension '"+var_it->dimension()+"'");
-            }
-
-            const Dimension &dimension = UnitManager::instance().dimension (var_it->dimension());
-            double factor;
-
-            if (!dimension.hasUnit(column.unit()))
-                logerr  <<  "Buffer: transformVariables: dimension '" << var_it->dimension() << "' has unknown unit '"
-                         << column.unit() << "'";
-
-            if (!dimension.hasUnit(var_it->unit()))
-                logerr  <<  "Buffer: transformVariables: dimension '" << var_it->dimension() << "' has unknown unit '"
-                         << var_it->unit() << "'";
-
-            if (tc2dbovar)
-                factor = dimension.getFactor (column.unit(), var_it->unit());
-            else
-                factor = dimension.getFactor (var_it->unit(), column.unit());
-
-            logdbg  << "Buffer: transformVariables: correct unit transformation with factor " << factor;
-
-            switch (data_type)
-            {
-            case PropertyDataType::BOOL:
-            {
-                assert (has<bool>(current_var_name));
-                NullableVector<bool> &array_list = get<bool>(current_var_name);
-                logwrn << "Buffer: transformVariables: double multiplication of boolean variable "
-                       << var_it->name();
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::CHAR:
-            {
-                assert (has<char>(current_var_name));
-                NullableVector<char> &array_list = get<char> (current_var_name);
-                logwrn << "Buffer: transformVariables: double multiplication of char variable "
-                       << var_it->name();
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::UCHAR:
-            {
-                assert (has<unsigned char>(current_var_name));
-                NullableVector<unsigned char> &array_list = get<unsigned char> (current_var_name);
-                logwrn << "Buffer: transformVariables: double multiplication of unsigned char variable "
-                       << var_it->name();
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::INT:
-            {
-                assert (has<int>(current_var_name));
-                NullableVector<int> &array_list = get<int> (current_var_name);
-                loginf << "JsonMapping: transformBuffer: double multiplication of int variable "
-                       << current_var_name << " factor " << factor;
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::UINT:
-            {
-                assert (has<unsigned int>(current_var_name));
-                NullableVector<unsigned int> &array_list = get<unsigned int> (current_var_name);
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::LONGINT:
-            {
-                assert (has<long int>(current_var_name));
-                NullableVector<long int> &array_list = get<long int>(current_var_name);
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::ULONGINT:
-            {
-                assert (has<unsigned long>(current_var_name));
-                NullableVector<unsigned long> &array_list = get<unsigned long>(current_var_name);
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::FLOAT:
-            {
-                assert (has<float>(current_var_name));
-                NullableVector<float> &array_list = get<float>(current_var_name);
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::DOUBLE:
-            {
-                assert (has<double>(current_var_name));
-                NullableVector<double> &array_list = get<double>(current_var_name);
-                array_list *= factor;
-                break;
-            }
-            case PropertyDataType::STRING:
-                logerr << "Buffer: transformVariables: unit transformation for string variable "
-                       << var_it->name() << " impossible";
-                break;
-            default:
-                logerr  <<  "Buffer: transformVariables: unknown property type "
-                         << Property::asString(data_type);
-                throw std::runtime_error ("Buffer: transformVariables: unknown property type "
-                                          + Property::asString(data_type));
-            }
-        }
+    BufferTransformation (list, tc2dbovar).apply(*this);
+}
 
-        // rename to reflect dbo variable
-        if (current_var_name != transformed_var_name)
-        {
-            logdbg << "Buffer: transformVariables: renaming variable " << current_var_name
-                   << " to variable name " << transformed_var_name;
-
-            switch (data_type)
-            {
-            case PropertyDataType::BOOL:
-            {
-                rename<bool> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::CHAR:
-            {
-                rename<char> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::UCHAR:
-            {
-                rename<unsigned char> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::INT:
-            {
-                rename<int> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::UINT:
-            {
-                rename<unsigned int> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::LONGINT:
-            {
-                rename<long int> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::ULONGINT:
-            {
-                rename<unsigned long int> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::FLOAT:
-            {
-                rename<float> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::DOUBLE:
-            {
-                rename<double> (current_var_name, transformed_var_name);
-                break;
-            }
-            case PropertyDataType::STRING:
-            {
-                rename<std::string> (current_var_name, transformed_var_name);
-                break;
-            }
-            default:
-                logerr  <<  "Buffer: transformVariables: unknown property type "
-                         << Property::asString(data_type);
-                throw std::runtime_error ("Buffer: transformVariables: unknown property type "
-                                          + Property::asString(data_type));
-            }
-        }
-    }
+void Buffer::transformVariables (const BufferTransformation& transformation)
+{
+    transformation.apply(*this);
 }
 
 std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_properties)
@@ -582,6 +344,12 @@ std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_prop
         case PropertyDataType::UCHAR:
             tmp_buffer->get<unsigned char>(prop.name()).copyData(get<unsigned char>(prop.name()));
             break;
+        case PropertyDataType::SHORTINT:
+            tmp_buffer->get<short int>(prop.name()).copyData(get<short int>(prop.name()));
+            break;
+        case PropertyDataType::USHORTINT:
+            tmp_buffer->get<unsigned short int>(prop.name()).copyData(get<unsigned short int>(prop.name()));
+            break;
         case PropertyDataType::INT:
             tmp_buffer->get<int>(prop.name()).copyData(get<int>(prop.name()));
             break;
@@ -600,6 +368,9 @@ std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_prop
         case PropertyDataType::DOUBLE:
             tmp_buffer->get<double>(prop.name()).copyData(get<double>(prop.name()));
             break;
+        case PropertyDataType::TIMESTAMP:
+            tmp_buffer->get<Timestamp>(prop.name()).copyData(get<Timestamp>(prop.name()));
+            break;
         case PropertyDataType::STRING:
             tmp_buffer->get<std::string>(prop.name()).copyData(get<std::string>(prop.name()));
             break;
@@ -614,6 +385,62 @@ std::shared_ptr<Buffer> Buffer::getPartialCopy (const PropertyList& partial_prop
     return tmp_buffer;
 }
 
+size_t Buffer::memoryUsage ()
+{
+    return memoryUsageArrayListMap<bool>() + memoryUsageArrayListMap<char>()
+            + memoryUsageArrayListMap<unsigned char>() + memoryUsageArrayListMap<short int>()
+            + memoryUsageArrayListMap<unsigned short int>() + memoryUsageArrayListMap<int>()
+            + memoryUsageArrayListMap<unsigned int>() + memoryUsageArrayListMap<long int>()
+            + memoryUsageArrayListMap<unsigned long int>() + memoryUsageArrayListMap<float>()
+            + memoryUsageArrayListMap<double>() + memoryUsageArrayListMap<Timestamp>()
+            + memoryUsageArrayListMap<std::string>();
+}
 
+unsigned int Buffer::numSpilled ()
+{
+    return numSpilledArrayListMap<char>() + numSpilledArrayListMap<unsigned char>()
+            + numSpilledArrayListMap<short int>() + numSpilledArrayListMap<unsigned short int>()
+            + numSpilledArrayListMap<int>() + numSpilledArrayListMap<unsigned int>()
+            + numSpilledArrayListMap<long int>() + numSpilledArrayListMap<unsigned long int>()
+            + numSpilledArrayListMap<float>() + numSpilledArrayListMap<double>()
+            + numSpilledArrayListMap<Timestamp>();
+}
 
+size_t Buffer::spill (const std::set<std::string>& keep_properties, size_t bytes_to_free)
+{
+    logdbg << "Buffer: spill: dbo " << dbo_name_ << " bytes to free " << bytes_to_free;
 
+    if (pinned()) // read by a job
+    {
+        logdbg << "Buffer: spill: dbo " << dbo_name_ << " pinned";
+        return 0;
+    }
+
+    // largest types first, bool and string containers can not be spilled
+    size_t freed_bytes = spillArrayListMap<double>(keep_properties, bytes_to_free);
+
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<long int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<unsigned long int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<Timestamp>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<float>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<unsigned int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<short int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<unsigned short int>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<char>(keep_properties, bytes_to_free-freed_bytes);
+    if (freed_bytes < bytes_to_free)
+        freed_bytes += spillArrayListMap<unsigned char>(keep_properties, bytes_to_free-freed_bytes);
+
+    logdbg << "Buffer: spill: dbo " << dbo_name_ << " freed " << freed_bytes << " bytes";
+
+    return freed_bytes;
+}
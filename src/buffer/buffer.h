@@ -18,26 +18,32 @@
 #ifndef BUFFER_H_
 #define BUFFER_H_
 
+#include <atomic>
 #include <unordered_map>
 #include <tuple>
 #include <vector>
 #include <memory>
+#include <set>
 
 #include "propertylist.h"
 
 class DBOVariableSet;
+class BufferTransformation;
 
 template <class T> class NullableVector;
 
 typedef std::tuple< std::map <std::string, std::shared_ptr<NullableVector<bool>>>,
 std::map <std::string, std::shared_ptr<NullableVector<char>>>,
 std::map <std::string, std::shared_ptr<NullableVector<unsigned char>>>,
+std::map <std::string, std::shared_ptr<NullableVector<short int>>>,
+std::map <std::string, std::shared_ptr<NullableVector<unsigned short int>>>,
 std::map <std::string, std::shared_ptr<NullableVector<int>>>,
 std::map <std::string, std::shared_ptr<NullableVector<unsigned int>>>,
 std::map <std::string, std::shared_ptr<NullableVector<long int>>> ,
 std::map <std::string, std::shared_ptr<NullableVector<unsigned long int>>>,
 std::map <std::string, std::shared_ptr<NullableVector<float>>>,
 std::map <std::string, std::shared_ptr<NullableVector<double>>>,
+std::map <std::string, std::shared_ptr<NullableVector<Timestamp>>>,
 std::map <std::string, std::shared_ptr<NullableVector<std::string>>> > ArrayListMapTupel;
 
 template <class T, class Tuple>
@@ -112,9 +118,23 @@ public:
     bool isNone (const Property& property, unsigned int row_cnt);
 
     void transformVariables (DBOVariableSet& list, bool tc2dbovar); // tc2dbovar true for db->dbo, false dbo->db
+    /// @brief Transforms using a precompiled transformation, to be preferred when transforming many chunks
+    void transformVariables (const BufferTransformation& transformation);
 
     std::shared_ptr<Buffer> getPartialCopy (const PropertyList& partial_properties);
 
+    /// @brief Returns number of bytes held in memory by all containers
+    size_t memoryUsage ();
+    /// @brief Returns number of containers which are currently spilled to disk
+    unsigned int numSpilled ();
+    /// @brief Spills containers not listed in keep_properties until bytes_to_free are freed, returns freed bytes
+    size_t spill (const std::set<std::string>& keep_properties, size_t bytes_to_free);
+
+    /// @brief Prevents spilling while the buffer is read in other threads, to be called before the job is started
+    void pin () { ++pin_count_; }
+    void unpin () { assert (pin_count_); --pin_count_; }
+    bool pinned () const { return pin_count_ > 0; }
+
 protected:
     /// Unique buffer id, copied when getting shallow copies
     unsigned int id_;
@@ -129,12 +149,19 @@ protected:
     /// Flag indicating if buffer is the last of a DB operation
     bool last_one_;
 
+    /// Number of jobs reading the buffer, not spilled if set
+    std::atomic<unsigned int> pin_count_ {0};
+
     static unsigned int ids_;
 
 private:
     template<typename T> inline std::map <std::string, std::shared_ptr<NullableVector<T>>>& getArrayListMap ();
     template<typename T> void renameArrayListMapEntry (const std::string &id, const std::string &id_new);
     template<typename T> void seizeArrayListMap (Buffer &org_buffer);
+    template<typename T> size_t memoryUsageArrayListMap ();
+    template<typename T> unsigned int numSpilledArrayListMap ();
+    template<typename T> size_t spillArrayListMap (const std::set<std::string>& keep_properties,
+                                                   size_t bytes_to_free);
 };
 
 #include "nullablevector.h"
@@ -186,4 +213,44 @@ template<typename T> void Buffer::seizeArrayListMap (Buffer &org_buffer)
     org_buffer.getArrayListMap<T>().clear();
 }
 
+template<typename T> size_t Buffer::memoryUsageArrayListMap ()
+{
+    size_t bytes = 0;
+
+    for (auto& it : getArrayListMap<T>())
+        bytes += it.second->memoryUsage();
+
+    return bytes;
+}
+
+template<typename T> unsigned int Buffer::numSpilledArrayListMap ()
+{
+    unsigned int num = 0;
+
+    for (auto& it : getArrayListMap<T>())
+        if (it.second->spilled())
+            ++num;
+
+    return num;
+}
+
+template<typename T> size_t Buffer::spillArrayListMap (const std::set<std::string>& keep_properties,
+                                                       size_t bytes_to_free)
+{
+    size_t freed_bytes = 0;
+
+    for (auto& it : getArrayListMap<T>())
+    {
+        if (freed_bytes >= bytes_to_free)
+            break;
+
+        if (keep_properties.count(it.first) || it.second->spilled())
+            continue;
+
+        freed_bytes += it.second->spill();
+    }
+
+    return freed_bytes;
+}
+
 #endif /* BUFFER_H_ */
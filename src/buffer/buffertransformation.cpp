@@ -0,0 +1,287 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <tbb/tbb.h>
+
+#include "buffertransformation.h"
+#include "buffer.h"
+#include "dbovariableset.h"
+#include "dbovariable.h"
+#include "dbtablecolumn.h"
+#include "unitmanager.h"
+#include "unit.h"
+#include "logger.h"
+
+BufferTransformation::BufferTransformation (DBOVariableSet& list, bool tc2dbovar)
+    : tc2dbovar_(tc2dbovar)
+{
+    // TODO add proper data type conversion
+    for (auto var_it : list.getSet ())
+    {
+        assert (var_it->hasCurrentDBColumn());
+        const DBTableColumn &column = var_it->currentDBColumn ();
+
+        logdbg << "BufferTransformation: constructor: variable " << var_it->name() << " col " << column.name();
+
+        Step step;
+        step.variable_name_ = var_it->name();
+        step.data_type_ = list.readDataType(*var_it);
+
+        if (tc2dbovar)
+        {
+            step.current_name_ = column.name();
+            step.transformed_name_ = var_it->name();
+        }
+        else
+        {
+            step.current_name_ = var_it->name();
+            step.transformed_name_ = column.name();
+        }
+
+        if (column.dataFormat() != "") // do format conversion stuff
+        {
+            logdbg << "BufferTransformation: constructor: column " << column.name()
+                   << " has to-be-removed format " << column.dataFormat();
+
+            switch (step.data_type_)
+            {
+            case PropertyDataType::CHAR:
+            case PropertyDataType::UCHAR:
+            case PropertyDataType::SHORTINT:
+            case PropertyDataType::USHORTINT:
+            case PropertyDataType::INT:
+            case PropertyDataType::UINT:
+            case PropertyDataType::LONGINT:
+            case PropertyDataType::ULONGINT:
+                break;
+            default:
+                logerr  <<  "BufferTransformation: constructor: format conversion impossible for property type "
+                         << Property::asString(step.data_type_);
+                throw std::runtime_error ("BufferTransformation: constructor: impossible property type "
+                                          + Property::asString(step.data_type_));
+            }
+
+            if (column.dataFormat() != "octal")
+            {
+                logerr << "BufferTransformation: constructor: unknown format '" << column.dataFormat() << "'";
+                throw std::runtime_error ("BufferTransformation: constructor: unknown format '"
+                                          +column.dataFormat()+"'");
+            }
+
+            step.format_ = Format::OCTAL;
+        }
+
+        if (column.dimension() != var_it->dimension())
+            logwrn << "BufferTransformation: constructor: variable " << var_it->name()
+                   << " has differing dimensions " << column.dimension() << " " << var_it->dimension();
+        else if (column.unit() != var_it->unit()) // do unit conversion stuff
+        {
+            logdbg << "BufferTransformation: constructor: variable " << var_it->name()
+                   << " of same dimension has different units " << column.unit() << " " << var_it->unit();
+
+            if (!UnitManager::instance().hasDimension (var_it->dimension()))
+            {
+                logerr  <<  "BufferTransformation: constructor: unknown dimension '" << var_it->dimension() << "'";
+                throw std::runtime_error ("BufferTransformation: constructor: unknown dimension '"
+                                          +var_it->dimension()+"'");
+            }
+
+            const Dimension &dimension = UnitManager::instance().dimension (var_it->dimension());
+
+            if (!dimension.hasUnit(column.unit()))
+                logerr  <<  "BufferTransformation: constructor: dimension '" << var_it->dimension()
+                         << "' has unknown unit '" << column.unit() << "'";
+
+            if (!dimension.hasUnit(var_it->unit()))
+                logerr  <<  "BufferTransformation: constructor: dimension '" << var_it->dimension()
+                         << "' has unknown unit '" << var_it->unit() << "'";
+
+            if (tc2dbovar)
+                step.factor_ = dimension.getFactor (column.unit(), var_it->unit());
+            else
+                step.factor_ = dimension.getFactor (var_it->unit(), column.unit());
+
+            logdbg  << "BufferTransformation: constructor: unit transformation with factor " << step.factor_;
+
+            switch (step.data_type_)
+            {
+            case PropertyDataType::BOOL:
+            case PropertyDataType::CHAR:
+            case PropertyDataType::UCHAR:
+                logwrn << "BufferTransformation: constructor: double multiplication of "
+                       << Property::asString(step.data_type_) << " variable " << var_it->name();
+                break;
+            case PropertyDataType::STRING:
+                logerr << "BufferTransformation: constructor: unit transformation for string variable "
+                       << var_it->name() << " impossible";
+                step.factor_ = 1.0;
+                break;
+            default:
+                break;
+            }
+        }
+
+        steps_.push_back(step);
+    }
+}
+
+void BufferTransformation::apply (Buffer& buffer) const
+{
+    logdbg << "BufferTransformation: apply: buffer " << buffer.id() << " size " << buffer.size() << " variables "
+           << steps_.size();
+
+    const PropertyList& properties = buffer.properties();
+
+    for (const Step& step : steps_)
+    {
+        assert (properties.hasProperty(step.current_name_));
+        // TODO HACK should be column data type
+        if (tc2dbovar_)
+            assert (properties.get(step.current_name_).dataType() == step.data_type_);
+    }
+
+    // containers are independent, only the maps are shared, which are not modified until renaming
+    tbb::parallel_for (size_t(0), steps_.size(), [&] (size_t cnt)
+    {
+        transformStep (buffer, steps_.at(cnt));
+    });
+
+    for (const Step& step : steps_)
+        renameStep (buffer, step);
+}
+
+void BufferTransformation::transformStep (Buffer& buffer, const Step& step) const
+{
+    bool from_octal = step.format_ == Format::OCTAL;
+
+    if (!from_octal && step.factor_ == 1.0)
+        return;
+
+    switch (step.data_type_)
+    {
+    case PropertyDataType::BOOL:
+        assert (buffer.has<bool>(step.current_name_));
+        buffer.get<bool>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::CHAR:
+        assert (buffer.has<char>(step.current_name_));
+        buffer.get<char>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::UCHAR:
+        assert (buffer.has<unsigned char>(step.current_name_));
+        buffer.get<unsigned char>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::SHORTINT:
+        assert (buffer.has<short int>(step.current_name_));
+        buffer.get<short int>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::USHORTINT:
+        assert (buffer.has<unsigned short int>(step.current_name_));
+        buffer.get<unsigned short int>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::INT:
+        assert (buffer.has<int>(step.current_name_));
+        buffer.get<int>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::UINT:
+        assert (buffer.has<unsigned int>(step.current_name_));
+        buffer.get<unsigned int>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::LONGINT:
+        assert (buffer.has<long int>(step.current_name_));
+        buffer.get<long int>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::ULONGINT:
+        assert (buffer.has<unsigned long>(step.current_name_));
+        buffer.get<unsigned long>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::FLOAT:
+        assert (buffer.has<float>(step.current_name_));
+        buffer.get<float>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::DOUBLE:
+        assert (buffer.has<double>(step.current_name_));
+        buffer.get<double>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    case PropertyDataType::TIMESTAMP:
+        assert (buffer.has<Timestamp>(step.current_name_));
+        buffer.get<Timestamp>(step.current_name_).transform(from_octal, step.factor_);
+        break;
+    default:
+        logerr  <<  "BufferTransformation: transformStep: unknown property type "
+                 << Property::asString(step.data_type_);
+        throw std::runtime_error ("BufferTransformation: transformStep: unknown property type "
+                                  + Property::asString(step.data_type_));
+    }
+}
+
+void BufferTransformation::renameStep (Buffer& buffer, const Step& step) const
+{
+    if (step.current_name_ == step.transformed_name_)
+        return;
+
+    logdbg << "BufferTransformation: renameStep: renaming variable " << step.current_name_
+           << " to variable name " << step.transformed_name_;
+
+    switch (step.data_type_)
+    {
+    case PropertyDataType::BOOL:
+        buffer.rename<bool> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::CHAR:
+        buffer.rename<char> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::UCHAR:
+        buffer.rename<unsigned char> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::SHORTINT:
+        buffer.rename<short int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::USHORTINT:
+        buffer.rename<unsigned short int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::INT:
+        buffer.rename<int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::UINT:
+        buffer.rename<unsigned int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::LONGINT:
+        buffer.rename<long int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::ULONGINT:
+        buffer.rename<unsigned long int> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::FLOAT:
+        buffer.rename<float> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::DOUBLE:
+        buffer.rename<double> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::TIMESTAMP:
+        buffer.rename<Timestamp> (step.current_name_, step.transformed_name_);
+        break;
+    case PropertyDataType::STRING:
+        buffer.rename<std::string> (step.current_name_, step.transformed_name_);
+        break;
+    default:
+        logerr  <<  "BufferTransformation: renameStep: unknown property type "
+                 << Property::asString(step.data_type_);
+        throw std::runtime_error ("BufferTransformation: renameStep: unknown property type "
+                                  + Property::asString(step.data_type_));
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUFFERTRANSFORMATION_H
+#define BUFFERTRANSFORMATION_H
+
+#include <string>
+#include <vector>
+
+#include "property.h"
+
+class Buffer;
+class DBOVariableSet;
+
+/**
+ * @brief Precompiled transformation between DB column and DBO variable representation of a Buffer
+ *
+ * Resolves column names, data formats and unit conversion factors of all variables of a read list once, so that
+ * transforming each read or inserted chunk only has to touch the data. Each column is converted in a single pass
+ * (format conversion and unit scaling fused), columns are processed in parallel. Immutable after construction, so
+ * one instance can be shared between jobs transforming chunks of the same read list.
+ */
+class BufferTransformation
+{
+public:
+    /// @brief Constructor, tc2dbovar true for db->dbo, false dbo->db
+    BufferTransformation (DBOVariableSet& list, bool tc2dbovar);
+    virtual ~BufferTransformation() {}
+
+    /// @brief Transforms buffer contents and renames the containers
+    void apply (Buffer& buffer) const;
+
+    bool tc2dbovar () const { return tc2dbovar_; }
+    size_t size () const { return steps_.size(); }
+
+protected:
+    enum class Format { NONE, OCTAL };
+
+    struct Step
+    {
+        std::string variable_name_;
+        PropertyDataType data_type_;
+        std::string current_name_;
+        std::string transformed_name_;
+        Format format_ {Format::NONE};
+        double factor_ {1.0};
+    };
+
+    bool tc2dbovar_ {false};
+    std::vector<Step> steps_;
+
+    void transformStep (Buffer& buffer, const Step& step) const;
+    void renameStep (Buffer& buffer, const Step& step) const;
+};
+
+#endif // BUFFERTRANSFORMATION_H
@@ -38,6 +38,15 @@ NullableVector<bool>& NullableVector<bool>::operator*=(double factor)
     return *this;
 }
 
+template <>
+void NullableVector<bool>::transform (bool from_octal, double factor)
+{
+    assert (!from_octal);
+
+    if (factor != 1.0)
+        *this *= factor;
+}
+
 template <>
 void NullableVector<bool>::append (size_t index, bool value)
 {
@@ -89,13 +98,259 @@ void NullableVector<std::string>::append (size_t index, std::string value)
     if (BUFFER_PEDANTIC_CHECKING)
         assert (index < data_.size());
 
-    if (data_.at(index).size())
-        data_.at(index) += ";"+value;
+    if (data_.equals(index, ""))
+        data_.set(index, value);
     else
-        data_.at(index) = value;
+        data_.set(index, data_.at(index)+";"+value);
 
     unsetNull(index);
 
     //logdbg << "ArrayListTemplate: append: size " << size_ << " max_size " << max_size_;
 }
 
+template <>
+void NullableVector<std::string>::clear ()
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": clear";
+
+    data_.clearValues();
+    std::fill (null_flags_.begin(), null_flags_.end(), true);
+}
+
+template <>
+void NullableVector<std::string>::set (size_t index, std::string value)
+{
+    set (index, value.data(), value.size());
+}
+
+template <>
+void NullableVector<std::string>::set (size_t index, const char* value, size_t length)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": set: index " << index << " length " << length;
+
+    if (BUFFER_PEDANTIC_CHECKING)
+    {
+        assert (data_.size() <= buffer_.data_size_);
+        assert (null_flags_.size() <= buffer_.data_size_);
+    }
+
+    if (index >= data_.size()) // allocate new stuff, fill all new with not null
+    {
+        if (index != data_.size()) // some where left out
+            resizeNullTo(index+1);
+
+        resizeDataTo (index+1);
+    }
+
+    data_.set(index, value, length);
+    unsetNull(index);
+}
+
+template <>
+bool NullableVector<std::string>::equals (size_t index, const std::string& value)
+{
+    return !isNull(index) && data_.equals(index, value);
+}
+
+template <>
+std::vector<size_t> NullableVector<std::string>::valueIndexes (const std::set<std::string>& values,
+                                                               size_t from_index, size_t to_index)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": valueIndexes";
+
+    std::vector<size_t> indexes;
+
+    assert (from_index <= to_index);
+
+    to_index = std::min (to_index+1, data_.size()); // now end index
+
+    if (data_.dictionaryEncoded()) // compare codes
+    {
+        std::vector<bool> matching (data_.dictionarySize(), false);
+        bool any_matching = false;
+
+        for (auto& value : values)
+        {
+            size_t code = data_.findCode(value);
+
+            if (code != StringColumn::NO_CODE)
+            {
+                matching[code] = true;
+                any_matching = true;
+            }
+        }
+
+        if (!any_matching)
+            return indexes;
+
+        for (size_t index = from_index; index < to_index; ++index)
+        {
+            if (matching[data_.code(index)] && !isNull(index))
+                indexes.push_back(index);
+        }
+
+        return indexes;
+    }
+
+    for (size_t index = from_index; index < to_index; ++index)
+    {
+        if (isNull(index))
+            continue;
+
+        if (values.size() == 1 ? data_.equals(index, *values.begin()) : values.count(data_.at(index)) != 0)
+            indexes.push_back(index);
+    }
+
+    return indexes;
+}
+
+template <>
+std::set<std::string> NullableVector<std::string>::distinctValues (size_t index)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": distinctValues";
+
+    std::set<std::string> values;
+
+    if (data_.dictionaryEncoded()) // collect used codes, values only once
+    {
+        std::vector<bool> used (data_.dictionarySize(), false);
+
+        for (; index < data_.size(); ++index)
+        {
+            if (!isNull(index))
+                used[data_.code(index)] = true;
+        }
+
+        for (size_t code=0; code < used.size(); ++code)
+        {
+            if (used[code])
+                values.insert(data_.dictionaryValue(code));
+        }
+
+        return values;
+    }
+
+    for (; index < data_.size(); ++index)
+    {
+        if (!isNull(index)) // not for null
+            values.insert(data_.at(index));
+    }
+
+    return values;
+}
+
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (
+        size_t from_index, size_t to_index)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": distinctValuesWithIndexes";
+
+    assert (from_index < to_index);
+
+    std::vector<size_t> indexes;
+
+    for (size_t index = from_index; index <= to_index && index < data_.size(); ++index)
+        indexes.push_back(index);
+
+    return distinctValuesWithIndexes(indexes);
+}
+
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (
+        const std::vector<size_t>& indexes)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": distinctValuesWithIndexes";
+
+    std::map<std::string, std::vector<size_t>> values;
+
+    if (data_.dictionaryEncoded()) // group by code, values only once
+    {
+        std::vector<std::vector<size_t>> code_indexes (data_.dictionarySize());
+
+        for (auto index : indexes)
+        {
+            if (!isNull(index))
+                code_indexes[data_.code(index)].push_back(index);
+        }
+
+        for (size_t code=0; code < code_indexes.size(); ++code)
+        {
+            if (code_indexes[code].size())
+                values[data_.dictionaryValue(code)] = std::move(code_indexes[code]);
+        }
+
+        return values;
+    }
+
+    for (auto index : indexes)
+    {
+        if (!isNull(index)) // not for null
+            values[data_.at(index)].push_back(index);
+    }
+
+    return values;
+}
+
+template <>
+void NullableVector<bool>::appendData (NullableVector<bool>& other)
+{
+    data_.insert(data_.end(), other.data_.begin(), other.data_.end()); // never spilled
+}
+
+template <>
+void NullableVector<std::string>::appendData (NullableVector<std::string>& other)
+{
+    data_.append(other.data_);
+}
+
+template <>
+void NullableVector<std::string>::copyData (NullableVector<std::string>& other)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": copyData";
+
+    data_ = other.data_; // never spilled
+    null_flags_ = other.null_flags_;
+
+    if (buffer_.data_size_ < data_.size())
+        buffer_.data_size_ = data_.size();
+
+    if (buffer_.data_size_ < null_flags_.size())
+        buffer_.data_size_ = null_flags_.size();
+}
+
+
+template <>
+size_t NullableVector<bool>::memoryUsage ()
+{
+    return data_.capacity()/8 + null_flags_.capacity()/8;
+}
+
+template <>
+size_t NullableVector<bool>::spill ()
+{
+    return 0; // packed bits, not worth spilling
+}
+
+template <>
+void NullableVector<bool>::restore ()
+{
+    assert (!spilled_);
+}
+
+template <>
+size_t NullableVector<std::string>::memoryUsage ()
+{
+    return data_.memoryUsage() + null_flags_.capacity()/8;
+}
+
+template <>
+size_t NullableVector<std::string>::spill ()
+{
+    return 0; // not trivially copyable, already compact
+}
+
+template <>
+void NullableVector<std::string>::restore ()
+{
+    assert (!spilled_);
+}
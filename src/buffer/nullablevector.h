@@ -18,7 +18,10 @@
 #ifndef ARRAYLIST_H_
 #define ARRAYLIST_H_
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <bitset>
 #include <sstream>
@@ -26,17 +29,25 @@
 #include <array>
 #include <set>
 #include <map>
+#include <type_traits>
 
 #include <tbb/tbb.h>
 
 #include <QDateTime>
 
 #include "stringconv.h"
+#include "formatconverter.h"
 #include "buffer.h"
 #include "property.h"
+#include "spillfile.h"
+#include "stringcolumn.h"
 
 const bool BUFFER_PEDANTIC_CHECKING=false;
 
+/// @brief Data container type of NullableVector, strings are held in a StringColumn
+template <class T> struct NullableVectorData { typedef std::vector<T> type; };
+template <> struct NullableVectorData<std::string> { typedef StringColumn type; };
+
 /**
  * @brief Template List of fixed-size arrays to be used in Buffer classes.
  *
@@ -49,7 +60,7 @@ class NullableVector
 
 public:
     /// @brief Destructor
-    virtual ~NullableVector () {}
+    virtual ~NullableVector ();
 
     /// @brief Sets all elements to false
     void clear();
@@ -62,6 +73,8 @@ public:
 
     /// @brief Sets specific value
     void set (size_t index, T value);
+    /// @brief Sets string value from raw characters, without creating a std::string. Only defined for strings.
+    void set (size_t index, const char* value, size_t length);
     void setFromFormat (size_t index, const std::string& format, const std::string& value_str);
 
     /// @brief Appends specific value
@@ -73,6 +86,11 @@ public:
 
     NullableVector<T>& operator*=(double factor);
 
+    /// @brief Returns if value at index is not null and equal to value
+    bool equals (size_t index, const T& value);
+    /// @brief Returns indexes in [from_index, to_index] with values contained in values (IN filter)
+    std::vector<size_t> valueIndexes (const std::set<T>& values, size_t from_index, size_t to_index);
+
     std::set<T> distinctValues (size_t index=0);
 
     std::map<T, std::vector<size_t>> distinctValuesWithIndexes (size_t from_index, size_t to_index);
@@ -82,6 +100,9 @@ public:
 
     void convertToStandardFormat(const std::string& from_format);
 
+    /// @brief Converts from octal format (if set) and multiplies by factor in one pass, skips null values
+    void transform (bool from_octal, double factor);
+
     size_t size();
 
     /// @brief Checks if specific element is Null
@@ -91,23 +112,53 @@ public:
 
     std::string propertyName () const { return property_.name()+"("+property_.dataTypeString()+")"; }
 
+    /// @brief Returns number of bytes held in memory
+    size_t memoryUsage ();
+    /// @brief Returns if data was moved into a spill file
+    bool spilled () const { return spilled_; }
+    /// @brief Moves data (not null flags) into a memory-mapped spill file, returns freed bytes
+    size_t spill ();
+    /// @brief Reads spilled data back, done automatically before modifying values
+    void restore ();
+
 private:
     Property property_;
     Buffer& buffer_;
     /// Data container
-    std::vector<T> data_;
+    typename NullableVectorData<T>::type data_;
     // Null flags container
     std::vector <bool> null_flags_;
 
+    /// if set, values are read through the mapping of spill_file_ and appended data is written to it
+    std::atomic<bool> spilled_ {false};
+    /// guards spill state and data_ while spilling or restoring
+    std::mutex spill_mutex_;
+    std::unique_ptr<SpillFile> spill_file_;
+
+    /// @brief Restores data if spilled, to be called before modifying data_
+    void ensureRestored () { if (spilled_) restore(); }
+    /// @brief Returns number of stored values, in data_ or the spill file
+    size_t dataSize () const { return spilled_ ? spill_file_->size()/sizeof(T) : data_.size(); }
+    /// @brief Returns spilled values, only valid if spilled
+    const T* spilledData () const { return reinterpret_cast<const T*>(spill_file_->data()); }
+    /// @brief Returns stored value without null check, read through the mapping if spilled
+    T valueAt (size_t index) { if (spilled_) return spilledData()[index]; return data_.at(index); }
+
     /// @brief Sets specific element to not Null value
     void unsetNull (size_t index);
 
     void resizeDataTo (size_t size);
     void resizeNullTo (size_t size);
     void addData (NullableVector<T>& other);
+    /// @brief Appends data of other to data_, used by addData
+    void appendData (NullableVector<T>& other);
     void copyData (NullableVector<T>& other);
     void cutToSize (size_t size);
 
+    /// @brief Returns decimal digits of value interpreted as octal number, up to the first digit 8 or 9
+    static T fromOctal (T value, std::true_type is_integral);
+    static T fromOctal (T value, std::false_type is_integral) { assert (false); return value; }
+
     /// @brief Constructor, only for friend Buffer
     NullableVector (Property& property, Buffer& buffer);
 
@@ -117,9 +168,13 @@ private:
 template <class T> NullableVector<T>::NullableVector (Property& property, Buffer& buffer)
     : property_(property), buffer_(buffer) {}
 
+template <class T> NullableVector<T>::~NullableVector () {}
+
 template <class T> void NullableVector<T>::clear()
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": clear";
+
+    ensureRestored();
     std::fill (data_.begin(),data_.end(), T());
     std::fill (null_flags_.begin(), null_flags_.end(), true);
 }
@@ -127,12 +182,12 @@ template <class T> void NullableVector<T>::clear()
 template <class T> const T NullableVector<T>::get (size_t index)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": get: index " << index;
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
-        assert (index < data_.size());
-        assert (index < data_.size());
+        assert (index < dataSize());
     }
 
     if (isNull(index))
@@ -146,7 +201,7 @@ template <class T> const T NullableVector<T>::get (size_t index)
         throw std::runtime_error ("ArrayListTemplate: get of Null value "+std::to_string(index));
     }
 
-    return data_.at(index);
+    return valueAt(index);
 }
 
 template <class T> const std::string NullableVector<T>::getAsString (size_t index)
@@ -159,6 +214,8 @@ template <class T> void NullableVector<T>::set (size_t index, T value)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": set: index " << index << " value '" << value << "'";
 
+    ensureRestored();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert (data_.size() <= buffer_.data_size_);
@@ -182,45 +239,25 @@ template <class T> void NullableVector<T>::set (size_t index, T value)
     //logdbg << "ArrayListTemplate: set: size " << size_ << " max_size " << max_size_;
 }
 
+template <class T> void NullableVector<T>::set (size_t index, const char* value, size_t length)
+{
+    static_assert (std::is_same<T, std::string>::value, "only defined for strings");
+}
+
 template <class T> void NullableVector<T>::setFromFormat (size_t index, const std::string& format,
                                                           const std::string& value_str)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": setFromFormat";
-    T value;
-
-    if (format == "octal")
-    {
-        value = std::stoi(value_str, 0, 8);
-    }
-    else if (format == "hexadecimal")
-    {
-        value = std::stoi(value_str, 0, 16);
-    }
-    else if (format == "epoch_tod_ms")
-    {
-        QDateTime date_time;
-        date_time.setMSecsSinceEpoch(std::stoul(value_str));
-        value = Utils::String::timeFromString(date_time.toString("hh:mm:ss.zzz").toStdString());
-    }
-    else if (format == "epoch_tod_s")
-    {
-        QDateTime date_time;
-        date_time.setMSecsSinceEpoch(1000*std::stoul(value_str));
-        value = Utils::String::timeFromString(date_time.toString("hh:mm:ss.zzz").toStdString());
-    }
-    else
-    {
-        logerr << "ArrayListTemplate: setFromFormat: unknown format '" << format << "'";
-        assert (false);
-    }
 
-    set (index, value);
+    set (index, Utils::FormatConverter::fromString<T> (Format::typeFromString(format), value_str));
 }
 
 template <class T> void NullableVector<T>::append (size_t index, T value)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": append: index " << index << " value '" << value << "'";
 
+    ensureRestored();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert (data_.size() <= buffer_.data_size_);
@@ -248,35 +285,8 @@ template <class T> void NullableVector<T>::appendFromFormat (size_t index, const
                                                              const std::string& value_str)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": appendFromFormat";
-    T value;
 
-    if (format == "octal")
-    {
-        value = std::stoi(value_str, 0, 8);
-    }
-    else if (format == "hexadecimal")
-    {
-        value = std::stoi(value_str, 0, 16);
-    }
-    else if (format == "epoch_tod_ms")
-    {
-        QDateTime date_time;
-        date_time.setMSecsSinceEpoch(std::stoul(value_str));
-        value = Utils::String::timeFromString(date_time.toString("hh:mm:ss.zzz").toStdString());
-    }
-    else if (format == "epoch_tod_s")
-    {
-        QDateTime date_time;
-        date_time.setMSecsSinceEpoch(1000*std::stoul(value_str));
-        value = Utils::String::timeFromString(date_time.toString("hh:mm:ss.zzz").toStdString());
-    }
-    else
-    {
-        logerr << "ArrayListTemplate: setFromFormat: unknown format '" << format << "'";
-        assert (false);
-    }
-
-    append (index, value);
+    append (index, Utils::FormatConverter::fromString<T> (Format::typeFromString(format), value_str));
 }
 
 template <class T> void NullableVector<T>::setNull(size_t index)
@@ -285,7 +295,7 @@ template <class T> void NullableVector<T>::setNull(size_t index)
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
     }
 
@@ -305,7 +315,7 @@ template <class T> bool NullableVector<T>::isNull(size_t index)
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
         assert (index < buffer_.data_size_);
     }
@@ -315,7 +325,7 @@ template <class T> bool NullableVector<T>::isNull(size_t index)
 
     // null not stored, so all set are not null
 
-    if (index >= data_.size()) // not yet set
+    if (index >= dataSize()) // not yet set
         return true;
 
     // must be set
@@ -328,14 +338,23 @@ template <class T> void NullableVector<T>::resizeDataTo (size_t size)
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
-        assert (data_.size() < size); // only to be called if needed
+        assert (dataSize() <= buffer_.data_size_);
+        assert (dataSize() < size); // only to be called if needed
     }
 
-    data_.resize(size, T());
+    if (spilled_) // padded in the spill file
+    {
+        size_t padding_size = size-dataSize();
+        std::unique_ptr<T[]> padding (new T[padding_size]());
 
-    if (buffer_.data_size_ < data_.size()) // set new data size
-        buffer_.data_size_ = data_.size();
+        std::lock_guard<std::mutex> lock (spill_mutex_);
+        spill_file_->append(reinterpret_cast<const char*>(padding.get()), padding_size*sizeof(T));
+    }
+    else
+        data_.resize(size, T());
+
+    if (buffer_.data_size_ < size) // set new data size
+        buffer_.data_size_ = size;
 }
 
 template <class T> void NullableVector<T>::resizeNullTo (size_t size)
@@ -345,8 +364,10 @@ template <class T> void NullableVector<T>::resizeNullTo (size_t size)
     if (BUFFER_PEDANTIC_CHECKING)
         assert (null_flags_.size() <= buffer_.data_size_);
 
-    if (data_.size() > null_flags_.size()) // data was set w/o null, adjust & fill with set values
-        null_flags_.resize(data_.size(), false);
+    size_t data_size = dataSize();
+
+    if (data_size > null_flags_.size()) // data was set w/o null, adjust & fill with set values
+        null_flags_.resize(data_size, false);
 
     if (null_flags_.size() < size) // adjust to new size, fill with null values
         null_flags_.resize(size, true);
@@ -362,13 +383,15 @@ template <class T> void NullableVector<T>::addData (NullableVector<T>& other)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": addData";
 
+    // neither side is restored, data of a spilled container is appended to its spill file
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
     }
 
-    if (!other.data_.size() && other.null_flags_.size()) // if other has null flags set, need to fill my nulls
+    if (!other.dataSize() && other.null_flags_.size()) // if other has null flags set, need to fill my nulls
     {
         logdbg << "ArrayListTemplate " << property_.name() << ": addData: 1: other no data resizing null";
         resizeNullTo (buffer_.data_size_);
@@ -377,11 +400,11 @@ template <class T> void NullableVector<T>::addData (NullableVector<T>& other)
         goto DONE;
     }
 
-    if (other.data_.size() && !other.null_flags_.size()) // if other has everything set
+    if (other.dataSize() && !other.null_flags_.size()) // if other has everything set
     {
         logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: other has everything set";
 
-        if (data_.size() < buffer_.data_size_) // need to size data up
+        if (dataSize() < buffer_.data_size_) // need to size data up
         {
             logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: data not full, setting null";
             resizeNullTo (buffer_.data_size_);
@@ -391,7 +414,7 @@ template <class T> void NullableVector<T>::addData (NullableVector<T>& other)
         }
 
         logdbg << "ArrayListTemplate " << property_.name() << ": addData: 2: inserting data";
-        data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+        appendData(other);
         goto DONE;
     }
 
@@ -402,14 +425,14 @@ template <class T> void NullableVector<T>::addData (NullableVector<T>& other)
     logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: inserting nulls";
     null_flags_.insert(null_flags_.end(), other.null_flags_.begin(), other.null_flags_.end());
 
-    if (data_.size() < buffer_.data_size_) // need to size data up
+    if (dataSize() < buffer_.data_size_) // need to size data up
     {
         logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: resizing data";
         resizeDataTo (buffer_.data_size_);
     }
 
     logdbg << "ArrayListTemplate " << property_.name() << ": addData: 3: inserting data";
-    data_.insert(data_.end(), other.data_.begin(), other.data_.end());
+    appendData(other);
 
 DONE:
     // size is adjusted in Buffer::seizeBuffer
@@ -417,11 +440,31 @@ DONE:
     logdbg << "ArrayListTemplate " << property_.name() << ": addData: end";
 }
 
+template <class T> void NullableVector<T>::appendData (NullableVector<T>& other)
+{
+    const T* values = other.spilled_ ? other.spilledData() : other.data_.data();
+    size_t size = other.dataSize();
+
+    if (spilled_)
+    {
+        std::lock_guard<std::mutex> lock (spill_mutex_);
+        spill_file_->append(reinterpret_cast<const char*>(values), size*sizeof(T));
+    }
+    else
+        data_.insert(data_.end(), values, values+size);
+}
+
 template <class T> void NullableVector<T>::copyData (NullableVector<T>& other)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": copyData";
 
-    data_ = other.data_;
+    assert (!spilled_); // only done for new buffers
+
+    if (other.spilled_) // read through the mapping
+        data_.assign(other.spilledData(), other.spilledData()+other.dataSize());
+    else
+        data_ = other.data_;
+
     null_flags_ = other.null_flags_;
 
     // is only done for new buffers in Buffer::getPartialCopy, so no size-too-big isse
@@ -439,20 +482,34 @@ template <class T> NullableVector<T>& NullableVector<T>::operator*=(double facto
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": operator*=";
 
-    size_t data_size = data_.size();
+    transform (false, factor);
 
-    tbb::parallel_for( size_t(0), data_size, [&] (size_t cnt)
-    {
-        if (!isNull(cnt))
-        {
-            data_.at(cnt) *= factor;
-        }
-    });
+    return *this;
+}
 
-//    for (auto &data_it : data_)
-//        data_it *= factor;
+template <class T> bool NullableVector<T>::equals (size_t index, const T& value)
+{
+    return !isNull(index) && valueAt(index) == value;
+}
 
-    return *this;
+template <class T> std::vector<size_t> NullableVector<T>::valueIndexes (const std::set<T>& values, size_t from_index,
+                                                                        size_t to_index)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": valueIndexes";
+
+    std::vector<size_t> indexes;
+
+    assert (from_index <= to_index);
+
+    size_t data_size = dataSize();
+
+    for (size_t index = from_index; index <= to_index && index < data_size; ++index)
+    {
+        if (!isNull(index) && values.count(valueAt(index)))
+            indexes.push_back(index);
+    }
+
+    return indexes;
 }
 
 template <class T> std::set<T> NullableVector<T>::distinctValues (size_t index)
@@ -462,12 +519,13 @@ template <class T> std::set<T> NullableVector<T>::distinctValues (size_t index)
     std::set<T> values;
 
     T value;
+    size_t data_size = dataSize();
 
-    for (; index < data_.size(); ++index)
+    for (; index < data_size; ++index)
     {
         if (!isNull(index)) // not for null
         {
-            value = data_.at(index);
+            value = valueAt(index);
             if (values.count(value) == 0)
                 values.insert(value);
         }
@@ -490,11 +548,11 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
         assert (to_index);
         assert (from_index < buffer_.data_size_);
         assert (to_index < buffer_.data_size_);
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
     }
 
-    if (from_index+1 > data_.size()) // no data
+    if (from_index+1 > dataSize()) // no data
         return values;
 
     for (size_t index = from_index; index <= to_index; ++index)
@@ -502,9 +560,9 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
         if (!isNull(index)) // not for null
         {
             if (BUFFER_PEDANTIC_CHECKING)
-                assert (index < data_.size());
+                assert (index < dataSize());
 
-            values[data_.at(index)].push_back(index);
+            values[valueAt(index)].push_back(index);
         }
     }
 
@@ -521,7 +579,7 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
 
     if (BUFFER_PEDANTIC_CHECKING)
     {
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
     }
 
@@ -530,9 +588,9 @@ template <class T> std::map<T, std::vector<size_t>> NullableVector<T>::distinctV
         if (!isNull(index)) // not for null
         {
             if (BUFFER_PEDANTIC_CHECKING)
-                assert (index < data_.size());
+                assert (index < dataSize());
 
-            values[data_.at(index)].push_back(index);
+            values[valueAt(index)].push_back(index);
         }
     }
 
@@ -554,7 +612,7 @@ template <class T> std::vector<size_t>  NullableVector<T>::nullValueIndexes (siz
         assert (to_index);
         assert (from_index < buffer_.data_size_);
         assert (to_index < buffer_.data_size_);
-        assert (data_.size() <= buffer_.data_size_);
+        assert (dataSize() <= buffer_.data_size_);
         assert (null_flags_.size() <= buffer_.data_size_);
     }
 
@@ -566,7 +624,7 @@ template <class T> std::vector<size_t>  NullableVector<T>::nullValueIndexes (siz
         if (isNull(index)) // not for null
         {
             if (BUFFER_PEDANTIC_CHECKING)
-                assert (index < data_.size());
+                assert (index < dataSize());
 
             indexes.push_back(index);
         }
@@ -587,7 +645,7 @@ template <class T> std::vector<size_t>  NullableVector<T>::nullValueIndexes (con
         if (isNull(index)) // not for null
         {
             if (BUFFER_PEDANTIC_CHECKING)
-                assert (index < data_.size());
+                assert (index < dataSize());
 
             ret_indexes.push_back(index);
         }
@@ -603,52 +661,124 @@ template <class T> void NullableVector<T>::convertToStandardFormat(const std::st
 
     static_assert (std::is_integral<T>::value, "only defined for integer types");
 
-    //std::string value_str;
-    //T value;
-
     if (from_format != "octal")
     {
         logerr << "ArrayListTemplate: convertToStandardFormat: unknown format '" << from_format << "'";
         assert (false);
     }
 
+    transform (true, 1.0);
+}
+
+template <class T> void NullableVector<T>::transform (bool from_octal, double factor)
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": transform: octal " << from_octal << " factor " << factor;
+
+    bool scale = factor != 1.0;
+
+    if (!from_octal && !scale)
+        return;
+
+    ensureRestored();
+
+    T* data = data_.data();
     size_t data_size = data_.size();
+    size_t null_size = std::min (null_flags_.size(), data_size); // values after stored null flags are set
 
-    tbb::parallel_for( size_t(0), data_size, [&] (size_t cnt)
+    tbb::parallel_for (tbb::blocked_range<size_t>(0, data_size, 4096),
+                       [&] (const tbb::blocked_range<size_t>& range)
     {
-        if (!isNull(cnt))
+        size_t cnt = range.begin();
+        size_t end = range.end();
+
+        if (!from_octal && std::is_floating_point<T>::value)
+        {
+            // values of null elements are never read, so they are scaled too to keep the loop vectorizable
+            for (; cnt < end; ++cnt)
+                data[cnt] *= factor;
+
+            return;
+        }
+
+        T value;
+
+        for (; cnt < end; ++cnt)
         {
-            //value_str = std::to_string(data_.at(cnt));
-            data_.at(cnt) = std::stoi(std::to_string(data_.at(cnt)), 0, 8);
+            if (cnt < null_size && null_flags_[cnt])
+                continue;
+
+            value = data[cnt];
+
+            if (from_octal)
+                value = fromOctal (value, std::is_integral<T>());
+
+            if (scale)
+                value *= factor;
+
+            data[cnt] = value;
         }
     });
+}
 
+template <class T> T NullableVector<T>::fromOctal (T value, std::true_type)
+{
+    // same result as std::stoi(std::to_string(value), 0, 8), without the string allocations
+    return static_cast<T> (Utils::FormatConverter::digitsInBase(static_cast<long long> (value), 8));
+}
 
-    //    for (size_t cnt=0; cnt < data_size; cnt++)
-    //    {
-    //        if (isNull(cnt))
-    //            continue;
+template <class T> size_t NullableVector<T>::size()
+{
+    return dataSize();
+}
 
-    //        value_str = std::to_string(data_.at(cnt));
+template <class T> size_t NullableVector<T>::memoryUsage ()
+{
+    std::lock_guard<std::mutex> lock (spill_mutex_);
+    return data_.capacity()*sizeof(T) + null_flags_.capacity()/8;
+}
 
-    //        if (from_format == "octal")
-    //        {
-    //            data_.at(cnt) = std::stoi(value_str, 0, 8);
-    //        }
-    //        else
-    //        {
-    //            logerr << "ArrayListTemplate: convertToStandardFormat: unknown format '" << from_format << "'";
-    //            assert (false);
-    //        }
-    //    }
+template <class T> size_t NullableVector<T>::spill ()
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": spill";
+
+    static_assert (std::is_trivially_copyable<T>::value, "only defined for trivially copyable types");
+
+    std::lock_guard<std::mutex> lock (spill_mutex_);
+
+    if (spilled_ || !data_.size())
+        return 0;
+
+    size_t freed_bytes = data_.capacity()*sizeof(T);
+
+    spill_file_.reset(new SpillFile (reinterpret_cast<const char*>(data_.data()), data_.size()*sizeof(T)));
+    spilled_ = true;
+
+    std::vector<T>().swap(data_); // release memory
+
+    return freed_bytes;
 }
 
-template <class T> size_t NullableVector<T>::size() { return data_.size(); }
+template <class T> void NullableVector<T>::restore ()
+{
+    logdbg << "ArrayListTemplate " << property_.name() << ": restore";
+
+    std::lock_guard<std::mutex> lock (spill_mutex_);
+
+    if (!spilled_) // restored by another thread in the meantime
+        return;
+
+    data_.assign(spilledData(), spilledData()+dataSize());
+    spilled_ = false;
+
+    spill_file_ = nullptr; // removes file
+}
 
 template <class T> void NullableVector<T>::cutToSize (size_t size)
 {
     logdbg << "ArrayListTemplate " << property_.name() << ": cutToSize: size " << size;
 
+    ensureRestored();
+
     if (BUFFER_PEDANTIC_CHECKING)
     {
         assert (data_.size() <= buffer_.data_size_);
@@ -700,12 +830,69 @@ template <class T> void NullableVector<T>::unsetNull (size_t index)
 template <>
 NullableVector<bool>& NullableVector<bool>::operator*=(double factor);
 
+template <>
+void NullableVector<bool>::transform (bool from_octal, double factor);
+
 template <>
 void NullableVector<bool>::append (size_t index, bool value);
 
 template <>
 void NullableVector<std::string>::append (size_t index, std::string value);
 
+template <>
+void NullableVector<std::string>::clear ();
+
+template <>
+void NullableVector<std::string>::set (size_t index, std::string value);
+
+template <>
+void NullableVector<std::string>::set (size_t index, const char* value, size_t length);
+
+template <>
+bool NullableVector<std::string>::equals (size_t index, const std::string& value);
+
+template <>
+std::vector<size_t> NullableVector<std::string>::valueIndexes (const std::set<std::string>& values,
+                                                               size_t from_index, size_t to_index);
+
+template <>
+std::set<std::string> NullableVector<std::string>::distinctValues (size_t index);
+
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (
+        size_t from_index, size_t to_index);
+
+template <>
+std::map<std::string, std::vector<size_t>> NullableVector<std::string>::distinctValuesWithIndexes (
+        const std::vector<size_t>& indexes);
+
+template <>
+void NullableVector<bool>::appendData (NullableVector<bool>& other);
+
+template <>
+void NullableVector<std::string>::appendData (NullableVector<std::string>& other);
+
+template <>
+void NullableVector<std::string>::copyData (NullableVector<std::string>& other);
+
+template <>
+size_t NullableVector<bool>::memoryUsage ();
+
+template <>
+size_t NullableVector<bool>::spill ();
+
+template <>
+void NullableVector<bool>::restore ();
+
+template <>
+size_t NullableVector<std::string>::memoryUsage ();
+
+template <>
+size_t NullableVector<std::string>::spill ();
+
+template <>
+void NullableVector<std::string>::restore ();
+
 
 
 
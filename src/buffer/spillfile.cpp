@@ -0,0 +1,118 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spillfile.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+static std::string directory_;
+static std::mutex directory_mutex_;
+
+/// Minimum step by which files grow when appending
+static const size_t SPILL_FILE_MIN_GROWTH = 1024*1024;
+
+SpillFile::SpillFile (const char* data, size_t bytes)
+{
+    assert (bytes);
+
+    create (bytes);
+
+    std::memcpy (data_, data, bytes);
+    size_ = bytes;
+}
+
+SpillFile::~SpillFile()
+{
+    logdbg << "SpillFile: destructor: removing " << path_;
+
+    if (file_ && file_->is_open())
+        file_->close();
+
+    boost::system::error_code error;
+    boost::filesystem::remove(path_, error);
+
+    if (error)
+        logwrn << "SpillFile: destructor: unable to remove " << path_ << ": " << error.message();
+}
+
+void SpillFile::append (const char* data, size_t bytes)
+{
+    if (!bytes)
+        return;
+
+    assert (file_);
+
+    if (size_+bytes > file_->size()) // grow at least by half, so that appending chunks does not re-map each time
+    {
+        size_t capacity = std::max (size_+bytes, file_->size()+std::max (file_->size()/2, SPILL_FILE_MIN_GROWTH));
+
+        logdbg << "SpillFile: append: growing " << path_ << " to " << capacity << " bytes";
+
+        file_->resize(capacity);
+
+        if (!file_->is_open())
+            throw std::runtime_error ("SpillFile: append: unable to re-map file "+path_);
+
+        data_ = file_->data();
+    }
+
+    std::memcpy (data_+size_, data, bytes);
+    size_ += bytes;
+}
+
+void SpillFile::directory (const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock (directory_mutex_);
+    directory_ = directory;
+}
+
+void SpillFile::create (size_t capacity)
+{
+    boost::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock (directory_mutex_);
+
+        if (directory_.size())
+            path = directory_;
+        else
+            path = boost::filesystem::temp_directory_path();
+    }
+
+    path /= boost::filesystem::unique_path("atsdb_spill_%%%%-%%%%-%%%%-%%%%.bin");
+    path_ = path.string();
+
+    logdbg << "SpillFile: create: " << capacity << " bytes in " << path_;
+
+    boost::iostreams::mapped_file_params params;
+    params.path = path_;
+    params.new_file_size = capacity;
+    params.flags = boost::iostreams::mapped_file::mapmode::readwrite;
+
+    file_.reset(new boost::iostreams::mapped_file (params));
+
+    if (!file_->is_open())
+        throw std::runtime_error ("SpillFile: create: unable to map file "+path_);
+
+    data_ = file_->data();
+}
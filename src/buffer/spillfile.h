@@ -0,0 +1,67 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPILLFILE_H_
+#define SPILLFILE_H_
+
+#include <memory>
+#include <string>
+
+namespace boost { namespace iostreams { class mapped_file; } }
+
+/**
+ * @brief Memory-mapped temporary file holding NullableVector data which was spilled from RAM
+ *
+ * Spilled data is read through the mapping, so it is only paged in by the operating system when accessed. Data can
+ * be appended without reading it back, the file then grows in steps and is re-mapped. The file is removed on
+ * destruction.
+ */
+class SpillFile
+{
+public:
+    /// @brief Constructor, writes bytes to a new file in the spill directory
+    SpillFile (const char* data, size_t bytes);
+    /// @brief Destructor, unmaps and removes the file
+    virtual ~SpillFile();
+
+    SpillFile (const SpillFile&) = delete;
+    SpillFile& operator= (const SpillFile&) = delete;
+
+    /// @brief Appends bytes, invalidates pointers returned by data()
+    void append (const char* data, size_t bytes);
+
+    /// @brief Returns mapped data
+    const char* data () const { return data_; }
+    /// @brief Returns number of stored bytes
+    size_t size () const { return size_; }
+
+    /// @brief Sets directory in which spill files are created, system temp directory if empty
+    static void directory (const std::string& directory);
+
+protected:
+    std::string path_;
+    std::unique_ptr<boost::iostreams::mapped_file> file_;
+    /// Start of the mapping, changes when the file grows
+    char* data_ {nullptr};
+    /// Number of stored bytes, the file may be larger
+    size_t size_ {0};
+
+    /// @brief Creates and maps new file of given size in the spill directory
+    void create (size_t capacity);
+};
+
+#endif /* SPILLFILE_H_ */
@@ -0,0 +1,277 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "stringcolumn.h"
+#include "logger.h"
+
+const size_t StringColumn::MAX_DICTIONARY_SIZE;
+const size_t StringColumn::NO_CODE;
+
+StringColumn::StringColumn()
+{
+    dictionary_.push_back(std::string());
+    dictionary_codes_[std::string()] = 0;
+}
+
+void StringColumn::resize (size_t size, const std::string& value)
+{
+    assert (!value.size()); // new rows are always empty
+
+    if (dictionary_encoded_)
+    {
+        codes_.resize(size, 0);
+        return;
+    }
+
+    for (size_t cnt=size; cnt < lengths_.size(); ++cnt) // removed rows
+        unused_bytes_ += lengths_[cnt];
+
+    offsets_.resize(size, arena_.size());
+    lengths_.resize(size, 0);
+}
+
+void StringColumn::clearValues ()
+{
+    size_t current_size = size();
+
+    *this = StringColumn();
+    resize(current_size);
+}
+
+std::string StringColumn::at (size_t index) const
+{
+    if (dictionary_encoded_)
+        return dictionary_[codes_.at(index)];
+
+    size_t length = lengths_.at(index);
+
+    if (!length)
+        return std::string();
+
+    return std::string(arena_.data()+offsets_[index], length);
+}
+
+void StringColumn::set (size_t index, const char* value, size_t length)
+{
+    assert (index < size());
+
+    if (dictionary_encoded_)
+    {
+        size_t code = addCode(value, length);
+
+        if (code != NO_CODE)
+        {
+            codes_[index] = static_cast<uint16_t>(code);
+            return;
+        }
+
+        convertToArena();
+    }
+
+    unused_bytes_ += lengths_[index];
+
+    offsets_[index] = arena_.size();
+    lengths_[index] = static_cast<uint32_t>(length);
+    appendToArena(value, length);
+
+    if (unused_bytes_ > arena_.size()/2 && unused_bytes_ > 4096)
+        compact();
+}
+
+bool StringColumn::equals (size_t index, const std::string& value) const
+{
+    if (dictionary_encoded_)
+        return dictionary_[codes_.at(index)] == value;
+
+    return lengths_.at(index) == value.size()
+            && (!value.size() || !memcmp(arena_.data()+offsets_[index], value.data(), value.size()));
+}
+
+void StringColumn::append (const StringColumn& other)
+{
+    if (&other == this)
+    {
+        StringColumn tmp (other);
+        append (tmp);
+        return;
+    }
+
+    if (dictionary_encoded_ && other.dictionary_encoded_)
+    {
+        std::vector<uint16_t> mapping; // other code -> own code
+        mapping.reserve(other.dictionary_.size());
+
+        for (const std::string& value : other.dictionary_)
+        {
+            size_t code = addCode(value.data(), value.size());
+
+            if (code == NO_CODE)
+                break;
+
+            mapping.push_back(static_cast<uint16_t>(code));
+        }
+
+        if (mapping.size() == other.dictionary_.size())
+        {
+            codes_.reserve(codes_.size()+other.codes_.size());
+
+            for (uint16_t code : other.codes_)
+                codes_.push_back(mapping[code]);
+
+            return;
+        }
+    }
+
+    if (dictionary_encoded_)
+        convertToArena();
+
+    offsets_.reserve(offsets_.size()+other.size());
+    lengths_.reserve(lengths_.size()+other.size());
+
+    if (other.dictionary_encoded_)
+    {
+        for (uint16_t code : other.codes_)
+        {
+            const std::string& value = other.dictionary_[code];
+
+            offsets_.push_back(arena_.size());
+            lengths_.push_back(static_cast<uint32_t>(value.size()));
+            appendToArena(value.data(), value.size());
+        }
+    }
+    else
+    {
+        size_t arena_offset = arena_.size();
+
+        arena_.insert(arena_.end(), other.arena_.begin(), other.arena_.end());
+
+        for (size_t offset : other.offsets_)
+            offsets_.push_back(arena_offset+offset);
+
+        lengths_.insert(lengths_.end(), other.lengths_.begin(), other.lengths_.end());
+        unused_bytes_ += other.unused_bytes_;
+    }
+}
+
+size_t StringColumn::memoryUsage () const
+{
+    size_t bytes = codes_.capacity()*sizeof(uint16_t) + arena_.capacity()
+            + offsets_.capacity()*sizeof(size_t) + lengths_.capacity()*sizeof(uint32_t);
+
+    // values are held twice, hash map node overhead estimated
+    for (const std::string& value : dictionary_)
+        bytes += 2*(sizeof(std::string)+value.capacity()) + 4*sizeof(void*);
+
+    return bytes;
+}
+
+size_t StringColumn::findCode (const std::string& value) const
+{
+    assert (dictionary_encoded_);
+
+    auto it = dictionary_codes_.find(value);
+
+    if (it == dictionary_codes_.end())
+        return NO_CODE;
+
+    return it->second;
+}
+
+size_t StringColumn::addCode (const char* value, size_t length)
+{
+    lookup_.assign(value, length);
+
+    auto it = dictionary_codes_.find(lookup_);
+
+    if (it != dictionary_codes_.end())
+        return it->second;
+
+    if (dictionary_.size() >= MAX_DICTIONARY_SIZE)
+        return NO_CODE;
+
+    uint16_t code = static_cast<uint16_t>(dictionary_.size());
+
+    dictionary_.push_back(lookup_);
+    dictionary_codes_.emplace(lookup_, code);
+
+    return code;
+}
+
+void StringColumn::convertToArena ()
+{
+    assert (dictionary_encoded_);
+
+    logdbg << "StringColumn: convertToArena: rows " << codes_.size() << " distinct values " << dictionary_.size();
+
+    size_t num_rows = codes_.size();
+    size_t num_bytes = 0;
+
+    for (uint16_t code : codes_)
+        num_bytes += dictionary_[code].size();
+
+    arena_.reserve(num_bytes);
+    offsets_.reserve(num_rows);
+    lengths_.reserve(num_rows);
+
+    for (uint16_t code : codes_)
+    {
+        const std::string& value = dictionary_[code];
+
+        offsets_.push_back(arena_.size());
+        lengths_.push_back(static_cast<uint32_t>(value.size()));
+        appendToArena(value.data(), value.size());
+    }
+
+    dictionary_encoded_ = false;
+
+    std::vector<uint16_t>().swap(codes_);
+    std::vector<std::string>().swap(dictionary_);
+    std::unordered_map<std::string, uint16_t>().swap(dictionary_codes_);
+}
+
+void StringColumn::appendToArena (const char* value, size_t length)
+{
+    if (length > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error ("StringColumn: appendToArena: value too long");
+
+    arena_.insert(arena_.end(), value, value+length);
+}
+
+void StringColumn::compact ()
+{
+    logdbg << "StringColumn: compact: unused bytes " << unused_bytes_ << " of " << arena_.size();
+
+    std::vector<char> arena;
+    arena.reserve(arena_.size()-unused_bytes_);
+
+    for (size_t cnt=0; cnt < offsets_.size(); ++cnt)
+    {
+        const char* value = arena_.data()+offsets_[cnt];
+
+        offsets_[cnt] = arena.size();
+        arena.insert(arena.end(), value, value+lengths_[cnt]);
+    }
+
+    arena_.swap(arena);
+    unused_bytes_ = 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STRINGCOLUMN_H
+#define STRINGCOLUMN_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Storage of string values of a NullableVector without one heap allocation per value
+ *
+ * Starts dictionary-encoded: each row holds a 16-bit code into a list of distinct values, so flags, track status
+ * or mode strings need 2 bytes per row. When the number of distinct values exceeds MAX_DICTIONARY_SIZE, e.g. for
+ * hashes, the values are moved into a contiguous byte arena addressed by offset and length per row.
+ *
+ * Rows added by resizing hold the empty string. Overwritten values leave unused bytes in the arena, which is
+ * compacted if they exceed half of it. Not thread-safe for writing, concurrent reading is fine.
+ */
+class StringColumn
+{
+public:
+    static const size_t MAX_DICTIONARY_SIZE {4096};
+    /// Code returned by findCode if value is not in the dictionary
+    static const size_t NO_CODE {static_cast<size_t>(-1)};
+
+    StringColumn ();
+
+    size_t size () const { return dictionary_encoded_ ? codes_.size() : offsets_.size(); }
+    /// @brief Resizes to size, new rows hold the empty string, value only for std::vector compatibility
+    void resize (size_t size, const std::string& value=std::string());
+    void pop_back () { resize(size()-1); }
+    /// @brief Sets all values to the empty string
+    void clearValues ();
+
+    /// @brief Returns copy of value, throws std::out_of_range like std::vector::at
+    std::string at (size_t index) const;
+    void set (size_t index, const std::string& value) { set (index, value.data(), value.size()); }
+    void set (size_t index, const char* value, size_t length);
+    /// @brief Compares without creating a string
+    bool equals (size_t index, const std::string& value) const;
+
+    /// @brief Appends all rows of other
+    void append (const StringColumn& other);
+
+    size_t memoryUsage () const;
+
+    bool dictionaryEncoded () const { return dictionary_encoded_; }
+    /// @brief Returns code of row, only if dictionary encoded
+    size_t code (size_t index) const { return codes_.at(index); }
+    /// @brief Returns number of distinct values in dictionary, only if dictionary encoded
+    size_t dictionarySize () const { return dictionary_.size(); }
+    /// @brief Returns value of code, only if dictionary encoded
+    const std::string& dictionaryValue (size_t code) const { return dictionary_.at(code); }
+    /// @brief Returns code of value or NO_CODE, only if dictionary encoded
+    size_t findCode (const std::string& value) const;
+
+protected:
+    bool dictionary_encoded_ {true};
+
+    /// Dictionary mode: code per row
+    std::vector<uint16_t> codes_;
+    /// Dictionary mode: value per code, code 0 is the empty string
+    std::vector<std::string> dictionary_;
+    std::unordered_map<std::string, uint16_t> dictionary_codes_;
+    /// Reused for lookups of raw values in dictionary_codes_
+    std::string lookup_;
+
+    /// Arena mode: all values, concatenated
+    std::vector<char> arena_;
+    /// Arena mode: begin in arena_ per row
+    std::vector<size_t> offsets_;
+    /// Arena mode: length per row
+    std::vector<uint32_t> lengths_;
+    /// Arena mode: bytes of overwritten values
+    size_t unused_bytes_ {0};
+
+    /// @brief Returns code of value, adding it if not found, or NO_CODE if the dictionary is full
+    size_t addCode (const char* value, size_t length);
+    /// @brief Moves all values from dictionary codes into the arena
+    void convertToArena ();
+    void appendToArena (const char* value, size_t length);
+    /// @brief Rewrites the arena without unused bytes
+    void compact ();
+};
+
+#endif // STRINGCOLUMN_H
@@ -0,0 +1,450 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <boost/filesystem.hpp>
+
+#include "batchrunner.h"
+#include "atsdb.h"
+#include "global.h"
+#include "logger.h"
+#include "files.h"
+#include "dbinterface.h"
+#include "sqliteconnection.h"
+#include "mysqlppconnection.h"
+#include "dbobject.h"
+#include "dbobjectmanager.h"
+#include "dbovariable.h"
+#include "dbovariableset.h"
+#include "taskmanager.h"
+#include "jsonimportertask.h"
+#include "radarplotpositioncalculatortask.h"
+#include "createartasassociationstask.h"
+#include "buffercsvexportjob.h"
+#include "jobmanager.h"
+
+#if USE_JASTERIX
+#include "asteriximportertask.h"
+#endif
+
+using namespace Utils;
+
+BatchRunner::BatchRunner(const BatchOptions& options)
+    : options_(options)
+{
+    unsigned int threads = options_.threads_ ? options_.threads_
+                                             : static_cast<unsigned int>(QThread::idealThreadCount());
+
+    loginf << "BatchRunner: constructor: using " << threads << " threads";
+    QThreadPool::globalInstance()->setMaxThreadCount(static_cast<int>(threads));
+
+    addSteps();
+}
+
+void BatchRunner::startSlot ()
+{
+    loginf << "BatchRunner: startSlot: " << steps_.size() << " steps";
+
+    current_step_ = 0;
+    nextStep();
+}
+
+void BatchRunner::stepDoneSlot ()
+{
+    if (!step_running_) // task signals are also emitted if not started by us
+        return;
+
+    step_running_ = false;
+
+    // continue after the queued database content update, so that the element counts are current
+    QTimer::singleShot(0, this, [this] () { nextStep(); });
+}
+
+void BatchRunner::asterixImportDoneSlot ()
+{
+#if USE_JASTERIX
+    if (!step_running_)
+        return;
+
+    ASTERIXImporterTask* task = ATSDB::instance().taskManager().getASTERIXImporterTask();
+    assert (task);
+
+    if (task->error())
+    {
+        stepFailed("step '"+steps_.at(current_step_-1).first+"' failed: "+task->errorMessage());
+        return;
+    }
+#endif
+
+    stepDoneSlot();
+}
+
+void BatchRunner::addSteps ()
+{
+    steps_.push_back({"open database", [this] () { openDatabase(); }});
+
+    for (auto& filename : options_.json_files_)
+        steps_.push_back({"import JSON '"+filename+"'", [this, filename] () { importJSON(filename); }});
+
+    if (options_.asterix_files_.size()) // all files in one step, decoded in parallel
+        steps_.push_back({"import "+std::to_string(options_.asterix_files_.size())+" ASTERIX file(s)",
+                          [this] () { importASTERIX(options_.asterix_files_); }});
+
+    if (options_.calculate_radar_plots_)
+        steps_.push_back({"calculate radar plot positions", [this] () { calculateRadarPlots(); }});
+
+    if (options_.associate_artas_)
+        steps_.push_back({"create ARTAS associations", [this] () { associateARTAS(); }});
+
+    if (options_.post_process_)
+        steps_.push_back({"post-process", [this] () { postProcess(); }});
+
+    if (options_.export_csv_directory_.size())
+        steps_.push_back({"export CSV to '"+options_.export_csv_directory_+"'", [this] () { exportCSV(); }});
+}
+
+void BatchRunner::nextStep ()
+{
+    assert (!step_running_);
+
+    if (current_step_ > 0) // report previous step
+    {
+        size_t count = databaseCount();
+        double seconds = (boost::posix_time::microsec_clock::local_time() - step_start_time_).total_milliseconds()
+                / 1000.0;
+
+        // for steps not inserting data, the number of elements in the database is reported
+        size_t elements = count > step_start_count_ ? count - step_start_count_ : count;
+
+        std::cout << "BatchRunner: step '" << steps_.at(current_step_-1).first << "' done in "
+                  << std::fixed << std::setprecision(3) << seconds << "s, " << elements << " elements";
+
+        if (seconds > 0)
+            std::cout << ", " << std::setprecision(1) << elements/seconds << " e/s";
+
+        std::cout << std::endl;
+    }
+
+    if (current_step_ == steps_.size())
+    {
+        finish(0);
+        return;
+    }
+
+    loginf << "BatchRunner: nextStep: starting '" << steps_.at(current_step_).first << "'";
+
+    step_start_time_ = boost::posix_time::microsec_clock::local_time();
+    step_start_count_ = databaseCount();
+    step_running_ = true;
+
+    std::function<void()> step = steps_.at(current_step_).second;
+    ++current_step_;
+
+    try
+    {
+        step();
+    }
+    catch (std::exception& e)
+    {
+        stepFailed("step failed: "+std::string(e.what()));
+    }
+}
+
+void BatchRunner::stepFailed (const std::string& message)
+{
+    logerr << "BatchRunner: stepFailed: " << message << ", skipping " << steps_.size()-current_step_
+           << " remaining step(s)";
+    std::cerr << "BatchRunner: " << message << std::endl;
+
+    finish(-1);
+}
+
+void BatchRunner::finish (int exit_code)
+{
+    loginf << "BatchRunner: finish: exit code " << exit_code;
+
+    step_running_ = false;
+
+    if (ATSDB::instance().ready())
+        ATSDB::instance().shutdown();
+
+    QCoreApplication::exit(exit_code);
+}
+
+void BatchRunner::openDatabase ()
+{
+    DBInterface& interface = ATSDB::instance().interface();
+
+    if (options_.sqlite_file_.size())
+    {
+        interface.useConnection(SQLITE_IDENTIFIER);
+
+        SQLiteConnection* connection = dynamic_cast<SQLiteConnection*> (&interface.connection());
+        assert (connection);
+
+        connection->openFile(options_.sqlite_file_);
+    }
+    else if (options_.mysql_database_.size())
+    {
+        interface.useConnection(MYSQL_IDENTIFIER);
+
+        MySQLppConnection* connection = dynamic_cast<MySQLppConnection*> (&interface.connection());
+        assert (connection);
+
+        connection->connectServer();
+
+        std::vector<std::string> databases = connection->getDatabases();
+        if (std::find(databases.begin(), databases.end(), options_.mysql_database_) == databases.end())
+            connection->createDatabase(options_.mysql_database_);
+
+        connection->openDatabase(options_.mysql_database_);
+    }
+    else
+        throw std::runtime_error ("BatchRunner: openDatabase: no database given");
+
+    if (!interface.ready())
+        throw std::runtime_error ("BatchRunner: openDatabase: database not ready");
+
+    stepDoneSlot();
+}
+
+void BatchRunner::importJSON (const std::string& filename)
+{
+    JSONImporterTask* task = ATSDB::instance().taskManager().getJSONImporterTask();
+    assert (task);
+
+    if (options_.json_schema_.size())
+    {
+        if (!task->hasSchema(options_.json_schema_))
+            throw std::runtime_error ("BatchRunner: importJSON: unknown schema '"+options_.json_schema_+"'");
+
+        task->currentSchemaName(options_.json_schema_);
+    }
+
+    if (!task->canImportFile(filename))
+        throw std::runtime_error ("BatchRunner: importJSON: unable to import file '"+filename+"'");
+
+    connect (task, &JSONImporterTask::importDoneSignal, this, &BatchRunner::stepDoneSlot, Qt::UniqueConnection);
+
+    std::string extension = boost::filesystem::extension(filename);
+
+    if (extension == ".zip" || extension == ".gz" || extension == ".tgz")
+        task->importFileArchive(filename, false);
+    else
+        task->importFile(filename, false);
+}
+
+void BatchRunner::importASTERIX (const std::vector<std::string>& filenames)
+{
+#if USE_JASTERIX
+    ASTERIXImporterTask* task = ATSDB::instance().taskManager().getASTERIXImporterTask();
+    assert (task);
+
+    if (options_.asterix_framing_.size())
+        task->currentFraming(options_.asterix_framing_ == "none" ? "" : options_.asterix_framing_);
+
+    if (options_.asterix_parallel_files_)
+        task->numParallelFiles(options_.asterix_parallel_files_);
+
+    for (auto& filename : filenames)
+        if (!task->canImportFile(filename))
+            throw std::runtime_error ("BatchRunner: importASTERIX: unable to import file '"+filename+"'");
+
+    task->test(false);
+
+    connect (task, &ASTERIXImporterTask::importDoneSignal, this, &BatchRunner::asterixImportDoneSlot,
+             Qt::UniqueConnection);
+
+    task->importFiles(filenames);
+#else
+    throw std::runtime_error ("BatchRunner: importASTERIX: compiled without ASTERIX support, unable to import '"
+                              +filenames.front()+"'");
+#endif
+}
+
+void BatchRunner::calculateRadarPlots ()
+{
+    RadarPlotPositionCalculatorTask* task = ATSDB::instance().taskManager().getRadarPlotPositionCalculatorTask();
+    assert (task);
+
+    if (!task->canCalculate())
+        throw std::runtime_error ("BatchRunner: calculateRadarPlots: calculation not possible");
+
+    connect (task, &RadarPlotPositionCalculatorTask::calculationDoneSignal, this, &BatchRunner::stepDoneSlot,
+             Qt::UniqueConnection);
+
+    task->calculate();
+}
+
+void BatchRunner::associateARTAS ()
+{
+    CreateARTASAssociationsTask* task = ATSDB::instance().taskManager().getCreateARTASAssociationsTask();
+    assert (task);
+
+    if (!task->canRun())
+        throw std::runtime_error ("BatchRunner: associateARTAS: association not possible");
+
+    connect (task, &CreateARTASAssociationsTask::runDoneSignal, this, &BatchRunner::stepDoneSlot,
+             Qt::UniqueConnection);
+
+    task->run();
+}
+
+void BatchRunner::postProcess ()
+{
+    DBObjectManager& object_man = ATSDB::instance().objectManager();
+
+    bool any_data = std::any_of(object_man.begin(), object_man.end(),
+                                [] (std::pair<const std::string, DBObject*>& obj_it)
+    { return obj_it.second->hasData(); });
+
+    if (!any_data)
+    {
+        logwrn << "BatchRunner: postProcess: no data in objects, skipping";
+        stepDoneSlot();
+        return;
+    }
+
+    connect (&ATSDB::instance().interface(), &DBInterface::postProcessingDoneSignal,
+             this, &BatchRunner::stepDoneSlot, Qt::UniqueConnection);
+
+    ATSDB::instance().interface().postProcess();
+}
+
+void BatchRunner::exportCSV ()
+{
+    if (!Files::directoryExists(options_.export_csv_directory_))
+        throw std::runtime_error ("BatchRunner: exportCSV: directory '"+options_.export_csv_directory_
+                                  +"' does not exist");
+
+    export_objects_.clear();
+    export_index_ = 0;
+
+    for (auto& obj_it : ATSDB::instance().objectManager())
+        if (obj_it.second->hasData() && obj_it.second->loadable())
+            export_objects_.push_back(obj_it.second);
+
+    exportNextObject();
+}
+
+void BatchRunner::exportNextObject ()
+{
+    if (export_index_ == export_objects_.size())
+    {
+        stepDoneSlot();
+        return;
+    }
+
+    DBObject* object = export_objects_.at(export_index_);
+    assert (object);
+
+    loginf << "BatchRunner: exportNextObject: loading " << object->name();
+
+    DBOVariableSet read_set;
+
+    for (auto& var_it : *object)
+        if (var_it.second.existsInDB())
+            read_set.add(var_it.second);
+
+    connect (object, &DBObject::loadingDoneSignal, this, &BatchRunner::exportLoadingDoneSlot,
+             Qt::UniqueConnection);
+
+    object->load(read_set, false, false, nullptr, true);
+}
+
+void BatchRunner::exportLoadingDoneSlot (DBObject& object)
+{
+    if (object.isLoading()) // may be emitted more than once
+        return;
+
+    disconnect (&object, &DBObject::loadingDoneSignal, this, &BatchRunner::exportLoadingDoneSlot);
+
+    assert (!export_job_);
+
+    std::string file_name = options_.export_csv_directory_+"/"+object.name()+".csv";
+
+    if (!object.data() || !object.data()->size())
+    {
+        logwrn << "BatchRunner: exportLoadingDoneSlot: no data loaded for " << object.name();
+        ++export_index_;
+        exportNextObject();
+        return;
+    }
+
+    loginf << "BatchRunner: exportLoadingDoneSlot: exporting " << object.data()->size() << " rows of "
+           << object.name() << " to '" << file_name << "'";
+
+    DBOVariableSet read_set;
+
+    for (auto& var_it : object)
+        if (var_it.second.existsInDB())
+            read_set.add(var_it.second);
+
+    export_job_ = std::make_shared<BufferCSVExportJob> (object.data(), read_set, file_name, true, false, true,
+                                                          false);
+
+    connect (export_job_.get(), &BufferCSVExportJob::obsoleteSignal, this, &BatchRunner::exportJobObsoleteSlot,
+             Qt::QueuedConnection);
+    connect (export_job_.get(), &BufferCSVExportJob::doneSignal, this, &BatchRunner::exportJobDoneSlot,
+             Qt::QueuedConnection);
+
+    JobManager::instance().addBlockingJob(export_job_);
+}
+
+void BatchRunner::exportJobDoneSlot ()
+{
+    assert (export_job_);
+    export_job_ = nullptr;
+
+    DBObject* object = export_objects_.at(export_index_);
+    loginf << "BatchRunner: exportJobDoneSlot: " << object->name() << " done";
+
+    object->clearData(); // release memory before loading next object
+
+    ++export_index_;
+    exportNextObject();
+}
+
+void BatchRunner::exportJobObsoleteSlot ()
+{
+    export_job_ = nullptr;
+
+    logerr << "BatchRunner: exportJobObsoleteSlot: export of " << export_objects_.at(export_index_)->name()
+           << " failed";
+    finish(-1);
+}
+
+size_t BatchRunner::databaseCount ()
+{
+    size_t count = 0;
+
+    if (!ATSDB::instance().interface().ready())
+        return count;
+
+    for (auto& obj_it : ATSDB::instance().objectManager())
+        count += obj_it.second->count();
+
+    return count;
+}
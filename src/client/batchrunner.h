@@ -0,0 +1,117 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <QObject>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+class DBObject;
+class BufferCSVExportJob;
+
+/**
+ * @brief Command line options of the batch mode
+ */
+struct BatchOptions
+{
+    std::string sqlite_file_;
+    std::string mysql_database_;
+
+    std::vector<std::string> json_files_;
+    std::string json_schema_;
+
+    std::vector<std::string> asterix_files_;
+    std::string asterix_framing_;
+    unsigned int asterix_parallel_files_ {0}; // 0 for configured number
+
+    bool calculate_radar_plots_ {false};
+    bool associate_artas_ {false};
+    bool post_process_ {false};
+
+    std::string export_csv_directory_;
+
+    unsigned int threads_ {0}; // 0 for ideal thread count
+};
+
+/**
+ * @brief Runs import, post-processing and export steps without user interaction
+ *
+ * Steps are executed in fixed order, each one started after the previous one has signalled completion. After each
+ * step the elapsed time and number of processed elements is written to stdout. When all steps are done, ATSDB is
+ * shut down and the application event loop is left with the resulting exit code.
+ */
+class BatchRunner : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void startSlot ();
+
+    void stepDoneSlot ();
+    /// @brief Checks the ASTERIX importer for decoding errors, aborts if there were any
+    void asterixImportDoneSlot ();
+
+    void exportLoadingDoneSlot (DBObject& object);
+    void exportJobDoneSlot ();
+    void exportJobObsoleteSlot ();
+
+public:
+    BatchRunner(const BatchOptions& options);
+    virtual ~BatchRunner() {}
+
+protected:
+    BatchOptions options_;
+
+    std::vector<std::pair<std::string, std::function<void()>>> steps_;
+    size_t current_step_ {0};
+    bool step_running_ {false};
+
+    boost::posix_time::ptime step_start_time_;
+    size_t step_start_count_ {0};
+
+    std::vector<DBObject*> export_objects_;
+    size_t export_index_ {0};
+    std::shared_ptr<BufferCSVExportJob> export_job_;
+
+    void addSteps ();
+    void nextStep ();
+    /// @brief Aborts the remaining steps, exits with a nonzero exit code
+    void stepFailed (const std::string& message);
+    void finish (int exit_code);
+
+    void openDatabase ();
+    void importJSON (const std::string& filename);
+    void importASTERIX (const std::vector<std::string>& filenames);
+    void calculateRadarPlots ();
+    void associateARTAS ();
+    void postProcess ();
+    void exportCSV ();
+    void exportNextObject ();
+
+    /// @brief Returns sum of element counts of all database objects
+    size_t databaseCount ();
+};
+
+#endif // BATCHRUNNER_H
@@ -30,6 +30,7 @@
 #include <boost/program_options.hpp>
 
 #include <string>
+#include <vector>
 
 #include <locale.h>
 
@@ -50,6 +51,8 @@ Client::Client(int& argc, char** argv)
     : QApplication(argc, argv)
 {
     bool reset_config = false;
+    vector<string> log_levels;
+    int log_rate_limit = -1;
 
     setlocale(LC_ALL, "C");
 
@@ -58,6 +61,32 @@ Client::Client(int& argc, char** argv)
             ("help", "produce help message")
             //("compression", po::value<int>(), "set compression level")
             ("reset-config,rc", po::bool_switch(&reset_config), "reset user configuration files")
+            ("log-level", po::value<vector<string>>(&log_levels)->composing(),
+             "log level as 'LEVEL' or 'module=LEVEL', module being a source directory, may be given multiple times")
+            ("log-rate-limit", po::value<int>(&log_rate_limit),
+             "maximum number of records per second of one log statement, 0 for unlimited (default)")
+            ("batch", po::bool_switch(&batch_), "run given steps without user interface and quit")
+            ("sqlite3", po::value<string>(&batch_options_.sqlite_file_), "batch: open or create SQLite3 file")
+            ("mysql-db", po::value<string>(&batch_options_.mysql_database_),
+             "batch: open or create MySQL database on configured server")
+            ("import-json", po::value<vector<string>>(&batch_options_.json_files_)->composing(),
+             "batch: import JSON file, may be given multiple times")
+            ("json-schema", po::value<string>(&batch_options_.json_schema_), "batch: JSON parsing schema name")
+            ("import-asterix", po::value<vector<string>>(&batch_options_.asterix_files_)->composing(),
+             "batch: import ASTERIX file, may be given multiple times")
+            ("asterix-framing", po::value<string>(&batch_options_.asterix_framing_),
+             "batch: ASTERIX framing, 'none' for raw data")
+            ("asterix-parallel-files", po::value<unsigned int>(&batch_options_.asterix_parallel_files_),
+             "batch: number of ASTERIX files decoded in parallel")
+            ("calculate-radar-plots", po::bool_switch(&batch_options_.calculate_radar_plots_),
+             "batch: calculate radar plot positions")
+            ("associate-artas", po::bool_switch(&batch_options_.associate_artas_),
+             "batch: create ARTAS associations")
+            ("post-process", po::bool_switch(&batch_options_.post_process_), "batch: post-process database")
+            ("export-csv", po::value<string>(&batch_options_.export_csv_directory_),
+             "batch: export all data to CSV files in given directory")
+            ("threads", po::value<unsigned int>(&batch_options_.threads_),
+             "batch: maximum number of worker threads")
             ;
 
     try
@@ -72,6 +101,9 @@ Client::Client(int& argc, char** argv)
             quit_requested_ = true;
             return;
         }
+
+        if (batch_ && !batch_options_.sqlite_file_.size() && !batch_options_.mysql_database_.size())
+            throw runtime_error ("batch mode requires sqlite3 or mysql-db parameter");
     }
     catch (exception& e)
     {
@@ -141,6 +173,13 @@ Client::Client(int& argc, char** argv)
                 cout << "ATSDBClient: configuration mismatch detected, local version '" << config_version << "'"
                           << " application version '" << VERSION << "'" << endl;
 
+                if (batch_)
+                {
+                    cerr << "ATSDBClient: configuration upgrade required, please start without batch mode" << endl;
+                    quit_requested_ = true;
+                    return;
+                }
+
                 QMessageBox::StandardButton reply;
                 reply = QMessageBox::question(nullptr, "Upgrade Configuration & Data",
                                               "A configuration & data updade is required, do you want to update now?",
@@ -180,6 +219,10 @@ Client::Client(int& argc, char** argv)
 
         cout << "ATSDBClient: initializing logger using '" << log_config_path << "'" << endl;
         Logger::getInstance().init(log_config_path);
+        Logger::getInstance().levels(log_levels);
+
+        if (log_rate_limit >= 0)
+            Logger::getInstance().rateLimit(log_rate_limit);
 
         loginf << "ATSDBClient: startup version " << VERSION;
         string config_version = config.getString("version");
@@ -190,7 +233,7 @@ Client::Client(int& argc, char** argv)
     catch (exception &ex)
     {
         logerr  << "ATSDBClient: Caught Exception '" << ex.what() << "'";
-        logerr.flush();
+        Logger::getInstance().flush();
         //assert (false);
 
         quit_requested_ = true;
@@ -199,7 +242,7 @@ Client::Client(int& argc, char** argv)
     catch(...)
     {
         logerr  << "ATSDBClient: Caught Exception";
-        logerr.flush();
+        Logger::getInstance().flush();
         //assert (false);
 
         quit_requested_ = true;
@@ -218,11 +261,26 @@ bool Client::notify(QObject * receiver, QEvent * event)
     {
         logerr  << "Client: Exception thrown: " << e.what();
         //assert (false);
+
+        if (batch_)
+        {
+            exit(-1);
+            return false;
+        }
+
         QMessageBox::critical( NULL, "Client::notify(): Exception", QString( e.what() ) );
     }
     catch(...)
     {
         //assert (false);
+
+        if (batch_)
+        {
+            logerr  << "Client: Unknown exception thrown";
+            exit(-1);
+            return false;
+        }
+
         QMessageBox::critical( NULL, "Client::notify(): Exception", "Unknown exception" );
     }
     return false;
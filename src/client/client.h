@@ -20,6 +20,8 @@
 
 #include <QApplication>
 
+#include "batchrunner.h"
+
 //namespace ATSDB
 //{
 
@@ -40,9 +42,16 @@ public:
 
   bool quitRequested() const;
 
+  ///@brief Returns if running in batch mode, without main window
+  bool batch() const { return batch_; }
+  const BatchOptions& batchOptions() const { return batch_options_; }
+
 private:
   bool quit_requested_ {false};
 
+  bool batch_ {false};
+  BatchOptions batch_options_;
+
   void copyConfigurationAndData (const std::string& system_install_path);
   void copyConfiguration (const std::string& system_install_path);
 };
@@ -4,9 +4,13 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+
+#include <QTimer>
 
 #include "atsdb.h"
 #include "client.h"
+#include "batchrunner.h"
 #include "mainwindow.h"
 
 #include <stdio.h>
@@ -37,6 +41,11 @@ int main (int argc, char **argv)
     bool atsdb_initialized = false;
 
     // real atsdb stuff
+    // batch mode runs without display, but still requires the Qt event loop
+    for (int cnt=1; cnt < argc; ++cnt)
+        if (strcmp(argv[cnt], "--batch") == 0)
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
     try
     {
         Client mf(argc, argv);
@@ -48,6 +57,16 @@ int main (int argc, char **argv)
 
         atsdb_initialized = true;
 
+        if (mf.batch())
+        {
+            ATSDB::instance().headless(true);
+
+            BatchRunner runner (mf.batchOptions());
+            QTimer::singleShot(0, &runner, &BatchRunner::startSlot);
+
+            return mf.exec();
+        }
+
         MainWindow window;
 
         window.show();
@@ -55,6 +55,8 @@
 #include "taskmanager.h"
 #include "jsonimportertask.h"
 #include "jsonimportertaskwidget.h"
+#include "csvimportertask.h"
+#include "csvimportertaskwidget.h"
 #include "radarplotpositioncalculatortask.h"
 #include "radarplotpositioncalculatortaskwidget.h"
 #include "createartasassociationstask.h"
@@ -200,6 +202,13 @@ void MainWindow::addJSONImporterTaskSlot ()
     ATSDB::instance().taskManager().getJSONImporterTask()->widget()->show();
 }
 
+void MainWindow::addCSVImporterTaskSlot ()
+{
+    loginf  << "MainWindow: addCSVImporterTaskSlot";
+
+    ATSDB::instance().taskManager().getCSVImporterTask()->widget()->show();
+}
+
 void MainWindow::addRadarPlotPositionCalculatorTaskSlot ()
 {
     loginf  << "MainWindow: addRadarPlotPositionCalculatorTaskSlot";
@@ -267,6 +276,9 @@ void MainWindow::createMenus()
     QAction* json_importer_task_action = new QAction(tr("Import JSON Data"), this);
     connect(json_importer_task_action, &QAction::triggered, this, &MainWindow::addJSONImporterTaskSlot);
 
+    QAction* csv_importer_task_action = new QAction(tr("Import CSV Data"), this);
+    connect(csv_importer_task_action, &QAction::triggered, this, &MainWindow::addCSVImporterTaskSlot);
+
     QAction* radar_plot_position_calculator_task_action = new QAction(
                 tr("Perform Radar Plot Position Calculation"), this);
     connect(radar_plot_position_calculator_task_action, &QAction::triggered,
@@ -282,6 +294,7 @@ void MainWindow::createMenus()
     task_menu_->addAction(asterix_importer_task_action);
 #endif
     task_menu_->addAction(json_importer_task_action);
+    task_menu_->addAction(csv_importer_task_action);
     task_menu_->addAction(radar_plot_position_calculator_task_action);
     task_menu_->addAction(create_artas_associations_task_action);
 
@@ -57,6 +57,7 @@ private slots:
     /// @brief If database is open, switch to ManagementWidget
     void startSlot ();
     void addJSONImporterTaskSlot ();
+    void addCSVImporterTaskSlot ();
     void addRadarPlotPositionCalculatorTaskSlot ();
     void addCreateARTASAssociationsTaskSlot ();
 
@@ -68,6 +68,8 @@ public:
   virtual void stepAndClearBindings ()=0;
   /// @brief Commit the transaction.
   virtual void endBindTransaction ()=0;
+  /// @brief Roll back the transaction, e.g. if cancelled
+  virtual void abortBindTransaction ()=0;
   /// @brief Clear the bound statement for reuse
   virtual void finalizeBindStatement ()=0;
 
@@ -94,6 +96,19 @@ public:
   /// @brief Returns if all data from the prepared command was read
   virtual bool getPreparedCommandDone ()=0;
 
+  /// @brief Aborts the statement currently executed, may be called from any thread
+  ///
+  /// An interrupted prepared command returns the rows read so far as the last result.
+  virtual void interrupt ()=0;
+
+  /// @brief Returns the query plan of a select statement (EXPLAIN), one line per row
+  virtual std::string queryPlan (const std::string &sql)=0;
+
+  /// @brief Enables timing of the conversion of result rows into buffers in stepPreparedCommand
+  void profileConversion (bool value) { profile_conversion_ = value; conversion_time_ = 0; }
+  /// @brief Returns the conversion time in seconds since the last call
+  double takeConversionTime () { double tmp = conversion_time_; conversion_time_ = 0; return tmp; }
+
   virtual std::map <std::string, DBTableInfo> getTableInfo ()=0;
   virtual std::vector <std::string> getDatabases()=0;
 
@@ -112,6 +127,10 @@ protected:
   /// Defines the database system and parameters
   bool connection_ready_;
 
+  /// Conversion time is only measured if set, since it requires timing every row
+  bool profile_conversion_ {false};
+  double conversion_time_ {0};
+
   /// @brief Creates a prepared query (internal)
   virtual void prepareStatement (const std::string &sql)=0;
   /// @brief Finalizes a prepared query (internal)
@@ -16,9 +16,11 @@
  */
 
 #include "buffer.h"
+#include "cancellationtoken.h"
 #include "dbcommand.h"
 #include "dbcommandlist.h"
 #include "dbinterface.h"
+#include "dbqueryprofiler.h"
 #include "dbresult.h"
 #include "logger.h"
 #include "propertylist.h"
@@ -28,6 +30,7 @@
 #include "dbtableinfo.h"
 #include "stringconv.h"
 #include "mysqlserver.h"
+#include "mysqlstatementreader.h"
 #include "files.h"
 #include "stringconv.h"
 
@@ -36,6 +39,8 @@
 #include <archive.h>
 #include <archive_entry.h>
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 
@@ -47,12 +52,72 @@
 
 using namespace Utils;
 
+namespace
+{
+/// Source of a LOAD DATA LOCAL INFILE statement, read from memory instead of a file
+struct LocalInfileData
+{
+    const std::string* data_ {nullptr};
+    size_t position_ {0};
+};
+
+int localInfileInit (void** ptr, const char* filename, void* userdata)
+{
+    LocalInfileData* infile = static_cast<LocalInfileData*> (userdata);
+    infile->position_ = 0;
+    *ptr = infile;
+    return 0;
+}
+
+int localInfileRead (void* ptr, char* buf, unsigned int buf_len)
+{
+    LocalInfileData* infile = static_cast<LocalInfileData*> (ptr);
+
+    size_t length = std::min<size_t> (buf_len, infile->data_->size() - infile->position_);
+    std::memcpy (buf, infile->data_->data() + infile->position_, length);
+    infile->position_ += length;
+
+    return static_cast<int> (length); // 0 at end
+}
+
+void localInfileEnd (void* ptr)
+{
+}
+
+int localInfileError (void* ptr, char* error_msg, unsigned int error_msg_len)
+{
+    std::snprintf (error_msg, error_msg_len, "reading buffer data failed");
+    return 2000; // CR_UNKNOWN_ERROR
+}
+
+/// Appends formatted number, format has to match the promoted type of T
+template <typename T> MySQLppConnection::TSVWriter numberTSVWriter (NullableVector<T>& values, const char* format)
+{
+    return [&values, format] (size_t index, std::string& data)
+    {
+        if (values.isNull(index))
+        {
+            data += "\\N";
+            return;
+        }
+
+        char tmp[32];
+        int length = std::snprintf (tmp, sizeof(tmp), format, values.get(index));
+        assert (length > 0 && static_cast<size_t> (length) < sizeof(tmp));
+        data.append (tmp, length);
+    };
+}
+}
+
 MySQLppConnection::MySQLppConnection(const std::string &class_id, const std::string &instance_id,
                                      DBInterface *interface)
     : DBConnection (class_id, instance_id, interface), interface_(*interface), connection_(mysqlpp::Connection ()),
       prepared_query_(connection_.query()), prepared_parameters_(mysqlpp::SQLQueryParms(&prepared_query_))
 {
     registerParameter("used_server", &used_server_, "");
+    registerParameter("binary_reads", &binary_reads_, true);
+    registerParameter("bulk_load", &bulk_load_, true);
+    registerParameter("bulk_load_batch_size", &bulk_load_batch_size_, 50000);
 
     connection_.set_option(new mysqlpp::LocalInfileOption(true));
 
@@ -92,6 +157,8 @@ void MySQLppConnection::connectServer ()
     if (!ret)
         throw std::runtime_error("MySQL server connect failed with error "
                                  + std::to_string(connection_.errnum()) + ": " + connection_.error());
+
+    connection_thread_id_ = connection_.thread_id();
 }
 
 void MySQLppConnection::createDatabase (const std::string &database_name)
@@ -131,13 +198,14 @@ void MySQLppConnection::openDatabase (const std::string &database_name)
 
     if (info_widget_)
         info_widget_->updateSlot();
-
-    //loginf  << "MySQLppConnection: init: performance test";
-    //performanceTest ();
 }
 
 void MySQLppConnection::disconnect()
 {
+    if (importing_ && connection_ready_)
+        endImport();
+
+    connection_thread_id_ = 0;
     connection_.disconnect();
     connection_ready_ = false;
 
@@ -232,6 +300,13 @@ void MySQLppConnection::endBindTransaction ()
     transaction_=0;
 }
 
+void MySQLppConnection::abortBindTransaction ()
+{
+    transaction_->rollback();
+    delete transaction_;
+    transaction_=0;
+}
+
 void MySQLppConnection::finalizeBindStatement ()
 {
     assert (query_used_);
@@ -265,6 +340,296 @@ void MySQLppConnection::bindVariableNull (unsigned int index)
     prepared_parameters_[index] = mysqlpp::null;
 }
 
+bool MySQLppConnection::loadBuffer (const std::string& table_name, std::shared_ptr<Buffer> buffer,
+                                    size_t from_index, size_t end_index, const CancellationToken* token)
+{
+    assert (buffer);
+    assert (end_index <= buffer->size());
+    assert (bulk_load_batch_size_);
+    assert (!transaction_);
+
+    const PropertyList& properties = buffer->properties();
+
+    std::stringstream ss;
+    ss << "LOAD DATA LOCAL INFILE 'buffer' INTO TABLE " << table_name
+       << " CHARACTER SET utf8 FIELDS TERMINATED BY '\\t' LINES TERMINATED BY '\\n' (";
+
+    for (unsigned int cnt=0; cnt < properties.size(); ++cnt)
+    {
+        if (cnt != 0)
+            ss << ", ";
+        ss << properties.at(cnt).name();
+    }
+    ss << ");";
+
+    std::string statement = ss.str();
+
+    loginf << "MySQLppConnection: loadBuffer: table " << table_name << " rows " << end_index-from_index
+           << " batch size " << bulk_load_batch_size_;
+    logdbg << "MySQLppConnection: loadBuffer: statement '" << statement << "'";
+
+    std::vector<TSVWriter> writers = getTSVWriters(*buffer);
+    size_t num_writers = writers.size();
+
+    std::string data;
+    LocalInfileData infile;
+    infile.data_ = &data;
+
+    MYSQL* handle = connection_.driver()->mysql_handle();
+    mysql_set_local_infile_handler(handle, localInfileInit, localInfileRead, localInfileEnd, localInfileError,
+                                   &infile);
+
+    if (importing_)
+        disableKeys(table_name); // ALTER TABLE commits implicitly, so done before the transaction
+
+    setLoadChecks(false);
+
+    transaction_ = new mysqlpp::Transaction (connection_);
+
+    bool cancelled = false;
+    boost::posix_time::ptime start_time;
+
+    try
+    {
+        for (size_t batch_index=from_index; batch_index < end_index; batch_index += bulk_load_batch_size_)
+        {
+            if (token && token->cancelled())
+            {
+                loginf << "MySQLppConnection: loadBuffer: cancelled after " << batch_index-from_index
+                       << " rows, rolling back";
+                cancelled = true;
+                break;
+            }
+
+            size_t batch_end = std::min<size_t> (batch_index+bulk_load_batch_size_, end_index);
+
+            if (profile_conversion_)
+                start_time = DBQueryProfiler::now();
+
+            data.clear(); // keeps capacity of the previous batch
+
+            for (size_t index=batch_index; index < batch_end; ++index)
+            {
+                for (size_t cnt=0; cnt < num_writers; ++cnt)
+                {
+                    if (cnt != 0)
+                        data += '\t';
+                    writers[cnt](index, data);
+                }
+                data += '\n';
+            }
+
+            if (profile_conversion_)
+                conversion_time_ += DBQueryProfiler::secondsSince(start_time);
+
+            mysqlpp::Query query = connection_.query(statement);
+
+            if (!query.exec())
+            {
+                logerr << "MySQLppConnection: loadBuffer: error when loading into table " << table_name
+                       << ": '" << query.error() << "', local_infile has to be enabled on the server";
+                throw std::runtime_error ("MySQLppConnection: loadBuffer: error when loading into table "+table_name);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        logerr << "MySQLppConnection: loadBuffer: error '" << e.what() << "', rolling back";
+
+        transaction_->rollback();
+        delete transaction_;
+        transaction_ = nullptr;
+
+        mysql_set_local_infile_default(handle);
+        setLoadChecks(true);
+
+        throw;
+    }
+
+    if (cancelled)
+        transaction_->rollback();
+    else
+        transaction_->commit();
+
+    delete transaction_;
+    transaction_ = nullptr;
+
+    mysql_set_local_infile_default(handle);
+    setLoadChecks(true);
+
+    return !cancelled;
+}
+
+std::vector<MySQLppConnection::TSVWriter> MySQLppConnection::getTSVWriters (Buffer& buffer)
+{
+    const PropertyList& properties = buffer.properties();
+    std::vector<TSVWriter> writers;
+
+    for (unsigned int cnt=0; cnt < properties.size(); ++cnt)
+    {
+        const Property& property = properties.at(cnt);
+        const std::string& name = property.name();
+
+        switch (property.dataType())
+        {
+        case PropertyDataType::BOOL:
+            writers.push_back(numberTSVWriter(buffer.get<bool>(name), "%d"));
+            break;
+        case PropertyDataType::CHAR:
+            writers.push_back(numberTSVWriter(buffer.get<char>(name), "%d"));
+            break;
+        case PropertyDataType::UCHAR:
+            writers.push_back(numberTSVWriter(buffer.get<unsigned char>(name), "%d"));
+            break;
+        case PropertyDataType::SHORTINT:
+            writers.push_back(numberTSVWriter(buffer.get<short int>(name), "%d"));
+            break;
+        case PropertyDataType::USHORTINT:
+            writers.push_back(numberTSVWriter(buffer.get<unsigned short int>(name), "%d"));
+            break;
+        case PropertyDataType::INT:
+            writers.push_back(numberTSVWriter(buffer.get<int>(name), "%d"));
+            break;
+        case PropertyDataType::UINT:
+            writers.push_back(numberTSVWriter(buffer.get<unsigned int>(name), "%u"));
+            break;
+        case PropertyDataType::LONGINT:
+            writers.push_back(numberTSVWriter(buffer.get<long int>(name), "%ld"));
+            break;
+        case PropertyDataType::ULONGINT:
+            writers.push_back(numberTSVWriter(buffer.get<unsigned long int>(name), "%lu"));
+            break;
+        case PropertyDataType::FLOAT:
+            writers.push_back(numberTSVWriter(buffer.get<float>(name), "%.9g"));
+            break;
+        case PropertyDataType::DOUBLE:
+            writers.push_back(numberTSVWriter(buffer.get<double>(name), "%.17g"));
+            break;
+        case PropertyDataType::TIMESTAMP:
+        {
+            NullableVector<Timestamp>& values = buffer.get<Timestamp>(name);
+            writers.push_back([&values] (size_t index, std::string& data)
+            {
+                if (values.isNull(index))
+                {
+                    data += "\\N";
+                    return;
+                }
+
+                char tmp[32];
+                int length = std::snprintf (tmp, sizeof(tmp), "%.17g", values.get(index).seconds());
+                data.append (tmp, length);
+            });
+            break;
+        }
+        case PropertyDataType::STRING:
+        {
+            NullableVector<std::string>& values = buffer.get<std::string>(name);
+            writers.push_back([&values] (size_t index, std::string& data)
+            {
+                if (values.isNull(index))
+                {
+                    data += "\\N";
+                    return;
+                }
+
+                for (char c : values.get(index))
+                {
+                    switch (c)
+                    {
+                    case '\\':
+                        data += "\\\\";
+                        break;
+                    case '\t':
+                        data += "\\t";
+                        break;
+                    case '\n':
+                        data += "\\n";
+                        break;
+                    case '\0':
+                        data += "\\0";
+                        break;
+                    default:
+                        data += c;
+                    }
+                }
+            });
+            break;
+        }
+        default:
+            logerr << "MySQLppConnection: getTSVWriters: unknown property type "
+                   << Property::asString(property.dataType());
+            throw std::runtime_error ("MySQLppConnection: getTSVWriters: unknown property type "
+                                      + Property::asString(property.dataType()));
+        }
+    }
+
+    return writers;
+}
+
+void MySQLppConnection::setLoadChecks (bool enabled)
+{
+    executeSQL(std::string("SET unique_checks=")+(enabled ? "1;" : "0;"));
+    executeSQL(std::string("SET foreign_key_checks=")+(enabled ? "1;" : "0;"));
+}
+
+void MySQLppConnection::beginImport ()
+{
+    loginf << "MySQLppConnection: beginImport";
+
+    if (importing_) // previous import did not end, keep its disabled keys
+        logwrn << "MySQLppConnection: beginImport: previous import not ended";
+
+    importing_ = true;
+}
+
+void MySQLppConnection::endImport ()
+{
+    loginf << "MySQLppConnection: endImport";
+
+    for (auto& table_it : import_tables_)
+    {
+        if (table_it.second)
+        {
+            loginf << "MySQLppConnection: endImport: enabling keys of table " << table_it.first;
+            executeSQL("ALTER TABLE "+table_it.first+" ENABLE KEYS;");
+        }
+    }
+
+    import_tables_.clear();
+    importing_ = false;
+}
+
+void MySQLppConnection::disableKeys (const std::string& table_name)
+{
+    assert (importing_);
+
+    if (import_tables_.count(table_name))
+        return;
+
+    // DISABLE KEYS only defers non-unique index updates of MyISAM tables, InnoDB ignores it
+    DBCommand command;
+    command.set ("SELECT ENGINE FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '"
+                 +table_name+"';");
+    PropertyList list;
+    list.addProperty ("engine", PropertyDataType::STRING);
+    command.list (list);
+
+    std::shared_ptr <DBResult> result = execute(command);
+    assert (result->containsData());
+    std::shared_ptr <Buffer> buffer = result->buffer();
+
+    bool myisam = buffer->size() && !buffer->get<std::string>("engine").isNull(0)
+            && buffer->get<std::string>("engine").get(0) == "MyISAM";
+
+    loginf << "MySQLppConnection: disableKeys: table " << table_name << " MyISAM " << myisam;
+
+    if (myisam)
+        executeSQL("ALTER TABLE "+table_name+" DISABLE KEYS;");
+
+    import_tables_[table_name] = myisam;
+}
+
 
 std::shared_ptr <DBResult> MySQLppConnection::execute (const DBCommand &command)
 {
@@ -386,6 +751,15 @@ void MySQLppConnection::readRowIntoBuffer (mysqlpp::Row &row, const PropertyList
 //                    buffer->get<char>(prop.name()).setNone(index);
                 //loginf  << "sqlex: char " << prop->id_ << " val " << *ptr;
                 break;
+            case PropertyDataType::SHORTINT:
+                if (row[cnt] != mysqlpp::null)
+                    buffer->get<short int>(prop.name()).set(index, static_cast<short int> (row[cnt]));
+                break;
+            case PropertyDataType::USHORTINT:
+                if (row[cnt] != mysqlpp::null)
+                    buffer->get<unsigned short int>(prop.name()).set(index,
+                                                                     static_cast<unsigned short int> (row[cnt]));
+                break;
             case PropertyDataType::INT:
                 if (row[cnt] != mysqlpp::null)
                     buffer->get<int>(prop.name()).set(index, static_cast<int> (row[cnt]));
@@ -402,7 +776,7 @@ void MySQLppConnection::readRowIntoBuffer (mysqlpp::Row &row, const PropertyList
                 break;
             case PropertyDataType::STRING:
                 if (row[cnt] != mysqlpp::null)
-                    buffer->get<std::string>(prop.name()).set(index, static_cast<const char *> (row[cnt]));
+                    buffer->get<std::string>(prop.name()).set(index, row[cnt].data(), row[cnt].length());
 //                else
 //                    buffer->get<std::string>(prop.name()).setNone(index);
                 //loginf  << "sqlex: string " << prop->id_ << " val " << *ptr;
@@ -421,6 +795,10 @@ void MySQLppConnection::readRowIntoBuffer (mysqlpp::Row &row, const PropertyList
 //                    buffer->get<double>(prop.name()).setNone(index);
                 //loginf  << "sqlex: double " << prop->id_ << " val " << *ptr;
                 break;
+            case PropertyDataType::TIMESTAMP:
+                if (row[cnt] != mysqlpp::null)
+                    buffer->get<Timestamp>(prop.name()).set(index, Timestamp (static_cast<double> (row[cnt])));
+                break;
             default:
                 logerr  <<  "MySQLppConnection: readRowIntoBuffer: unknown property type";
                 throw std::runtime_error ("MySQLppConnection: readRowIntoBuffer: unknown property type");
@@ -503,7 +881,27 @@ void MySQLppConnection::prepareCommand (std::shared_ptr<DBCommand> command)
     if (info_widget_)
         info_widget_->updateSlot();
 
-    prepareStatement (command->get().c_str());
+    if (binary_reads_)
+    {
+        assert (!query_used_);
+        query_used_=true;
+
+        try
+        {
+            statement_reader_.reset(new MySQLStatementReader (connection_.driver()->mysql_handle(), command->get(),
+                                                              command->resultList()));
+        }
+        catch (std::exception& e)
+        {
+            query_used_=false;
+            prepared_command_=nullptr;
+            prepared_command_done_=true;
+            throw;
+        }
+    }
+    else
+        prepareStatement (command->get().c_str());
+
     logdbg  << "MySQLppConnection: prepareCommand: done";
 }
 
@@ -521,6 +919,31 @@ std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int
     assert (buffer->size() == 0);
     std::shared_ptr <DBResult> dbresult (new DBResult(buffer));
 
+    bool done=true;
+
+    if (statement_reader_)
+        done = statement_reader_->read(*buffer, max_results, profile_conversion_ ? &conversion_time_ : nullptr);
+    else
+        done = readPreparedRows(buffer, max_results);
+
+    logdbg  << "MySQLppConnection: stepPreparedCommand: buffer size " << buffer->size() << " max results " << max_results;
+
+    if (buffer->size() == 0 || done)
+    {
+        logdbg  << "MySQLppConnection: stepPreparedCommand: reading done";
+        prepared_command_done_=true;
+        if (done)
+            buffer->lastOne(true);
+        else
+            buffer=nullptr;
+    }
+
+    logdbg  << "MySQLppConnection: stepPreparedCommand: done";
+    return dbresult;
+}
+
+bool MySQLppConnection::readPreparedRows (std::shared_ptr <Buffer> buffer, unsigned int max_results)
+{
     unsigned int num_properties = buffer->properties().size();
     const PropertyList &list = buffer->properties();
     unsigned int cnt = 0;
@@ -531,7 +954,15 @@ std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int
 
     while (mysqlpp::Row row = result_step_.fetch_row())
     {
-        readRowIntoBuffer (row, list, num_properties, buffer, cnt);
+        if (profile_conversion_)
+        {
+            boost::posix_time::ptime start_time = DBQueryProfiler::now();
+            readRowIntoBuffer (row, list, num_properties, buffer, cnt);
+            conversion_time_ += DBQueryProfiler::secondsSince(start_time);
+        }
+        else
+            readRowIntoBuffer (row, list, num_properties, buffer, cnt);
+
         assert (buffer->size() == cnt+1);
 
         if (max_results != 0 && cnt >= max_results)
@@ -542,22 +973,10 @@ std::shared_ptr <DBResult> MySQLppConnection::stepPreparedCommand (unsigned int
 
         ++cnt;
     }
-    logdbg  << "MySQLppConnection: stepPreparedCommand: buffer size " << buffer->size() << " max results " << max_results;
 
     assert (buffer->size() <= max_results+1); // because of max_results--
 
-    if (buffer->size() == 0 || done)
-    {
-        logdbg  << "MySQLppConnection: stepPreparedCommand: reading done";
-        prepared_command_done_=true;
-        if (done)
-            buffer->lastOne(true);
-        else
-            buffer=nullptr;
-    }
-
-    logdbg  << "MySQLppConnection: stepPreparedCommand: done";
-    return dbresult;
+    return done;
 }
 void MySQLppConnection::finalizeCommand ()
 {
@@ -565,13 +984,18 @@ void MySQLppConnection::finalizeCommand ()
     assert (prepared_command_);
     //assert (prepared_command_done_); true if ok, false if quit job
 
-    bool first = true;
-    while (mysqlpp::Row row = result_step_.fetch_row())
-        if (first)
-        {
-            loginf << "MySQLppConnection: finalizeCommand: stepping through result set to finalize";
-            first = false;
-        }
+    if (statement_reader_)
+        statement_reader_ = nullptr; // discards unread rows
+    else
+    {
+        bool first = true;
+        while (mysqlpp::Row row = result_step_.fetch_row())
+            if (first)
+            {
+                loginf << "MySQLppConnection: finalizeCommand: stepping through result set to finalize";
+                first = false;
+            }
+    }
 
     prepared_command_=nullptr; // should be deleted by caller
     prepared_command_done_=true;
@@ -583,6 +1007,33 @@ void MySQLppConnection::finalizeCommand ()
     logdbg  << "MySQLppConnection: finalizeCommand: done";
 }
 
+void MySQLppConnection::interrupt ()
+{
+    unsigned long thread_id = connection_thread_id_;
+
+    loginf << "MySQLppConnection: interrupt: thread id " << thread_id;
+
+    if (!thread_id || !connected_server_)
+        return;
+
+    // the connection is blocked by the running query, so it has to be killed from a different one
+    mysqlpp::Connection kill_connection (false); // no exceptions
+
+    if (!kill_connection.connect("", connected_server_->host().c_str(), connected_server_->user().c_str(),
+                                 connected_server_->password().c_str(), connected_server_->port()))
+    {
+        logwrn << "MySQLppConnection: interrupt: connect failed with error " << kill_connection.error();
+        return;
+    }
+
+    mysqlpp::Query query = kill_connection.query("KILL QUERY "+std::to_string(thread_id));
+
+    if (!query.exec())
+        logwrn << "MySQLppConnection: interrupt: kill failed with error " << query.error();
+
+    kill_connection.disconnect();
+}
+
 std::map <std::string, DBTableInfo> MySQLppConnection::getTableInfo ()
 {
     std::map <std::string, DBTableInfo> info;
@@ -688,72 +1139,47 @@ std::vector<std::string> MySQLppConnection::getDatabases ()
     return names;
 }
 
-void MySQLppConnection::performanceTest ()
+std::string MySQLppConnection::queryPlan (const std::string &sql)
 {
-    //SELECT sd_radar.POS_SYS_X_NM, sd_radar.POS_SYS_Y_NM, sd_radar.MODEC_CODE_FT, sd_radar.TOD, sd_radar.DETECTION_TYPE, sd_radar.DS_ID, sd_radar.REC_NUM FROM sd_radar ORDER BY REC_NUM;'
-    boost::posix_time::ptime start_time;
-    boost::posix_time::ptime stop_time;
+    logdbg  << "MySQLppConnection: queryPlan: sql '" << sql << "'";
 
-    unsigned int chunk_size=100000;
-
-    loginf  << "MySQLppConnection: performanceTest: start";
+    assert (!query_used_);
+    assert (!prepared_command_);
 
-    start_time = boost::posix_time::microsec_clock::local_time();
+    query_used_=true;
 
-    std::shared_ptr<DBCommand> command = std::make_shared<DBCommand> (DBCommand());
-    command->set("SELECT sd_radar.REC_NUM, sd_radar.POS_SYS_X_NM, sd_radar.POS_SYS_Y_NM, sd_radar.MODEC_CODE_FT, sd_radar.TOD, sd_radar.DETECTION_TYPE, sd_radar.DS_ID FROM sd_radar ORDER BY REC_NUM;");
-    //ORDER BY REC_NUM
+    std::string plan;
 
-    PropertyList list;
-    list.addProperty ("REC_NUM", PropertyDataType::INT);
-    list.addProperty ("POS_LAT_DEG", PropertyDataType::DOUBLE);
-    list.addProperty ("POS_LONG_DEG", PropertyDataType::DOUBLE);
-    list.addProperty ("MODEC_CODE_FT", PropertyDataType::DOUBLE);
-    list.addProperty ("TOD", PropertyDataType::DOUBLE);
-    list.addProperty ("POS_SYS_X_NM", PropertyDataType::DOUBLE);
-    list.addProperty ("POS_SYS_Y_NM", PropertyDataType::DOUBLE);
-    //list.addProperty ("DETECTION_TYPE", PropertyDataType::INT);
-    //list.addProperty ("DS_ID", PropertyDataType::INT);
-    command->list (list);
-
-    prepareCommand (command);
-
-    size_t rows=0;
-    bool quit = false;
-    while (!quit)
+    try
     {
-        std::shared_ptr <DBResult> result = stepPreparedCommand(chunk_size);
-        assert (result->containsData());
-        std::shared_ptr <Buffer> buffer = result->buffer();
-        assert (buffer->size() != 0);
-
-        if (buffer->lastOne())
-            quit=true;
-        else
-            assert (buffer->size() == chunk_size);
+        mysqlpp::Query query = connection_.query("EXPLAIN "+sql);
+        mysqlpp::StoreQueryResult res = query.store();
 
-        rows += buffer->size();
+        for (mysqlpp::StoreQueryResult::const_iterator it = res.begin(); it != res.end(); ++it)
+        {
+            const mysqlpp::Row& row = *it;
 
-        loginf << "MySQLppConnection: performanceTest: got " << rows << " rows";
-    }
+            if (plan.size())
+                plan += "\n";
 
-    finalizeCommand ();
+            for (size_t cnt=0; cnt < row.size(); ++cnt)
+            {
+                if (cnt)
+                    plan += " ";
 
-    //    for (unsigned int cnt=0; cnt < num_reads; cnt++)
-    //    {
-    //        DBResult *result = readBulkCommand(&command,
-    //                                           "SELECT sd_radar.REC_NUM, sd_radar.POS_SYS_X_NM, sd_radar.POS_SYS_Y_NM, sd_radar.MODEC_CODE_FT, sd_radar.TOD, sd_radar.DETECTION_TYPE, sd_radar.DS_ID FROM sd_radar",
-    //                                           "",  chunk_size);
-    //        Buffer *buffer = result->getBuffer();
-    //        delete result;
-    //        delete buffer;
-    //    }
+                plan += res.field_name(cnt)+"=";
+                plan += row[cnt] != mysqlpp::null ? std::string(row[cnt].c_str()) : "NULL";
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        logwrn << "MySQLppConnection: queryPlan: sql error '" << e.what() << "'";
+    }
 
-    stop_time = boost::posix_time::microsec_clock::local_time();
-    boost::posix_time::time_duration diff = stop_time - start_time;
-    double load_time = diff.total_milliseconds()/1000.0;
+    query_used_=false;
 
-    loginf  << "MySQLppConnection: performanceTest: end after load time " << load_time << "s rows " << rows << " " << rows/load_time << " r/s";
+    return plan;
 }
 
 QWidget *MySQLppConnection::widget ()
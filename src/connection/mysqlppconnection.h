@@ -19,18 +19,25 @@
 #define MySQLppConnection_H_
 
 #include <mysql++/mysql++.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "configurable.h"
 #include "dbconnection.h"
 #include "global.h"
 
 class Buffer;
+class CancellationToken;
 class DBInterface;
 class DBTableInfo;
 class MySQLppConnectionWidget;
 class MySQLppConnectionInfoWidget;
 class MySQLServer;
+class MySQLStatementReader;
 class PropertyList;
 
 /**
@@ -61,6 +68,7 @@ public:
     void beginBindTransaction () override;
     void stepAndClearBindings () override;
     void endBindTransaction () override;
+    void abortBindTransaction () override;
     void finalizeBindStatement () override;
 
     void bindVariable (unsigned int index, int value) override;
@@ -76,6 +84,11 @@ public:
     void finalizeCommand () override;
     bool getPreparedCommandDone () override { return prepared_command_done_; }
 
+    /// @brief Kills the running query using a separate connection (KILL QUERY)
+    void interrupt () override;
+
+    std::string queryPlan (const std::string &sql) override;
+
     /// @brief Added for performance test. Do not use.
     //DBResult *readBulkCommand (DBCommand *command, std::string main_statement, std::string order_statement,
     // unsigned int max_results=0);
@@ -98,6 +111,28 @@ public:
 
     MySQLServer& connectedServer () { assert (connected_server_); return *connected_server_; }
 
+    /// @brief Returns if buffers are inserted using LOAD DATA LOCAL INFILE instead of per-row statements
+    bool bulkLoad () const { return bulk_load_; }
+    void bulkLoad (bool value) { bulk_load_ = value; }
+
+    /// @brief Returns if prepared commands are read using server-side prepared statements (binary protocol)
+    bool binaryReads () const { return binary_reads_; }
+    void binaryReads (bool value) { binary_reads_ = value; }
+
+    /// @brief Inserts rows [from_index, end_index) of buffer into table using LOAD DATA LOCAL INFILE
+    ///
+    /// Rows are written in MySQL's tab-separated text format and streamed from memory in batches of
+    /// bulk_load_batch_size rows, in one transaction with unique and foreign key checks disabled. During an import,
+    /// keys of MyISAM tables are disabled at their first load. Returns false and rolls back if the token was
+    /// cancelled.
+    bool loadBuffer (const std::string& table_name, std::shared_ptr<Buffer> buffer, size_t from_index,
+                     size_t end_index, const CancellationToken* token=nullptr);
+
+    /// @brief Starts an import, non-unique index updates of loaded MyISAM tables are deferred until endImport
+    void beginImport ();
+    /// @brief Ends an import, re-enables the disabled keys (which rebuilds the indexes)
+    void endImport ();
+
     void importSQLFile (const std::string& filename);
     void importSQLArchiveFile (const std::string& filename);
 
@@ -110,6 +145,8 @@ protected:
 
     /// Used for all database queries
     mysqlpp::Connection connection_;
+    /// Server thread id of connection_, 0 if not connected. Used to kill running queries from other threads.
+    std::atomic<unsigned long> connection_thread_id_ {0};
 
     /// Prepared query
     mysqlpp::Query prepared_query_;
@@ -117,6 +154,8 @@ protected:
     mysqlpp::SQLQueryParms prepared_parameters_;
     /// Result from query for incremental reading.
     mysqlpp::UseQueryResult result_step_;
+    /// Reader of the prepared command if binary reads are used
+    std::unique_ptr<MySQLStatementReader> statement_reader_;
     /// Query is in use flag.
     bool query_used_ {false};
 
@@ -133,6 +172,22 @@ protected:
 
     std::map <std::string, MySQLServer*> servers_;
 
+    /// Read prepared commands using server-side prepared statements
+    bool binary_reads_ {true};
+
+    /// Insert buffers using LOAD DATA LOCAL INFILE
+    bool bulk_load_ {true};
+    /// Number of rows per LOAD DATA statement
+    unsigned int bulk_load_batch_size_ {50000};
+
+    /// Set between beginImport and endImport
+    bool importing_ {false};
+    /// Tables loaded into during the current import -> if their keys were disabled (MyISAM)
+    std::map<std::string, bool> import_tables_;
+
+    /// Appends the value of a buffer column at an index in tab-separated text format
+    typedef std::function<void(size_t, std::string&)> TSVWriter;
+
     void prepareStatement (const std::string &sql) override;
     void finalizeStatement () override;
 
@@ -142,14 +197,21 @@ protected:
     /// @brief Executes an SQL command which returns no data (internal)
     void execute (const std::string &command);
 
+    /// @brief Reads up to max_results rows of the text result of the prepared statement into buffer
+    ///
+    /// Returns true if all rows were read.
+    bool readPreparedRows (std::shared_ptr <Buffer> buffer, unsigned int max_results);
     void readRowIntoBuffer (mysqlpp::Row &row, const PropertyList &list, unsigned int num_properties,
                             std::shared_ptr <Buffer> buffer, unsigned int index);
 
+    std::vector<TSVWriter> getTSVWriters (Buffer& buffer);
+    /// @brief Enables or disables unique/foreign key checks of the session for bulk loading
+    void setLoadChecks (bool enabled);
+    /// @brief Disables keys of table if it is a MyISAM table, once per import
+    void disableKeys (const std::string& table_name);
+
     std::vector<std::string> getTableList();
     DBTableInfo getColumnList(const std::string &table);
-
-    /// @brief Used for performance tests.
-    void performanceTest ();
 };
 
 #endif /* MySQLppConnection_H_ */
@@ -0,0 +1,336 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstring>
+#include <stdexcept>
+
+#include <mysqld_error.h>
+
+#include "mysqlstatementreader.h"
+#include "buffer.h"
+#include "dbqueryprofiler.h"
+#include "logger.h"
+
+namespace
+{
+const size_t NUMBER_SIZE = 8;
+const size_t INITIAL_STRING_SIZE = 256;
+
+template <typename T, typename V> std::function<void(size_t)> valueSetter (NullableVector<T>& values,
+                                                                          const std::vector<char>& data)
+{
+    const V* value = reinterpret_cast<const V*> (data.data()); // numeric storage is never resized
+    return [&values, value] (size_t index) { values.set(index, static_cast<T> (*value)); };
+}
+}
+
+MySQLStatementReader::MySQLStatementReader (MYSQL* handle, const std::string& sql, const PropertyList& list)
+    : list_(list)
+{
+    assert (handle);
+
+    logdbg << "MySQLStatementReader: constructor: sql '" << sql << "'";
+
+    statement_ = mysql_stmt_init(handle);
+
+    if (!statement_)
+        throw std::runtime_error ("MySQLStatementReader: constructor: statement init failed: "
+                                  +std::string(mysql_error(handle)));
+
+    try
+    {
+        if (mysql_stmt_prepare(statement_, sql.c_str(), sql.size()))
+            throwError("constructor");
+
+        if (mysql_stmt_field_count(statement_) != list_.size())
+        {
+            logerr << "MySQLStatementReader: constructor: statement returns " << mysql_stmt_field_count(statement_)
+                   << " columns, expected " << list_.size();
+            throw std::runtime_error ("MySQLStatementReader: constructor: wrong number of result columns");
+        }
+
+        bindColumns();
+
+        if (mysql_stmt_execute(statement_))
+            throwError("constructor");
+    }
+    catch (std::exception& e)
+    {
+        mysql_stmt_close(statement_); // destructor is not called
+        statement_ = nullptr;
+        throw;
+    }
+}
+
+MySQLStatementReader::~MySQLStatementReader ()
+{
+    if (statement_)
+    {
+        mysql_stmt_free_result(statement_);
+        mysql_stmt_close(statement_); // discards unread rows
+    }
+}
+
+bool MySQLStatementReader::read (Buffer& buffer, size_t max_results, double* conversion_time)
+{
+    assert (statement_);
+
+    std::vector<std::function<void(size_t)>> setters = getSetters(buffer);
+    size_t num_columns = columns_.size();
+
+    size_t index = buffer.size();
+    size_t cnt = 0;
+    boost::posix_time::ptime start_time;
+
+    while (!max_results || cnt < max_results)
+    {
+        if (rebind_)
+        {
+            if (mysql_stmt_bind_result(statement_, binds_.data()))
+                throwError("read");
+            rebind_ = false;
+        }
+
+        int ret = mysql_stmt_fetch(statement_);
+
+        if (ret == MYSQL_NO_DATA)
+            return true;
+
+        if (ret == 1)
+        {
+            if (mysql_stmt_errno(statement_) == ER_QUERY_INTERRUPTED)
+            {
+                loginf << "MySQLStatementReader: read: interrupted after " << cnt << " rows";
+                return true;
+            }
+
+            throwError("read");
+        }
+
+        if (ret == MYSQL_DATA_TRUNCATED)
+            fetchTruncated();
+
+        if (conversion_time)
+            start_time = DBQueryProfiler::now();
+
+        for (size_t col=0; col < num_columns; ++col)
+            if (!columns_[col]->is_null_)
+                setters[col](index);
+
+        if (conversion_time)
+            *conversion_time += DBQueryProfiler::secondsSince(start_time);
+
+        ++index;
+        ++cnt;
+    }
+
+    return false;
+}
+
+void MySQLStatementReader::bindColumns ()
+{
+    size_t num_columns = list_.size();
+
+    columns_.clear();
+    binds_.resize(num_columns);
+
+    for (size_t cnt=0; cnt < num_columns; ++cnt)
+    {
+        const Property& property = list_.at(cnt);
+
+        columns_.push_back(std::unique_ptr<Column> (new Column ()));
+        Column& column = *columns_.back();
+
+        column.data_type_ = property.dataType();
+        column.name_ = property.name();
+
+        MYSQL_BIND& bind = binds_.at(cnt);
+        std::memset(&bind, 0, sizeof(bind));
+
+        switch (column.data_type_)
+        {
+        case PropertyDataType::BOOL:
+        case PropertyDataType::CHAR:
+            bind.buffer_type = MYSQL_TYPE_TINY;
+            break;
+        case PropertyDataType::UCHAR:
+            bind.buffer_type = MYSQL_TYPE_TINY;
+            bind.is_unsigned = 1;
+            break;
+        case PropertyDataType::SHORTINT:
+            bind.buffer_type = MYSQL_TYPE_SHORT;
+            break;
+        case PropertyDataType::USHORTINT:
+            bind.buffer_type = MYSQL_TYPE_SHORT;
+            bind.is_unsigned = 1;
+            break;
+        case PropertyDataType::INT:
+            bind.buffer_type = MYSQL_TYPE_LONG;
+            break;
+        case PropertyDataType::UINT:
+            bind.buffer_type = MYSQL_TYPE_LONG;
+            bind.is_unsigned = 1;
+            break;
+        case PropertyDataType::LONGINT:
+            bind.buffer_type = MYSQL_TYPE_LONGLONG;
+            break;
+        case PropertyDataType::ULONGINT:
+            bind.buffer_type = MYSQL_TYPE_LONGLONG;
+            bind.is_unsigned = 1;
+            break;
+        case PropertyDataType::FLOAT:
+            bind.buffer_type = MYSQL_TYPE_FLOAT;
+            break;
+        case PropertyDataType::DOUBLE:
+        case PropertyDataType::TIMESTAMP: // stored as seconds
+            bind.buffer_type = MYSQL_TYPE_DOUBLE;
+            break;
+        case PropertyDataType::STRING:
+            bind.buffer_type = MYSQL_TYPE_STRING;
+            break;
+        default:
+            logerr << "MySQLStatementReader: bindColumns: unknown property type "
+                   << Property::asString(column.data_type_);
+            throw std::runtime_error ("MySQLStatementReader: bindColumns: unknown property type "
+                                      + Property::asString(column.data_type_));
+        }
+
+        column.data_.resize(column.data_type_ == PropertyDataType::STRING ? INITIAL_STRING_SIZE : NUMBER_SIZE);
+
+        bind.buffer = column.data_.data();
+        bind.buffer_length = column.data_.size();
+        bind.length = &column.length_;
+        bind.is_null = &column.is_null_;
+        bind.error = &column.error_;
+    }
+
+    if (mysql_stmt_bind_result(statement_, binds_.data()))
+        throwError("bindColumns");
+}
+
+std::vector<std::function<void(size_t)>> MySQLStatementReader::getSetters (Buffer& buffer)
+{
+    std::vector<std::function<void(size_t)>> setters;
+
+    for (auto& column_it : columns_)
+    {
+        Column& column = *column_it;
+        const std::string& name = column.name_;
+
+        switch (column.data_type_)
+        {
+        case PropertyDataType::BOOL:
+            setters.push_back(valueSetter<bool, signed char>(buffer.get<bool>(name), column.data_));
+            break;
+        case PropertyDataType::CHAR:
+            setters.push_back(valueSetter<char, signed char>(buffer.get<char>(name), column.data_));
+            break;
+        case PropertyDataType::UCHAR:
+            setters.push_back(valueSetter<unsigned char, unsigned char>(buffer.get<unsigned char>(name),
+                                                                        column.data_));
+            break;
+        case PropertyDataType::SHORTINT:
+            setters.push_back(valueSetter<short int, short int>(buffer.get<short int>(name), column.data_));
+            break;
+        case PropertyDataType::USHORTINT:
+            setters.push_back(valueSetter<unsigned short int, unsigned short int>(
+                                  buffer.get<unsigned short int>(name), column.data_));
+            break;
+        case PropertyDataType::INT:
+            setters.push_back(valueSetter<int, int>(buffer.get<int>(name), column.data_));
+            break;
+        case PropertyDataType::UINT:
+            setters.push_back(valueSetter<unsigned int, unsigned int>(buffer.get<unsigned int>(name), column.data_));
+            break;
+        case PropertyDataType::LONGINT:
+            setters.push_back(valueSetter<long int, long long>(buffer.get<long int>(name), column.data_));
+            break;
+        case PropertyDataType::ULONGINT:
+            setters.push_back(valueSetter<unsigned long int, unsigned long long>(
+                                  buffer.get<unsigned long int>(name), column.data_));
+            break;
+        case PropertyDataType::FLOAT:
+            setters.push_back(valueSetter<float, float>(buffer.get<float>(name), column.data_));
+            break;
+        case PropertyDataType::DOUBLE:
+            setters.push_back(valueSetter<double, double>(buffer.get<double>(name), column.data_));
+            break;
+        case PropertyDataType::TIMESTAMP:
+        {
+            NullableVector<Timestamp>& values = buffer.get<Timestamp>(name);
+            const double* value = reinterpret_cast<const double*> (column.data_.data());
+            setters.push_back([&values, value] (size_t index) { values.set(index, Timestamp (*value)); });
+            break;
+        }
+        case PropertyDataType::STRING:
+        {
+            NullableVector<std::string>& values = buffer.get<std::string>(name);
+            // storage might be enlarged, so accessed through the column
+            setters.push_back([&values, &column] (size_t index)
+            {
+                values.set(index, column.data_.data(), column.length_);
+            });
+            break;
+        }
+        default:
+            throw std::runtime_error ("MySQLStatementReader: getSetters: unknown property type "
+                                      + Property::asString(column.data_type_));
+        }
+    }
+
+    return setters;
+}
+
+void MySQLStatementReader::fetchTruncated ()
+{
+    for (size_t cnt=0; cnt < columns_.size(); ++cnt)
+    {
+        Column& column = *columns_.at(cnt);
+
+        if (column.data_type_ != PropertyDataType::STRING || column.is_null_ || column.length_ <= column.data_.size())
+            continue; // numeric truncation is accepted, as for text results
+
+        size_t fetched = column.data_.size();
+
+        logdbg << "MySQLStatementReader: fetchTruncated: column " << column.name_ << " length " << column.length_;
+
+        column.data_.resize(column.length_);
+
+        MYSQL_BIND bind;
+        std::memset(&bind, 0, sizeof(bind));
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = column.data_.data() + fetched;
+        bind.buffer_length = column.length_ - fetched;
+
+        if (mysql_stmt_fetch_column(statement_, &bind, cnt, fetched))
+            throwError("fetchTruncated");
+
+        binds_.at(cnt).buffer = column.data_.data();
+        binds_.at(cnt).buffer_length = column.data_.size();
+        rebind_ = true;
+    }
+}
+
+void MySQLStatementReader::throwError (const std::string& function)
+{
+    std::string error = mysql_stmt_error(statement_);
+
+    logerr << "MySQLStatementReader: " << function << ": error " << mysql_stmt_errno(statement_) << " '" << error
+           << "'";
+    throw std::runtime_error ("MySQLStatementReader: "+function+": error '"+error+"'");
+}
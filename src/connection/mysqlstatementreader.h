@@ -0,0 +1,90 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MYSQLSTATEMENTREADER_H
+#define MYSQLSTATEMENTREADER_H
+
+#include <mysql.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "propertylist.h"
+
+class Buffer;
+
+/**
+ * @brief Reads the result of a select statement using a server-side prepared statement
+ *
+ * @details Uses the binary protocol of the MySQL C API. Result columns are bound to preallocated typed values
+ * according to the data types of the property list, so no text is parsed and no row objects are created. Rows are
+ * streamed from the server (unbuffered) and copied into buffers in chunks. String values longer than the bound
+ * storage are fetched separately and the storage is enlarged for the following rows.
+ *
+ * The connection can not be used for other statements while the reader exists.
+ */
+class MySQLStatementReader
+{
+public:
+    /// @brief Constructor, prepares and executes the statement, throws on error
+    MySQLStatementReader (MYSQL* handle, const std::string& sql, const PropertyList& list);
+    virtual ~MySQLStatementReader ();
+
+    /// @brief Reads up to max_results rows (all if 0) into buffer, returns true if all rows were read
+    ///
+    /// Conversion time is accumulated if given. An interrupted statement (KILL QUERY) counts as read completely.
+    bool read (Buffer& buffer, size_t max_results, double* conversion_time=nullptr);
+
+protected:
+    /// Null flag type of MYSQL_BIND, differs between client library versions
+    typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type NullFlag;
+
+    /// Bound storage of one result column
+    struct Column
+    {
+        PropertyDataType data_type_;
+        std::string name_;
+        /// Value, 8 bytes for numbers, variable for strings
+        std::vector<char> data_;
+        unsigned long length_ {0};
+        NullFlag is_null_ {0};
+        NullFlag error_ {0};
+    };
+
+    MYSQL_STMT* statement_ {nullptr};
+    PropertyList list_;
+
+    std::vector<std::unique_ptr<Column>> columns_;
+    std::vector<MYSQL_BIND> binds_;
+    /// Result has to be bound again since string storage was enlarged
+    bool rebind_ {false};
+
+    void bindColumns ();
+    /// @brief Returns functions copying the value of each column into buffer at an index
+    std::vector<std::function<void(size_t)>> getSetters (Buffer& buffer);
+    /// @brief Fetches the remainder of truncated string values
+    void fetchTruncated ();
+
+    /// @brief Throws error of the statement
+    void throwError (const std::string& function);
+};
+
+#endif // MYSQLSTATEMENTREADER_H
@@ -31,6 +31,7 @@
 #include "sqliteconnectioninfowidget.h"
 #include "dbinterface.h"
 #include "dbtableinfo.h"
+#include "dbqueryprofiler.h"
 #include "stringconv.h"
 
 SQLiteConnection::SQLiteConnection(const std::string &class_id, const std::string &instance_id, DBInterface *interface)
@@ -176,6 +177,12 @@ void SQLiteConnection::endBindTransaction ()
     char * sErrMsg = 0;
     sqlite3_exec(db_handle_, "END TRANSACTION", NULL, NULL, &sErrMsg);
 }
+void SQLiteConnection::abortBindTransaction ()
+{
+    char * sErrMsg = 0;
+    sqlite3_exec(db_handle_, "ROLLBACK TRANSACTION", NULL, NULL, &sErrMsg);
+}
+
 void SQLiteConnection::finalizeBindStatement ()
 {
     sqlite3_finalize(statement_);
@@ -331,6 +338,16 @@ void SQLiteConnection::readRowIntoBuffer (const PropertyList &list, unsigned int
 //                buffer->get<char>(prop.name()).setNone(index);
             //loginf  << "sqlex: char " << prop->id_ << " val " << *ptr;
             break;
+        case PropertyDataType::SHORTINT:
+            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                buffer->get<short int>(prop.name()).set(
+                            index, static_cast<short int> (sqlite3_column_int(statement_, cnt)));
+            break;
+        case PropertyDataType::USHORTINT:
+            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                buffer->get<unsigned short int>(prop.name()).set(
+                            index, static_cast<unsigned short int> (sqlite3_column_int(statement_, cnt)));
+            break;
         case PropertyDataType::INT:
             if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
                 buffer->get<int>(prop.name()).set(index, static_cast<int> (sqlite3_column_int(statement_, cnt)));
@@ -347,7 +364,11 @@ void SQLiteConnection::readRowIntoBuffer (const PropertyList &list, unsigned int
             break;
         case PropertyDataType::STRING:
             if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                buffer->get<std::string>(prop.name()).set(index, std::string (reinterpret_cast<const char*> (sqlite3_column_text(statement_, cnt))));
+            {
+                // text before bytes, so that the length is of the UTF-8 text
+                const char* text = reinterpret_cast<const char*> (sqlite3_column_text(statement_, cnt));
+                buffer->get<std::string>(prop.name()).set(index, text, sqlite3_column_bytes(statement_, cnt));
+            }
 //            else
 //                buffer->get<std::string>(prop.name()).setNone(index);
             //loginf  << "sqlex: string " << prop->id_ << " val " << *ptr;
@@ -366,6 +387,10 @@ void SQLiteConnection::readRowIntoBuffer (const PropertyList &list, unsigned int
 //                buffer->get<double>(prop.name()).setNone(index);
             //loginf  << "sqlex: double " << prop->id_ << " val " << *ptr;
             break;
+        case PropertyDataType::TIMESTAMP:
+            if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                buffer->get<Timestamp>(prop.name()).set(index, Timestamp (sqlite3_column_double (statement_, cnt)));
+            break;
         default:
             logerr  <<  "MySQLppConnection: readRowIntoBuffer: unknown property type";
             throw std::runtime_error ("MySQLppConnection: readRowIntoBuffer: unknown property type");
@@ -435,7 +460,14 @@ std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int m
     // Now step throught the result lines
     for (result = sqlite3_step(statement_); result == SQLITE_ROW; result = sqlite3_step(statement_))
     {
-        readRowIntoBuffer (list, num_properties, buffer, cnt);
+        if (profile_conversion_)
+        {
+            boost::posix_time::ptime start_time = DBQueryProfiler::now();
+            readRowIntoBuffer (list, num_properties, buffer, cnt);
+            conversion_time_ += DBQueryProfiler::secondsSince(start_time);
+        }
+        else
+            readRowIntoBuffer (list, num_properties, buffer, cnt);
 
         if (buffer->size()) // 0 == 1 otherwise
             assert (buffer->size() == cnt+1);
@@ -449,6 +481,12 @@ std::shared_ptr <DBResult> SQLiteConnection::stepPreparedCommand (unsigned int m
         ++cnt;
     }
 
+    if (result == SQLITE_INTERRUPT)
+    {
+        loginf << "SQLiteConnection: stepPreparedCommand: interrupted after " << buffer->size() << " rows";
+        result = SQLITE_DONE;
+    }
+
     if (result != SQLITE_ROW && result != SQLITE_DONE)
     {
         logerr <<  "SQLiteConnection: stepPreparedCommand: problem while stepping the result: " <<  result << " " <<  sqlite3_errmsg(db_handle_);
@@ -477,6 +515,51 @@ void SQLiteConnection::finalizeCommand ()
     prepared_command_done_=true;
 }
 
+void SQLiteConnection::interrupt ()
+{
+    loginf << "SQLiteConnection: interrupt";
+
+    if (db_handle_)
+        sqlite3_interrupt(db_handle_); // thread-safe, only effective while statements are running
+}
+
+std::string SQLiteConnection::queryPlan (const std::string &sql)
+{
+    logdbg  << "SQLiteConnection: queryPlan: sql '" << sql << "'";
+
+    // own statement, since statement_ might be in use by a prepared command
+    sqlite3_stmt* plan_statement {nullptr};
+    std::string plan_sql = "EXPLAIN QUERY PLAN "+sql;
+
+    int result = sqlite3_prepare_v2(db_handle_, plan_sql.c_str(), plan_sql.size(), &plan_statement, nullptr);
+    if (result != SQLITE_OK)
+    {
+        logwrn <<  "SQLiteConnection: queryPlan: error " <<  result << " " <<  sqlite3_errmsg(db_handle_);
+        sqlite3_finalize(plan_statement);
+        return "";
+    }
+
+    std::string plan;
+    int num_columns = sqlite3_column_count(plan_statement);
+
+    // last column is the detail text
+    for (result = sqlite3_step(plan_statement); result == SQLITE_ROW; result = sqlite3_step(plan_statement))
+    {
+        const unsigned char* detail = sqlite3_column_text(plan_statement, num_columns-1);
+
+        if (detail)
+        {
+            if (plan.size())
+                plan += "\n";
+            plan += reinterpret_cast<const char*> (detail);
+        }
+    }
+
+    sqlite3_finalize(plan_statement);
+
+    return plan;
+}
+
 
 std::map <std::string, DBTableInfo> SQLiteConnection::getTableInfo ()
 {
@@ -51,6 +51,7 @@ public:
     void beginBindTransaction () override;
     void stepAndClearBindings () override;
     void endBindTransaction () override;
+    void abortBindTransaction () override;
     void finalizeBindStatement () override;
 
     void bindVariable (unsigned int index, int value) override;
@@ -66,6 +67,10 @@ public:
     void finalizeCommand () override;
     bool getPreparedCommandDone () override { return prepared_command_done_; }
 
+    void interrupt () override;
+
+    std::string queryPlan (const std::string &sql) override;
+
     std::map <std::string, DBTableInfo> getTableInfo () override;
     virtual std::vector <std::string> getDatabases() override;
 
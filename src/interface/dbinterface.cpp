@@ -54,6 +54,7 @@
 #include "dbtableinfo.h"
 #include "dbtable.h"
 #include "stringconv.h"
+#include "cancellationtoken.h"
 
 using namespace Utils;
 
@@ -70,6 +71,8 @@ DBInterface::DBInterface(std::string class_id, std::string instance_id, ATSDB *a
 
     registerParameter ("read_chunk_size", &read_chunk_size_, 50000);
     registerParameter ("used_connection", &used_connection_, "");
+    registerParameter ("profile_queries", &profile_queries_, false);
+    registerParameter ("explain_queries", &explain_queries_, false);
 
     createSubConfigurables();
 }
@@ -172,6 +175,12 @@ DBInterfaceWidget *DBInterface::widget()
     return widget_;
 }
 
+void DBInterface::profileQueries (bool value)
+{
+    loginf << "DBInterface: profileQueries: " << value;
+    profile_queries_ = value;
+}
+
 DBInterfaceInfoWidget *DBInterface::infoWidget()
 {
     if (!info_widget_)
@@ -710,8 +719,8 @@ void DBInterface::loadProperties ()
     assert (buffer->has<std::string> ("id"));
     assert (buffer->has<std::string> ("value"));
 
-    NullableVector<std::string> id_vec = buffer->get<std::string> ("id");
-    NullableVector<std::string> value_vec = buffer->get<std::string> ("value");
+    NullableVector<std::string>& id_vec = buffer->get<std::string> ("id");
+    NullableVector<std::string>& value_vec = buffer->get<std::string> ("value");
 
     for (size_t cnt=0; cnt < buffer->size(); ++cnt)
     {
@@ -875,6 +884,9 @@ void DBInterface::postProcess ()
     {
         logwrn << "DBInterface: postProcess: no data in objects";
 
+        if (ATSDB::instance().headless())
+            return;
+
         QMessageBox m_warning (QMessageBox::Warning, "No Data in Objects",
                                "None of the database objects contains any data. Post-processing was not performed.",
                                QMessageBox::Ok);
@@ -888,14 +900,17 @@ void DBInterface::postProcess ()
         if (obj_it.second->hasData())
             ++dbos_with_data;
 
-    assert (!postprocess_dialog_);
-    postprocess_dialog_ = new QProgressDialog (tr(""), tr(""), 0, static_cast<int>(2*dbos_with_data));
-    postprocess_dialog_->setWindowTitle("Post-Processing Status");
-    postprocess_dialog_->setCancelButton(nullptr);
-    postprocess_dialog_->setWindowModality(Qt::ApplicationModal);
-    postprocess_dialog_->show();
-
-    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    if (!ATSDB::instance().headless())
+    {
+        assert (!postprocess_dialog_);
+        postprocess_dialog_ = new QProgressDialog (tr(""), tr(""), 0, static_cast<int>(2*dbos_with_data));
+        postprocess_dialog_->setWindowTitle("Post-Processing Status");
+        postprocess_dialog_->setCancelButton(nullptr);
+        postprocess_dialog_->setWindowModality(Qt::ApplicationModal);
+        postprocess_dialog_->show();
+
+        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    }
 
     if (!existsMinMaxTable())
         createMinMaxTable();
@@ -936,7 +951,7 @@ void DBInterface::postProcessingJobDoneSlot()
     Job* job_sender = static_cast <Job*> (QObject::sender());
     assert (job_sender);
     assert (postprocess_jobs_.size() > 0);
-    assert (postprocess_dialog_);
+    assert (postprocess_dialog_ || ATSDB::instance().headless());
 
     bool found=false;
     for (auto job_it = postprocess_jobs_.begin(); job_it != postprocess_jobs_.end(); job_it++)
@@ -956,14 +971,17 @@ void DBInterface::postProcessingJobDoneSlot()
         loginf << "DBInterface: postProcessingJobDoneSlot: done";
         setPostProcessed(true);
 
-        delete postprocess_dialog_;
-        postprocess_dialog_=nullptr;
+        if (postprocess_dialog_)
+        {
+            delete postprocess_dialog_;
+            postprocess_dialog_=nullptr;
 
-        QApplication::restoreOverrideCursor();
+            QApplication::restoreOverrideCursor();
+        }
 
         emit postProcessingDoneSignal();
     }
-    else
+    else if (postprocess_dialog_)
         postprocess_dialog_->setValue(postprocess_job_num_-postprocess_jobs_.size());
 }
 
@@ -1039,23 +1057,28 @@ std::set<int> DBInterface::getActiveDataSources (DBObject &object)
 //    buffer_writer_->write (data, table_name);
 //}
 
-void DBInterface::insertBuffer (MetaDBTable& meta_table, std::shared_ptr<Buffer> buffer)
+bool DBInterface::insertBuffer (MetaDBTable& meta_table, std::shared_ptr<Buffer> buffer,
+                                const CancellationToken* token)
 {
     loginf << "DBInterface: insertBuffer: meta " << meta_table.name() << " buffer size " << buffer->size();
 
     std::shared_ptr<Buffer> partial_buffer = getPartialBuffer(meta_table.mainTable(), buffer);
     assert (partial_buffer->size());
-    insertBuffer(meta_table.mainTable(), partial_buffer);
+    if (!insertBuffer(meta_table.mainTable(), partial_buffer, token))
+        return false;
 
     for (auto& sub_it : meta_table.subTables())
     {
         partial_buffer = getPartialBuffer(sub_it.second, buffer);
         assert (partial_buffer->size());
-        insertBuffer(sub_it.second, partial_buffer);
+        if (!insertBuffer(sub_it.second, partial_buffer, token))
+            return false;
     }
+
+    return true;
 }
 
-void DBInterface::insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer)
+bool DBInterface::insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer, const CancellationToken* token)
 {
     loginf << "DBInterface: insertBuffer: table " << table.name() << " buffer size " << buffer->size();
 
@@ -1082,21 +1105,11 @@ void DBInterface::insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer)
 
     QMutexLocker locker(&connection_mutex_);
 
-    logdbg  << "DBInterface: insertBuffer: preparing bind statement";
-    current_connection_->prepareBindStatement(bind_statement);
-    current_connection_->beginBindTransaction();
-
-    logdbg  << "DBInterface: insertBuffer: starting inserts";
-    size_t size = buffer->size();
-    for (unsigned int cnt=0; cnt < size; ++cnt)
-    {
-        insertBindStatementUpdateForCurrentIndex(buffer, cnt);
-    }
+    if (MySQLppConnection* connection = bulkLoadConnection())
+        return loadBuffer(*connection, table.name(), buffer, 0, buffer->size(), token);
 
-    logdbg  << "DBInterface: insertBuffer: ending bind transactions";
-    current_connection_->endBindTransaction();
-    logdbg  << "DBInterface: insertBuffer: finalizing bind statement";
-    current_connection_->finalizeBindStatement();
+    logdbg  << "DBInterface: insertBuffer: executing bind statement";
+    return executeBindStatement("insert", bind_statement, buffer, 0, buffer->size(), token);
 }
 
 void DBInterface::insertBuffer (const std::string& table_name, std::shared_ptr<Buffer> buffer)
@@ -1128,22 +1141,14 @@ void DBInterface::insertBuffer (const std::string& table_name, std::shared_ptr<B
 
     QMutexLocker locker(&connection_mutex_);
 
-    logdbg  << "DBInterface: insertBuffer: preparing bind statement";
-    current_connection_->prepareBindStatement(bind_statement);
-    current_connection_->beginBindTransaction();
-
-    logdbg  << "DBInterface: insertBuffer: starting inserts";
-    size_t size = buffer->size();
-
-    for (unsigned int cnt=0; cnt < size; ++cnt)
+    if (MySQLppConnection* connection = bulkLoadConnection())
     {
-        insertBindStatementUpdateForCurrentIndex(buffer, cnt);
+        loadBuffer(*connection, table_name, buffer, 0, buffer->size());
+        return;
     }
 
-    logdbg  << "DBInterface: insertBuffer: ending bind transactions";
-    current_connection_->endBindTransaction();
-    logdbg  << "DBInterface: insertBuffer: finalizing bind statement";
-    current_connection_->finalizeBindStatement();
+    logdbg  << "DBInterface: insertBuffer: executing bind statement";
+    executeBindStatement("insert", bind_statement, buffer, 0, buffer->size());
 }
 
 std::shared_ptr<Buffer> DBInterface::getPartialBuffer (DBTable& table, std::shared_ptr<Buffer> buffer)
@@ -1217,15 +1222,16 @@ bool DBInterface::checkUpdateBuffer (DBObject &object, DBOVariable &key_var, DBO
     return true;
 }
 
-void DBInterface::updateBuffer (MetaDBTable& meta_table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
-                                int from_index, int to_index)
+bool DBInterface::updateBuffer (MetaDBTable& meta_table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
+                                int from_index, int to_index, const CancellationToken* token)
 {
     logdbg << "DBInterface: updateBuffer: meta " << meta_table.name() << " buffer size " << buffer->size()
            << " key " << key_col.identifier();
 
     std::shared_ptr<Buffer> partial_buffer = getPartialBuffer(meta_table.mainTable(), buffer);
     assert (partial_buffer->size());
-    updateBuffer(meta_table.mainTable(), key_col, partial_buffer, from_index, to_index);
+    if (!updateBuffer(meta_table.mainTable(), key_col, partial_buffer, from_index, to_index, token))
+        return false;
 
     for (auto& sub_it : meta_table.subTables())
     {
@@ -1239,7 +1245,8 @@ void DBInterface::updateBuffer (MetaDBTable& meta_table, const DBTableColumn& ke
             if (partial_buffer->size())
             {
                 logdbg << "DBInterface: updateBuffer: doing update for sub table " << sub_it.second.name();
-                updateBuffer(sub_it.second, sub_key_col, partial_buffer, from_index, to_index);
+                if (!updateBuffer(sub_it.second, sub_key_col, partial_buffer, from_index, to_index, token))
+                    return false;
             }
             else
                 logdbg << "DBInterface: updateBuffer: empty buffer for sub table " << sub_it.second.name();
@@ -1247,10 +1254,12 @@ void DBInterface::updateBuffer (MetaDBTable& meta_table, const DBTableColumn& ke
         else
             logdbg << "DBInterface: updateBuffer: key not found in sub table " << sub_it.second.name();
     }
+
+    return true;
 }
 
-void DBInterface::updateBuffer (DBTable& table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
-                                int from_index, int to_index)
+bool DBInterface::updateBuffer (DBTable& table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
+                                int from_index, int to_index, const CancellationToken* token)
 {
     logdbg << "DBInterface: updateBuffer: table " << table.name() << " buffer size " << buffer->size()
            << " key " << key_col.identifier();
@@ -1272,26 +1281,132 @@ void DBInterface::updateBuffer (DBTable& table, const DBTableColumn& key_col, st
 
     QMutexLocker locker(&connection_mutex_);
 
-    logdbg  << "DBInterface: updateBuffer: preparing bind statement '" << bind_statement << "'";
-    current_connection_->prepareBindStatement(bind_statement);
-    current_connection_->beginBindTransaction();
-
     if (from_index < 0)
         from_index = 0;
     if (to_index < 0)
         to_index = buffer->size()-1;
 
-    logdbg  << "DBInterface: updateBuffer: starting inserts";
-    for (int cnt=from_index; cnt <= to_index; cnt++)
+    logdbg  << "DBInterface: updateBuffer: executing bind statement '" << bind_statement << "'";
+    return executeBindStatement("update", bind_statement, buffer, from_index, to_index+1, token);
+}
+
+bool DBInterface::executeBindStatement (const std::string& type, const std::string& bind_statement,
+                                        std::shared_ptr<Buffer> buffer, size_t from_index, size_t end_index,
+                                        const CancellationToken* token)
+{
+    assert (current_connection_);
+    assert (buffer);
+
+    bool profile = profile_queries_; // might be changed during execution
+    size_t hash {0};
+    boost::posix_time::ptime start_time;
+
+    if (profile)
+    {
+        hash = profiler_.begin(type, bind_statement);
+        start_time = DBQueryProfiler::now();
+    }
+
+    current_connection_->prepareBindStatement(bind_statement);
+    current_connection_->beginBindTransaction();
+
+    if (profile)
     {
-        logdbg  << "DBInterface: updateBuffer: insert cnt " << cnt;
+        profiler_.addPrepare(hash, DBQueryProfiler::secondsSince(start_time));
+        start_time = DBQueryProfiler::now();
+        bind_step_time_ = 0;
+    }
+
+    const size_t cancel_check_rows = 1000; // cancellation is checked in between, a few ms of work
+
+    for (size_t cnt=from_index; cnt < end_index; ++cnt)
+    {
+        if (token && (cnt-from_index) % cancel_check_rows == 0 && token->cancelled())
+        {
+            loginf << "DBInterface: executeBindStatement: " << type << " cancelled after " << cnt-from_index
+                   << " rows, rolling back";
+
+            current_connection_->abortBindTransaction();
+            current_connection_->finalizeBindStatement();
+
+            return false;
+        }
+
         insertBindStatementUpdateForCurrentIndex(buffer, cnt);
     }
 
-    logdbg  << "DBInterface: updateBuffer: ending bind transactions";
-    current_connection_->endBindTransaction();
-    logdbg  << "DBInterface: update: finalizing bind statement";
+    if (profile)
+    {
+        double bind_time = DBQueryProfiler::secondsSince(start_time);
+
+        start_time = DBQueryProfiler::now();
+        current_connection_->endBindTransaction();
+        double commit_time = DBQueryProfiler::secondsSince(start_time);
+
+        // everything except stepping is the conversion of the buffer values into bound variables
+        profiler_.addChunk(hash, bind_step_time_+commit_time, bind_time-bind_step_time_, end_index-from_index,
+                           end_index > from_index ? buffer->memoryUsage()*(end_index-from_index)/buffer->size() : 0);
+    }
+    else
+        current_connection_->endBindTransaction();
+
     current_connection_->finalizeBindStatement();
+
+    return true;
+}
+
+void DBInterface::beginImport ()
+{
+    QMutexLocker locker(&connection_mutex_);
+
+    if (MySQLppConnection* connection = bulkLoadConnection())
+        connection->beginImport();
+}
+
+void DBInterface::endImport ()
+{
+    QMutexLocker locker(&connection_mutex_);
+
+    if (MySQLppConnection* connection = bulkLoadConnection())
+        connection->endImport();
+}
+
+MySQLppConnection* DBInterface::bulkLoadConnection ()
+{
+    assert (current_connection_);
+
+    if (current_connection_->type() != MYSQL_IDENTIFIER)
+        return nullptr;
+
+    MySQLppConnection* connection = dynamic_cast<MySQLppConnection*> (current_connection_);
+    assert (connection);
+
+    return connection->bulkLoad() ? connection : nullptr;
+}
+
+bool DBInterface::loadBuffer (MySQLppConnection& connection, const std::string& table_name,
+                              std::shared_ptr<Buffer> buffer, size_t from_index, size_t end_index,
+                              const CancellationToken* token)
+{
+    assert (buffer);
+
+    if (!profile_queries_)
+        return connection.loadBuffer(table_name, buffer, from_index, end_index, token);
+
+    size_t hash = profiler_.begin("load", "LOAD DATA LOCAL INFILE INTO TABLE "+table_name);
+    boost::posix_time::ptime start_time = DBQueryProfiler::now();
+
+    connection.profileConversion(true); // serialisation of the buffer into text
+    bool ret = connection.loadBuffer(table_name, buffer, from_index, end_index, token);
+
+    double conversion_time = connection.takeConversionTime();
+    connection.profileConversion(false);
+
+    profiler_.addChunk(hash, DBQueryProfiler::secondsSince(start_time)-conversion_time, conversion_time,
+                       end_index-from_index,
+                       end_index > from_index ? buffer->memoryUsage()*(end_index-from_index)/buffer->size() : 0);
+
+    return ret;
 }
 
 void DBInterface::prepareRead (const DBObject &dbobject, DBOVariableSet read_list, std::string custom_filter_clause,
@@ -1318,7 +1433,25 @@ void DBInterface::prepareRead (const DBObject &dbobject, DBOVariableSet read_lis
                 order_variable, use_order_ascending, limit, true);
 
     loginf  << "DBInterface: prepareRead: dbo " << dbobject.name() << " sql '" << read->get() << "'";
-    current_connection_->prepareCommand(read);
+
+    read_profile_hash_ = 0;
+
+    if (profile_queries_)
+    {
+        read_profile_hash_ = profiler_.begin("read", read->get());
+
+        // before prepareCommand, since the connection can not execute other statements while reading
+        if (explain_queries_ && !profiler_.hasPlan(read_profile_hash_))
+            profiler_.setPlan(read_profile_hash_, current_connection_->queryPlan(read->get()));
+
+        boost::posix_time::ptime start_time = DBQueryProfiler::now();
+        current_connection_->prepareCommand(read);
+        profiler_.addPrepare(read_profile_hash_, DBQueryProfiler::secondsSince(start_time));
+    }
+    else
+        current_connection_->prepareCommand(read);
+
+    current_connection_->profileConversion(read_profile_hash_ != 0);
 }
 
 /**
@@ -1329,6 +1462,11 @@ std::shared_ptr <Buffer> DBInterface::readDataChunk (const DBObject &dbobject)
     // locked by prepareRead
     assert (current_connection_);
 
+    boost::posix_time::ptime start_time;
+
+    if (read_profile_hash_)
+        start_time = DBQueryProfiler::now();
+
     std::shared_ptr <DBResult> result = current_connection_->stepPreparedCommand(read_chunk_size_);
 
     if (!result)
@@ -1352,18 +1490,37 @@ std::shared_ptr <Buffer> DBInterface::readDataChunk (const DBObject &dbobject)
     bool last_one = current_connection_->getPreparedCommandDone();
     buffer->lastOne (last_one);
 
+    if (read_profile_hash_)
+    {
+        double total_time = DBQueryProfiler::secondsSince(start_time);
+        double conversion_time = current_connection_->takeConversionTime();
+
+        profiler_.addChunk(read_profile_hash_, total_time-conversion_time, conversion_time, buffer->size(),
+                           buffer->memoryUsage());
+    }
+
     return buffer;
 }
 
 
 void DBInterface::finalizeReadStatement (const DBObject &dbobject)
 {
-    connection_mutex_.unlock();
     assert (current_connection_);
 
     logdbg  << "DBInterface: finishReadSystemTracks: start ";
     //prepared_.at(dbobject.name())=false;
     current_connection_->finalizeCommand();
+    current_connection_->profileConversion(false);
+
+    // unlocked after finalizing, so that a late interrupt can not hit the next statement
+    connection_mutex_.unlock();
+}
+
+void DBInterface::interruptQuery ()
+{
+    // not locked, since the connection is held by the read to be interrupted
+    assert (current_connection_);
+    current_connection_->interrupt();
 }
 
 void DBInterface::createPropertiesTable ()
@@ -1404,6 +1561,41 @@ std::shared_ptr<DBResult> DBInterface::queryMinMaxNormalForTable (const DBTable&
     return result;
 }
 
+std::shared_ptr<DBResult> DBInterface::queryColumnStatistics (const std::string& table_name,
+                                                              const std::string& column_name)
+{
+    QMutexLocker locker(&connection_mutex_);
+
+    std::shared_ptr <DBCommand> command = sql_generator_.getColumnStatisticsCommand (table_name, column_name);
+
+    logdbg << "DBInterface: queryColumnStatistics: sql '" << command->get() << "'";
+    return current_connection_->execute(*command);
+}
+
+std::shared_ptr<DBResult> DBInterface::queryColumnHistogram (const std::string& table_name,
+                                                             const std::string& column_name, double min,
+                                                             double bin_width)
+{
+    QMutexLocker locker(&connection_mutex_);
+
+    std::shared_ptr <DBCommand> command = sql_generator_.getColumnHistogramCommand (table_name, column_name, min,
+                                                                                     bin_width);
+
+    logdbg << "DBInterface: queryColumnHistogram: sql '" << command->get() << "'";
+    return current_connection_->execute(*command);
+}
+
+std::shared_ptr<DBResult> DBInterface::queryColumnTopValues (const std::string& table_name,
+                                                             const std::string& column_name, unsigned int limit)
+{
+    QMutexLocker locker(&connection_mutex_);
+
+    std::shared_ptr <DBCommand> command = sql_generator_.getColumnTopValuesCommand (table_name, column_name, limit);
+
+    logdbg << "DBInterface: queryColumnTopValues: sql '" << command->get() << "'";
+    return current_connection_->execute(*command);
+}
+
 void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row)
 {
     assert (buffer);
@@ -1455,6 +1647,14 @@ void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buff
             current_connection_->bindVariable (index_cnt,
                                                static_cast<int> (buffer->get<unsigned char>(property.name()).get(row)));
             break;
+        case PropertyDataType::SHORTINT:
+            current_connection_->bindVariable (index_cnt,
+                                               static_cast<int> (buffer->get<short int>(property.name()).get(row)));
+            break;
+        case PropertyDataType::USHORTINT:
+            current_connection_->bindVariable (
+                        index_cnt, static_cast<int> (buffer->get<unsigned short int>(property.name()).get(row)));
+            break;
         case PropertyDataType::INT:
             logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: at " << cnt << " is '"
                     << buffer->get<int>(property.name()).get(row) << "'";
@@ -1477,6 +1677,9 @@ void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buff
         case PropertyDataType::DOUBLE:
             current_connection_->bindVariable (index_cnt, buffer->get<double>(property.name()).get(row));
             break;
+        case PropertyDataType::TIMESTAMP:
+            current_connection_->bindVariable (index_cnt, buffer->get<Timestamp>(property.name()).get(row).seconds());
+            break;
         case PropertyDataType::STRING:
             if (connection_type == SQLITE_IDENTIFIER)
                 current_connection_->bindVariable (index_cnt, buffer->get<std::string>(property.name()).get(row));
@@ -1491,7 +1694,14 @@ void DBInterface::insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buff
         }
     }
 
-    current_connection_->stepAndClearBindings();
+    if (profile_queries_)
+    {
+        boost::posix_time::ptime start_time = DBQueryProfiler::now();
+        current_connection_->stepAndClearBindings();
+        bind_step_time_ += DBQueryProfiler::secondsSince(start_time);
+    }
+    else
+        current_connection_->stepAndClearBindings();
 
     logdbg  << "DBInterface: insertBindStatementUpdateForCurrentIndex: done";
 }
@@ -1506,6 +1716,35 @@ void DBInterface::createAssociationsTable (const std::string &table_name)
     updateTableInfo ();
 }
 
+void DBInterface::createIndex (const std::string& table_name, const std::string& column_name)
+{
+    std::string index_name = table_name+"_"+column_name+"_index";
+
+    loginf << "DBInterface: createIndex: " << index_name;
+
+    QMutexLocker locker(&connection_mutex_);
+
+    try
+    {
+        current_connection_->executeSQL(sql_generator_.getCreateIndexStatement(table_name, column_name, index_name));
+    }
+    catch (std::exception& e)
+    {
+        std::string message = e.what();
+
+        // MySQL has no IF NOT EXISTS for indexes, fails with ER_DUP_KEYNAME
+        if (message.find("Duplicate key name") != std::string::npos
+                || message.find("already exists") != std::string::npos)
+        {
+            loginf << "DBInterface: createIndex: " << index_name << " already exists";
+            return;
+        }
+
+        logerr << "DBInterface: createIndex: " << index_name << " failed: " << message;
+        throw;
+    }
+}
+
 DBOAssociationCollection DBInterface::getAssociations (const std::string &table_name)
 {
     assert (existsTable(table_name));
@@ -28,6 +28,7 @@
 #include "dbovariableset.h"
 #include "sqlgenerator.h"
 #include "dboassociationentry.h"
+#include "dbqueryprofiler.h"
 
 static const std::string ACTIVE_DATA_SOURCES_PROPERTY_PREFIX="activeDataSources_";
 static const std::string TABLE_NAME_PROPERTIES = "atsdb_properties";
@@ -36,6 +37,7 @@ static const std::string TABLE_NAME_MINMAX = "atsdb_minmax";
 class ATSDB;
 class Buffer;
 class BufferWriter;
+class CancellationToken;
 class DBConnection;
 class DBOVariable;
 class DBTable;
@@ -49,6 +51,7 @@ class DBInterfaceWidget;
 class DBInterfaceInfoWidget;
 class Job;
 class BufferWriter;
+class MySQLppConnection;
 
 class SQLGenerator;
 class QWidget;
@@ -117,16 +120,26 @@ public:
     //    void writeBuffer (Buffer *data, std::string table_name);
 //    void insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer, size_t from_index,
 //                       size_t to_index);
-    void insertBuffer (MetaDBTable& meta_table, std::shared_ptr<Buffer> buffer);
-    void insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer);
+    /// @brief Inserts buffer, returns false if cancelled by token (transaction of current table rolled back)
+    bool insertBuffer (MetaDBTable& meta_table, std::shared_ptr<Buffer> buffer,
+                       const CancellationToken* token=nullptr);
+    bool insertBuffer (DBTable& table, std::shared_ptr<Buffer> buffer, const CancellationToken* token=nullptr);
     void insertBuffer (const std::string& table_name, std::shared_ptr<Buffer> buffer);
 
+    /// @brief Starts an import, index updates of bulk loaded tables may be deferred until endImport
+    void beginImport ();
+    /// @brief Ends an import, to be called once all its inserts are done, also if cancelled or failed
+    void endImport ();
+
     bool checkUpdateBuffer (DBObject &object, DBOVariable &key_var, DBOVariableSet& list,
                             std::shared_ptr<Buffer> buffer);
-    void updateBuffer (MetaDBTable& meta_table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
-                       int from_index=-1, int to_index=-1); // no indexes means full buffer
-    void updateBuffer (DBTable& table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
-                       int from_index=-1, int to_index=-1); // no indexes means full buffer
+    /// @brief Updates buffer rows, returns false if cancelled by token (transaction of current table rolled back)
+    bool updateBuffer (MetaDBTable& meta_table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
+                       int from_index=-1, int to_index=-1, // no indexes means full buffer
+                       const CancellationToken* token=nullptr);
+    bool updateBuffer (DBTable& table, const DBTableColumn& key_col, std::shared_ptr<Buffer> buffer,
+                       int from_index=-1, int to_index=-1, // no indexes means full buffer
+                       const CancellationToken* token=nullptr);
 
     std::shared_ptr<Buffer> getPartialBuffer (DBTable& table, std::shared_ptr<Buffer> buffer);
 
@@ -139,6 +152,8 @@ public:
     std::shared_ptr <Buffer> readDataChunk (const DBObject &dbobject);
     /// @brief Cleans up incremental read of DBO type
     void finalizeReadStatement (const DBObject &dbobject);
+    /// @brief Aborts the running read, next readDataChunk returns last one. Does not lock, callable from any thread.
+    void interruptQuery ();
     /// @brief Sets reading_done_ flags
     //void clearResult ();
 
@@ -191,6 +206,14 @@ public:
 
     /// @brief Returns minimum/maximum information for all columns in a table
     std::shared_ptr<DBResult> queryMinMaxNormalForTable (const DBTable& table);
+    /// @brief Returns count, not null count, distinct count, minimum and maximum of a column
+    std::shared_ptr<DBResult> queryColumnStatistics (const std::string& table_name, const std::string& column_name);
+    /// @brief Returns not null value counts per bin of a numeric column
+    std::shared_ptr<DBResult> queryColumnHistogram (const std::string& table_name, const std::string& column_name,
+                                                    double min, double bin_width);
+    /// @brief Returns the limit most frequent values of a column and their counts
+    std::shared_ptr<DBResult> queryColumnTopValues (const std::string& table_name, const std::string& column_name,
+                                                    unsigned int limit);
     //    /// @brief Returns minimum/maximum information for a given column in a table
     //    DBResult *queryMinMaxForColumn (DBTableColumn *column, std::string table);
 
@@ -209,8 +232,18 @@ public:
     //            bool has_tod, double tod_min, double tod_max);
 
     void createAssociationsTable (const std::string& table_name);
+    /// @brief Creates index on column if not existing, throws if creation fails for another reason
+    void createIndex (const std::string& table_name, const std::string& column_name);
     DBOAssociationCollection getAssociations (const std::string& table_name);
 
+    bool profileQueries () const { return profile_queries_; }
+    void profileQueries (bool value);
+    /// @brief Returns if query plans are captured for profiled select statements
+    bool explainQueries () const { return explain_queries_; }
+    void explainQueries (bool value) { explain_queries_ = value; }
+
+    DBQueryProfiler& profiler () { return profiler_; }
+
 protected:
     std::map <std::string, DBConnection*> connections_;
 
@@ -241,9 +274,32 @@ protected:
 
     std::map <std::string, std::string> properties_;
 
+    /// Statement profiling, set by profile_queries parameter
+    bool profile_queries_ {false};
+    bool explain_queries_ {false};
+    DBQueryProfiler profiler_;
+    /// Hash of the profiled prepared read statement
+    size_t read_profile_hash_ {0};
+    /// Accumulated stepAndClearBindings time of the current bind statement
+    double bind_step_time_ {0};
+
     virtual void checkSubConfigurables ();
 
     void insertBindStatementUpdateForCurrentIndex (std::shared_ptr<Buffer> buffer, unsigned int row);
+    /// @brief Executes bind statement for rows [from_index, end_index) of buffer, connection has to be locked
+    ///
+    /// Returns false and rolls back the transaction if the token was cancelled.
+    bool executeBindStatement (const std::string& type, const std::string& bind_statement,
+                               std::shared_ptr<Buffer> buffer, size_t from_index, size_t end_index,
+                               const CancellationToken* token=nullptr);
+
+    /// @brief Returns current connection if buffers are inserted using the MySQL bulk loader, nullptr otherwise
+    MySQLppConnection* bulkLoadConnection ();
+    /// @brief Inserts rows [from_index, end_index) of buffer using the bulk loader, connection has to be locked
+    ///
+    /// Returns false and rolls back if the token was cancelled.
+    bool loadBuffer (MySQLppConnection& connection, const std::string& table_name, std::shared_ptr<Buffer> buffer,
+                     size_t from_index, size_t end_index, const CancellationToken* token=nullptr);
 
     void setPostProcessed (bool value);
     //    /// @brief Returns buffer with min/max data from another Buffer with the string contents. Delete returned buffer yourself.
@@ -15,9 +15,15 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QCheckBox>
+#include <QFileDialog>
 #include <QGridLayout>
 #include <QHBoxLayout>
+#include <QHeaderView>
 #include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
 #include <QTextEdit>
 
 #include "atsdb.h"
@@ -41,6 +47,50 @@ DBInterfaceInfoWidget::DBInterfaceInfoWidget(DBInterface &interface, QWidget* pa
     setLineWidth(frame_width);
 
     layout_ = new QVBoxLayout ();
+
+    QLabel* profile_label = new QLabel ("Query Profiling");
+    profile_label->setFont(font_bold);
+    layout_->addWidget(profile_label);
+
+    QHBoxLayout* profile_layout = new QHBoxLayout ();
+
+    profile_check_ = new QCheckBox ("Profile Queries");
+    profile_check_->setChecked(interface_.profileQueries());
+    connect (profile_check_, SIGNAL(toggled(bool)), this, SLOT(toggleProfileQueriesSlot()));
+    profile_layout->addWidget(profile_check_);
+
+    explain_check_ = new QCheckBox ("Capture Query Plans");
+    explain_check_->setChecked(interface_.explainQueries());
+    connect (explain_check_, SIGNAL(toggled(bool)), this, SLOT(toggleExplainQueriesSlot()));
+    profile_layout->addWidget(explain_check_);
+
+    profile_layout->addStretch();
+
+    QPushButton* update_button = new QPushButton ("Update");
+    connect (update_button, SIGNAL(clicked()), this, SLOT(updateProfilesSlot()));
+    profile_layout->addWidget(update_button);
+
+    QPushButton* clear_button = new QPushButton ("Clear");
+    connect (clear_button, SIGNAL(clicked()), this, SLOT(clearProfilesSlot()));
+    profile_layout->addWidget(clear_button);
+
+    QPushButton* save_button = new QPushButton ("Save as JSON");
+    connect (save_button, SIGNAL(clicked()), this, SLOT(saveProfilesSlot()));
+    profile_layout->addWidget(save_button);
+
+    layout_->addLayout(profile_layout);
+
+    QStringList header;
+    header << "Type" << "Hash" << "Executions" << "Rows" << "MB" << "Prepare (s)" << "Step (s)" << "Conversion (s)"
+           << "Total (s)" << "Plan";
+
+    profile_table_ = new QTableWidget ();
+    profile_table_->setColumnCount(header.size());
+    profile_table_->setHorizontalHeaderLabels(header);
+    profile_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    profile_table_->horizontalHeader()->setStretchLastSection(true);
+    layout_->addWidget(profile_table_);
+
     setLayout (layout_);
 
     connect (&interface_, SIGNAL(databaseContentChangedSignal()), this, SLOT(databaseContentChangedSlot()));
@@ -54,6 +104,72 @@ DBInterfaceInfoWidget::~DBInterfaceInfoWidget()
 void DBInterfaceInfoWidget::databaseContentChangedSlot ()
 {
     assert (layout_);
-    layout_->addWidget(interface_.connection().infoWidget());
+    layout_->insertWidget(0, interface_.connection().infoWidget());
     layout_->addStretch();
 }
+
+void DBInterfaceInfoWidget::toggleProfileQueriesSlot ()
+{
+    assert (profile_check_);
+    interface_.profileQueries(profile_check_->checkState() == Qt::Checked);
+}
+
+void DBInterfaceInfoWidget::toggleExplainQueriesSlot ()
+{
+    assert (explain_check_);
+    interface_.explainQueries(explain_check_->checkState() == Qt::Checked);
+}
+
+void DBInterfaceInfoWidget::updateProfilesSlot ()
+{
+    assert (profile_table_);
+
+    std::vector<DBQueryProfile> profiles = interface_.profiler().profiles();
+
+    profile_table_->setRowCount(profiles.size());
+
+    int row = 0;
+    for (auto& profile : profiles)
+    {
+        std::vector<QString> values {profile.type_.c_str(), QString::number(profile.hash_, 16),
+                    QString::number(profile.executions_), QString::number(profile.rows_),
+                    QString::number(profile.bytes_/1e6, 'f', 1), QString::number(profile.prepare_time_, 'f', 3),
+                    QString::number(profile.step_time_, 'f', 3), QString::number(profile.conversion_time_, 'f', 3),
+                    QString::number(profile.totalTime(), 'f', 3), profile.plan_.c_str()};
+
+        for (unsigned int col=0; col < values.size(); ++col)
+        {
+            QTableWidgetItem* item = new QTableWidgetItem (values.at(col));
+            item->setToolTip(profile.sql_.c_str());
+            profile_table_->setItem(row, col, item);
+        }
+        ++row;
+    }
+
+    profile_table_->resizeColumnsToContents();
+}
+
+void DBInterfaceInfoWidget::clearProfilesSlot ()
+{
+    interface_.profiler().clear();
+    updateProfilesSlot();
+}
+
+void DBInterfaceInfoWidget::saveProfilesSlot ()
+{
+    QString file_name = QFileDialog::getSaveFileName(this, "Save Query Profiles as JSON", "",
+                                                     tr("JSON (*.json);;All Files (*)"));
+
+    if (!file_name.size())
+        return;
+
+    try
+    {
+        interface_.profiler().saveJSON(file_name.toStdString());
+    }
+    catch (std::exception& e)
+    {
+        QMessageBox m_warning (QMessageBox::Warning, "Saving Query Profiles Failed", e.what(), QMessageBox::Ok);
+        m_warning.exec();
+    }
+}
@@ -23,6 +23,8 @@
 
 class DBInterface;
 class QVBoxLayout;
+class QCheckBox;
+class QTableWidget;
 
 /**
  * @brief Widget for choosing a database system and parameters
@@ -35,6 +37,12 @@ public slots:
     //void update ();
     void databaseContentChangedSlot ();
 
+    void toggleProfileQueriesSlot ();
+    void toggleExplainQueriesSlot ();
+    void updateProfilesSlot ();
+    void clearProfilesSlot ();
+    void saveProfilesSlot ();
+
 public:
     /// @brief Constructor
     explicit DBInterfaceInfoWidget(DBInterface &interface, QWidget* parent = 0, Qt::WindowFlags f = 0);
@@ -44,6 +52,10 @@ public:
 protected:
     DBInterface &interface_;
     QVBoxLayout *layout_;
+
+    QCheckBox* profile_check_ {nullptr};
+    QCheckBox* explain_check_ {nullptr};
+    QTableWidget* profile_table_ {nullptr};
 };
 
 #endif /* DBINTERFACEINFOWIDGET_H_ */
@@ -0,0 +1,149 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+
+#include <QMutexLocker>
+
+#include "dbqueryprofiler.h"
+#include "logger.h"
+
+size_t DBQueryProfiler::begin (const std::string& type, const std::string& sql)
+{
+    size_t hash = std::hash<std::string>{}(sql);
+
+    QMutexLocker locker(&mutex_);
+
+    DBQueryProfile& profile = profiles_[hash];
+
+    if (!profile.executions_)
+    {
+        profile.hash_ = hash;
+        profile.type_ = type;
+        profile.sql_ = sql;
+    }
+
+    ++profile.executions_;
+
+    return hash;
+}
+
+void DBQueryProfiler::addPrepare (size_t hash, double seconds)
+{
+    QMutexLocker locker(&mutex_);
+    assert (profiles_.count(hash));
+
+    profiles_.at(hash).prepare_time_ += seconds;
+}
+
+void DBQueryProfiler::addChunk (size_t hash, double step_seconds, double conversion_seconds, size_t rows,
+                                size_t bytes)
+{
+    QMutexLocker locker(&mutex_);
+    assert (profiles_.count(hash));
+
+    DBQueryProfile& profile = profiles_.at(hash);
+
+    ++profile.chunks_;
+    profile.step_time_ += step_seconds;
+    profile.conversion_time_ += conversion_seconds;
+    profile.rows_ += rows;
+    profile.bytes_ += bytes;
+}
+
+bool DBQueryProfiler::hasPlan (size_t hash)
+{
+    QMutexLocker locker(&mutex_);
+    return profiles_.count(hash) && profiles_.at(hash).plan_.size();
+}
+
+void DBQueryProfiler::setPlan (size_t hash, const std::string& plan)
+{
+    QMutexLocker locker(&mutex_);
+    assert (profiles_.count(hash));
+
+    profiles_.at(hash).plan_ = plan;
+}
+
+std::vector<DBQueryProfile> DBQueryProfiler::profiles ()
+{
+    std::vector<DBQueryProfile> profiles;
+
+    {
+        QMutexLocker locker(&mutex_);
+
+        for (auto& prof_it : profiles_)
+            profiles.push_back(prof_it.second);
+    }
+
+    std::sort (profiles.begin(), profiles.end(), [](const DBQueryProfile& a, const DBQueryProfile& b)
+    { return a.totalTime() > b.totalTime(); });
+
+    return profiles;
+}
+
+void DBQueryProfiler::clear ()
+{
+    QMutexLocker locker(&mutex_);
+    profiles_.clear();
+}
+
+nlohmann::json DBQueryProfiler::toJSON ()
+{
+    nlohmann::json j = nlohmann::json::array();
+
+    for (auto& profile : profiles())
+    {
+        nlohmann::json entry;
+
+        entry["hash"] = profile.hash_;
+        entry["type"] = profile.type_;
+        entry["sql"] = profile.sql_;
+        entry["executions"] = profile.executions_;
+        entry["chunks"] = profile.chunks_;
+        entry["rows"] = profile.rows_;
+        entry["bytes"] = profile.bytes_;
+        entry["prepare_time"] = profile.prepare_time_;
+        entry["step_time"] = profile.step_time_;
+        entry["conversion_time"] = profile.conversion_time_;
+        entry["total_time"] = profile.totalTime();
+
+        if (profile.plan_.size())
+            entry["plan"] = profile.plan_;
+
+        j.push_back(entry);
+    }
+
+    return j;
+}
+
+void DBQueryProfiler::saveJSON (const std::string& filename)
+{
+    loginf << "DBQueryProfiler: saveJSON: file '" << filename << "'";
+
+    std::ofstream file (filename);
+
+    if (!file)
+    {
+        logerr << "DBQueryProfiler: saveJSON: unable to open file '" << filename << "'";
+        throw std::runtime_error ("DBQueryProfiler: saveJSON: unable to open file '"+filename+"'");
+    }
+
+    file << toJSON().dump(4);
+}
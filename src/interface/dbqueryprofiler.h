@@ -0,0 +1,96 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBQUERYPROFILER_H
+#define DBQUERYPROFILER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QMutex>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+#include "json.hpp"
+
+/**
+ * @brief Accumulated timing information of one SQL statement
+ *
+ * Times are in seconds. Step time is the time spent in the database library, conversion time the time spent
+ * reading result rows into (or binding values from) a Buffer.
+ */
+struct DBQueryProfile
+{
+    size_t hash_ {0};
+    std::string type_;
+    std::string sql_;
+
+    unsigned int executions_ {0};
+    unsigned int chunks_ {0};
+    size_t rows_ {0};
+    size_t bytes_ {0};
+
+    double prepare_time_ {0};
+    double step_time_ {0};
+    double conversion_time_ {0};
+
+    std::string plan_;
+
+    double totalTime () const { return prepare_time_ + step_time_ + conversion_time_; }
+};
+
+/**
+ * @brief Collects DBQueryProfile entries for all statements executed by the DBInterface
+ *
+ * Statements are identified by the hash of their SQL text. Thread-safe, since the statistics are shown in the
+ * GUI thread while reads and inserts are performed in jobs.
+ */
+class DBQueryProfiler
+{
+public:
+    DBQueryProfiler() {}
+    virtual ~DBQueryProfiler() {}
+
+    /// @brief Registers an execution of the given statement, returns its hash
+    size_t begin (const std::string& type, const std::string& sql);
+
+    void addPrepare (size_t hash, double seconds);
+    void addChunk (size_t hash, double step_seconds, double conversion_seconds, size_t rows, size_t bytes);
+
+    bool hasPlan (size_t hash);
+    void setPlan (size_t hash, const std::string& plan);
+
+    /// @brief Returns copy of all profiles, sorted by descending total time
+    std::vector<DBQueryProfile> profiles ();
+    void clear ();
+
+    nlohmann::json toJSON ();
+    void saveJSON (const std::string& filename);
+
+    static boost::posix_time::ptime now () { return boost::posix_time::microsec_clock::universal_time(); }
+    static double secondsSince (const boost::posix_time::ptime& start)
+    {
+        return (now() - start).total_microseconds() / 1e6;
+    }
+
+protected:
+    QMutex mutex_;
+    std::map<size_t, DBQueryProfile> profiles_;
+};
+
+#endif // DBQUERYPROFILER_H
@@ -302,6 +302,21 @@ std::string SQLGenerator::getCreateAssociationTableStatement (const std::string&
     return ss.str();
 }
 
+std::string SQLGenerator::getCreateIndexStatement (const std::string& table_name, const std::string& column_name,
+                                                   const std::string& index_name)
+{
+    std::stringstream ss;
+
+    ss << "CREATE INDEX ";
+
+    if (db_interface_.connection().type() == SQLITE_IDENTIFIER)
+        ss << "IF NOT EXISTS ";
+
+    ss << index_name << " ON " << table_name << " (" << column_name << ");";
+
+    return ss.str();
+}
+
 std::shared_ptr<DBCommand> SQLGenerator::getSelectAssociationsCommand (const std::string& table_name)
 {
     std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
@@ -322,6 +337,76 @@ std::shared_ptr<DBCommand> SQLGenerator::getSelectAssociationsCommand (const std
     return command;
 }
 
+std::shared_ptr<DBCommand> SQLGenerator::getColumnStatisticsCommand (const std::string& table_name,
+                                                                     const std::string& column_name)
+{
+    std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
+
+    std::stringstream ss;
+
+    ss << "SELECT COUNT(*), COUNT(" << column_name << "), COUNT(DISTINCT " << column_name << "), MIN("
+       << column_name << "), MAX(" << column_name << ") FROM " << table_name << ";";
+
+    PropertyList property_list;
+    property_list.addProperty("count", PropertyDataType::UINT);
+    property_list.addProperty("not_null_count", PropertyDataType::UINT);
+    property_list.addProperty("distinct_count", PropertyDataType::UINT);
+    property_list.addProperty("min", PropertyDataType::STRING);
+    property_list.addProperty("max", PropertyDataType::STRING);
+
+    command->set(ss.str());
+    command->list(property_list);
+
+    return command;
+}
+
+std::shared_ptr<DBCommand> SQLGenerator::getColumnHistogramCommand (const std::string& table_name,
+                                                                    const std::string& column_name,
+                                                                    double min, double bin_width)
+{
+    assert (bin_width > 0);
+
+    std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
+
+    std::string integer_type = db_interface_.connection().type() == MYSQL_IDENTIFIER ? "SIGNED" : "INTEGER";
+
+    std::stringstream ss;
+
+    ss << std::setprecision(15) << "SELECT CAST((" << column_name << " - " << min << ") / " << bin_width << " AS "
+       << integer_type << ") AS bin, COUNT(*) FROM " << table_name << " WHERE " << column_name
+       << " IS NOT NULL GROUP BY bin;";
+
+    PropertyList property_list;
+    property_list.addProperty("bin", PropertyDataType::INT);
+    property_list.addProperty("count", PropertyDataType::UINT);
+
+    command->set(ss.str());
+    command->list(property_list);
+
+    return command;
+}
+
+std::shared_ptr<DBCommand> SQLGenerator::getColumnTopValuesCommand (const std::string& table_name,
+                                                                    const std::string& column_name,
+                                                                    unsigned int limit)
+{
+    std::shared_ptr<DBCommand> command = std::make_shared<DBCommand>(DBCommand());
+
+    std::stringstream ss;
+
+    ss << "SELECT " << column_name << ", COUNT(*) AS value_count FROM " << table_name << " WHERE " << column_name
+       << " IS NOT NULL GROUP BY " << column_name << " ORDER BY value_count DESC LIMIT " << limit << ";";
+
+    PropertyList property_list;
+    property_list.addProperty("value", PropertyDataType::STRING);
+    property_list.addProperty("count", PropertyDataType::UINT);
+
+    command->set(ss.str());
+    command->list(property_list);
+
+    return command;
+}
+
 //DBCommand *SQLGenerator::getCountStatement (const std::string &dbo_type, unsigned int sensor_number)
 //{
 //    assert (ATSDB::getInstance().existsDBObject(dbo_type));
@@ -963,7 +1048,7 @@ std::shared_ptr<DBCommand> SQLGenerator::getSelectCommand (
 
         ss << table_db_name << "." << column.name();
 
-        property_list.addProperty(column.name(), variable->dataType());
+        property_list.addProperty(column.name(), read_list.readDataType(*variable));
 
         first=false;
     }
@@ -71,8 +71,22 @@ public:
     std::shared_ptr<DBCommand> getDistinctDataSourcesSelectCommand (DBObject &object);
 
     std::string getCreateAssociationTableStatement (const std::string& table_name);
+    /// @brief Returns statement creating an index on a column, existing index is kept for SQLite
+    std::string getCreateIndexStatement (const std::string& table_name, const std::string& column_name,
+                                         const std::string& index_name);
     std::shared_ptr<DBCommand> getSelectAssociationsCommand (const std::string& table_name);
 
+    /// @brief Returns command for count, not null count, distinct count, minimum and maximum of a column
+    std::shared_ptr<DBCommand> getColumnStatisticsCommand (const std::string& table_name,
+                                                           const std::string& column_name);
+    /// @brief Returns command for counts of not null values per bin, bin = (value - min) / bin_width
+    std::shared_ptr<DBCommand> getColumnHistogramCommand (const std::string& table_name,
+                                                          const std::string& column_name, double min,
+                                                          double bin_width);
+    /// @brief Returns command for the limit most frequent not null values and their counts
+    std::shared_ptr<DBCommand> getColumnTopValuesCommand (const std::string& table_name,
+                                                          const std::string& column_name, unsigned int limit);
+
 //    DBCommand *getDistinctStatistics (const std::string &dbo_type, DBOVariable *variable, unsigned int sensor_number);
 
 //    /// @brief Returns statement to check table existence
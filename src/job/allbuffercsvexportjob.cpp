@@ -20,6 +20,7 @@
 
 #include "allbuffercsvexportjob.h"
 #include "dbovariable.h"
+#include "dbovariableformatter.h"
 #include "dbovariableorderedset.h"
 #include "dbobjectmanager.h"
 #include "dbobject.h"
@@ -38,11 +39,15 @@ AllBufferCSVExportJob::AllBufferCSVExportJob(std::map<std::string, std::shared_p
 {
     assert (read_set_);
     assert (file_name_.size());
+
+    for (auto& buf_it : buffers_) // loaded data, must not be spilled while read
+        buf_it.second->pin();
 }
 
 AllBufferCSVExportJob::~AllBufferCSVExportJob()
 {
-
+    for (auto& buf_it : buffers_)
+        buf_it.second->unpin();
 }
 
 void AllBufferCSVExportJob::run ()
@@ -90,8 +95,18 @@ void AllBufferCSVExportJob::run ()
         // write the data
         DBObjectManager& manager = ATSDB::instance().objectManager();
 
+        formatters_.clear();
+
+        size_t row_cnt = 0;
+
         for (auto& row_index_it : row_indexes_)
         {
+            if (row_cnt++ % 10000 == 0 && obsolete())
+            {
+                loginf << "AllBufferCSVExportJob: run: obsolete after " << row_cnt-1 << " rows";
+                break;
+            }
+
             // set up everything to access the data
             dbo_num = row_index_it.first;
             buffer_index = row_index_it.second;
@@ -105,10 +120,10 @@ void AllBufferCSVExportJob::run ()
             assert (buffer_index < buffer->size());
 
             assert (buffer->has<bool>("selected"));
-            NullableVector<bool> selected_vec = buffer->get<bool>("selected");
+            NullableVector<bool>& selected_vec = buffer->get<bool>("selected");
 
             assert (buffer->has<int>("rec_num"));
-            NullableVector<int> rec_num_vec = buffer->get<int>("rec_num");
+            NullableVector<int>& rec_num_vec = buffer->get<int>("rec_num");
 
 
             // check if skipped because not selected
@@ -178,10 +193,12 @@ void AllBufferCSVExportJob::run ()
                            ? manager.metaVariable(variable_name).getFor(dbo_name)
                            : manager.object(dbo_name).variable(variable_name);
 
-                PropertyDataType data_type = variable.dataType();
-
                 std::string property_name = variable.name();
 
+                // loaded integers may be narrowed
+                PropertyDataType data_type = buffer->properties().hasProperty(property_name)
+                        ? buffer->properties().get(property_name).dataType() : variable.dataType();
+
                 if (data_type == PropertyDataType::BOOL)
                 {
                     if (!buffer->has<bool>(property_name))
@@ -194,8 +211,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<bool>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<bool>(property_name).getAsString(buffer_index);
                     }
@@ -212,8 +228,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<char>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<char>(property_name).getAsString(buffer_index);
                     }
@@ -230,12 +245,45 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<unsigned char>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<unsigned char>(property_name).getAsString(buffer_index);
                     }
                 }
+                else if (data_type == PropertyDataType::SHORTINT)
+                {
+                    if (!buffer->has<short int>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer->get<short int>(property_name).isNull(buffer_index);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
+                        else
+                            value_str = buffer->get<short int>(property_name).getAsString(buffer_index);
+                    }
+                }
+                else if (data_type == PropertyDataType::USHORTINT)
+                {
+                    if (!buffer->has<unsigned short int>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer->get<unsigned short int>(property_name).isNull(buffer_index);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
+                        else
+                            value_str = buffer->get<unsigned short int>(property_name).getAsString(buffer_index);
+                    }
+                }
                 else if (data_type == PropertyDataType::INT)
                 {
                     if (!buffer->has<int>(property_name))
@@ -248,8 +296,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<int>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<int>(property_name).getAsString(buffer_index);
                     }
@@ -266,8 +313,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<unsigned int>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<unsigned int>(property_name).getAsString(buffer_index);
                     }
@@ -284,8 +330,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<long int>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<long int>(property_name).getAsString(buffer_index);
                     }
@@ -302,8 +347,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<unsigned long int>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<unsigned long int>(property_name).getAsString(buffer_index);
                     }
@@ -320,8 +364,7 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<float>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<float>(property_name).getAsString(buffer_index);
                     }
@@ -338,12 +381,28 @@ void AllBufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer->get<double>(property_name).getAsString(buffer_index));
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
                         else
                             value_str = buffer->get<double>(property_name).getAsString(buffer_index);
                     }
                 }
+                else if (data_type == PropertyDataType::TIMESTAMP)
+                {
+                    if (!buffer->has<Timestamp>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer->get<Timestamp>(property_name).isNull(buffer_index);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(dbo_name, variable, col, buffer_index);
+                        else
+                            value_str = buffer->get<Timestamp>(property_name).getAsString(buffer_index);
+                    }
+                }
                 else if (data_type == PropertyDataType::STRING)
                 {
                     if (!buffer->has<std::string>(property_name))
@@ -593,3 +652,16 @@ void AllBufferCSVExportJob::run ()
     logdbg << "AllBufferCSVExportJob: execute: done";
     return;
 }
+
+std::string AllBufferCSVExportJob::representationString (const std::string& dbo_name, DBOVariable& variable,
+                                                         unsigned int col, size_t buffer_index)
+{
+    std::unique_ptr<DBOVariableFormatter>& formatter = formatters_[std::make_pair(dbo_name, col)];
+
+    if (!formatter)
+        formatter.reset(new DBOVariableFormatter (variable));
+
+    assert (buffers_.count(dbo_name));
+    formatter->formatBlock(*buffers_.at(dbo_name), buffer_index);
+    return formatter->get(buffer_index);
+}
@@ -24,6 +24,8 @@
 #include "job.h"
 #include "buffer.h"
 
+class DBOVariable;
+class DBOVariableFormatter;
 class DBOVariableOrderedSet;
 
 class AllBufferCSVExportJob : public Job
@@ -52,6 +54,13 @@ protected:
 
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
+
+    /// (dbo name, col) -> formatter, created on first use
+    std::map<std::pair<std::string, unsigned int>, std::unique_ptr<DBOVariableFormatter>> formatters_;
+
+    /// @brief Returns value of column in buffer row of DBObject in presentation, formatting blocks of rows at once
+    std::string representationString (const std::string& dbo_name, DBOVariable& variable, unsigned int col,
+                                      size_t buffer_index);
 };
 
 #endif // AllBufferCSVExportJob_H
@@ -16,23 +16,30 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "asteriximportertask.h"
+#include "asterixdecodejob.h"
+#include "asterixblockscanner.h"
 #include "stringconv.h"
 #include "logger.h"
 
 #include <jasterix/jasterix.h>
 
+#include <algorithm>
+#include <fstream>
 #include <memory>
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
 #include <QThread>
 
 using namespace nlohmann;
 using namespace Utils;
 
-ASTERIXDecodeJob::ASTERIXDecodeJob(ASTERIXImporterTask& task, const std::string& filename, const std::string& framing,
-                                   bool test)
-    : Job ("ASTERIXDecodeJob"), task_(task), filename_(filename), framing_(framing), test_(test)
+ASTERIXDecodeJob::ASTERIXDecodeJob(std::shared_ptr<jASTERIX::jASTERIX> jasterix, const std::string& filename,
+                                   const std::string& framing, bool test)
+    : Job ("ASTERIXDecodeJob"), jasterix_(jasterix), filename_(filename), framing_(framing), test_(test)
 {
+    assert (jasterix_);
     logdbg << "ASTERIXDecodeJob: ctor";
 }
 
@@ -41,6 +48,16 @@ ASTERIXDecodeJob::~ASTERIXDecodeJob()
     logdbg << "ASTERIXDecodeJob: dtor";
 }
 
+void ASTERIXDecodeJob::rangeDecoders (const std::vector<std::shared_ptr<jASTERIX::jASTERIX>>& decoders,
+                                      size_t range_size)
+{
+    assert (!started_);
+    assert (range_size);
+
+    range_decoders_ = decoders;
+    range_size_ = range_size;
+}
+
 void ASTERIXDecodeJob::run ()
 {
     logdbg << "ASTERIXDecodeJob: run";
@@ -52,10 +69,12 @@ void ASTERIXDecodeJob::run ()
             std::bind(&ASTERIXDecodeJob::jasterix_callback, this, _1, _2, _3, _4);
     try
     {
-        if (framing_ == "")
-            task_.jASTERIX()->decodeFile (filename_, callback);
+        if (framing_ == "" && range_decoders_.size() > 1)
+            decodeRanges();
+        else if (framing_ == "")
+            jasterix_->decodeFile (filename_, callback);
         else
-            task_.jASTERIX()->decodeFile (filename_, framing_, callback);
+            jasterix_->decodeFile (filename_, framing_, callback);
     }
     catch (std::exception& e)
     {
@@ -64,17 +83,120 @@ void ASTERIXDecodeJob::run ()
         error_message_ = e.what();
     }
 
-    assert (extracted_records_ == nullptr);
+    assert (obsolete() || extracted_records_ == nullptr); // obsolete records may not have been moved out
 
     done_ = true;
 
     logdbg << "ASTERIXDecodeJob: run: done";
 }
 
+void ASTERIXDecodeJob::decodeRanges ()
+{
+    std::vector<Utils::ASTERIXBlockScanner::Range> ranges = Utils::ASTERIXBlockScanner::scan(filename_, range_size_);
+
+    loginf << "ASTERIXDecodeJob: decodeRanges: file '" << filename_ << "' " << ranges.size() << " ranges, "
+           << range_decoders_.size() << " decoders";
+
+    const size_t num_decoders = range_decoders_.size();
+
+    // all ranges of a wave are decoded in parallel, while the previous wave is processed in file order. since records
+    // are processed in order in this thread, the cat002 time of day state is carried over range boundaries.
+    auto decode_wave = [this, &ranges, num_decoders] (size_t first, std::vector<DecodedRange>& decoded)
+    {
+        size_t count = std::min(num_decoders, ranges.size() - first);
+
+        decoded.clear();
+        decoded.resize(count);
+
+        tbb::parallel_for (size_t(0), count, [&] (size_t cnt)
+        {
+            const Utils::ASTERIXBlockScanner::Range& range = ranges.at(first+cnt);
+            decodeRange(*range_decoders_.at(cnt), range.offset_, range.size_, decoded.at(cnt));
+        });
+    };
+
+    size_t num_frames {0};
+    size_t num_records {0};
+    size_t num_errors {0};
+
+    std::vector<DecodedRange> current;
+    std::vector<DecodedRange> next;
+
+    decode_wave (0, current);
+
+    for (size_t first=0; first < ranges.size() && !obsolete(); first += num_decoders)
+    {
+        size_t next_first = first + num_decoders;
+
+        tbb::task_group next_wave;
+
+        if (next_first < ranges.size())
+            next_wave.run([&decode_wave, &next, next_first] { decode_wave (next_first, next); });
+
+        try
+        {
+            for (DecodedRange& range : current)
+            {
+                num_frames += range.num_frames_;
+                num_records += range.num_records_;
+                num_errors += range.num_errors_;
+
+                for (std::unique_ptr<nlohmann::json>& data : range.data_)
+                    jasterix_callback(std::move(data), num_frames, num_records, num_errors);
+            }
+        }
+        catch (...)
+        {
+            next_wave.cancel();
+
+            try
+            {
+                next_wave.wait();
+            }
+            catch (...) // first error is reported
+            {
+            }
+
+            throw;
+        }
+
+        next_wave.wait();
+
+        std::swap(current, next);
+    }
+}
+
+void ASTERIXDecodeJob::decodeRange (jASTERIX::jASTERIX& decoder, size_t offset, size_t size, DecodedRange& decoded)
+{
+    std::vector<char> data (size);
+
+    std::ifstream file (filename_, std::ios::binary);
+    file.seekg(offset);
+    file.read(data.data(), size);
+
+    if (!file)
+        throw std::runtime_error ("ASTERIXDecodeJob: decodeRange: read error in file '"+filename_+"' at offset "
+                                  +std::to_string(offset));
+
+    // jASTERIX counts per decode call, so the last counts are the ones of the range
+    std::function<void(std::unique_ptr<nlohmann::json>, size_t, size_t, size_t)> callback =
+            [&decoded] (std::unique_ptr<nlohmann::json> range_data, size_t num_frames, size_t num_records,
+            size_t num_errors)
+    {
+        decoded.data_.push_back(std::move(range_data));
+        decoded.num_frames_ = num_frames;
+        decoded.num_records_ = num_records;
+        decoded.num_errors_ = num_errors;
+    };
+
+    decoder.decodeASTERIX(data.data(), data.size(), callback);
+}
+
 void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, size_t num_frames, size_t num_records,
                                          size_t num_errors)
 {
-    if (error_)
+    // jASTERIX can not be stopped, so remaining data of an obsolete file is only read and skipped
+    if (error_ || obsolete())
         return;
 
     assert (!extracted_records_);
@@ -152,12 +274,13 @@ void ASTERIXDecodeJob::jasterix_callback(std::unique_ptr<nlohmann::json> data, s
 
     emit decodedASTERIXSignal();
 
-    while (pause_ || extracted_records_) // block decoder until unpaused and extracted records moved out
+    // block decoder until unpaused and extracted records moved out
+    while ((pause_ || extracted_records_) && !obsolete())
     {
         QThread::msleep(1);
     }
 
-    assert (extracted_records_ == nullptr);
+    assert (obsolete() || extracted_records_ == nullptr);
 }
 
 
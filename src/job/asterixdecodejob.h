@@ -21,7 +21,13 @@
 #include "job.h"
 #include "json.hpp"
 
-class ASTERIXImporterTask;
+#include <memory>
+#include <vector>
+
+namespace jASTERIX
+{
+    class jASTERIX;
+}
 
 class ASTERIXDecodeJob : public Job
 {
@@ -30,11 +36,18 @@ signals:
     void decodedASTERIXSignal ();
 
 public:
-    ASTERIXDecodeJob(ASTERIXImporterTask& task, const std::string& filename, const std::string& framing, bool test);
+    /// @brief Constructor, jasterix is used by this job only, so that several files can be decoded in parallel
+    ASTERIXDecodeJob(std::shared_ptr<jASTERIX::jASTERIX> jasterix, const std::string& filename,
+                     const std::string& framing, bool test);
     virtual ~ASTERIXDecodeJob();
 
     virtual void run ();
 
+    const std::string& filename() const { return filename_; }
+
+    /// @brief Decodes unframed files in ranges of about range_size bytes, one range per decoder in parallel
+    void rangeDecoders (const std::vector<std::shared_ptr<jASTERIX::jASTERIX>>& decoders, size_t range_size);
+
     size_t numFrames() const;
     size_t numRecords() const;
     size_t numErrors() const;
@@ -51,8 +64,8 @@ public:
     void clearExtractedRecords ();
     std::unique_ptr<std::vector<nlohmann::json>>& extractedRecords();
 
-private:
-    ASTERIXImporterTask& task_;
+protected:
+    std::shared_ptr<jASTERIX::jASTERIX> jasterix_;
     std::string filename_;
     std::string framing_;
     bool test_ {false};
@@ -72,6 +85,21 @@ private:
     std::map<std::pair<unsigned int, unsigned int>, double> cat002_last_tod_period_;
     std::map<std::pair<unsigned int, unsigned int>, double> cat002_last_tod_;
 
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> range_decoders_;
+    size_t range_size_ {0};
+
+    /// @brief Decoded data of one file range with the jASTERIX counts of the range
+    struct DecodedRange
+    {
+        std::vector<std::unique_ptr<nlohmann::json>> data_;
+        size_t num_frames_ {0};
+        size_t num_records_ {0};
+        size_t num_errors_ {0};
+    };
+
+    void decodeRanges ();
+    void decodeRange (jASTERIX::jASTERIX& decoder, size_t offset, size_t size, DecodedRange& decoded);
+
     void jasterix_callback(std::unique_ptr<nlohmann::json> data, size_t num_frames, size_t num_records,
                            size_t numErrors);
     void processRecord (unsigned int category, nlohmann::json& record);
@@ -0,0 +1,288 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "asterixnetworkdecodejob.h"
+#include "datagramrecording.h"
+#include "logger.h"
+
+#include <jasterix/jasterix.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+using namespace Utils;
+
+const size_t max_datagram_size = 65536;
+const int poll_timeout_ms = 100; // stop flag check interval
+const int receive_buffer_size = 8*1024*1024; // covers decoder stalls while records are mapped
+
+ASTERIXNetworkDecodeJob::ASTERIXNetworkDecodeJob(std::shared_ptr<jASTERIX::jASTERIX> jasterix,
+                                                 const std::string& address, unsigned int port,
+                                                 const std::string& interface, unsigned int batch_interval_ms,
+                                                 size_t max_batch_size, const std::string& recording_filename)
+    : ASTERIXDecodeJob (jasterix, "udp://"+address+":"+std::to_string(port), "", false), address_(address),
+      port_(port), interface_(interface), batch_interval_ms_(batch_interval_ms), max_batch_size_(max_batch_size),
+      recording_filename_(recording_filename)
+{
+    name_ = "ASTERIXNetworkDecodeJob";
+
+    assert (port_ && port_ < 65536);
+    assert (batch_interval_ms_);
+    assert (max_batch_size_);
+}
+
+ASTERIXNetworkDecodeJob::~ASTERIXNetworkDecodeJob()
+{
+    closeSocket();
+}
+
+void ASTERIXNetworkDecodeJob::run ()
+{
+    loginf << "ASTERIXNetworkDecodeJob: run: receiving from " << filename_;
+
+    started_ = true;
+
+    if (!openSocket())
+    {
+        done_ = true;
+        return;
+    }
+
+    if (recording_filename_.size())
+    {
+        try
+        {
+            recording_.reset(new DatagramRecordingWriter(recording_filename_));
+        }
+        catch (std::exception& e)
+        {
+            logerr << "ASTERIXNetworkDecodeJob: run: recording failed '" << e.what() << "'";
+            error_ = true;
+            error_message_ = e.what();
+
+            closeSocket();
+            done_ = true;
+            return;
+        }
+    }
+
+    const boost::posix_time::ptime epoch (boost::gregorian::date(1970, 1, 1));
+    boost::posix_time::ptime batch_start_time;
+    boost::posix_time::ptime now;
+
+    std::vector<char> datagram (max_datagram_size);
+
+    while (!stop_ && !obsolete())
+    {
+        pollfd poll_fd {socket_, POLLIN, 0};
+        int ret = poll(&poll_fd, 1, poll_timeout_ms);
+
+        if (ret < 0 && errno != EINTR)
+        {
+            error_ = true;
+            error_message_ = "poll failed: "+std::string(strerror(errno));
+            break;
+        }
+
+        now = boost::posix_time::microsec_clock::universal_time();
+
+        if (ret > 0 && (poll_fd.revents & POLLIN))
+        {
+            while (batch_.size() < max_batch_size_) // drain socket without blocking
+            {
+                ssize_t size = recv(socket_, datagram.data(), datagram.size(), MSG_DONTWAIT);
+
+                if (size < 0)
+                {
+                    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    {
+                        error_ = true;
+                        error_message_ = "receive failed: "+std::string(strerror(errno));
+                    }
+                    break;
+                }
+
+                if (!batch_.size())
+                    batch_start_time = now;
+
+                batch_.insert(batch_.end(), datagram.data(), datagram.data()+size);
+                ++num_datagrams_;
+
+                if (recording_)
+                    recording_->write((now-epoch).total_microseconds(), datagram.data(), size);
+            }
+
+            if (error_)
+                break;
+        }
+
+        if (batch_.size() && (batch_.size() >= max_batch_size_
+                              || (now-batch_start_time).total_milliseconds() >= batch_interval_ms_))
+            decodeBatch();
+    }
+
+    if (error_)
+        logerr << "ASTERIXNetworkDecodeJob: run: " << error_message_;
+    else if (batch_.size() && !obsolete()) // nobody takes the records during shutdown
+        decodeBatch();
+
+    closeSocket();
+
+    if (recording_)
+    {
+        recording_->flush();
+        loginf << "ASTERIXNetworkDecodeJob: run: recorded " << recording_->numDatagrams() << " datagrams into '"
+               << recording_filename_ << "'";
+        recording_ = nullptr;
+    }
+
+    done_ = true;
+
+    loginf << "ASTERIXNetworkDecodeJob: run: done, received " << num_datagrams_ << " datagrams";
+}
+
+bool ASTERIXNetworkDecodeJob::openSocket ()
+{
+    assert (socket_ < 0);
+
+    in_addr address;
+
+    if (inet_pton(AF_INET, address_.c_str(), &address) != 1)
+    {
+        error_ = true;
+        error_message_ = "invalid address '"+address_+"'";
+        logerr << "ASTERIXNetworkDecodeJob: openSocket: " << error_message_;
+        return false;
+    }
+
+    in_addr interface_address;
+    interface_address.s_addr = htonl(INADDR_ANY);
+
+    if (interface_.size() && inet_pton(AF_INET, interface_.c_str(), &interface_address) != 1)
+    {
+        error_ = true;
+        error_message_ = "invalid interface address '"+interface_+"'";
+        logerr << "ASTERIXNetworkDecodeJob: openSocket: " << error_message_;
+        return false;
+    }
+
+    bool multicast = IN_MULTICAST(ntohl(address.s_addr));
+
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (socket_ < 0)
+    {
+        error_ = true;
+        error_message_ = "socket creation failed: "+std::string(strerror(errno));
+        logerr << "ASTERIXNetworkDecodeJob: openSocket: " << error_message_;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)); // several receivers of same group
+
+    int buffer_size = receive_buffer_size;
+    if (setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size)) < 0)
+        logwrn << "ASTERIXNetworkDecodeJob: openSocket: unable to set receive buffer size";
+
+    sockaddr_in bind_address;
+    std::memset(&bind_address, 0, sizeof(bind_address));
+    bind_address.sin_family = AF_INET;
+    bind_address.sin_port = htons(port_);
+    bind_address.sin_addr = address; // binding to group only receives datagrams of that group
+
+    if (bind(socket_, reinterpret_cast<sockaddr*>(&bind_address), sizeof(bind_address)) < 0)
+    {
+        error_ = true;
+        error_message_ = "bind to "+address_+":"+std::to_string(port_)+" failed: "+strerror(errno);
+        logerr << "ASTERIXNetworkDecodeJob: openSocket: " << error_message_;
+        closeSocket();
+        return false;
+    }
+
+    if (multicast)
+    {
+        ip_mreq membership;
+        membership.imr_multiaddr = address;
+        membership.imr_interface = interface_address;
+
+        if (setsockopt(socket_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0)
+        {
+            error_ = true;
+            error_message_ = "joining multicast group "+address_+" failed: "+strerror(errno);
+            logerr << "ASTERIXNetworkDecodeJob: openSocket: " << error_message_;
+            closeSocket();
+            return false;
+        }
+    }
+
+    loginf << "ASTERIXNetworkDecodeJob: openSocket: bound to " << address_ << ":" << port_
+           << (multicast ? " multicast" : "");
+
+    return true;
+}
+
+void ASTERIXNetworkDecodeJob::closeSocket ()
+{
+    if (socket_ >= 0)
+    {
+        close(socket_);
+        socket_ = -1;
+    }
+}
+
+void ASTERIXNetworkDecodeJob::decodeBatch ()
+{
+    logdbg << "ASTERIXNetworkDecodeJob: decodeBatch: " << batch_.size() << " bytes";
+
+    assert (batch_.size());
+
+    // jASTERIX counts per decode call, totals are kept over all batches
+    size_t num_frames = num_frames_;
+    size_t num_records = num_records_;
+    size_t num_errors = num_errors_;
+
+    std::function<void(std::unique_ptr<nlohmann::json>, size_t, size_t, size_t)> callback =
+            [this, num_frames, num_records, num_errors] (std::unique_ptr<nlohmann::json> data,
+            size_t batch_frames, size_t batch_records, size_t batch_errors)
+    {
+        jasterix_callback(std::move(data), num_frames+batch_frames, num_records+batch_records,
+                          num_errors+batch_errors);
+    };
+
+    try
+    {
+        jasterix_->decodeASTERIX(batch_.data(), batch_.size(), callback);
+    }
+    catch (std::exception& e) // a corrupt datagram must not stop the live import
+    {
+        logerr << "ASTERIXNetworkDecodeJob: decodeBatch: dropping batch of " << batch_.size()
+               << " bytes, decoding error '" << e.what() << "'";
+        ++num_errors_;
+    }
+
+    batch_.clear();
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ASTERIXNETWORKDECODEJOB_H
+#define ASTERIXNETWORKDECODEJOB_H
+
+#include "asterixdecodejob.h"
+
+#include <memory>
+#include <vector>
+
+namespace Utils
+{
+    class DatagramRecordingWriter;
+}
+
+/**
+ * @brief Decodes ASTERIX data blocks received as UDP datagrams until stopped
+ *
+ * Datagrams are received from a unicast or multicast address and collected into batches, which are decoded when
+ * the batch interval has passed or the batch size is reached. Decoded records are handed out like in the file based
+ * ASTERIXDecodeJob, so the same mapping and insert pipeline can be used. Optionally, the received datagrams are
+ * written into a recording, which can be replayed with atsdb_asterix_replay.
+ */
+class ASTERIXNetworkDecodeJob : public ASTERIXDecodeJob
+{
+public:
+    /// @brief Constructor, a multicast group is joined on the given interface address if address is one
+    ASTERIXNetworkDecodeJob(std::shared_ptr<jASTERIX::jASTERIX> jasterix, const std::string& address,
+                            unsigned int port, const std::string& interface, unsigned int batch_interval_ms,
+                            size_t max_batch_size, const std::string& recording_filename);
+    virtual ~ASTERIXNetworkDecodeJob();
+
+    virtual void run ();
+
+    /// @brief Stops receiving, the remaining batch is decoded before the job is done, also done if set obsolete
+    void stop () { stop_ = true; }
+
+    size_t numDatagrams () const { return num_datagrams_; }
+
+protected:
+    std::string address_;
+    unsigned int port_ {0};
+    std::string interface_;
+    unsigned int batch_interval_ms_ {1000};
+    size_t max_batch_size_ {0};
+    std::string recording_filename_;
+
+    volatile bool stop_ {false};
+
+    int socket_ {-1};
+    std::vector<char> batch_;
+    size_t num_datagrams_ {0};
+
+    std::unique_ptr<Utils::DatagramRecordingWriter> recording_;
+
+    /// @brief Opens and binds the socket, joins multicast group, returns false and sets error on failure
+    bool openSocket ();
+    void closeSocket ();
+    void decodeBatch ();
+};
+
+#endif // ASTERIXNETWORKDECODEJOB_H
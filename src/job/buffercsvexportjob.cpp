@@ -20,6 +20,7 @@
 
 #include "buffercsvexportjob.h"
 #include "dbovariable.h"
+#include "dbovariableformatter.h"
 #include "dbobjectmanager.h"
 #include "dbobject.h"
 #include "atsdb.h"
@@ -31,11 +32,14 @@ BufferCSVExportJob::BufferCSVExportJob(std::shared_ptr<Buffer> buffer, const DBO
       only_selected_(only_selected), use_presentation_(use_presentation), show_associations_(show_associations)
 {
     assert (file_name_.size());
+    assert (buffer_);
+
+    buffer_->pin(); // loaded data, must not be spilled while read
 }
 
 BufferCSVExportJob::~BufferCSVExportJob()
 {
-
+    buffer_->unpin();
 }
 
 void BufferCSVExportJob::run ()
@@ -76,16 +80,19 @@ void BufferCSVExportJob::run ()
         output_file << ss.str() << "\n";
 
         assert (buffer_->has<bool>("selected"));
-        NullableVector<bool> selected_vec = buffer_->get<bool>("selected");
+        NullableVector<bool>& selected_vec = buffer_->get<bool>("selected");
 
         assert (buffer_->has<int>("rec_num"));
-        NullableVector<int> rec_num_vec = buffer_->get<int>("rec_num");
+        NullableVector<int>& rec_num_vec = buffer_->get<int>("rec_num");
 
         std::string dbo_name = buffer_->dboName();
         assert (dbo_name.size());
 
         DBObjectManager& manager = ATSDB::instance().objectManager();
 
+        formatters_.clear();
+        formatters_.resize(read_set_size);
+
         for (; row < buffer_size; ++row)
         {
             if (only_selected_ && (selected_vec.isNull(row) || !selected_vec.get(row)))
@@ -122,10 +129,12 @@ void BufferCSVExportJob::run ()
                 value_str = "";
 
                 DBOVariable& variable = read_set_.getVariable(col);
-                PropertyDataType data_type = variable.dataType();
-
                 std::string property_name = variable.name();
 
+                // loaded integers may be narrowed
+                PropertyDataType data_type = buffer_->properties().hasProperty(property_name)
+                        ? buffer_->properties().get(property_name).dataType() : variable.dataType();
+
                 if (data_type == PropertyDataType::BOOL)
                 {
                     if (!buffer_->has<bool>(property_name))
@@ -138,8 +147,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<bool>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<bool>(property_name).getAsString(row);
                     }
@@ -156,8 +164,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<char>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<char>(property_name).getAsString(row);
                     }
@@ -174,12 +181,45 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<unsigned char>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<unsigned char>(property_name).getAsString(row);
                     }
                 }
+                else if (data_type == PropertyDataType::SHORTINT)
+                {
+                    if (!buffer_->has<short int>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer_->get<short int>(property_name).isNull(row);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(col, row);
+                        else
+                            value_str = buffer_->get<short int>(property_name).getAsString(row);
+                    }
+                }
+                else if (data_type == PropertyDataType::USHORTINT)
+                {
+                    if (!buffer_->has<unsigned short int>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer_->get<unsigned short int>(property_name).isNull(row);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(col, row);
+                        else
+                            value_str = buffer_->get<unsigned short int>(property_name).getAsString(row);
+                    }
+                }
                 else if (data_type == PropertyDataType::INT)
                 {
                     if (!buffer_->has<int>(property_name))
@@ -192,8 +232,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<int>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<int>(property_name).getAsString(row);
                     }
@@ -210,8 +249,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<unsigned int>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<unsigned int>(property_name).getAsString(row);
                     }
@@ -228,8 +266,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<long int>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<long int>(property_name).getAsString(row);
                     }
@@ -246,8 +283,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<unsigned long int>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<unsigned long int>(property_name).getAsString(row);
                     }
@@ -264,8 +300,7 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<float>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<float>(property_name).getAsString(row);
                     }
@@ -282,12 +317,28 @@ void BufferCSVExportJob::run ()
                     if (!null)
                     {
                         if (use_presentation_)
-                            value_str = variable.getRepresentationStringFromValue(
-                                        buffer_->get<double>(property_name).getAsString(row));
+                            value_str = representationString(col, row);
                         else
                             value_str = buffer_->get<double>(property_name).getAsString(row);
                     }
                 }
+                else if (data_type == PropertyDataType::TIMESTAMP)
+                {
+                    if (!buffer_->has<Timestamp>(property_name))
+                    {
+                        ss << ";";
+                        continue;
+                    }
+
+                    null = buffer_->get<Timestamp>(property_name).isNull(row);
+                    if (!null)
+                    {
+                        if (use_presentation_)
+                            value_str = representationString(col, row);
+                        else
+                            value_str = buffer_->get<Timestamp>(property_name).getAsString(row);
+                    }
+                }
                 else if (data_type == PropertyDataType::STRING)
                 {
                     if (!buffer_->has<std::string>(property_name))
@@ -328,3 +379,14 @@ void BufferCSVExportJob::run ()
     logdbg << "BufferCSVExportJob: execute: done";
     return;
 }
+
+std::string BufferCSVExportJob::representationString (size_t col, size_t row)
+{
+    assert (col < formatters_.size());
+
+    if (!formatters_.at(col))
+        formatters_.at(col).reset(new DBOVariableFormatter (read_set_.getVariable(col)));
+
+    formatters_.at(col)->formatBlock(*buffer_, row);
+    return formatters_.at(col)->get(row);
+}
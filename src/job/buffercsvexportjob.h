@@ -25,6 +25,8 @@
 #include "buffer.h"
 #include "dbovariableset.h"
 
+class DBOVariableFormatter;
+
 class BufferCSVExportJob : public Job
 {
 public:
@@ -46,6 +48,11 @@ protected:
 
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
+
+    std::vector<std::unique_ptr<DBOVariableFormatter>> formatters_; // col -> formatter, created on first use
+
+    /// @brief Returns value of column in row in presentation, formatting blocks of rows at once
+    std::string representationString (size_t col, size_t row);
 };
 
 #endif // BUFFERCSVEXPORTJOB_H
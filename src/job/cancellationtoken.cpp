@@ -0,0 +1,79 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "cancellationtoken.h"
+
+void CancellationToken::cancel ()
+{
+    std::function<void()> interrupt;
+
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        if (cancelled_.exchange(true))
+            return;
+
+        interrupt = interrupt_;
+        interrupting_ = static_cast<bool> (interrupt);
+    }
+
+    if (!interrupt)
+        return;
+
+    // called unlocked, clearInterrupt waits until done
+    try
+    {
+        interrupt();
+    }
+    catch (...)
+    {
+        interruptDone();
+        throw;
+    }
+
+    interruptDone();
+}
+
+void CancellationToken::setInterrupt (std::function<void()> interrupt)
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        interrupt_ = interrupt;
+    }
+
+    if (cancelled_ && interrupt) // cancelled before registration
+        interrupt();
+}
+
+void CancellationToken::clearInterrupt ()
+{
+    std::unique_lock<std::mutex> lock (mutex_);
+    interrupt_ = nullptr;
+
+    interrupt_done_.wait(lock, [this] { return !interrupting_; });
+}
+
+void CancellationToken::interruptDone ()
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        interrupting_ = false;
+    }
+
+    interrupt_done_.notify_all();
+}
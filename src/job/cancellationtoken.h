@@ -0,0 +1,81 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Cooperative cancellation of a running Job
+ *
+ * Loops poll cancelled(), which is a single relaxed atomic load, e.g. once per chunk or every few thousand rows.
+ * Blocking calls which can not poll, such as a database query, register an interrupt function for their duration
+ * using an InterruptGuard. It is called once from the cancelling thread, either on cancel() or at registration if
+ * already cancelled, and must be thread-safe. It is called without holding the lock, so that a slow interrupt does not
+ * block other callers, but leaving the guard waits until a running interrupt has returned. So an interrupt never
+ * hits a later operation, e.g. the next statement on a shared database connection.
+ */
+class CancellationToken
+{
+public:
+    /// @brief Registers an interrupt function while in scope
+    class InterruptGuard
+    {
+    public:
+        InterruptGuard (CancellationToken& token, std::function<void()> interrupt) : token_(token)
+        {
+            token_.setInterrupt(interrupt);
+        }
+        ~InterruptGuard() { token_.clearInterrupt(); }
+
+        InterruptGuard (const InterruptGuard&) = delete;
+        InterruptGuard& operator= (const InterruptGuard&) = delete;
+
+    protected:
+        CancellationToken& token_;
+    };
+
+    CancellationToken() {}
+
+    CancellationToken (const CancellationToken&) = delete;
+    CancellationToken& operator= (const CancellationToken&) = delete;
+
+    /// @brief Sets the cancelled flag and calls the registered interrupt function
+    void cancel ();
+    bool cancelled () const { return cancelled_.load(std::memory_order_relaxed); }
+
+protected:
+    std::atomic<bool> cancelled_ {false};
+
+    std::mutex mutex_; // protects interrupt_ and interrupting_
+    std::function<void()> interrupt_;
+    /// set while cancel() calls the interrupt function
+    bool interrupting_ {false};
+    std::condition_variable interrupt_done_;
+
+    void setInterrupt (std::function<void()> interrupt);
+    /// @brief Unregisters the interrupt function, waits if it is being called
+    void clearInterrupt ();
+    void interruptDone ();
+};
+
+#endif // CANCELLATIONTOKEN_H
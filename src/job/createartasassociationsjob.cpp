@@ -32,10 +32,17 @@ CreateARTASAssociationsJob::CreateARTASAssociationsJob(CreateARTASAssociationsTa
     associations_dubious_distant_time_ = task_.associationsDubiousDistantTime();
     association_dubious_close_time_past_ = task_.associationDubiousCloseTimePast();
     association_dubious_close_time_future_ = task_.associationDubiousCloseTimeFuture(); // will be negative time diff
+
+    for (auto& buf_it : buffers_) // loaded data, must not be spilled while read
+        if (buf_it.second)
+            buf_it.second->pin();
 }
 
 CreateARTASAssociationsJob::~CreateARTASAssociationsJob()
 {
+    for (auto& buf_it : buffers_)
+        if (buf_it.second)
+            buf_it.second->unpin();
 }
 
 void CreateARTASAssociationsJob::run ()
@@ -61,13 +68,22 @@ void CreateARTASAssociationsJob::run ()
     emit statusSignal("Creating UTNs");
     createUTNS();
 
+    if (abortIfObsolete("creating UTNs"))
+        return;
+
     // create associations for artas tracks
     emit statusSignal("Creating ARTAS Associations");
     createARTASAssociations();
 
+    if (abortIfObsolete("creating ARTAS associations"))
+        return;
+
     // create associations for sensors
     createSensorAssociations();
 
+    if (abortIfObsolete("creating sensor associations"))
+        return;
+
     if (missing_hashes_cnt_ || dubious_associations_cnt_)
     {
         std::stringstream ss;
@@ -75,9 +91,12 @@ void CreateARTASAssociationsJob::run ()
            << " dubious associations.\nDo you want to still save the associations?";
         emit saveAssociationsQuestionSignal(ss.str().c_str());
 
-        while (!save_question_answered_)
+        while (!save_question_answered_ && !obsolete())
             QThread::msleep (1);
 
+        if (abortIfObsolete("save question"))
+            return;
+
         if (!save_question_answer_) // nope
         {
             emit statusSignal("Clearing created Associations");
@@ -99,7 +118,7 @@ void CreateARTASAssociationsJob::run ()
         // else simply continue
     }
 
-    // save associations
+    // save associations, not cancelled since written per object
     emit statusSignal("Saving Associations");
     for (auto& dbo_it : object_man)
     {
@@ -120,6 +139,19 @@ void CreateARTASAssociationsJob::run ()
     done_=true;
 }
 
+bool CreateARTASAssociationsJob::abortIfObsolete (const std::string& step)
+{
+    if (!obsolete())
+        return false;
+
+    loginf << "CreateARTASAssociationsJob: abortIfObsolete: obsolete after " << step << ", clearing associations";
+
+    ATSDB::instance().objectManager().removeAssociations();
+    done_=true;
+
+    return true;
+}
+
 size_t CreateARTASAssociationsJob::missingHashes() const
 {
     return missing_hashes_cnt_;
@@ -165,16 +197,16 @@ void CreateARTASAssociationsJob::createUTNS ()
 
     assert (buffer->has<int>(task_.keyVar()->getNameFor(tracker_dbo_name_)));
     assert (buffer->has<std::string>(task_.hashVar()->getNameFor(tracker_dbo_name_)));
-    assert (buffer->has<float>(task_.todVar()->getNameFor(tracker_dbo_name_)));
+    assert (buffer->has<Timestamp>(task_.todVar()->getNameFor(tracker_dbo_name_)));
 
-    NullableVector<int> track_nums = buffer->get<int>(task_.trackerTrackNumVarStr());
-    NullableVector<std::string> track_begins = buffer->get<std::string>(task_.trackerTrackBeginVarStr());
-    NullableVector<std::string> track_ends = buffer->get<std::string>(task_.trackerTrackEndVarStr());
-    NullableVector<std::string> track_coastings = buffer->get<std::string>(task_.trackerTrackCoastingVarStr());
+    NullableVector<int>& track_nums = buffer->get<int>(task_.trackerTrackNumVarStr());
+    NullableVector<std::string>& track_begins = buffer->get<std::string>(task_.trackerTrackBeginVarStr());
+    NullableVector<std::string>& track_ends = buffer->get<std::string>(task_.trackerTrackEndVarStr());
+    NullableVector<std::string>& track_coastings = buffer->get<std::string>(task_.trackerTrackCoastingVarStr());
 
-    NullableVector<int> rec_nums = buffer->get<int>(task_.keyVar()->getNameFor(tracker_dbo_name_));
-    NullableVector<std::string> hashes = buffer->get<std::string>(task_.hashVar()->getNameFor(tracker_dbo_name_));
-    NullableVector<float> tods = buffer->get<float>(task_.todVar()->getNameFor(tracker_dbo_name_));
+    NullableVector<int>& rec_nums = buffer->get<int>(task_.keyVar()->getNameFor(tracker_dbo_name_));
+    NullableVector<std::string>& hashes = buffer->get<std::string>(task_.hashVar()->getNameFor(tracker_dbo_name_));
+    NullableVector<Timestamp>& tods = buffer->get<Timestamp>(task_.todVar()->getNameFor(tracker_dbo_name_));
 
     std::map<int, UniqueARTASTrack> current_tracks; // utn -> unique track
     std::map<int, int> current_track_mappings; // track_num -> utn
@@ -206,6 +238,9 @@ void CreateARTASAssociationsJob::createUTNS ()
 
     for (size_t cnt=0; cnt < buffer_size; ++cnt)
     {
+        if (cnt % 10000 == 0 && obsolete())
+            return;
+
         //new_track_created = false;
         finish_previous_track = false;
 
@@ -220,19 +255,19 @@ void CreateARTASAssociationsJob::createUTNS ()
 
         track_begin_set = !track_begins.isNull(cnt);
         if (track_begin_set)
-            track_begin = track_begins.get(cnt) == "1";
+            track_begin = track_begins.equals(cnt, "1");
         else
             track_begin = false;
 
         track_end_set = !track_ends.isNull(cnt);
         if (track_end_set)
-            track_end = track_ends.get(cnt) == "1";
+            track_end = track_ends.equals(cnt, "1");
         else
             track_end = false;
 
         track_coasting_set = !track_coastings.isNull(cnt);
         if (track_coasting_set)
-            track_coasting = track_coastings.get(cnt) == "1";
+            track_coasting = track_coastings.equals(cnt, "1");
         else
             track_coasting = false;
 
@@ -240,7 +275,7 @@ void CreateARTASAssociationsJob::createUTNS ()
         rec_num = rec_nums.get(cnt);
 
         assert (!tods.isNull(cnt));
-        tod = tods.get(cnt);
+        tod = tods.get(cnt).seconds();
 
         // was loaded as sorted in time
         if (cnt == 0) // store first time
@@ -386,6 +421,9 @@ void CreateARTASAssociationsJob::createSensorAssociations()
     emit statusSignal("Creating Associations");
     for (auto& ut_it : finished_tracks_) // utn -> UAT, for each unqique target
     {
+        if (obsolete())
+            return;
+
         logdbg << "CreateARTASAssociationsJob: createSensorAssociations: utn " << ut_it.first;
 
         for (auto& assoc_it : ut_it.second.rec_nums_tris_) // rec_num -> (tri, tod), for each TRIs compound string
@@ -574,14 +612,17 @@ void CreateARTASAssociationsJob::createSensorHashes (DBObject& object)
 
     assert (buffer->has<int>(key_var.name()));
     assert (buffer->has<std::string>(hash_var.name()));
-    assert (buffer->has<float>(tod_var.name()));
+    assert (buffer->has<Timestamp>(tod_var.name()));
 
-    NullableVector<int> rec_nums = buffer->get<int>(key_var.name());
-    NullableVector<std::string> hashes = buffer->get<std::string>(hash_var.name());
-    NullableVector<float> tods = buffer->get<float>(tod_var.name());
+    NullableVector<int>& rec_nums = buffer->get<int>(key_var.name());
+    NullableVector<std::string>& hashes = buffer->get<std::string>(hash_var.name());
+    NullableVector<Timestamp>& tods = buffer->get<Timestamp>(tod_var.name());
 
     for (size_t cnt=0; cnt < buffer_size; ++cnt)
     {
+        if (cnt % 10000 == 0 && obsolete())
+            return;
+
         assert (!rec_nums.isNull(cnt));
         assert (!hashes.isNull(cnt));
 
@@ -597,7 +638,7 @@ void CreateARTASAssociationsJob::createSensorHashes (DBObject& object)
         // dbo -> hash -> rec_num, tod
         //std::map <std::string, std::multimap<std::string, std::pair<int, float>>> sensor_hashes_;
 
-        sensor_hashes_[dbo_name].emplace(hashes.get(cnt), std::make_pair(rec_nums.get(cnt), tods.get(cnt)));
+        sensor_hashes_[dbo_name].emplace(hashes.get(cnt), std::make_pair(rec_nums.get(cnt), tods.get(cnt).seconds()));
     }
 }
 
@@ -81,6 +81,9 @@ protected:
     volatile bool save_question_answered_ {false};
     volatile bool save_question_answer_ {false};
 
+    /// @brief Clears created associations and sets done if obsolete, returns obsolete flag
+    bool abortIfObsolete (const std::string& step);
+
     void createUTNS ();
     void createARTASAssociations();
     void createSensorAssociations();
@@ -0,0 +1,436 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "csvparsejob.h"
+#include "buffer.h"
+#include "dbovariable.h"
+#include "propertylist.h"
+#include "flathashset.h"
+#include "logger.h"
+
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+CSVParseJob::CSVParseJob(const char* data, size_t size, char separator, const std::string& dbo_name,
+                         const std::vector<DBOVariable*>& columns, bool use_presentation,
+                         const std::string& data_source_variable_name)
+    : Job("CSVParseJob"), data_(data), size_(size), separator_(separator), dbo_name_(dbo_name),
+      variables_(columns), use_presentation_(use_presentation),
+      data_source_variable_name_(data_source_variable_name)
+{
+    assert (data_);
+}
+
+CSVParseJob::~CSVParseJob()
+{
+}
+
+void CSVParseJob::run ()
+{
+    logdbg << "CSVParseJob: run: " << size_ << " bytes";
+
+    started_ = true;
+
+    createBuffer();
+
+    const char* line_begin = data_;
+    const char* data_end = data_ + size_;
+    const char* line_end;
+    const char* field_begin;
+    const char* field_end;
+
+    size_t row {0};
+    size_t column_cnt;
+    bool row_has_value;
+
+    while (line_begin < data_end)
+    {
+        if (obsolete())
+            break;
+
+        line_end = static_cast<const char*> (std::memchr(line_begin, '\n', data_end - line_begin));
+
+        if (!line_end)
+            line_end = data_end;
+
+        const char* next_line = line_end + 1;
+
+        if (line_end > line_begin && *(line_end-1) == '\r')
+            --line_end;
+
+        if (line_end == line_begin) // empty line
+        {
+            line_begin = next_line;
+            continue;
+        }
+
+        ++num_lines_;
+
+        field_begin = line_begin;
+        column_cnt = 0;
+        row_has_value = false;
+
+        while (field_begin <= line_end && column_cnt < columns_.size())
+        {
+            field_end = static_cast<const char*> (std::memchr(field_begin, separator_, line_end - field_begin));
+
+            if (!field_end)
+                field_end = line_end;
+
+            Column& column = columns_.at(column_cnt);
+
+            if (column.variable_ && field_end > field_begin) // empty fields are null
+            {
+                if (setValue(column, row, field_begin, field_end))
+                    row_has_value = true;
+                else
+                    ++num_parse_errors_;
+            }
+
+            field_begin = field_end + 1;
+            ++column_cnt;
+        }
+
+        if (row_has_value)
+            ++row;
+
+        line_begin = next_line;
+    }
+
+    if (obsolete())
+    {
+        buffer_ = nullptr;
+        done_ = true;
+        return;
+    }
+
+    discoverDataSources();
+
+    logdbg << "CSVParseJob: run: done, lines " << num_lines_ << " rows " << buffer_->size() << " errors "
+           << num_parse_errors_;
+
+    done_ = true;
+}
+
+void CSVParseJob::createBuffer ()
+{
+    PropertyList properties;
+
+    for (DBOVariable* variable : variables_)
+        if (variable && !properties.hasProperty(variable->name()))
+            properties.addProperty(variable->name(), variable->dataType());
+
+    buffer_ = std::make_shared<Buffer> (properties, dbo_name_);
+
+    for (DBOVariable* variable : variables_)
+    {
+        Column column;
+        column.variable_ = variable;
+
+        if (variable)
+        {
+            column.data_type_ = variable->dataType();
+            column.use_presentation_ = use_presentation_
+                    && variable->representation() != DBOVariable::Representation::STANDARD;
+
+            const std::string& name = variable->name();
+
+            switch (column.data_type_)
+            {
+                case PropertyDataType::BOOL:
+                    column.values_ = &buffer_->get<bool>(name);
+                    break;
+                case PropertyDataType::CHAR:
+                    column.values_ = &buffer_->get<char>(name);
+                    break;
+                case PropertyDataType::UCHAR:
+                    column.values_ = &buffer_->get<unsigned char>(name);
+                    break;
+                case PropertyDataType::SHORTINT:
+                    column.values_ = &buffer_->get<short int>(name);
+                    break;
+                case PropertyDataType::USHORTINT:
+                    column.values_ = &buffer_->get<unsigned short int>(name);
+                    break;
+                case PropertyDataType::INT:
+                    column.values_ = &buffer_->get<int>(name);
+                    break;
+                case PropertyDataType::UINT:
+                    column.values_ = &buffer_->get<unsigned int>(name);
+                    break;
+                case PropertyDataType::LONGINT:
+                    column.values_ = &buffer_->get<long int>(name);
+                    break;
+                case PropertyDataType::ULONGINT:
+                    column.values_ = &buffer_->get<unsigned long int>(name);
+                    break;
+                case PropertyDataType::FLOAT:
+                    column.values_ = &buffer_->get<float>(name);
+                    break;
+                case PropertyDataType::DOUBLE:
+                    column.values_ = &buffer_->get<double>(name);
+                    break;
+                case PropertyDataType::TIMESTAMP:
+                    column.values_ = &buffer_->get<Timestamp>(name);
+                    break;
+                case PropertyDataType::STRING:
+                    column.values_ = &buffer_->get<std::string>(name);
+                    break;
+                default:
+                    logerr << "CSVParseJob: createBuffer: unknown property type "
+                           << Property::asString(column.data_type_);
+                    throw std::runtime_error ("CSVParseJob: createBuffer: unknown property type "
+                                              + Property::asString(column.data_type_));
+            }
+        }
+
+        columns_.push_back(column);
+    }
+}
+
+bool CSVParseJob::setValue (Column& column, size_t row, const char* begin, const char* end)
+{
+    std::string value_str;
+
+    if (column.use_presentation_)
+    {
+        try
+        {
+            value_str = column.variable_->getValueStringFromRepresentation(std::string(begin, end));
+        }
+        catch (std::exception& e)
+        {
+            logdbg << "CSVParseJob: setValue: representation of " << column.variable_->name() << " not parsed: "
+                   << e.what();
+            return false;
+        }
+
+        begin = value_str.data();
+        end = begin + value_str.size();
+    }
+
+    switch (column.data_type_)
+    {
+        case PropertyDataType::BOOL:
+        {
+            size_t length = end - begin;
+            bool value;
+
+            if ((length == 1 && *begin == '1') || (length == 4 && !std::strncmp(begin, "true", 4)))
+                value = true;
+            else if ((length == 1 && *begin == '0') || (length == 5 && !std::strncmp(begin, "false", 5)))
+                value = false;
+            else
+                return false;
+
+            static_cast<NullableVector<bool>*> (column.values_)->set(row, value);
+            return true;
+        }
+        case PropertyDataType::CHAR:
+            return setInteger<char>(column, row, begin, end);
+        case PropertyDataType::UCHAR:
+            return setInteger<unsigned char>(column, row, begin, end);
+        case PropertyDataType::SHORTINT:
+            return setInteger<short int>(column, row, begin, end);
+        case PropertyDataType::USHORTINT:
+            return setInteger<unsigned short int>(column, row, begin, end);
+        case PropertyDataType::INT:
+            return setInteger<int>(column, row, begin, end);
+        case PropertyDataType::UINT:
+            return setInteger<unsigned int>(column, row, begin, end);
+        case PropertyDataType::LONGINT:
+            return setInteger<long int>(column, row, begin, end);
+        case PropertyDataType::ULONGINT:
+            return setInteger<unsigned long int>(column, row, begin, end);
+        case PropertyDataType::FLOAT:
+            return setFloatingPoint<float>(column, row, begin, end);
+        case PropertyDataType::DOUBLE:
+            return setFloatingPoint<double>(column, row, begin, end);
+        case PropertyDataType::TIMESTAMP:
+            return setFloatingPoint<Timestamp>(column, row, begin, end);
+        case PropertyDataType::STRING:
+            static_cast<NullableVector<std::string>*> (column.values_)->set(row, begin, end-begin);
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename T> bool CSVParseJob::setInteger (Column& column, size_t row, const char* begin, const char* end)
+{
+    long int value;
+
+    if (!parseInteger(begin, end, value))
+        return false;
+
+    if (value < static_cast<long int>(std::numeric_limits<T>::min())
+            || (value > 0 && static_cast<unsigned long int>(value) > std::numeric_limits<T>::max()))
+        return false;
+
+    static_cast<NullableVector<T>*> (column.values_)->set(row, static_cast<T>(value));
+    return true;
+}
+
+template <typename T> bool CSVParseJob::setFloatingPoint (Column& column, size_t row, const char* begin,
+                                                          const char* end)
+{
+    double value;
+
+    if (!parseFloatingPoint(begin, end, value))
+        return false;
+
+    static_cast<NullableVector<T>*> (column.values_)->set(row, static_cast<T>(value));
+    return true;
+}
+
+void CSVParseJob::discoverDataSources ()
+{
+    if (!data_source_variable_name_.size() || !buffer_->size() || !buffer_->has<int>(data_source_variable_name_))
+        return;
+
+    NullableVector<int>& keys = buffer_->get<int> (data_source_variable_name_);
+
+    if (buffer_->has<unsigned char>("sac") && buffer_->has<unsigned char>("sic"))
+        collectDataSources<unsigned char>(keys, &buffer_->get<unsigned char>("sac"),
+                                          &buffer_->get<unsigned char>("sic"));
+    else if (buffer_->has<char>("sac") && buffer_->has<char>("sic"))
+        collectDataSources<char>(keys, &buffer_->get<char>("sac"), &buffer_->get<char>("sic"));
+    else
+        collectDataSources<char>(keys, nullptr, nullptr);
+}
+
+template <typename T> void CSVParseJob::collectDataSources (NullableVector<int>& keys, NullableVector<T>* sacs,
+                                                            NullableVector<T>* sics)
+{
+    Utils::FlatHashSet<int> distinct_keys;
+
+    size_t size = buffer_->size();
+    int key_val;
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+    {
+        if (keys.isNull(cnt))
+            continue;
+
+        key_val = keys.get(cnt);
+
+        if (!distinct_keys.insert(key_val))
+            continue;
+
+        if (sacs && sics && !sacs->isNull(cnt) && !sics->isNull(cnt))
+            data_sources_[key_val] = {static_cast<int>(sacs->get(cnt)), static_cast<int>(sics->get(cnt))};
+        else
+            data_sources_[key_val] = {-1, -1};
+    }
+}
+
+bool CSVParseJob::parseInteger (const char* begin, const char* end, long int& value)
+{
+    bool negative = false;
+
+    if (begin < end && (*begin == '-' || *begin == '+'))
+    {
+        negative = *begin == '-';
+        ++begin;
+    }
+
+    if (begin == end || end - begin > 18) // no digits or possible overflow
+        return false;
+
+    value = 0;
+
+    for (; begin < end; ++begin)
+    {
+        if (*begin < '0' || *begin > '9')
+            return false;
+
+        value = value*10 + (*begin - '0');
+    }
+
+    if (negative)
+        value = -value;
+
+    return true;
+}
+
+bool CSVParseJob::parseFloatingPoint (const char* begin, const char* end, double& value)
+{
+    // exact for up to 15 significant digits and 22 decimals, since both operands are exact doubles
+    static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                           1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char* pos = begin;
+    bool negative = false;
+
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+        negative = *pos == '-';
+        ++pos;
+    }
+
+    unsigned long int mantissa {0};
+    unsigned int num_digits {0};
+    unsigned int num_decimals {0};
+    bool in_decimals {false};
+    bool fast_path {true};
+
+    for (; pos < end; ++pos)
+    {
+        if (*pos >= '0' && *pos <= '9')
+        {
+            if (num_digits < 15)
+            {
+                mantissa = mantissa*10 + (*pos - '0');
+
+                if (mantissa)
+                    ++num_digits;
+
+                if (in_decimals)
+                    ++num_decimals;
+            }
+            else
+                fast_path = false;
+        }
+        else if (*pos == '.' && !in_decimals)
+            in_decimals = true;
+        else
+            break;
+    }
+
+    if (pos == end && fast_path && num_decimals <= 22)
+    {
+        if (pos == begin || (pos == begin+1 && (*begin == '-' || *begin == '+' || *begin == '.')))
+            return false;
+
+        value = static_cast<double>(mantissa) / powers_of_ten[num_decimals];
+
+        if (negative)
+            value = -value;
+
+        return true;
+    }
+
+    // exponents, many digits, inf/nan: locale-independent stream parsing
+    std::istringstream stream (std::string(begin, end));
+    stream.imbue(std::locale::classic());
+    stream >> value;
+
+    return stream && stream.peek() == std::char_traits<char>::eof();
+}
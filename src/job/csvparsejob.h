@@ -0,0 +1,102 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CSVPARSEJOB_H
+#define CSVPARSEJOB_H
+
+#include "job.h"
+#include "property.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Buffer;
+class DBOVariable;
+
+template <class T> class NullableVector;
+
+/**
+ * @brief Parses a chunk of CSV lines into a Buffer
+ *
+ * The chunk is a range of complete lines in a memory-mapped file, which must stay mapped while the job runs. Each
+ * CSV column is mapped to a DBOVariable (or ignored), values are parsed directly from the mapped data into the typed
+ * buffer columns, numeric values without allocation. Empty fields are null. If use_presentation is set, values of
+ * variables with a special representation are converted back as written by BufferCSVExportJob.
+ *
+ * Data sources found in the data source variable are collected, key -> (sac, sic) or (-1, -1) if not available.
+ */
+class CSVParseJob : public Job
+{
+public:
+    CSVParseJob(const char* data, size_t size, char separator, const std::string& dbo_name,
+                const std::vector<DBOVariable*>& columns, bool use_presentation,
+                const std::string& data_source_variable_name);
+    virtual ~CSVParseJob();
+
+    virtual void run ();
+
+    std::shared_ptr<Buffer> buffer () { return buffer_; }
+
+    size_t numLines () const { return num_lines_; }
+    size_t numParseErrors () const { return num_parse_errors_; }
+    size_t size () const { return size_; }
+
+    const std::map<int, std::pair<int,int>>& dataSources () const { return data_sources_; }
+
+protected:
+    struct Column
+    {
+        DBOVariable* variable_ {nullptr};
+        PropertyDataType data_type_ {PropertyDataType::BOOL};
+        bool use_presentation_ {false};
+        void* values_ {nullptr}; // NullableVector of data type
+    };
+
+    const char* data_ {nullptr};
+    size_t size_ {0};
+    char separator_ {';'};
+    std::string dbo_name_;
+    std::vector<DBOVariable*> variables_;
+    bool use_presentation_ {false};
+    std::string data_source_variable_name_;
+
+    std::vector<Column> columns_;
+    std::shared_ptr<Buffer> buffer_;
+
+    size_t num_lines_ {0};
+    size_t num_parse_errors_ {0};
+
+    std::map<int, std::pair<int,int>> data_sources_;
+
+    void createBuffer ();
+    /// @brief Sets value of field in row, returns false on parse error
+    bool setValue (Column& column, size_t row, const char* begin, const char* end);
+    template <typename T> bool setInteger (Column& column, size_t row, const char* begin, const char* end);
+    template <typename T> bool setFloatingPoint (Column& column, size_t row, const char* begin, const char* end);
+
+    void discoverDataSources ();
+    template <typename T> void collectDataSources (NullableVector<int>& keys, NullableVector<T>* sacs,
+                                                   NullableVector<T>* sics);
+
+    static bool parseInteger (const char* begin, const char* end, long int& value);
+    static bool parseFloatingPoint (const char* begin, const char* end, double& value);
+};
+
+#endif // CSVPARSEJOB_H
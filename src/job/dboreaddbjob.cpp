@@ -21,6 +21,7 @@
 #include "propertylist.h"
 #include "dbinterface.h"
 #include "buffer.h"
+#include "buffertransformation.h"
 #include "logger.h"
 
 DBOReadDBJob::DBOReadDBJob(DBInterface &db_interface, DBObject &dbobject, DBOVariableSet read_list,
@@ -42,6 +43,8 @@ DBOReadDBJob::DBOReadDBJob(DBInterface &db_interface, DBObject &dbobject, DBOVar
 
     if (order_variable_)
         assert (order_variable_->existsInDB());
+
+    transformation_.reset(new BufferTransformation(read_list_, true));
 }
 
 DBOReadDBJob::~DBOReadDBJob()
@@ -54,7 +57,7 @@ void DBOReadDBJob::run ()
     loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": start";
     started_ = true;
 
-    if (obsolete_)
+    if (obsolete())
     {
         loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete before prepared";
         done_=true;
@@ -69,28 +72,34 @@ void DBOReadDBJob::run ()
 
     unsigned int cnt=0;
     unsigned int row_count=0;
-    while (!done_)
-    {
-        std::shared_ptr<Buffer> buffer = db_interface_.readDataChunk(dbobject_);
-        assert (buffer);
 
-        cnt++;
+    {
+        // connection is locked by prepareRead, so only this statement can be interrupted
+        CancellationToken::InterruptGuard guard (cancellation_token_, [this] () { db_interface_.interruptQuery(); });
 
-        if (obsolete_)
+        while (!done_)
         {
-            loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete after prepared";
-            break;
-        }
+            std::shared_ptr<Buffer> buffer = db_interface_.readDataChunk(dbobject_);
+            assert (buffer);
 
-        assert (buffer->dboName() == dbobject_.name());
+            cnt++;
 
-        logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": intermediate signal, #buffers "
-               << cnt << " last one " << buffer->lastOne();
-        row_count += buffer->size();
-        emit intermediateSignal(buffer);
+            if (obsolete())
+            {
+                loginf << "DBOReadDBJob: run: " << dbobject_.name() << ": obsolete after prepared";
+                break;
+            }
 
-        if (buffer->lastOne())
-            break;
+            assert (buffer->dboName() == dbobject_.name());
+
+            logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": intermediate signal, #buffers "
+                   << cnt << " last one " << buffer->lastOne();
+            row_count += buffer->size();
+            emit intermediateSignal(buffer);
+
+            if (buffer->lastOne())
+                break;
+        }
     }
 
     logdbg << "DBOReadDBJob: run: " << dbobject_.name() << ": finalizing statement";
@@ -24,6 +24,7 @@
 #include "dbovariableset.h"
 
 class Buffer;
+class BufferTransformation;
 class DBObject;
 class DBInterface;
 
@@ -48,6 +49,8 @@ public:
     virtual void run ();
 
     DBOVariableSet &readList () { return read_list_; }
+    /// @brief Returns transformation of read buffers to DBO variables, shared by all finalize jobs
+    std::shared_ptr<BufferTransformation> transformation () { return transformation_; }
 
 protected:
     DBInterface &db_interface_;
@@ -60,6 +63,8 @@ protected:
     bool use_order_ascending_;
     std::string limit_str_;
 
+    std::shared_ptr<BufferTransformation> transformation_;
+
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
 };
@@ -0,0 +1,170 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbotimewindowreadjob.h"
+#include "dbobject.h"
+#include "dbovariable.h"
+#include "dbinterface.h"
+#include "dbtablecolumn.h"
+#include "dbtable.h"
+#include "metadbtable.h"
+#include "buffer.h"
+#include "buffertransformation.h"
+#include "unitmanager.h"
+#include "dimension.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+DBOTimeWindowReadJob::DBOTimeWindowReadJob(DBInterface& db_interface, DBObject& dbobject, DBOVariableSet read_list,
+                                           DBOVariable& tod_variable, unsigned int window, double begin, double end,
+                                           std::string custom_filter_clause,
+                                           std::vector <DBOVariable*> filtered_variables, bool create_index)
+    : Job("DBOTimeWindowReadJob"), db_interface_(db_interface), dbobject_(dbobject), read_list_(read_list),
+      tod_variable_(tod_variable), window_(window), begin_(begin), end_(end),
+      custom_filter_clause_(custom_filter_clause), filtered_variables_(filtered_variables),
+      create_index_(create_index)
+{
+    assert (dbobject_.existsInDB());
+    assert (tod_variable_.existsInDB());
+    assert (begin_ < end_);
+
+    if (!read_list_.hasVariable(tod_variable_))
+        read_list_.add(tod_variable_);
+
+    // window condition needs the table of the tod column
+    if (std::find(filtered_variables_.begin(), filtered_variables_.end(), &tod_variable_) == filtered_variables_.end())
+        filtered_variables_.push_back(&tod_variable_);
+}
+
+DBOTimeWindowReadJob::~DBOTimeWindowReadJob()
+{
+}
+
+void DBOTimeWindowReadJob::run ()
+{
+    logdbg << "DBOTimeWindowReadJob: run: " << dbobject_.name() << " window " << window_;
+    started_ = true;
+
+    if (obsolete())
+    {
+        done_ = true;
+        return;
+    }
+
+    const DBTableColumn& column = tod_variable_.currentDBColumn();
+    std::string table_name = tod_variable_.currentMetaTable().tableFor(column.identifier()).name();
+
+    if (create_index_)
+    {
+        try
+        {
+            db_interface_.createIndex(table_name, column.name());
+        }
+        catch (std::exception& e) // reading works without index, only slower
+        {
+            logerr << "DBOTimeWindowReadJob: run: " << dbobject_.name() << " reading without tod index: "
+                   << e.what();
+        }
+    }
+
+    std::string clause = windowClause();
+
+    if (custom_filter_clause_.size())
+        clause = "("+custom_filter_clause_+") AND "+clause;
+
+    db_interface_.prepareRead (dbobject_, read_list_, clause, filtered_variables_, true, &tod_variable_, true);
+
+    {
+        CancellationToken::InterruptGuard guard (cancellation_token_, [this] () { db_interface_.interruptQuery(); });
+
+        while (true)
+        {
+            std::shared_ptr<Buffer> buffer = db_interface_.readDataChunk(dbobject_);
+            assert (buffer);
+
+            if (obsolete())
+                break;
+
+            bool last_one = buffer->lastOne();
+
+            if (!buffer_)
+                buffer_ = buffer;
+            else
+                buffer_->seizeBuffer(*buffer);
+
+            if (last_one)
+                break;
+        }
+    }
+
+    db_interface_.finalizeReadStatement(dbobject_);
+
+    if (obsolete())
+    {
+        buffer_ = nullptr;
+        done_ = true;
+        return;
+    }
+
+    assert (buffer_);
+
+    BufferTransformation transformation (read_list_, true);
+    buffer_->transformVariables(transformation);
+    buffer_->addProperty("selected", PropertyDataType::BOOL);
+
+    logdbg << "DBOTimeWindowReadJob: run: " << dbobject_.name() << " window " << window_ << " done, "
+           << buffer_->size() << " rows";
+
+    done_ = true;
+}
+
+std::string DBOTimeWindowReadJob::windowClause () const
+{
+    const DBTableColumn& column = tod_variable_.currentDBColumn();
+    std::string table_name = tod_variable_.currentMetaTable().tableFor(column.identifier()).name();
+
+    double begin = begin_;
+    double end = end_;
+
+    if (column.unit() != tod_variable_.unit()) // same as done for filter values
+    {
+        const std::string& dimension_name = tod_variable_.dimension();
+
+        if (UnitManager::instance().hasDimension(dimension_name)
+                && UnitManager::instance().dimension(dimension_name).hasUnit(column.unit())
+                && UnitManager::instance().dimension(dimension_name).hasUnit(tod_variable_.unit()))
+        {
+            double factor = UnitManager::instance().dimension(dimension_name).getFactor(column.unit(),
+                                                                                          tod_variable_.unit());
+            begin /= factor;
+            end /= factor;
+        }
+        else
+            logwrn << "DBOTimeWindowReadJob: windowClause: no unit transformation from '" << tod_variable_.unit()
+                   << "' to '" << column.unit() << "' possible";
+    }
+
+    std::stringstream ss;
+    ss << std::setprecision(12) << table_name << "." << column.name() << " >= " << begin << " AND "
+       << table_name << "." << column.name() << " < " << end;
+
+    return ss.str();
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOTIMEWINDOWREADJOB_H
+#define DBOTIMEWINDOWREADJOB_H
+
+#include "job.h"
+#include "dbovariableset.h"
+
+class Buffer;
+class DBObject;
+class DBInterface;
+
+/**
+ * @brief Reads all data of a DBObject in a time of day window
+ *
+ * Rows with begin <= tod < end are read ordered by the tod variable and finalized into one buffer, like
+ * DBOReadDBJob and FinalizeDBOReadJob do for a normal load. Optionally creates an index on the tod column first.
+ */
+class DBOTimeWindowReadJob : public Job
+{
+public:
+    DBOTimeWindowReadJob(DBInterface& db_interface, DBObject& dbobject, DBOVariableSet read_list,
+                         DBOVariable& tod_variable, unsigned int window, double begin, double end,
+                         std::string custom_filter_clause, std::vector <DBOVariable*> filtered_variables,
+                         bool create_index);
+    virtual ~DBOTimeWindowReadJob();
+
+    virtual void run ();
+
+    DBObject& dbObject () { return dbobject_; }
+    unsigned int window () const { return window_; }
+
+    /// @brief Returns read buffer, nullptr if obsolete
+    std::shared_ptr<Buffer> buffer () { return buffer_; }
+
+protected:
+    DBInterface& db_interface_;
+    DBObject& dbobject_;
+    DBOVariableSet read_list_;
+    DBOVariable& tod_variable_;
+    unsigned int window_ {0};
+    double begin_ {0};
+    double end_ {0};
+    std::string custom_filter_clause_;
+    std::vector <DBOVariable*> filtered_variables_;
+    bool create_index_ {false};
+
+    std::shared_ptr<Buffer> buffer_;
+
+    /// @brief Returns condition for the window in the unit of the tod column
+    std::string windowClause () const;
+};
+
+#endif // DBOTIMEWINDOWREADJOB_H
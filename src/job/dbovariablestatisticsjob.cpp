@@ -0,0 +1,441 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbovariablestatisticsjob.h"
+#include "dbovariablestatistics.h"
+#include "dbovariable.h"
+#include "dbinterface.h"
+#include "dbresult.h"
+#include "dbtablecolumn.h"
+#include "dbtable.h"
+#include "metadbtable.h"
+#include "buffer.h"
+#include "unitmanager.h"
+#include "dimension.h"
+#include "logger.h"
+
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+template <typename T> void DBOVariableStatisticsJob::copyValues (NullableVector<T>& values)
+{
+    size_t size = values.size();
+
+    numeric_values_.reserve(size);
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+        if (!values.isNull(cnt))
+            numeric_values_.push_back(values.get(cnt));
+
+    loaded_null_count_ = loaded_count_ - numeric_values_.size();
+}
+
+template <> void DBOVariableStatisticsJob::copyValues (NullableVector<Timestamp>& values)
+{
+    size_t size = values.size();
+
+    numeric_values_.reserve(size);
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+        if (!values.isNull(cnt))
+            numeric_values_.push_back(values.get(cnt).seconds());
+
+    loaded_null_count_ = loaded_count_ - numeric_values_.size();
+}
+
+template <> void DBOVariableStatisticsJob::copyValues (NullableVector<std::string>& values)
+{
+    size_t size = values.size();
+
+    string_values_.reserve(size);
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+        if (!values.isNull(cnt))
+            string_values_.push_back(values.get(cnt));
+
+    loaded_null_count_ = loaded_count_ - string_values_.size();
+}
+
+DBOVariableStatisticsJob::DBOVariableStatisticsJob(DBInterface& db_interface, DBOVariable& variable,
+                                                   unsigned int num_bins, unsigned int num_top_values,
+                                                   std::shared_ptr<Buffer> loaded_buffer)
+    : Job("DBOVariableStatisticsJob"), db_interface_(db_interface), variable_(variable), num_bins_(num_bins),
+      num_top_values_(num_top_values), from_loaded_(loaded_buffer != nullptr)
+{
+    assert (num_bins_);
+
+    PropertyDataType data_type = variable_.dataType();
+    integral_ = data_type != PropertyDataType::FLOAT && data_type != PropertyDataType::DOUBLE
+            && data_type != PropertyDataType::TIMESTAMP && data_type != PropertyDataType::STRING;
+
+    if (!from_loaded_)
+    {
+        assert (variable_.existsInDB());
+        return;
+    }
+
+    loaded_buffer_ = loaded_buffer;
+    assert (loaded_buffer_->properties().hasProperty(variable_.name()));
+
+    loaded_buffer_->pin(); // loaded data, must not be spilled while read
+}
+
+DBOVariableStatisticsJob::~DBOVariableStatisticsJob()
+{
+    if (loaded_buffer_)
+        loaded_buffer_->unpin();
+}
+
+void DBOVariableStatisticsJob::run ()
+{
+    logdbg << "DBOVariableStatisticsJob: run: " << variable_.dboName() << " " << variable_.name() << " from "
+           << (from_loaded_ ? "loaded data" : "database");
+
+    started_ = true;
+
+    if (obsolete())
+    {
+        done_ = true;
+        return;
+    }
+
+    boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::local_time();
+
+    statistics_ = std::make_shared<DBOVariableStatistics> (
+                variable_.dboName(), variable_.name(),
+                from_loaded_ ? DBOVariableStatistics::Source::LOADED : DBOVariableStatistics::Source::DATABASE);
+
+    if (from_loaded_)
+        calculateFromLoaded();
+    else
+        calculateFromDatabase();
+
+    if (obsolete())
+        statistics_ = nullptr;
+    else
+        loginf << "DBOVariableStatisticsJob: run: " << variable_.dboName() << " " << variable_.name() << " count "
+               << statistics_->count_ << " nulls " << statistics_->null_count_ << " distinct "
+               << statistics_->distinct_count_ << " done after "
+               << (boost::posix_time::microsec_clock::local_time() - start_time).total_milliseconds() << " ms";
+
+    done_ = true;
+}
+
+void DBOVariableStatisticsJob::calculateFromDatabase ()
+{
+    const DBTableColumn& column = variable_.currentDBColumn();
+    std::string table_name = variable_.currentMetaTable().tableFor(column.identifier()).name();
+
+    std::shared_ptr<DBResult> result = db_interface_.queryColumnStatistics(table_name, column.name());
+    assert (result && result->containsData());
+
+    std::shared_ptr<Buffer> buffer = result->buffer();
+    assert (buffer->size() == 1);
+
+    // counts may be null in empty tables
+    statistics_->count_ = buffer->get<unsigned int>("count").isNull(0) ?
+                0 : buffer->get<unsigned int>("count").get(0);
+
+    size_t not_null_count = buffer->get<unsigned int>("not_null_count").isNull(0) ?
+                0 : buffer->get<unsigned int>("not_null_count").get(0);
+    statistics_->null_count_ = statistics_->count_ - not_null_count;
+
+    statistics_->distinct_count_ = buffer->get<unsigned int>("distinct_count").isNull(0) ?
+                0 : buffer->get<unsigned int>("distinct_count").get(0);
+
+    if (!not_null_count || obsolete())
+        return;
+
+    statistics_->min_string_ = buffer->get<std::string>("min").get(0);
+    statistics_->max_string_ = buffer->get<std::string>("max").get(0);
+
+    // formatted (e.g. hexadecimal) columns are not numeric in the database
+    bool numeric = variable_.dataType() != PropertyDataType::STRING && column.dataFormat() == "";
+    double factor = numeric ? unitFactor() : 1.0;
+
+    double min {0}, max {0};
+
+    if (numeric)
+    {
+        try
+        {
+            min = std::stod(statistics_->min_string_);
+            max = std::stod(statistics_->max_string_);
+        }
+        catch (std::exception& e)
+        {
+            logwrn << "DBOVariableStatisticsJob: calculateFromDatabase: variable " << variable_.name()
+                   << " minimum/maximum not numeric: " << e.what();
+            numeric = false;
+        }
+    }
+
+    if (numeric)
+    {
+        double bin_width = DBOVariableStatistics::binWidth(min, max, num_bins_, integral_);
+        size_t num_bins = std::min<size_t>(num_bins_, static_cast<size_t>(std::floor((max - min) / bin_width)) + 1);
+
+        result = db_interface_.queryColumnHistogram(table_name, column.name(), min, bin_width);
+        assert (result && result->containsData());
+        buffer = result->buffer();
+
+        statistics_->histogram_.resize(num_bins, 0);
+
+        NullableVector<int>& bins = buffer->get<int>("bin");
+        NullableVector<unsigned int>& counts = buffer->get<unsigned int>("count");
+
+        for (size_t cnt=0; cnt < buffer->size(); ++cnt)
+        {
+            if (bins.isNull(cnt) || counts.isNull(cnt))
+                continue;
+
+            int bin = std::max(0, std::min(static_cast<int>(num_bins) - 1, bins.get(cnt)));
+            statistics_->histogram_.at(bin) += counts.get(cnt);
+        }
+
+        statistics_->numeric_ = true;
+        statistics_->min_ = min * factor;
+        statistics_->max_ = max * factor;
+        statistics_->bin_begin_ = min * factor;
+        statistics_->bin_width_ = bin_width * factor;
+
+        if (factor != 1.0)
+        {
+            statistics_->min_string_ = toString(statistics_->min_);
+            statistics_->max_string_ = toString(statistics_->max_);
+        }
+
+        statistics_->quantilesFromHistogram();
+    }
+
+    // grouping by high-cardinality numeric columns is expensive and tells little
+    if (obsolete() || !num_top_values_ || (numeric && statistics_->distinct_count_ > num_bins_))
+        return;
+
+    result = db_interface_.queryColumnTopValues(table_name, column.name(), num_top_values_);
+    assert (result && result->containsData());
+    buffer = result->buffer();
+
+    NullableVector<std::string>& values = buffer->get<std::string>("value");
+    NullableVector<unsigned int>& counts = buffer->get<unsigned int>("count");
+
+    for (size_t cnt=0; cnt < buffer->size(); ++cnt)
+    {
+        if (values.isNull(cnt) || counts.isNull(cnt))
+            continue;
+
+        std::string value = values.get(cnt);
+
+        if (numeric && factor != 1.0)
+            value = toString(std::stod(value) * factor);
+
+        statistics_->top_values_.push_back({value, counts.get(cnt)});
+    }
+}
+
+void DBOVariableStatisticsJob::copyLoadedValues ()
+{
+    assert (loaded_buffer_);
+
+    PropertyDataType data_type = variable_.dataType();
+    assert (loaded_buffer_->properties().hasProperty(variable_.name()));
+
+    // loaded integers may be narrowed, values are the same
+    PropertyDataType loaded_data_type = loaded_buffer_->properties().get(variable_.name()).dataType();
+    assert (loaded_data_type == data_type
+            || (Property::isInteger(loaded_data_type) && Property::isInteger(data_type)));
+
+    loaded_count_ = loaded_buffer_->size();
+
+    switch (loaded_data_type)
+    {
+        case PropertyDataType::BOOL:
+            copyValues(loaded_buffer_->get<bool>(variable_.name()));
+            break;
+        case PropertyDataType::CHAR:
+            copyValues(loaded_buffer_->get<char>(variable_.name()));
+            break;
+        case PropertyDataType::UCHAR:
+            copyValues(loaded_buffer_->get<unsigned char>(variable_.name()));
+            break;
+        case PropertyDataType::SHORTINT:
+            copyValues(loaded_buffer_->get<short int>(variable_.name()));
+            break;
+        case PropertyDataType::USHORTINT:
+            copyValues(loaded_buffer_->get<unsigned short int>(variable_.name()));
+            break;
+        case PropertyDataType::INT:
+            copyValues(loaded_buffer_->get<int>(variable_.name()));
+            break;
+        case PropertyDataType::UINT:
+            copyValues(loaded_buffer_->get<unsigned int>(variable_.name()));
+            break;
+        case PropertyDataType::LONGINT:
+            copyValues(loaded_buffer_->get<long int>(variable_.name()));
+            break;
+        case PropertyDataType::ULONGINT:
+            copyValues(loaded_buffer_->get<unsigned long int>(variable_.name()));
+            break;
+        case PropertyDataType::FLOAT:
+            copyValues(loaded_buffer_->get<float>(variable_.name()));
+            break;
+        case PropertyDataType::DOUBLE:
+            copyValues(loaded_buffer_->get<double>(variable_.name()));
+            break;
+        case PropertyDataType::TIMESTAMP:
+            copyValues(loaded_buffer_->get<Timestamp>(variable_.name()));
+            break;
+        case PropertyDataType::STRING:
+            copyValues(loaded_buffer_->get<std::string>(variable_.name()));
+            break;
+        default:
+            logerr << "DBOVariableStatisticsJob: copyLoadedValues: unknown property type "
+                   << Property::asString(loaded_data_type);
+            throw std::runtime_error ("DBOVariableStatisticsJob: copyLoadedValues: unknown property type "
+                                      + Property::asString(loaded_data_type));
+    }
+
+    loaded_buffer_->unpin();
+    loaded_buffer_ = nullptr;
+}
+
+void DBOVariableStatisticsJob::calculateFromLoaded ()
+{
+    copyLoadedValues();
+
+    statistics_->count_ = loaded_count_;
+    statistics_->null_count_ = loaded_null_count_;
+
+    // runs of equal values in sorted data, value index -> count
+    std::vector<std::pair<size_t, size_t>> runs;
+
+    if (string_values_.size())
+    {
+        tbb::parallel_sort(string_values_.begin(), string_values_.end());
+
+        statistics_->min_string_ = string_values_.front();
+        statistics_->max_string_ = string_values_.back();
+
+        for (size_t cnt=0; cnt < string_values_.size(); ++cnt)
+        {
+            if (cnt && string_values_.at(cnt) == string_values_.at(cnt-1))
+                ++runs.back().second;
+            else
+                runs.push_back({cnt, 1});
+        }
+    }
+    else if (numeric_values_.size())
+    {
+        tbb::parallel_sort(numeric_values_.begin(), numeric_values_.end());
+
+        if (obsolete())
+            return;
+
+        size_t size = numeric_values_.size();
+
+        statistics_->numeric_ = true;
+        statistics_->min_ = numeric_values_.front();
+        statistics_->max_ = numeric_values_.back();
+        statistics_->min_string_ = toString(statistics_->min_);
+        statistics_->max_string_ = toString(statistics_->max_);
+
+        double bin_width = DBOVariableStatistics::binWidth(statistics_->min_, statistics_->max_, num_bins_,
+                                                           integral_);
+        size_t num_bins = std::min<size_t>(num_bins_, static_cast<size_t>(
+                                               std::floor((statistics_->max_ - statistics_->min_) / bin_width)) + 1);
+
+        statistics_->bin_begin_ = statistics_->min_;
+        statistics_->bin_width_ = bin_width;
+        statistics_->histogram_.resize(num_bins, 0);
+
+        for (size_t cnt=0; cnt < size; ++cnt)
+        {
+            double value = numeric_values_.at(cnt);
+
+            size_t bin = std::min(num_bins - 1, static_cast<size_t>((value - statistics_->min_) / bin_width));
+            ++statistics_->histogram_.at(bin);
+
+            if (cnt && value == numeric_values_.at(cnt-1))
+                ++runs.back().second;
+            else
+                runs.push_back({cnt, 1});
+        }
+
+        // nearest rank
+        for (double fraction : DBOVariableStatistics::quantileFractions())
+        {
+            size_t rank = static_cast<size_t>(std::ceil(fraction * size));
+            statistics_->quantiles_[fraction] = numeric_values_.at(rank ? rank - 1 : 0);
+        }
+
+        statistics_->exact_quantiles_ = true;
+    }
+
+    statistics_->distinct_count_ = runs.size();
+
+    if (obsolete() || !num_top_values_ || (statistics_->numeric_ && runs.size() > num_bins_))
+        return;
+
+    size_t num_top_values = std::min<size_t>(num_top_values_, runs.size());
+
+    std::partial_sort(runs.begin(), runs.begin() + num_top_values, runs.end(),
+                      [] (const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b)
+    { return a.second > b.second; });
+
+    for (size_t cnt=0; cnt < num_top_values; ++cnt)
+    {
+        if (statistics_->numeric_)
+            statistics_->top_values_.push_back({toString(numeric_values_.at(runs.at(cnt).first)),
+                                                runs.at(cnt).second});
+        else
+            statistics_->top_values_.push_back({string_values_.at(runs.at(cnt).first), runs.at(cnt).second});
+    }
+}
+
+double DBOVariableStatisticsJob::unitFactor ()
+{
+    const DBTableColumn& column = variable_.currentDBColumn();
+
+    if (column.unit() == variable_.unit()) // same as done for filter values
+        return 1.0;
+
+    const std::string& dimension_name = variable_.dimension();
+
+    if (UnitManager::instance().hasDimension(dimension_name)
+            && UnitManager::instance().dimension(dimension_name).hasUnit(column.unit())
+            && UnitManager::instance().dimension(dimension_name).hasUnit(variable_.unit()))
+        return UnitManager::instance().dimension(dimension_name).getFactor(column.unit(), variable_.unit());
+
+    logwrn << "DBOVariableStatisticsJob: unitFactor: no unit transformation from '" << column.unit()
+           << "' to '" << variable_.unit() << "' possible";
+
+    return 1.0;
+}
+
+std::string DBOVariableStatisticsJob::toString (double value)
+{
+    std::ostringstream ss;
+    ss << std::setprecision(12) << value;
+    return ss.str();
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOVARIABLESTATISTICSJOB_H
+#define DBOVARIABLESTATISTICSJOB_H
+
+#include "job.h"
+
+#include <string>
+#include <vector>
+
+class Buffer;
+class DBInterface;
+class DBOVariable;
+class DBOVariableStatistics;
+
+template <class T> class NullableVector;
+
+/**
+ * @brief Calculates DBOVariableStatistics for one DBOVariable
+ *
+ * Without a buffer, counts, minimum/maximum, a histogram and the most frequent values are calculated by SQL
+ * aggregation on the column of the variable. With a buffer of loaded data containing the variable, the not null
+ * values are copied from the buffer, pinned while held by the job, and sorted in parallel in run, from which all
+ * statistics including exact quantiles are derived.
+ */
+class DBOVariableStatisticsJob : public Job
+{
+public:
+    DBOVariableStatisticsJob(DBInterface& db_interface, DBOVariable& variable, unsigned int num_bins,
+                             unsigned int num_top_values, std::shared_ptr<Buffer> loaded_buffer=nullptr);
+    virtual ~DBOVariableStatisticsJob();
+
+    virtual void run ();
+
+    DBOVariable& variable () { return variable_; }
+
+    /// @brief Returns calculated statistics, nullptr if obsolete
+    std::shared_ptr<DBOVariableStatistics> statistics () { return statistics_; }
+
+protected:
+    DBInterface& db_interface_;
+    DBOVariable& variable_;
+    unsigned int num_bins_ {0};
+    unsigned int num_top_values_ {0};
+    bool from_loaded_ {false};
+    /// loaded data, pinned until its values are copied
+    std::shared_ptr<Buffer> loaded_buffer_;
+    bool integral_ {false};
+
+    size_t loaded_count_ {0};
+    size_t loaded_null_count_ {0};
+    std::vector<double> numeric_values_;
+    std::vector<std::string> string_values_;
+
+    std::shared_ptr<DBOVariableStatistics> statistics_;
+
+    template <typename T> void copyValues (NullableVector<T>& values);
+    /// @brief Copies the not null values of the variable from the loaded buffer and unpins it
+    void copyLoadedValues ();
+
+    void calculateFromDatabase ();
+    void calculateFromLoaded ();
+
+    /// @brief Returns factor from column unit to variable unit
+    double unitFactor ();
+    static std::string toString (double value);
+};
+
+#endif // DBOVARIABLESTATISTICSJOB_H
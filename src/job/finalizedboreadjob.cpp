@@ -21,10 +21,15 @@
 #include "dbobject.h"
 #include "dbovariableset.h"
 #include "buffer.h"
+#include "buffertransformation.h"
 
-FinalizeDBOReadJob::FinalizeDBOReadJob(DBObject &dbobject, DBOVariableSet &read_list, std::shared_ptr<Buffer> buffer)
-    : Job("FinalizeDBOReadJob"), dbobject_(dbobject), read_list_(read_list), buffer_ (buffer)
+FinalizeDBOReadJob::FinalizeDBOReadJob(DBObject &dbobject, DBOVariableSet &read_list,
+                                       std::shared_ptr<BufferTransformation> transformation,
+                                       std::shared_ptr<Buffer> buffer)
+    : Job("FinalizeDBOReadJob"), dbobject_(dbobject), read_list_(read_list), transformation_(transformation),
+      buffer_ (buffer)
 {
+    assert (transformation_);
     assert (buffer_);
 }
 
@@ -38,7 +43,7 @@ void FinalizeDBOReadJob::run ()
     logdbg << "FinalizeDBOReadJob: run: read_list size " << read_list_.getSize();
     started_ = true;
 
-    buffer_->transformVariables(read_list_, true);
+    buffer_->transformVariables(*transformation_);
     buffer_->addProperty("selected", PropertyDataType::BOOL); // add boolean to indicate selection
 
     logdbg << "FinalizeDBOReadJob: run: done";
@@ -24,6 +24,7 @@
 
 class DBObject;
 class Buffer;
+class BufferTransformation;
 
 /**
  * @brief Finalizes read DBObject data from DBOReadDBJob
@@ -33,7 +34,8 @@ class Buffer;
 class FinalizeDBOReadJob : public Job
 {
 public:
-    FinalizeDBOReadJob (DBObject &dbobject, DBOVariableSet &read_list, std::shared_ptr<Buffer> buffer);
+    FinalizeDBOReadJob (DBObject &dbobject, DBOVariableSet &read_list,
+                        std::shared_ptr<BufferTransformation> transformation, std::shared_ptr<Buffer> buffer);
     virtual ~FinalizeDBOReadJob();
 
     virtual void run ();
@@ -43,6 +45,7 @@ public:
 protected:
     DBObject &dbobject_;
     DBOVariableSet read_list_;
+    std::shared_ptr<BufferTransformation> transformation_;
     std::shared_ptr<Buffer> buffer_;
 };
 
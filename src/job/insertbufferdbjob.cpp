@@ -48,6 +48,13 @@ void InsertBufferDBJob::run ()
 
     started_ = true;
 
+    if (obsolete())
+    {
+        loginf << "InsertBufferDBJob: run: " << dbobject_.name() << ": obsolete before start";
+        done_=true;
+        return;
+    }
+
     boost::posix_time::ptime loading_start_time;
     boost::posix_time::ptime loading_stop_time;
 
@@ -56,7 +63,13 @@ void InsertBufferDBJob::run ()
     loginf  << "InsertBufferDBJob: run: writing object " << dbobject_.name() << " size " << buffer_->size();
     assert (buffer_->size());
 
-    db_interface_.insertBuffer(dbobject_.currentMetaTable(), buffer_);
+    if (!db_interface_.insertBuffer(dbobject_.currentMetaTable(), buffer_, &cancellation_token_))
+    {
+        loginf << "InsertBufferDBJob: run: " << dbobject_.name() << ": cancelled";
+        done_=true;
+        return;
+    }
+
     loading_stop_time = boost::posix_time::microsec_clock::local_time();
 
     double load_time;
@@ -20,8 +20,11 @@
 
 #include <QObject>
 #include <QRunnable>
+#include <atomic>
 #include <memory>
 
+#include "cancellationtoken.h"
+
 /**
  * @brief Encapsulates a work-package
  *
@@ -29,6 +32,9 @@
  * canceled (set as obsolete) or was completed (done). The work itself is defined in the execute function, which
  * must be overridden (and MUST set the done_ flag to true).
  *
+ * Setting a Job obsolete cancels its CancellationToken. Long-running jobs poll obsolete() in their loops and
+ * register interrupts for blocking calls, so that they return early.
+ *
  * Important: The Job and the contained data must be deleted in the callback functions.
  */
 class Job : public QObject, public QRunnable
@@ -52,22 +58,23 @@ public:
     // @brief Returns done flag
     bool done () { return done_; }
     void emitDone () { emit doneSignal(); }
-    // @brief Sets obsolete flag
-    void setObsolete () { obsolete_=true; }
-    // @brief Returns obsolete flag
-    bool obsolete () { return obsolete_; }
+    // @brief Sets obsolete flag, cancels the running work
+    void setObsolete () { cancellation_token_.cancel(); }
+    // @brief Returns obsolete flag, cheap enough to be polled in loops
+    bool obsolete () const { return cancellation_token_.cancelled(); }
+    CancellationToken& cancellationToken () { return cancellation_token_; }
     void emitObsolete () { emit doneSignal(); }
 
     const std::string &name() { return name_; }
 
 protected:
     std::string name_;
-    ///
-    bool started_ {false};
-    /// Done flag
-    bool done_ {false};
+    /// Started flag, set in the worker thread
+    std::atomic<bool> started_ {false};
+    /// Done flag, set in the worker thread
+    std::atomic<bool> done_ {false};
     /// Obsolete flag
-    bool obsolete_ {false};
+    CancellationToken cancellation_token_;
 
     virtual void setDone () { done_=true; }
 };
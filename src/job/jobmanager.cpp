@@ -57,6 +57,28 @@ void JobManager::addNonBlockingJob (std::shared_ptr<Job> job)
     updateWidget();
 }
 
+void JobManager::addParallelJob (std::shared_ptr<Job> job)
+{
+    logdbg << "JobManager: addParallelJob: " << job->name() << " num " << parallel_jobs_.unsafe_size();
+
+    ++num_parallel_jobs_; // counted until finalized, since the list is only accessed in the manager thread
+    parallel_jobs_.push(job); // add and start
+    QThreadPool::globalInstance()->start(job.get());
+
+    updateWidget();
+}
+
+void JobManager::addLongRunningJob (std::shared_ptr<Job> job)
+{
+    logdbg << "JobManager: addLongRunningJob: " << job->name() << " num " << parallel_jobs_.unsafe_size();
+
+    ++num_parallel_jobs_; // finalized like parallel jobs
+    parallel_jobs_.push(job);
+    long_running_pool_.start(job.get());
+
+    updateWidget();
+}
+
 void JobManager::addDBJob (std::shared_ptr<Job> job)
 {
     queued_db_jobs_.push(job);
@@ -74,7 +96,7 @@ void JobManager::cancelJob (std::shared_ptr<Job> job)
 
 bool JobManager::hasAnyJobs()
 {
-    return hasBlockingJobs() || hasNonBlockingJobs() || hasDBJobs();
+    return hasBlockingJobs() || hasNonBlockingJobs() || hasParallelJobs() || hasDBJobs();
 }
 
 bool JobManager::hasBlockingJobs ()
@@ -88,6 +110,11 @@ bool JobManager::hasNonBlockingJobs ()
 
 }
 
+bool JobManager::hasParallelJobs ()
+{
+    return num_parallel_jobs_ > 0;
+}
+
 bool JobManager::hasDBJobs()
 {
     return active_db_job_ || !queued_db_jobs_.empty();
@@ -116,6 +143,9 @@ void JobManager::run()
         if (hasNonBlockingJobs())
             handleNonBlockingJobs();
 
+        if (hasParallelJobs())
+            handleParallelJobs();
+
         if (hasDBJobs())
             handleDBJobs();
 
@@ -131,6 +161,7 @@ void JobManager::run()
 
     assert (!hasBlockingJobs());
     assert (!hasNonBlockingJobs());
+    assert (!hasParallelJobs());
     assert (!hasDBJobs());
 
     stopped_=true;
@@ -222,11 +253,56 @@ void JobManager::handleNonBlockingJobs ()
 
     }
 }
+void JobManager::handleParallelJobs ()
+{
+    std::shared_ptr<Job> job;
+
+    while (parallel_jobs_.try_pop(job))
+        active_parallel_jobs_.push_back(job);
+
+    for (auto job_it = active_parallel_jobs_.begin(); job_it != active_parallel_jobs_.end();)
+    {
+        if (stop_requested_ && !(*job_it)->obsolete()) // continuously running jobs quit when obsolete
+            (*job_it)->setObsolete();
+
+        // obsolete jobs are kept until they returned, since they were already handed to the thread pool
+        if ((*job_it)->done()) // can be finalized
+        {
+            if ((*job_it)->obsolete())
+            {
+                logdbg << "JobManager: run: flushing obsolete parallel job";
+
+                if (!stop_requested_)
+                    (*job_it)->emitObsolete();
+            }
+
+            logdbg << "JobManager: run: flushing parallel done job";
+
+            if (!stop_requested_)
+            {
+                (*job_it)->emitDone();
+                logdbg << "JobManager: run: done parallel job emitted "+(*job_it)->name();
+            }
+
+            job_it = active_parallel_jobs_.erase(job_it);
+
+            assert (num_parallel_jobs_);
+            --num_parallel_jobs_;
+
+            changed_ = true;
+            really_update_widget_ = !hasParallelJobs();
+        }
+        else
+            ++job_it;
+    }
+}
+
 void JobManager::handleDBJobs ()
 {
     if (active_db_job_) // see if active one exists
     {
-        if (active_db_job_->obsolete() || active_db_job_->done())
+        // running obsolete jobs are kept until they returned, they are interrupted and do so quickly
+        if (active_db_job_->done())
         {
             if(active_db_job_->obsolete())
             {
@@ -248,15 +324,30 @@ void JobManager::handleDBJobs ()
         }
     }
 
-    if (!active_db_job_ && !queued_db_jobs_.empty())
+    while (!active_db_job_ && !queued_db_jobs_.empty())
     {
-        if (queued_db_jobs_.try_pop(active_db_job_))
+        if (!queued_db_jobs_.try_pop(active_db_job_))
+            break;
+
+        changed_ = true;
+
+        if (active_db_job_->obsolete()) // cancelled before started, flush without running
         {
-            QThreadPool::globalInstance()->start(active_db_job_.get());
+            logdbg << "JobManager: run: flushing obsolete queued db job";
 
-            changed_ = true;
-            really_update_widget_ = !hasDBJobs();
+            if (!stop_requested_)
+            {
+                active_db_job_->emitObsolete();
+                active_db_job_->emitDone();
+            }
+
+            active_db_job_ = nullptr;
+            continue;
         }
+
+        QThreadPool::globalInstance()->start(active_db_job_.get());
+
+        really_update_widget_ = !hasDBJobs();
     }
 }
 
@@ -279,12 +370,16 @@ void JobManager::shutdown ()
     for (auto job_it = non_blocking_jobs_.unsafe_begin(); job_it != non_blocking_jobs_.unsafe_end(); ++job_it)
         (*job_it)->setObsolete ();
 
+    for (auto job_it = parallel_jobs_.unsafe_begin(); job_it != parallel_jobs_.unsafe_end(); ++job_it)
+        (*job_it)->setObsolete ();
+
     loginf  << "JobManager: shutdown: waiting on jobs to quit";
 
     while (hasAnyJobs())
     {
         loginf  << "JobManager: shutdown: waiting on jobs to finish: db " << hasDBJobs()
-                << " blocking " << hasBlockingJobs() << " non-locking " << hasNonBlockingJobs();
+                << " blocking " << hasBlockingJobs() << " non-locking " << hasNonBlockingJobs()
+                << " parallel " << hasParallelJobs();
 
         msleep(1000);
     }
@@ -309,6 +404,9 @@ void JobManager::shutdown ()
     assert (!active_non_blocking_job_);
     assert (non_blocking_jobs_.empty());
 
+    assert (!active_parallel_jobs_.size());
+    assert (parallel_jobs_.empty());
+
     assert (!active_db_job_);
     assert (queued_db_jobs_.empty());
 
@@ -337,6 +435,11 @@ unsigned int JobManager::numNonBlockingJobs ()
     return active_non_blocking_job_ ? non_blocking_jobs_.unsafe_size()+1 : non_blocking_jobs_.unsafe_size();
 }
 
+unsigned int JobManager::numParallelJobs ()
+{
+    return num_parallel_jobs_;
+}
+
 unsigned int JobManager::numDBJobs ()
 {
     return active_db_job_ ? queued_db_jobs_.unsafe_size()+1 : queued_db_jobs_.unsafe_size();
@@ -344,12 +447,12 @@ unsigned int JobManager::numDBJobs ()
 
 unsigned int JobManager::numJobs ()
 {
-    return numBlockingJobs() + numNonBlockingJobs();
+    return numBlockingJobs() + numNonBlockingJobs() + numParallelJobs();
 }
 
 int JobManager::numThreads ()
 {
-    return QThreadPool::globalInstance()->activeThreadCount();
+    return QThreadPool::globalInstance()->activeThreadCount() + long_running_pool_.activeThreadCount();
 }
 
 void JobManager::updateWidget (bool really)
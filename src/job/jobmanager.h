@@ -22,10 +22,12 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #endif
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <QMutex>
 #include <QThread>
+#include <QThreadPool>
 
 #include <tbb/concurrent_queue.h>
 
@@ -63,6 +65,11 @@ public:
     void addBlockingJob (std::shared_ptr<Job> job);
     // does not block start of later ones
     void addNonBlockingJob (std::shared_ptr<Job> job);
+    // started at once, done signal emitted when done, independent of order of other jobs
+    void addParallelJob (std::shared_ptr<Job> job);
+    // parallel job started in a separate thread pool, for jobs waiting on other jobs, e.g. paused decoding, which
+    // must not occupy the threads of the global pool
+    void addLongRunningJob (std::shared_ptr<Job> job);
     // only one db job can be active
     void addDBJob (std::shared_ptr<Job> job);
     void cancelJob (std::shared_ptr<Job> job);
@@ -70,10 +77,12 @@ public:
     bool hasAnyJobs();
     bool hasBlockingJobs ();
     bool hasNonBlockingJobs ();
+    bool hasParallelJobs ();
     bool hasDBJobs();
 
     unsigned int numBlockingJobs ();
     unsigned int numNonBlockingJobs ();
+    unsigned int numParallelJobs ();
     unsigned int numJobs ();
     unsigned int numDBJobs ();
     int numThreads ();
@@ -102,6 +111,14 @@ protected:
     std::shared_ptr<Job> active_non_blocking_job_;
     tbb::concurrent_queue <std::shared_ptr<Job>> non_blocking_jobs_;
 
+    /// only accessed in the manager thread
+    std::list <std::shared_ptr<Job>> active_parallel_jobs_;
+    /// number of added parallel jobs which were not yet finalized, queried from other threads
+    std::atomic<unsigned int> num_parallel_jobs_ {0};
+    tbb::concurrent_queue <std::shared_ptr<Job>> parallel_jobs_;
+    /// runs long running parallel jobs
+    QThreadPool long_running_pool_;
+
     std::shared_ptr<Job> active_db_job_;
     tbb::concurrent_queue <std::shared_ptr<Job>> queued_db_jobs_;
 
@@ -119,6 +136,7 @@ private:
     // set change flags as appropriate
     void handleBlockingJobs ();
     void handleNonBlockingJobs ();
+    void handleParallelJobs ();
     void handleDBJobs ();
 };
 
@@ -3,6 +3,7 @@
 #include "buffer.h"
 #include "dbobject.h"
 #include "logger.h"
+#include "flathashset.h"
 
 JSONMappingJob::JSONMappingJob(std::unique_ptr<std::vector<nlohmann::json>> extracted_records,
                                const std::map <std::string, JSONObjectParser>& parsers, size_t key_count)
@@ -96,6 +97,9 @@ void JSONMappingJob::run ()
         }
     }
 
+    logdbg << "JSONMappingJob: run: discovering data sources";
+    discoverDataSources();
+
     done_ = true;
 
     logdbg << "JSONMappingJob: run: done: mapped " << num_created_ << " skipped " << num_not_mapped_;
@@ -121,3 +125,74 @@ std::map<unsigned int, std::pair<size_t, size_t> > JSONMappingJob::categoryMappe
 {
     return category_mapped_counts_;
 }
+
+void JSONMappingJob::discoverDataSources ()
+{
+    for (auto& parser_it : parsers_)
+    {
+        const JSONObjectParser& parser = parser_it.second;
+        std::string data_source_var_name = parser.dataSourceVariableName();
+
+        if (!data_source_var_name.size())
+            continue;
+
+        DBObject& db_object = parser.dbObject();
+
+        if (data_sources_.count(db_object.name())) // buffer shared by several parsers
+            continue;
+
+        assert (buffers_.count(db_object.name()));
+        std::shared_ptr<Buffer>& buffer = buffers_.at(db_object.name());
+
+        if (!buffer || !buffer->size())
+            continue;
+
+        assert (buffer->properties().hasProperty(data_source_var_name));
+        assert (buffer->properties().get(data_source_var_name).dataType() == PropertyDataType::INT);
+
+        NullableVector<int>& keys = buffer->get<int> (data_source_var_name);
+        std::map<int, std::pair<int,int>>& data_sources = data_sources_[db_object.name()];
+
+        bool has_sac_sic = db_object.hasVariable("sac") && db_object.hasVariable("sic");
+
+        // sac/sic are mapped as unsigned char from ASTERIX, as char from JSON
+        if (has_sac_sic && buffer->has<unsigned char>("sac") && buffer->has<unsigned char>("sic"))
+            collectDataSources<unsigned char>(data_sources, *buffer, keys, &buffer->get<unsigned char>("sac"),
+                                              &buffer->get<unsigned char>("sic"));
+        else if (has_sac_sic && buffer->has<char>("sac") && buffer->has<char>("sic"))
+            collectDataSources<char>(data_sources, *buffer, keys, &buffer->get<char>("sac"),
+                                     &buffer->get<char>("sic"));
+        else
+            collectDataSources<char>(data_sources, *buffer, keys, nullptr, nullptr);
+
+        logdbg << "JSONMappingJob: discoverDataSources: " << db_object.name() << " " << data_sources.size()
+               << " data sources";
+    }
+}
+
+template <typename T>
+void JSONMappingJob::collectDataSources (std::map<int, std::pair<int,int>>& data_sources, Buffer& buffer,
+                                         NullableVector<int>& keys, NullableVector<T>* sacs,
+                                         NullableVector<T>* sics)
+{
+    Utils::FlatHashSet<int> distinct_keys;
+
+    size_t size = buffer.size();
+    int key_val;
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+    {
+        if (keys.isNull(cnt))
+            continue;
+
+        key_val = keys.get(cnt);
+
+        if (!distinct_keys.insert(key_val))
+            continue;
+
+        if (sacs && sics && !sacs->isNull(cnt) && !sics->isNull(cnt))
+            data_sources[key_val] = {static_cast<int>(sacs->get(cnt)), static_cast<int>(sics->get(cnt))};
+        else
+            data_sources[key_val] = {-1, -1};
+    }
+}
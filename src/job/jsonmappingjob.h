@@ -10,6 +10,9 @@
 class JSONObjectParser;
 class Buffer;
 
+template <class T>
+class NullableVector;
+
 class JSONMappingJob : public Job
 {
 public:
@@ -28,6 +31,9 @@ public:
 
     std::map<unsigned int, std::pair<size_t, size_t> > categoryMappedCounts() const;
 
+    /// @brief Returns distinct data sources found in the buffers, dbo name -> key -> (sac, sic), -1 if unknown
+    const std::map<std::string, std::map<int, std::pair<int,int>>>& dataSources() const { return data_sources_; }
+
 private:
     std::map<unsigned int, std::pair<size_t,size_t>> category_mapped_counts_; // mapped, not mapped
     size_t num_mapped_ {0}; // number of parsed where a parse was successful
@@ -39,6 +45,12 @@ private:
     size_t key_count_;
 
     std::map<std::string, std::shared_ptr<Buffer>> buffers_;
+    std::map<std::string, std::map<int, std::pair<int,int>>> data_sources_;
+
+    void discoverDataSources ();
+    template <typename T>
+    void collectDataSources (std::map<int, std::pair<int,int>>& data_sources, Buffer& buffer,
+                             NullableVector<int>& keys, NullableVector<T>* sacs, NullableVector<T>* sics);
 };
 
 #endif // JSONMAPPINGJOB_H
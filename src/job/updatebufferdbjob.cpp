@@ -71,8 +71,13 @@ void UpdateBufferDBJob::run ()
         logdbg << "UpdateBufferDBJob: run: step " << cnt << " steps " << steps << " from " << index_from
                << " to " << index_to;
 
-        db_interface_.updateBuffer (dbobject_.currentMetaTable(), key_var_.currentDBColumn(), buffer_,
-                                    index_from, index_to);
+        if (!db_interface_.updateBuffer (dbobject_.currentMetaTable(), key_var_.currentDBColumn(), buffer_,
+                                         index_from, index_to, &cancellation_token_))
+        {
+            loginf << "UpdateBufferDBJob: run: " << dbobject_.name() << ": cancelled in step " << cnt;
+            done_=true;
+            return;
+        }
 
         emit updateProgressSignal(100.0*index_to/buffer_->size());
     }
@@ -22,6 +22,7 @@
 #include "atsdb.h"
 #include "jsonobjectparser.h"
 #include "jsondatamappingwidget.h"
+#include "jsonvalueconverter.h"
 
 JSONDataMapping::JSONDataMapping (const std::string& class_id, const std::string& instance_id,
                                   JSONObjectParser& parent)
@@ -80,6 +81,7 @@ JSONDataMapping& JSONDataMapping::operator=(JSONDataMapping&& other)
     //json_value_format_ = other.json_value_format_;
     format_data_type_ = other.format_data_type_;
     json_value_format_ = std::move(other.json_value_format_);
+    converters_ = other.converters_;
 
     dimension_ = other.dimension_;
     unit_ = other.unit_;
@@ -314,9 +316,37 @@ void JSONDataMapping::initialize ()
 
     }
 
+    updateConverters();
+
     initialized_ =  true;
 }
 
+void JSONDataMapping::updateConverters ()
+{
+    logdbg << "JSONDataMapping: updateConverters: key " << json_key_ << " format '" << json_value_format_ << "'";
+
+    Format::Type type = json_value_format_.type();
+
+    if (type == Format::Type::NONE)
+    {
+        converters_ = decltype(converters_) {};
+        return;
+    }
+
+    converter<char>() = JSONValueConverter<char>::function(type);
+    converter<unsigned char>() = JSONValueConverter<unsigned char>::function(type);
+    converter<short int>() = JSONValueConverter<short int>::function(type);
+    converter<unsigned short int>() = JSONValueConverter<unsigned short int>::function(type);
+    converter<int>() = JSONValueConverter<int>::function(type);
+    converter<unsigned int>() = JSONValueConverter<unsigned int>::function(type);
+    converter<long int>() = JSONValueConverter<long int>::function(type);
+    converter<unsigned long int>() = JSONValueConverter<unsigned long int>::function(type);
+    converter<float>() = JSONValueConverter<float>::function(type);
+    converter<double>() = JSONValueConverter<double>::function(type);
+    converter<Timestamp>() = JSONValueConverter<Timestamp>::function(type);
+    converter<std::string>() = JSONValueConverter<std::string>::function(type);
+}
+
 template<typename T>
 bool JSONDataMapping::findAndSetValue(const nlohmann::json& j, NullableVector<T>& array_list, size_t row_cnt) const
 {
@@ -409,6 +439,10 @@ NullableVector<char>& array_list, size_t row_cnt) const;
 template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
 NullableVector<unsigned char>& array_list, size_t row_cnt) const;
 template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
+NullableVector<short int>& array_list, size_t row_cnt) const;
+template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
+NullableVector<unsigned short int>& array_list, size_t row_cnt) const;
+template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
 NullableVector<int>& array_list, size_t row_cnt) const;
 template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
 NullableVector<unsigned int>& array_list, size_t row_cnt) const;
@@ -421,6 +455,8 @@ NullableVector<float>& array_list, size_t row_cnt) const;
 template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
 NullableVector<double>& array_list, size_t row_cnt) const;
 template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
+NullableVector<Timestamp>& array_list, size_t row_cnt) const;
+template bool JSONDataMapping::findAndSetValue(const nlohmann::json& j,
 NullableVector<std::string>& array_list, size_t row_cnt) const;
 
 const nlohmann::json* JSONDataMapping::findKey (const nlohmann::json& j) const
@@ -509,10 +545,10 @@ void JSONDataMapping::setValue(const nlohmann::json* val_ptr, NullableVector<T>&
     logdbg << "JSONDataMapping: setValue: key " << json_key_ << " json " << val_ptr->type_name()
            << " '" << val_ptr->dump() << "' format '" << json_value_format_ << "'";
 
-    if (json_value_format_ == "")
-        array_list.set(row_cnt, *val_ptr);
+    if (converter<T>())
+        array_list.set(row_cnt, converter<T>()(*val_ptr));
     else
-        array_list.setFromFormat(row_cnt, json_value_format_, Utils::JSON::toString(*val_ptr));
+        array_list.set(row_cnt, *val_ptr);
 
     logdbg << "JSONDataMapping: setValue: key " << json_key_ << " json " << *val_ptr
            << " buffer " << array_list.get(row_cnt);
@@ -526,10 +562,10 @@ void JSONDataMapping::appendValue(const nlohmann::json* val_ptr, NullableVector<
     logdbg << "JSONDataMapping: appendValue: key " << json_key_ << " json " << val_ptr->type_name()
            << " '" << val_ptr->dump() << "' format '" << json_value_format_ << "'";
 
-    if (json_value_format_ == "")
-        array_list.append(row_cnt, *val_ptr);
+    if (converter<T>())
+        array_list.append(row_cnt, converter<T>()(*val_ptr));
     else
-        array_list.appendFromFormat(row_cnt, json_value_format_, Utils::JSON::toString(*val_ptr));
+        array_list.append(row_cnt, *val_ptr);
 
     logdbg << "JSONDataMapping: appendValue: key " << json_key_ << " json " << *val_ptr
            << " buffer " << array_list.get(row_cnt);
@@ -589,11 +625,10 @@ void JSONDataMapping::setValue(const nlohmann::json* val_ptr, NullableVector<cha
 {
     assert (val_ptr);
 
-    if (json_value_format_ == "")
-        array_list.set(row_cnt, static_cast<int> (*val_ptr));
+    if (converter<char>())
+        array_list.set(row_cnt, converter<char>()(*val_ptr));
     else
-        array_list.setFromFormat(row_cnt, json_value_format_,
-                                 Utils::JSON::toString(static_cast<int> (*val_ptr)));
+        array_list.set(row_cnt, static_cast<int> (*val_ptr));
 
     logdbg << "JSONDataMapping: setValue(char): json " << static_cast<int> (*val_ptr) << " buffer "
            << array_list.get(row_cnt);
@@ -603,11 +638,10 @@ void JSONDataMapping::appendValue(const nlohmann::json* val_ptr, NullableVector<
 {
     assert (val_ptr);
 
-    if (json_value_format_ == "")
-        array_list.append(row_cnt, static_cast<int> (*val_ptr));
+    if (converter<char>())
+        array_list.append(row_cnt, converter<char>()(*val_ptr));
     else
-        array_list.appendFromFormat(row_cnt, json_value_format_,
-                                    Utils::JSON::toString(static_cast<int> (*val_ptr)));
+        array_list.append(row_cnt, static_cast<int> (*val_ptr));
 
     logdbg << "JSONDataMapping: appendValue(char): json " << static_cast<int> (*val_ptr) << " buffer "
            << array_list.get(row_cnt);
@@ -618,6 +652,16 @@ NullableVector<unsigned char>& array_list, size_t row_cnt) const;
 template void JSONDataMapping::appendValue(const nlohmann::json* val_ptr,
 NullableVector<unsigned char>& array_list, size_t row_cnt) const;
 
+template void JSONDataMapping::setValue(const nlohmann::json* val_ptr,
+NullableVector<short int>& array_list, size_t row_cnt) const;
+template void JSONDataMapping::appendValue(const nlohmann::json* val_ptr,
+NullableVector<short int>& array_list, size_t row_cnt) const;
+
+template void JSONDataMapping::setValue(const nlohmann::json* val_ptr,
+NullableVector<unsigned short int>& array_list, size_t row_cnt) const;
+template void JSONDataMapping::appendValue(const nlohmann::json* val_ptr,
+NullableVector<unsigned short int>& array_list, size_t row_cnt) const;
+
 template void JSONDataMapping::setValue(const nlohmann::json* val_ptr,
 NullableVector<int>& array_list, size_t row_cnt) const;
 template void JSONDataMapping::appendValue(const nlohmann::json* val_ptr,
@@ -648,14 +692,41 @@ NullableVector<double>& array_list, size_t row_cnt) const;
 template void JSONDataMapping::appendValue(const nlohmann::json* val_ptr,
 NullableVector<double>& array_list, size_t row_cnt) const;
 
+void JSONDataMapping::setValue(const nlohmann::json* val_ptr, NullableVector<Timestamp>& array_list,
+                               size_t row_cnt) const
+{
+    assert (val_ptr);
+
+    if (converter<Timestamp>())
+        array_list.set(row_cnt, converter<Timestamp>()(*val_ptr));
+    else
+        array_list.set(row_cnt, Timestamp (val_ptr->get<double>()));
+
+    logdbg << "JSONDataMapping: setValue(timestamp): json " << *val_ptr << " buffer " << array_list.get(row_cnt);
+}
+
+void JSONDataMapping::appendValue(const nlohmann::json* val_ptr, NullableVector<Timestamp>& array_list,
+                                  size_t row_cnt) const
+{
+    assert (val_ptr);
+
+    if (converter<Timestamp>())
+        array_list.append(row_cnt, converter<Timestamp>()(*val_ptr));
+    else
+        array_list.append(row_cnt, Timestamp (val_ptr->get<double>()));
+
+    logdbg << "JSONDataMapping: appendValue(timestamp): json " << *val_ptr << " buffer "
+           << array_list.get(row_cnt);
+}
+
 void JSONDataMapping::setValue(const nlohmann::json* val_ptr, NullableVector<std::string>& array_list, size_t row_cnt) const
 {
     assert (val_ptr);
 
-    if (json_value_format_ == "")
-        array_list.set(row_cnt, Utils::JSON::toString(*val_ptr));
+    if (converter<std::string>())
+        array_list.set(row_cnt, converter<std::string>()(*val_ptr));
     else
-        array_list.setFromFormat(row_cnt, json_value_format_, Utils::JSON::toString(*val_ptr));
+        array_list.set(row_cnt, Utils::JSON::toString(*val_ptr));
 
     logdbg << "JSONDataMapping: setValue(string): json " << Utils::JSON::toString(*val_ptr)
            << " buffer " << array_list.get(row_cnt);
@@ -665,10 +736,10 @@ void JSONDataMapping::appendValue(const nlohmann::json* val_ptr, NullableVector<
 {
     assert (val_ptr);
 
-    if (json_value_format_ == "")
-        array_list.append(row_cnt, Utils::JSON::toString(*val_ptr));
+    if (converter<std::string>())
+        array_list.append(row_cnt, converter<std::string>()(*val_ptr));
     else
-        array_list.appendFromFormat(row_cnt, json_value_format_, Utils::JSON::toString(*val_ptr));
+        array_list.append(row_cnt, Utils::JSON::toString(*val_ptr));
 
     logdbg << "JSONDataMapping: setValue(string): json " << Utils::JSON::toString(*val_ptr)
            << " buffer " << array_list.get(row_cnt);
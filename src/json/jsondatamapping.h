@@ -22,6 +22,8 @@
 #include "logger.h"
 #include "format.h"
 #include "nullablevector.h"
+#include "buffer.h"
+#include "jsonvalueconverter.h"
 #include "jsonutils.h"
 #include "configurable.h"
 #include "jsondatamappingwidget.h"
@@ -95,6 +97,9 @@ public:
     bool inArray() const;
     void inArray(bool inArray);
 
+    /// @brief Resolves the value converters for the current format, to be called when it was changed
+    void updateConverters ();
+
 private:
     bool initialized_ {false};
 
@@ -113,6 +118,20 @@ private:
     Format json_value_format_;
     //std::unique_ptr<Format> json_value_format_;
 
+    /// Converters for json_value_format_ per buffer data type, resolved once instead of per value
+    std::tuple<JSONValueConverter<char>::Function,
+    JSONValueConverter<unsigned char>::Function,
+    JSONValueConverter<short int>::Function,
+    JSONValueConverter<unsigned short int>::Function,
+    JSONValueConverter<int>::Function,
+    JSONValueConverter<unsigned int>::Function,
+    JSONValueConverter<long int>::Function,
+    JSONValueConverter<unsigned long int>::Function,
+    JSONValueConverter<float>::Function,
+    JSONValueConverter<double>::Function,
+    JSONValueConverter<Timestamp>::Function,
+    JSONValueConverter<std::string>::Function> converters_;
+
     /// Unit dimension
     std::string dimension_;
     /// Unit
@@ -131,6 +150,15 @@ private:
 
     void initialize ();
 
+    template<typename T> typename JSONValueConverter<T>::Function& converter ()
+    {
+        return std::get<Index<typename JSONValueConverter<T>::Function, decltype(converters_)>::value>(converters_);
+    }
+    template<typename T> typename JSONValueConverter<T>::Function converter () const
+    {
+        return std::get<Index<typename JSONValueConverter<T>::Function, decltype(converters_)>::value>(converters_);
+    }
+
 protected:
     virtual void checkSubConfigurables () {}
 
@@ -149,6 +177,9 @@ protected:
     // char template functions
     void setValue(const nlohmann::json* val_ptr, NullableVector<char>& array_list, size_t row_cnt) const;
     void appendValue(const nlohmann::json* val_ptr, NullableVector<char>& array_list, size_t row_cnt) const;
+    // timestamp template functions, json values are seconds
+    void setValue(const nlohmann::json* val_ptr, NullableVector<Timestamp>& array_list, size_t row_cnt) const;
+    void appendValue(const nlohmann::json* val_ptr, NullableVector<Timestamp>& array_list, size_t row_cnt) const;
     // string template functions
     void setValue(const nlohmann::json* val_ptr, NullableVector<std::string>& array_list, size_t row_cnt) const;
     void appendValue(const nlohmann::json* val_ptr, NullableVector<std::string>& array_list, size_t row_cnt) const;
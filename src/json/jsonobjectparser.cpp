@@ -406,6 +406,25 @@ bool JSONObjectParser::parseTargetReport (const nlohmann::json& tr, std::shared_
 
             break;
         }
+        case PropertyDataType::SHORTINT:
+        {
+            logdbg << "JSONObjectParser: parseTargetReport: short " << current_var_name << " format '"
+                   << map_it.jsonValueFormat() << "'";
+            assert (buffer->has<short int>(current_var_name));
+            mandatory_missing = map_it.findAndSetValue (tr, buffer->get<short int> (current_var_name), row_cnt);
+
+            break;
+        }
+        case PropertyDataType::USHORTINT:
+        {
+            logdbg << "JSONObjectParser: parseTargetReport: ushort " << current_var_name << " format '"
+                   << map_it.jsonValueFormat() << "'";
+            assert (buffer->has<unsigned short int>(current_var_name));
+            mandatory_missing = map_it.findAndSetValue (tr, buffer->get<unsigned short int> (current_var_name),
+                                                        row_cnt);
+
+            break;
+        }
         case PropertyDataType::INT:
         {
             logdbg << "JSONObjectParser: parseTargetReport: int " << current_var_name << " format '"
@@ -460,6 +479,15 @@ bool JSONObjectParser::parseTargetReport (const nlohmann::json& tr, std::shared_
 
             break;
         }
+        case PropertyDataType::TIMESTAMP:
+        {
+            logdbg << "JSONObjectParser: parseTargetReport: timestamp " << current_var_name << " format '"
+                   << map_it.jsonValueFormat() << "'";
+            assert (buffer->has<Timestamp>(current_var_name));
+            mandatory_missing = map_it.findAndSetValue (tr, buffer->get<Timestamp> (current_var_name), row_cnt);
+
+            break;
+        }
         case PropertyDataType::STRING:
         {
             logdbg << "JSONObjectParser: parseTargetReport: string " << current_var_name << " format '"
@@ -762,6 +790,32 @@ void JSONObjectParser::transformBuffer (std::shared_ptr<Buffer>& buffer, size_t
                 array_list.set(index, array_list.get(index) * factor);
                 break;
             }
+            case PropertyDataType::SHORTINT:
+            {
+                assert (buffer->has<short int>(current_var_name));
+                NullableVector<short int> &array_list = buffer->get<short int> (current_var_name);
+
+                if (array_list.isNull(index))
+                    break;
+
+                logdbg << "JSONObjectParser: transformBuffer: double multiplication of short variable "
+                       << current_var_name << " factor " << factor;
+                array_list.set(index, array_list.get(index) * factor);
+                break;
+            }
+            case PropertyDataType::USHORTINT:
+            {
+                assert (buffer->has<unsigned short int>(current_var_name));
+                NullableVector<unsigned short int> &array_list = buffer->get<unsigned short int> (current_var_name);
+
+                if (array_list.isNull(index))
+                    break;
+
+                logdbg << "JSONObjectParser: transformBuffer: double multiplication of unsigned short variable "
+                       << current_var_name << " factor " << factor;
+                array_list.set(index, array_list.get(index) * factor);
+                break;
+            }
             case PropertyDataType::INT:
             {
                 assert (buffer->has<int>(current_var_name));
@@ -840,6 +894,21 @@ void JSONObjectParser::transformBuffer (std::shared_ptr<Buffer>& buffer, size_t
                 array_list.set(index, array_list.get(index) * factor);
                 break;
             }
+            case PropertyDataType::TIMESTAMP:
+            {
+                assert (buffer->has<Timestamp>(current_var_name));
+                NullableVector<Timestamp> &array_list = buffer->get<Timestamp>(current_var_name);
+
+                if (array_list.isNull(index))
+                    break;
+
+                logdbg << "JSONObjectParser: transformBuffer: multiplication of timestamp variable "
+                       << current_var_name << " factor " << factor;
+                Timestamp value = array_list.get(index);
+                value *= factor;
+                array_list.set(index, value);
+                break;
+            }
             case PropertyDataType::STRING:
                 logerr << "JSONObjectParser: transformBuffer: unit transformation for string variable "
                        << data_it.variable().name() << " impossible";
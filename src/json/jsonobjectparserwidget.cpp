@@ -256,6 +256,8 @@ void JSONObjectParserWidget::updateMappingsGrid()
         DataTypeFormatSelectionWidget* data_format_widget
                 = new DataTypeFormatSelectionWidget (map_it.second.second->formatDataTypeRef(),
                                                      map_it.second.second->jsonValueFormatRef());
+        connect(data_format_widget, SIGNAL(selectionChanged()), this, SLOT(mappingFormatChangedSlot()));
+        data_format_widget->setProperty("mapping", data);
 
         mappings_grid_->addWidget (data_format_widget, row, 6);
 
@@ -450,6 +452,20 @@ void JSONObjectParserWidget::mappingMandatoryChangedSlot()
     mapping->mandatory(widget->checkState() == Qt::Checked);
 }
 
+void JSONObjectParserWidget::mappingFormatChangedSlot()
+{
+    loginf << "JSONObjectParserWidget: mappingFormatChangedSlot";
+
+    DataTypeFormatSelectionWidget* widget = static_cast<DataTypeFormatSelectionWidget*>(sender());
+    assert (widget);
+    QVariant data = widget->property("mapping");
+
+    JSONDataMapping* mapping = data.value<JSONDataMapping*>();
+    assert (mapping);
+
+    mapping->updateConverters();
+}
+
 void JSONObjectParserWidget::mappingInArrayChangedSlot()
 {
     loginf << "JSONObjectParserWidget: mappingInArrayChangedSlot";
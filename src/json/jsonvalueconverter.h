@@ -0,0 +1,89 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JSONVALUECONVERTER_H
+#define JSONVALUECONVERTER_H
+
+#include "json.hpp"
+#include "format.h"
+#include "formatconverter.h"
+
+/**
+ * @brief Registry of converters from formatted JSON values to buffer data types
+ *
+ * For each data type and format a converter is specialised at compile time, which reads numbers directly and
+ * strings in place. Wrongly typed or unparsable values throw a nlohmann::json::type_error, like the plain JSON
+ * conversions do.
+ */
+template <typename T> class JSONValueConverter
+{
+public:
+    typedef T (*Function) (const nlohmann::json& value);
+
+    /// @brief Returns converter for format type, NONE is not a conversion
+    static Function function (Format::Type type)
+    {
+        switch (type)
+        {
+        case Format::Type::DECIMAL:
+            return &convert<Format::Type::DECIMAL>;
+        case Format::Type::HEXADECIMAL:
+            return &convert<Format::Type::HEXADECIMAL>;
+        case Format::Type::OCTAL:
+            return &convert<Format::Type::OCTAL>;
+        case Format::Type::EPOCH_TOD_MS:
+            return &convert<Format::Type::EPOCH_TOD_MS>;
+        case Format::Type::EPOCH_TOD_S:
+            return &convert<Format::Type::EPOCH_TOD_S>;
+        default:
+            throw std::runtime_error ("JSONValueConverter: function: no conversion for format type "
+                                      +std::to_string(static_cast<int> (type)));
+        }
+    }
+
+    template <Format::Type F> static T convert (const nlohmann::json& value)
+    {
+        typedef Utils::FormatConverter::Kernel<F> Kernel;
+
+        if (value.is_number_integer())
+            return Utils::FormatConverter::Cast<T>::from(Kernel::fromInteger(value.get<long long>()));
+        else if (value.is_number_float())
+            return Utils::FormatConverter::Cast<T>::from(
+                        Kernel::fromInteger(static_cast<long long> (value.get<double>())));
+        else if (value.is_string())
+        {
+            const std::string& value_str = value.get_ref<const std::string&>();
+
+            try
+            {
+                return Utils::FormatConverter::Cast<T>::from(
+                            Kernel::fromString(value_str.data(), value_str.data()+value_str.size()));
+            }
+            catch (std::invalid_argument& e)
+            {
+                throw nlohmann::json::type_error::create(302, "value '"+value_str+"' not in format");
+            }
+        }
+        else if (value.is_boolean())
+            return Utils::FormatConverter::Cast<T>::from(Kernel::fromInteger(value.get<bool>()));
+
+        throw nlohmann::json::type_error::create(302, "type must be number or string, but is "
+                                                 + std::string(value.type_name()));
+    }
+};
+
+#endif // JSONVALUECONVERTER_H
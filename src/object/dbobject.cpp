@@ -27,6 +27,7 @@
 #include "dbobjectwidget.h"
 #include "dbobjectinfowidget.h"
 #include "dbobjectmanager.h"
+#include "metadbovariable.h"
 #include "dbovariable.h"
 #include "buffer.h"
 #include "filtermanager.h"
@@ -47,6 +48,8 @@
 #include "dboeditdatasourceactionoptionswidget.h"
 #include "storeddbodatasourcewidget.h"
 #include "stringconv.h"
+#include "viewmanager.h"
+#include "dbospatialindex.h"
 
 using namespace Utils;
 
@@ -920,12 +923,16 @@ void DBObject::clearData ()
 {
     logdbg << "DBObject " << name_ << ": clearData";
 
+    spatial_index_ = nullptr;
+
     if (data_)
     {
         data_ = nullptr;
 
         if (info_widget_)
             info_widget_->updateSlot();
+
+        manager_.checkMemoryBudget();
     }
 }
 
@@ -1067,7 +1074,12 @@ void DBObject::readJobIntermediateSlot (std::shared_ptr<Buffer> buffer)
         logwrn << "DBObject: readJobIntermediateSlot: null sender, event on the loose";
         return;
     }
-    assert (sender == read_job_.get());
+
+    if (sender != read_job_.get() || sender->obsolete()) // from cancelled previous load
+    {
+        logdbg << "DBObject: " << name_ << " readJobIntermediateSlot: ignoring buffer of obsolete job";
+        return;
+    }
 
     std::vector <DBOVariable*>& variables = sender->readList().getSet ();
     const PropertyList &properties = buffer->properties();
@@ -1084,7 +1096,7 @@ void DBObject::readJobIntermediateSlot (std::shared_ptr<Buffer> buffer)
 
     read_job_data_.push_back(buffer);
 
-    FinalizeDBOReadJob* job = new FinalizeDBOReadJob (*this, sender->readList(), buffer);
+    FinalizeDBOReadJob* job = new FinalizeDBOReadJob (*this, sender->readList(), sender->transformation(), buffer);
 
     std::shared_ptr<FinalizeDBOReadJob> job_ptr = std::shared_ptr<FinalizeDBOReadJob> (job);
     connect (job, SIGNAL(doneSignal()), this, SLOT(finalizeReadJobDoneSlot()), Qt::QueuedConnection);
@@ -1100,6 +1112,10 @@ void DBObject::readJobIntermediateSlot (std::shared_ptr<Buffer> buffer)
 void DBObject::readJobObsoleteSlot ()
 {
     logdbg << "DBObject: " << name_ << " readJobObsoleteSlot";
+
+    if (!read_job_ || QObject::sender() != read_job_.get()) // from cancelled previous load
+        return;
+
     read_job_ = nullptr;
     read_job_data_.clear();
 
@@ -1112,6 +1128,10 @@ void DBObject::readJobObsoleteSlot ()
 void DBObject::readJobDoneSlot()
 {
     logdbg << "DBObject: " << name_ << " readJobDoneSlot";
+
+    if (!read_job_ || QObject::sender() != read_job_.get()) // from cancelled previous load
+        return;
+
     read_job_ = nullptr;
 
     if (info_widget_)
@@ -1150,6 +1170,13 @@ void DBObject::finalizeReadJobDoneSlot()
     }
     assert (found);
 
+    // contents are moved into data_ below, so the chunk is not held after e.g. a streaming consumer cleared data_
+    auto read_data_it = std::find(read_job_data_.begin(), read_job_data_.end(), buffer);
+    if (read_data_it != read_job_data_.end())
+        read_job_data_.erase(read_data_it);
+
+    addToSpatialIndex(*buffer); // while the chunk is still in memory
+
     if (!data_)
     {
         data_ = buffer;
@@ -1159,6 +1186,8 @@ void DBObject::finalizeReadJobDoneSlot()
 
     logdbg << "DBObject: " << name_ << " finalizeReadJobDoneSlot: got buffer with size " << data_->size();
 
+    manager_.checkMemoryBudget();
+
     if (info_widget_)
         info_widget_->updateSlot();
 
@@ -1172,6 +1201,117 @@ void DBObject::finalizeReadJobDoneSlot()
 }
 
 
+DBOSpatialIndex& DBObject::spatialIndex ()
+{
+    assert (spatial_index_);
+    return *spatial_index_;
+}
+
+bool DBObject::positionColumns (Buffer& buffer, std::string& latitude_name, std::string& longitude_name)
+{
+    if (!manager_.existsMetaVariable("pos_lat_deg") || !manager_.existsMetaVariable("pos_long_deg")
+            || !manager_.metaVariable("pos_lat_deg").existsIn(name_)
+            || !manager_.metaVariable("pos_long_deg").existsIn(name_))
+        return false;
+
+    latitude_name = manager_.metaVariable("pos_lat_deg").getNameFor(name_);
+    longitude_name = manager_.metaVariable("pos_long_deg").getNameFor(name_);
+
+    return buffer.has<double>(latitude_name) && buffer.has<double>(longitude_name); // not loaded otherwise
+}
+
+void DBObject::updateSpatialIndex ()
+{
+    spatial_index_ = nullptr;
+
+    std::string latitude_name, longitude_name;
+
+    if (!manager_.useSpatialIndex() || !data_ || !positionColumns(*data_, latitude_name, longitude_name))
+        return;
+
+    spatial_index_.reset(new DBOSpatialIndex (manager_.spatialIndexCellSize()));
+    spatial_index_->add(data_->get<double>(latitude_name), data_->get<double>(longitude_name), 0, data_->size());
+
+    logdbg << "DBObject " << name_ << ": updateSpatialIndex: " << spatial_index_->size() << " rows in "
+           << spatial_index_->numCells() << " cells";
+}
+
+void DBObject::addToSpatialIndex (Buffer& buffer)
+{
+    std::string latitude_name, longitude_name;
+
+    if (!manager_.useSpatialIndex() || !positionColumns(buffer, latitude_name, longitude_name))
+    {
+        spatial_index_ = nullptr;
+        return;
+    }
+
+    size_t num_rows = data_ ? data_->size() : 0;
+
+    if (!spatial_index_ || spatial_index_->size() != num_rows) // new load, or index removed meanwhile
+    {
+        updateSpatialIndex();
+
+        if (!spatial_index_) // first chunk
+            spatial_index_.reset(new DBOSpatialIndex (manager_.spatialIndexCellSize()));
+    }
+
+    assert (spatial_index_->size() == num_rows);
+
+    spatial_index_->add(buffer.get<double>(latitude_name), buffer.get<double>(longitude_name), 0, buffer.size());
+}
+
+size_t DBObject::selectRegion (double latitude_min, double latitude_max, double longitude_min, double longitude_max)
+{
+    if (!data_ || !data_->has<bool>("selected"))
+        return 0;
+
+    NullableVector<bool>& selected_vec = data_->get<bool>("selected");
+    size_t num_selected {0};
+
+    if (spatial_index_)
+    {
+        assert (spatial_index_->size() == data_->size());
+
+        std::vector<bool> rows = spatial_index_->region(latitude_min, latitude_max, longitude_min, longitude_max);
+
+        for (size_t row=0; row < rows.size(); ++row)
+        {
+            selected_vec.set(row, rows[row]);
+
+            if (rows[row])
+                ++num_selected;
+        }
+    }
+    else // not indexed, check loaded positions
+    {
+        std::string latitude_name, longitude_name;
+
+        if (!positionColumns(*data_, latitude_name, longitude_name))
+            return 0;
+
+        NullableVector<double>& latitude_vec = data_->get<double>(latitude_name);
+        NullableVector<double>& longitude_vec = data_->get<double>(longitude_name);
+
+        for (size_t row=0; row < data_->size(); ++row)
+        {
+            bool inside = !latitude_vec.isNull(row) && !longitude_vec.isNull(row)
+                    && latitude_vec.get(row) >= latitude_min && latitude_vec.get(row) <= latitude_max
+                    && longitude_vec.get(row) >= longitude_min && longitude_vec.get(row) <= longitude_max;
+
+            selected_vec.set(row, inside);
+
+            if (inside)
+                ++num_selected;
+        }
+    }
+
+    loginf << "DBObject " << name_ << ": selectRegion: selected " << num_selected << " of " << data_->size()
+           << " rows";
+
+    return num_selected;
+}
+
 void DBObject::updateToDatabaseContent ()
 {
     loginf << "DBObject " << name_ << ": updateToDatabaseContent";
@@ -1229,6 +1369,46 @@ size_t DBObject::loadedCount ()
         return 0;
 }
 
+size_t DBObject::memoryUsage ()
+{
+    size_t bytes = 0;
+
+    if (data_)
+        bytes += data_->memoryUsage();
+
+    if (spatial_index_)
+        bytes += spatial_index_->memoryUsage();
+
+    return bytes;
+}
+
+unsigned int DBObject::numSpilledColumns ()
+{
+    if (data_)
+        return data_->numSpilled();
+    else
+        return 0;
+}
+
+size_t DBObject::spillData (size_t bytes_to_free)
+{
+    if (!data_)
+        return 0;
+
+    std::set<std::string> keep_properties {"rec_num", "selected"};
+
+    DBOVariableSet read_set = ATSDB::instance().viewManager().getReadSet(name_);
+
+    for (auto var_it : read_set.getSet())
+        keep_properties.insert(var_it->name());
+
+    size_t freed_bytes = data_->spill(keep_properties, bytes_to_free);
+
+    loginf << "DBObject " << name_ << ": spillData: freed " << freed_bytes << " bytes";
+
+    return freed_bytes;
+}
+
 bool DBObject::existsInDB () const
 {
     if (!hasCurrentMetaTable())
@@ -49,6 +49,7 @@ class DBOVariableSet;
 class DBOLabelDefinition;
 class DBOLabelDefinitionWidget;
 class DBObjectManager;
+class DBOSpatialIndex;
 
 using DBOEditDataSourceActionOptionsCollection = typename std::map<unsigned int, DBOEditDataSourceActionOptions>;
 
@@ -246,6 +247,22 @@ public:
 
     std::shared_ptr<Buffer> data () { return data_; }
 
+    /// @brief Returns if loaded data has an index over the pos_lat_deg/pos_long_deg meta variables
+    bool hasSpatialIndex () { return spatial_index_ != nullptr; }
+    /// @brief Returns spatial index, rows are the rows of the loaded data
+    DBOSpatialIndex& spatialIndex ();
+    /// @brief Rebuilds the spatial index over the loaded data, or removes it according to the manager settings
+    void updateSpatialIndex ();
+    /// @brief Sets selection of loaded rows to whether their position is inside the region, returns selected rows
+    size_t selectRegion (double latitude_min, double latitude_max, double longitude_min, double longitude_max);
+
+    /// @brief Returns number of bytes held by loaded data, including its spatial index
+    size_t memoryUsage ();
+    /// @brief Returns number of loaded columns currently spilled to disk
+    unsigned int numSpilledColumns ();
+    /// @brief Spills loaded columns not read by any view, returns freed bytes
+    size_t spillData (size_t bytes_to_free);
+
     void lock ();
     void unlock ();
 
@@ -287,6 +304,12 @@ protected:
     std::shared_ptr <UpdateBufferDBJob> update_job_ {nullptr};
 
     std::shared_ptr<Buffer> data_;
+    std::unique_ptr<DBOSpatialIndex> spatial_index_;
+
+    /// @brief Returns if the buffer has both pos_lat_deg/pos_long_deg columns, sets their names
+    bool positionColumns (Buffer& buffer, std::string& latitude_name, std::string& longitude_name);
+    /// @brief Adds the rows of a newly loaded chunk to the spatial index, to be called before it is added to data_
+    void addToSpatialIndex (Buffer& buffer);
 
     bool locked_ {false};
 
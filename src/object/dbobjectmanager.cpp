@@ -29,6 +29,12 @@
 #include "dbinterface.h"
 #include "stringconv.h"
 #include "viewmanager.h"
+#include "spillfile.h"
+#include "dbotimewindowpager.h"
+#include "dbovariablestatistics.h"
+#include "dbovariablestatisticsjob.h"
+#include "jobmanager.h"
+#include "buffer.h"
 
 #include <QApplication>
 
@@ -53,6 +59,26 @@ DBObjectManager::DBObjectManager(const std::string& class_id, const std::string&
     registerParameter("limit_min", &limit_min_, 0);
     registerParameter("limit_max", &limit_max_, 100000);
 
+    registerParameter("use_memory_budget", &use_memory_budget_, false);
+    registerParameter("memory_budget_mb", &memory_budget_mb_, 4096);
+    registerParameter("spill_directory", &spill_directory_, "");
+
+    registerParameter("narrow_loaded_integers", &narrow_loaded_integers_, true);
+
+    registerParameter("use_spatial_index", &use_spatial_index_, true);
+    registerParameter("spatial_index_cell_size_deg", &spatial_index_cell_size_deg_, 0.1);
+
+    if (spatial_index_cell_size_deg_ <= 0)
+        spatial_index_cell_size_deg_ = 0.1;
+
+    registerParameter("statistics_num_bins", &statistics_num_bins_, 20);
+    registerParameter("statistics_num_top_values", &statistics_num_top_values_, 10);
+
+    if (!statistics_num_bins_)
+        statistics_num_bins_ = 20;
+
+    SpillFile::directory(spill_directory_);
+
     createSubConfigurables ();
 
     lock();
@@ -62,6 +88,16 @@ DBObjectManager::DBObjectManager(const std::string& class_id, const std::string&
  */
 DBObjectManager::~DBObjectManager()
 {
+    for (auto& job_it : statistics_jobs_)
+        JobManager::instance().cancelJob(job_it.second);
+    statistics_jobs_.clear();
+
+    if (time_window_pager_)
+    {
+        delete time_window_pager_;
+        time_window_pager_ = nullptr;
+    }
+
     for (auto it : objects_)
         delete it.second;
     objects_.clear();
@@ -107,13 +143,126 @@ void DBObjectManager::generateSubConfigurable (const std::string& class_id, cons
         assert (meta_variables_.find(meta_var->name()) == meta_variables_.end());
         meta_variables_.insert(std::pair <std::string, MetaDBOVariable*> (meta_var->name(), meta_var));
     }
+    else if (class_id.compare ("DBOTimeWindowPager") == 0)
+    {
+        assert (!time_window_pager_);
+        time_window_pager_ = new DBOTimeWindowPager (class_id, instance_id, this);
+    }
     else
         throw std::runtime_error ("DBObjectManager: generateSubConfigurable: unknown class_id "+class_id );
 }
 
 void DBObjectManager::checkSubConfigurables ()
 {
-    // nothing to do, must be defined in configuration
+    // objects and meta variables must be defined in configuration
+
+    if (!time_window_pager_)
+    {
+        addNewSubConfiguration ("DBOTimeWindowPager", "DBOTimeWindowPager0");
+        generateSubConfigurable ("DBOTimeWindowPager", "DBOTimeWindowPager0");
+        assert (time_window_pager_);
+    }
+}
+
+DBOTimeWindowPager& DBObjectManager::timeWindowPager()
+{
+    assert (time_window_pager_);
+    return *time_window_pager_;
+}
+
+bool DBObjectManager::hasStatistics (const DBOVariable& variable)
+{
+    auto it = statistics_.find({variable.dboName(), variable.name()});
+
+    return it != statistics_.end() && it->second->content_version_ == content_version_;
+}
+
+std::shared_ptr<DBOVariableStatistics> DBObjectManager::statistics (const DBOVariable& variable)
+{
+    assert (hasStatistics(variable));
+    return statistics_.at({variable.dboName(), variable.name()});
+}
+
+void DBObjectManager::calculateStatistics (DBOVariable& variable)
+{
+    std::pair<std::string, std::string> key {variable.dboName(), variable.name()};
+
+    if (hasStatistics(variable))
+    {
+        emit statisticsDoneSignal(key.first, key.second);
+        return;
+    }
+
+    if (statistics_jobs_.count(key)) // already calculating
+        return;
+
+    DBObject& object = variable.dbObject();
+
+    if (!object.existsInDB() || !variable.existsInDB())
+    {
+        logwrn << "DBObjectManager: calculateStatistics: variable " << key.first << " " << key.second
+               << " does not exist in database";
+        return;
+    }
+
+    // loaded data is cheaper to use if it is the complete database content
+    std::shared_ptr<Buffer> loaded_buffer;
+
+    if (!object.isLoading() && object.data() && object.data()->properties().hasProperty(variable.name())
+            && object.loadedCount() == object.count())
+        loaded_buffer = object.data();
+
+    loginf << "DBObjectManager: calculateStatistics: variable " << key.first << " " << key.second << " from "
+           << (loaded_buffer ? "loaded data" : "database");
+
+    std::shared_ptr<DBOVariableStatisticsJob> job = std::make_shared<DBOVariableStatisticsJob> (
+                ATSDB::instance().interface(), variable, statistics_num_bins_, statistics_num_top_values_,
+                loaded_buffer);
+
+    connect (job.get(), &DBOVariableStatisticsJob::doneSignal, this, &DBObjectManager::statisticsJobDoneSlot,
+             Qt::QueuedConnection);
+
+    statistics_jobs_[key] = job;
+
+    if (loaded_buffer)
+        JobManager::instance().addParallelJob(job);
+    else
+        JobManager::instance().addDBJob(job);
+}
+
+void DBObjectManager::calculateStatistics (MetaDBOVariable& meta_variable)
+{
+    for (auto& var_it : meta_variable.variables())
+        if (var_it.second.existsInDB())
+            calculateStatistics(var_it.second);
+}
+
+void DBObjectManager::statisticsJobDoneSlot ()
+{
+    DBOVariableStatisticsJob* job = dynamic_cast<DBOVariableStatisticsJob*> (QObject::sender());
+
+    if (!job)
+    {
+        logwrn << "DBObjectManager: statisticsJobDoneSlot: null sender, event on the loose";
+        return;
+    }
+
+    std::pair<std::string, std::string> key {job->variable().dboName(), job->variable().name()};
+
+    if (!statistics_jobs_.count(key) || statistics_jobs_.at(key).get() != job) // cancelled
+        return;
+
+    std::shared_ptr<DBOVariableStatistics> statistics = job->statistics();
+
+    statistics_jobs_.erase(key);
+
+    if (!statistics)
+        return;
+
+    statistics->content_version_ = content_version_;
+    statistics_[key] = statistics;
+
+    emit statisticsDoneSignal(key.first, key.second);
 }
 
 bool DBObjectManager::existsObject (const std::string& dbo_name)
@@ -203,6 +352,166 @@ DBObjectManagerLoadWidget* DBObjectManager::loadWidget()
     return load_widget_;
 }
 
+bool DBObjectManager::useMemoryBudget() const
+{
+    return use_memory_budget_;
+}
+
+void DBObjectManager::useMemoryBudget(bool value)
+{
+    loginf << "DBObjectManager: useMemoryBudget: " << value;
+    use_memory_budget_ = value;
+
+    checkMemoryBudget();
+}
+
+unsigned int DBObjectManager::memoryBudgetMB() const
+{
+    return memory_budget_mb_;
+}
+
+void DBObjectManager::memoryBudgetMB(unsigned int value)
+{
+    loginf << "DBObjectManager: memoryBudgetMB: " << value;
+    memory_budget_mb_ = value;
+
+    checkMemoryBudget();
+}
+
+const std::string& DBObjectManager::spillDirectory() const
+{
+    return spill_directory_;
+}
+
+void DBObjectManager::spillDirectory(const std::string& directory)
+{
+    spill_directory_ = directory;
+    SpillFile::directory(spill_directory_);
+}
+
+bool DBObjectManager::useSpatialIndex() const
+{
+    return use_spatial_index_;
+}
+
+void DBObjectManager::useSpatialIndex(bool value)
+{
+    loginf << "DBObjectManager: useSpatialIndex: " << value;
+    use_spatial_index_ = value;
+
+    for (auto& object_it : objects_)
+        object_it.second->updateSpatialIndex();
+
+    checkMemoryBudget(); // index memory is counted in the usage
+}
+
+double DBObjectManager::spatialIndexCellSize() const
+{
+    return spatial_index_cell_size_deg_;
+}
+
+void DBObjectManager::spatialIndexCellSize(double value)
+{
+    assert (value > 0);
+
+    loginf << "DBObjectManager: spatialIndexCellSize: " << value;
+    spatial_index_cell_size_deg_ = value;
+
+    for (auto& object_it : objects_)
+        object_it.second->updateSpatialIndex();
+
+    checkMemoryBudget(); // index memory is counted in the usage
+}
+
+void DBObjectManager::addNewDataSources (const std::map<std::string, std::map<int, std::pair<int,int>>>& data_sources,
+                                         std::set<int>& added_keys)
+{
+    for (auto& dbo_it : data_sources)
+    {
+        assert (existsObject(dbo_it.first));
+        DBObject& db_object = object(dbo_it.first);
+
+        std::map <int, std::pair<int,int>> datasources_to_add;
+
+        for (auto& ds_it : dbo_it.second)
+        {
+            if (added_keys.count(ds_it.first) || db_object.hasDataSource(ds_it.first))
+                continue;
+
+            loginf << "DBObjectManager: addNewDataSources: " << db_object.name() << " source " << ds_it.first
+                   << " sac " << ds_it.second.first << " sic " << ds_it.second.second;
+
+            datasources_to_add[ds_it.first] = ds_it.second;
+            added_keys.insert(ds_it.first);
+        }
+
+        if (datasources_to_add.size())
+            db_object.addDataSources(datasources_to_add);
+    }
+}
+
+size_t DBObjectManager::selectRegion (double latitude_min, double latitude_max, double longitude_min,
+                                      double longitude_max)
+{
+    loginf << "DBObjectManager: selectRegion: latitude " << latitude_min << " to " << latitude_max
+           << " longitude " << longitude_min << " to " << longitude_max;
+
+    size_t num_selected {0};
+
+    for (auto& object_it : objects_)
+        num_selected += object_it.second->selectRegion(latitude_min, latitude_max, longitude_min, longitude_max);
+
+    return num_selected;
+}
+
+size_t DBObjectManager::memoryUsage ()
+{
+    size_t bytes = 0;
+
+    for (auto& object_it : objects_)
+        bytes += object_it.second->memoryUsage();
+
+    if (time_window_pager_)
+        bytes += time_window_pager_->memoryUsage();
+
+    return bytes;
+}
+
+void DBObjectManager::checkMemoryBudget ()
+{
+    if (use_memory_budget_)
+    {
+        size_t budget = static_cast<size_t>(memory_budget_mb_)*1024*1024;
+        size_t usage = memoryUsage();
+
+        if (usage > budget)
+        {
+            size_t bytes_to_free = usage - budget;
+
+            logdbg << "DBObjectManager: checkMemoryBudget: usage " << usage << " exceeds budget " << budget;
+
+            for (auto& object_it : objects_)
+            {
+                size_t freed_bytes = object_it.second->spillData(bytes_to_free);
+
+                if (freed_bytes >= bytes_to_free)
+                {
+                    bytes_to_free = 0;
+                    break;
+                }
+
+                bytes_to_free -= freed_bytes;
+            }
+
+            if (bytes_to_free)
+                logwrn << "DBObjectManager: checkMemoryBudget: budget exceeded by " << bytes_to_free
+                       << " bytes, all columns not read by views are already spilled";
+        }
+    }
+
+    emit memoryUsageChangedSignal();
+}
+
 bool DBObjectManager::useLimit() const
 {
     return use_limit_;
@@ -385,6 +694,9 @@ void DBObjectManager::loadSlot ()
             if (hasOrderMetaVariable())
                 variable = &orderMetaVariable().getFor(object.first);
 
+            if (narrow_loaded_integers_ && ATSDB::instance().interface().isPostProcessed())
+                narrowReadDataTypes(read_set);
+
             // load (DBOVariableSet &read_set, bool use_filters, bool use_order, DBOVariable *order_variable,
             // bool use_order_ascending, const std::string &limit_str="")
             object.second->load(read_set, use_filters_, use_order_, variable, use_order_ascending_, limit_str);
@@ -401,6 +713,28 @@ void DBObjectManager::loadSlot ()
     }
 }
 
+/**
+ * The types are taken from the min/max table written during post-processing, so all chunks of a load have the same
+ * types and are never converted when seized. rec_num stays int, since views, labels and exports access it as int.
+ */
+void DBObjectManager::narrowReadDataTypes (DBOVariableSet& read_set)
+{
+    for (DBOVariable* variable : read_set.getSet())
+    {
+        if (variable->name() == "rec_num")
+            continue;
+
+        PropertyDataType type = variable->narrowestDataType();
+
+        if (type != variable->dataType())
+        {
+            logdbg << "DBObjectManager: narrowReadDataTypes: " << variable->dboName() << " " << variable->name()
+                   << " from " << Property::asString(variable->dataType()) << " to " << Property::asString(type);
+            read_set.readDataType(*variable, type);
+        }
+    }
+}
+
 void DBObjectManager::quitLoading ()
 {
     loginf << "DBObjectManager: quitLoading";
@@ -422,6 +756,14 @@ void DBObjectManager::databaseContentChangedSlot ()
 
     loginf << "DBObjectManager: databaseContentChangedSlot";
 
+    ++content_version_;
+
+    for (auto& job_it : statistics_jobs_)
+        JobManager::instance().cancelJob(job_it.second);
+
+    statistics_jobs_.clear();
+    statistics_.clear();
+
     if (ATSDB::instance().interface().hasProperty("associations_generated"))
     {
         assert (ATSDB::instance().interface().hasProperty("associations_dbo"));
@@ -441,6 +783,9 @@ void DBObjectManager::databaseContentChangedSlot ()
     for (auto& object : objects_)
         object.second->updateToDatabaseContent();
 
+    assert (time_window_pager_);
+    time_window_pager_->reload();
+
     QApplication::restoreOverrideCursor();
 
     if (load_widget_)
@@ -18,6 +18,9 @@
 #ifndef DBOBJECTMANAGER_H_
 #define DBOBJECTMANAGER_H_
 
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 #include <qobject.h>
 
@@ -33,6 +36,9 @@ class DBOVariable;
 class MetaDBOVariable;
 class DBOVariableSet;
 class DBSchemaManager;
+class DBOTimeWindowPager;
+class DBOVariableStatistics;
+class DBOVariableStatisticsJob;
 
 /**
  * @brief For management of all DBObjects
@@ -49,6 +55,7 @@ public slots:
     void updateSchemaInformationSlot ();
     void databaseContentChangedSlot ();
     void loadingDoneSlot (DBObject& object);
+    void statisticsJobDoneSlot ();
 
 signals:
     void dbObjectsChangedSignal ();
@@ -58,6 +65,11 @@ signals:
     void loadingStartedSignal ();
     void allLoadingDoneSignal ();
 
+    void memoryUsageChangedSignal ();
+
+    /// @brief Emitted when statistics of a variable are available
+    void statisticsDoneSignal (const std::string& dbo_name, const std::string& variable_name);
+
 public:
     /// @brief Constructor
     DBObjectManager(const std::string& class_id, const std::string& instance_id, ATSDB* atsdb);
@@ -130,6 +142,51 @@ public:
     std::string associationsDBObject() const;
     std::string associationsDataSourceName() const;
 
+    bool useMemoryBudget() const;
+    void useMemoryBudget(bool value);
+
+    unsigned int memoryBudgetMB() const;
+    void memoryBudgetMB(unsigned int value);
+
+    const std::string& spillDirectory() const;
+    void spillDirectory(const std::string& directory);
+
+    bool useSpatialIndex() const;
+    /// @brief Sets if loaded positions are indexed, builds or removes the spatial indexes of all DBObjects
+    void useSpatialIndex(bool value);
+
+    double spatialIndexCellSize() const;
+    void spatialIndexCellSize(double value);
+
+    /// @brief Adds data sources found during an import, dbo name -> key -> (sac, sic)
+    ///
+    /// Sources which exist or whose key is in added_keys (added before during the same import) are skipped, keys
+    /// of the added ones are inserted into added_keys.
+    void addNewDataSources (const std::map<std::string, std::map<int, std::pair<int,int>>>& data_sources,
+                            std::set<int>& added_keys);
+
+    /// @brief Selects loaded rows of all DBObjects by position, returns number of selected rows
+    size_t selectRegion (double latitude_min, double latitude_max, double longitude_min, double longitude_max);
+
+    /// @brief Returns number of bytes held by loaded data of all DBObjects and the cached time windows
+    size_t memoryUsage ();
+    /// @brief Spills unused columns if memory usage exceeds the budget, emits memoryUsageChangedSignal
+    void checkMemoryBudget ();
+
+    /// @brief Returns time-windowed access to the database content, used for playback
+    DBOTimeWindowPager& timeWindowPager();
+
+    /// @brief Returns if statistics of variable for the current database content are cached
+    bool hasStatistics (const DBOVariable& variable);
+    std::shared_ptr<DBOVariableStatistics> statistics (const DBOVariable& variable);
+    /// @brief Calculates statistics in the background if not cached, emits statisticsDoneSignal when available
+    void calculateStatistics (DBOVariable& variable);
+    /// @brief Calculates statistics of all variables of a meta variable existing in the database
+    void calculateStatistics (MetaDBOVariable& meta_variable);
+
+    /// @brief Returns version of the database content, incremented on every change
+    unsigned int contentVersion () const { return content_version_; }
+
 protected:
     bool use_filters_ {false};
 
@@ -144,6 +201,16 @@ protected:
 
     bool locked_ {false};
 
+    bool use_memory_budget_ {false};
+    unsigned int memory_budget_mb_ {4096};
+    std::string spill_directory_;
+
+    /// Loaded integer columns are read as the narrowest type holding the range of the min/max table
+    bool narrow_loaded_integers_ {true};
+
+    bool use_spatial_index_ {true};
+    double spatial_index_cell_size_deg_ {0.1};
+
     bool has_associations_ {false};
     std::string associations_dbo_;
     std::string associations_ds_;
@@ -155,7 +222,20 @@ protected:
     DBObjectManagerWidget* widget_ {nullptr};
     DBObjectManagerLoadWidget* load_widget_ {nullptr};
 
+    DBOTimeWindowPager* time_window_pager_ {nullptr};
+
+    unsigned int statistics_num_bins_ {20};
+    unsigned int statistics_num_top_values_ {10};
+
+    unsigned int content_version_ {0};
+    /// (dbo name, variable name) -> statistics, valid for content version
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<DBOVariableStatistics>> statistics_;
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<DBOVariableStatisticsJob>> statistics_jobs_;
+
     virtual void checkSubConfigurables ();
+
+    /// @brief Sets the narrowest read data types of the integer variables in read_set, once for a whole load
+    void narrowReadDataTypes (DBOVariableSet& read_set);
 };
 
 #endif /* DBOBJECTMANAGER_H_ */
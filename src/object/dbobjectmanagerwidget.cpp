@@ -23,6 +23,7 @@
 #include <QPushButton>
 #include <QScrollArea>
 #include <QInputDialog>
+#include <QCheckBox>
 
 #include "configuration.h"
 #include "configurationmanager.h"
@@ -82,6 +83,31 @@ DBObjectManagerWidget::DBObjectManagerWidget(DBObjectManager &object_manager)
     connect(add_dbo_button_, SIGNAL(clicked()), this, SLOT(addDBOSlot()));
     main_layout->addWidget (add_dbo_button_);
 
+    // memory budget
+    QGridLayout* memory_layout = new QGridLayout ();
+
+    memory_budget_check_ = new QCheckBox ("Use Memory Budget (MB)");
+    memory_budget_check_->setChecked(object_manager_.useMemoryBudget());
+    connect (memory_budget_check_, SIGNAL(toggled(bool)), this, SLOT(toggleUseMemoryBudgetSlot()));
+    memory_layout->addWidget(memory_budget_check_, 0, 0);
+
+    memory_budget_edit_ = new QLineEdit ();
+    memory_budget_edit_->setText (std::to_string(object_manager_.memoryBudgetMB()).c_str());
+    memory_budget_edit_->setEnabled(object_manager_.useMemoryBudget());
+    connect(memory_budget_edit_, SIGNAL(textChanged(QString)), this, SLOT(memoryBudgetChangedSlot(QString)));
+    memory_layout->addWidget(memory_budget_edit_, 0, 1);
+
+    memory_layout->addWidget(new QLabel ("Memory Usage"), 1, 0);
+
+    memory_total_label_ = new QLabel ();
+    memory_total_label_->setAlignment(Qt::AlignRight);
+    memory_layout->addWidget(memory_total_label_, 1, 1);
+
+    main_layout->addLayout(memory_layout);
+
+    connect (&object_manager_, &DBObjectManager::memoryUsageChangedSignal,
+             this, &DBObjectManagerWidget::updateMemoryUsageSlot);
+
     main_layout->addStretch();
 
     // meta objects
@@ -110,6 +136,8 @@ DBObjectManagerWidget::DBObjectManagerWidget(DBObjectManager &object_manager)
 
     setLayout (main_layout);
 
+    updateMemoryUsageSlot();
+
     lock();
 }
 
@@ -276,6 +304,12 @@ void DBObjectManagerWidget::updateDBOsSlot ()
     meta_label->setFont (font_bold);
     dbobjects_grid_->addWidget (meta_label, 0, 2);
 
+    QLabel *memory_label = new QLabel ("Memory");
+    memory_label->setFont (font_bold);
+    dbobjects_grid_->addWidget (memory_label, 0, 3);
+
+    memory_labels_.clear();
+
     unsigned int row=1;
 
     for (auto& obj_it : object_manager_)
@@ -298,6 +332,10 @@ void DBObjectManagerWidget::updateDBOsSlot ()
             meta->setText(obj_it.second->currentMetaTable().name().c_str());
         dbobjects_grid_->addWidget (meta, row, 2);
 
+        QLabel* memory = new QLabel ();
+        dbobjects_grid_->addWidget (memory, row, 3);
+        memory_labels_[obj_it.second] = memory;
+
         QPushButton* edit = new QPushButton ();
         edit->setIcon(edit_icon);
         edit->setIconSize(UI_ICON_SIZE);
@@ -305,7 +343,7 @@ void DBObjectManagerWidget::updateDBOsSlot ()
         edit->setFlat(UI_ICON_BUTTON_FLAT);
         //edit->setDisabled(!active || locked_);
         connect(edit, SIGNAL( clicked() ), this, SLOT( editDBOSlot() ));
-        dbobjects_grid_->addWidget (edit, row, 3);
+        dbobjects_grid_->addWidget (edit, row, 4);
         edit_dbo_buttons_[edit] = obj_it.second;
 
         QPushButton* del = new QPushButton ();
@@ -315,11 +353,56 @@ void DBObjectManagerWidget::updateDBOsSlot ()
         del->setFlat(UI_ICON_BUTTON_FLAT);
         //del->setDisabled(locked_);
         connect(del, SIGNAL( clicked() ), this, SLOT( deleteDBOSlot() ));
-        dbobjects_grid_->addWidget (del, row, 4);
+        dbobjects_grid_->addWidget (del, row, 5);
         delete_dbo_buttons_[del] = obj_it.second;
 
         row++;
     }
+
+    updateMemoryUsageSlot();
+}
+
+void DBObjectManagerWidget::updateMemoryUsageSlot ()
+{
+    for (auto& label_it : memory_labels_)
+    {
+        QString text = QString::number(label_it.first->memoryUsage()/1e6, 'f', 1) + " MB";
+
+        unsigned int num_spilled = label_it.first->numSpilledColumns();
+        if (num_spilled)
+            text += " ("+QString::number(num_spilled)+" spilled)";
+
+        label_it.second->setText(text);
+    }
+
+    if (memory_total_label_)
+        memory_total_label_->setText(QString::number(object_manager_.memoryUsage()/1e6, 'f', 1) + " MB");
+}
+
+void DBObjectManagerWidget::toggleUseMemoryBudgetSlot ()
+{
+    assert (memory_budget_check_);
+    assert (memory_budget_edit_);
+
+    bool checked = memory_budget_check_->checkState() == Qt::Checked;
+    logdbg  << "DBObjectManagerWidget: toggleUseMemoryBudgetSlot: setting use memory budget to " << checked;
+
+    memory_budget_edit_->setEnabled(checked);
+    object_manager_.useMemoryBudget(checked);
+}
+
+void DBObjectManagerWidget::memoryBudgetChangedSlot (const QString& value)
+{
+    bool ok;
+    unsigned int budget_mb = value.toUInt(&ok);
+
+    if (!ok || !budget_mb)
+    {
+        logwrn << "DBObjectManagerWidget: memoryBudgetChangedSlot: invalid value '" << value.toStdString() << "'";
+        return;
+    }
+
+    object_manager_.memoryBudgetMB(budget_mb);
 }
 
 void DBObjectManagerWidget::addMetaVariableSlot ()
@@ -32,6 +32,8 @@ class QScrollArea;
 class QPushButton;
 class QLineEdit;
 class QComboBox;
+class QCheckBox;
+class QLabel;
 
 /**
  * @brief Shows all DBObjects, allows editing and adding new ones
@@ -61,6 +63,11 @@ public slots:
     /// @brief Unlocks editing functionality
     void databaseOpenedSlot ();
 
+    /// @brief Updates the memory usage labels
+    void updateMemoryUsageSlot ();
+    void toggleUseMemoryBudgetSlot ();
+    void memoryBudgetChangedSlot (const QString& value);
+
 public:
     /// @brief Constructor
     DBObjectManagerWidget(DBObjectManager &object_manager);
@@ -92,6 +99,12 @@ private:
     /// Container with already existing edit DBO widgets
     std::map <DBObject*, DBObjectWidget*> edit_dbo_widgets_;
 
+    /// Container with DBO memory usage labels
+    std::map <DBObject*, QLabel*> memory_labels_;
+    QLabel* memory_total_label_ {nullptr};
+    QCheckBox* memory_budget_check_ {nullptr};
+    QLineEdit* memory_budget_edit_ {nullptr};
+
     std::map <QPushButton*, MetaDBOVariable*> edit_meta_buttons_;
     /// Container with DBO edit buttons
     std::map <QPushButton*, MetaDBOVariable*> delete_meta_buttons_;
@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "dbobject.h"
 #include "dbovariable.h"
+#include "dbovariableformatter.h"
 
 #include "buffer.h"
 #include "propertylist.h"
@@ -259,11 +260,16 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
     int var_count = 0;
     for (DBOVariable* variable : read_list_.getSet())
     {
-        data_type = variable->dataType();
+        // loaded integers may be narrowed
+        data_type = buffer->properties().hasProperty(variable->name())
+                ? buffer->properties().get(variable->name()).dataType() : variable->dataType();
         value_str = NULL_STRING;
         entry = entries_[variable->name()];
         assert (entry);
 
+        DBOVariableFormatter formatter (*variable); // whole column at once
+        formatter.format(*buffer, 0, buffer->size());
+
         for (size_t cnt=0; cnt < rec_num_list.size(); cnt++)
         {
             int rec_num = rec_num_list.get(cnt); //already checked
@@ -277,8 +283,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<bool>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<bool>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::CHAR)
@@ -287,8 +292,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<char>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<char>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::UCHAR)
@@ -297,8 +301,25 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<unsigned char>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<unsigned char>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
+                }
+            }
+            else if (data_type == PropertyDataType::SHORTINT)
+            {
+                assert (buffer->has<short int>(variable->name()));
+                null = buffer->get<short int>(variable->name()).isNull(buffer_index);
+                if (!null)
+                {
+                    value_str = formatter.get(buffer_index);
+                }
+            }
+            else if (data_type == PropertyDataType::USHORTINT)
+            {
+                assert (buffer->has<unsigned short int>(variable->name()));
+                null = buffer->get<unsigned short int>(variable->name()).isNull(buffer_index);
+                if (!null)
+                {
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::INT)
@@ -307,8 +328,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<int>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<int>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::UINT)
@@ -317,8 +337,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<unsigned int>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<unsigned int>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::LONGINT)
@@ -327,8 +346,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<long int>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<long int>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::ULONGINT)
@@ -337,8 +355,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<unsigned long int>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<unsigned long int>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::FLOAT)
@@ -347,8 +364,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<float>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<float>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::DOUBLE)
@@ -357,8 +373,16 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<double>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<double>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
+                }
+            }
+            else if (data_type == PropertyDataType::TIMESTAMP)
+            {
+                assert (buffer->has<Timestamp>(variable->name()));
+                null = buffer->get<Timestamp>(variable->name()).isNull(buffer_index);
+                if (!null)
+                {
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else if (data_type == PropertyDataType::STRING)
@@ -367,8 +391,7 @@ std::map<int, std::string> DBOLabelDefinition::generateLabels (
                 null = buffer->get<std::string>(variable->name()).isNull(buffer_index);
                 if (!null)
                 {
-                    value_str = variable->getRepresentationStringFromValue(
-                                buffer->get<std::string>(variable->name()).getAsString(buffer_index));
+                    value_str = formatter.get(buffer_index);
                 }
             }
             else
@@ -0,0 +1,283 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbospatialindex.h"
+#include "buffer.h"
+#include "logger.h"
+
+#include <tbb/tbb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+DBOSpatialIndex::DBOSpatialIndex(double cell_size_deg)
+    : cell_size_deg_(cell_size_deg)
+{
+    assert (cell_size_deg_ > 0);
+}
+
+void DBOSpatialIndex::add (NullableVector<double>& latitudes, NullableVector<double>& longitudes, size_t from_index,
+                           size_t to_index)
+{
+    assert (from_index <= to_index);
+
+    if (from_index == to_index)
+        return;
+
+    assert (to_index <= latitudes.size() && to_index <= longitudes.size());
+    assert (to_index - from_index < std::numeric_limits<unsigned int>::max() - size());
+
+    size_t first_row = latitudes_.size();
+    size_t num_new_rows = to_index - from_index;
+
+    latitudes_.resize(first_row + num_new_rows);
+    longitudes_.resize(first_row + num_new_rows);
+
+    // (cell key, row) of the new rows, spilled columns are only read through their mapping
+    std::vector<std::pair<int64_t, unsigned int>> cell_rows (num_new_rows);
+
+    tbb::parallel_for (size_t(0), num_new_rows, [&] (size_t cnt)
+    {
+        size_t index = from_index + cnt;
+        size_t row = first_row + cnt;
+
+        if (!latitudes.isNull(index) && !longitudes.isNull(index))
+        {
+            latitudes_[row] = latitudes.get(index);
+            longitudes_[row] = longitudes.get(index);
+        }
+        else
+        {
+            latitudes_[row] = std::numeric_limits<double>::quiet_NaN();
+            longitudes_[row] = std::numeric_limits<double>::quiet_NaN();
+        }
+
+        cell_rows[cnt] = {std::isnan(latitudes_[row]) ? 0 : cellKey(cellIndex(latitudes_[row]),
+                                                                     cellIndex(longitudes_[row])),
+                          static_cast<unsigned int>(row)};
+    });
+
+    // grouped by cell, rows ascending within a cell, so each cell is appended to in one go
+    tbb::parallel_sort (cell_rows.begin(), cell_rows.end());
+
+    auto range_begin = cell_rows.begin();
+
+    while (range_begin != cell_rows.end())
+    {
+        auto range_end = range_begin;
+
+        while (range_end != cell_rows.end() && range_end->first == range_begin->first)
+            ++range_end;
+
+        std::vector<unsigned int>* cell {nullptr};
+
+        for (auto it = range_begin; it != range_end; ++it)
+        {
+            if (std::isnan(latitudes_[it->second])) // no position
+                continue;
+
+            if (!cell)
+                cell = &cells_[range_begin->first];
+
+            cell->push_back(it->second);
+        }
+
+        range_begin = range_end;
+    }
+
+    logdbg << "DBOSpatialIndex: add: rows " << first_row << " to " << latitudes_.size() << " cells " << cells_.size();
+}
+
+void DBOSpatialIndex::clear ()
+{
+    latitudes_.clear();
+    longitudes_.clear();
+    cells_.clear();
+}
+
+size_t DBOSpatialIndex::memoryUsage () const
+{
+    size_t bytes = (latitudes_.capacity() + longitudes_.capacity()) * sizeof(double);
+
+    // node and bucket overhead of the map estimated
+    bytes += cells_.bucket_count() * sizeof(void*);
+
+    for (auto& cell_it : cells_)
+        bytes += sizeof(cell_it) + 2*sizeof(void*) + cell_it.second.capacity() * sizeof(unsigned int);
+
+    return bytes;
+}
+
+std::vector<bool> DBOSpatialIndex::region (double latitude_min, double latitude_max, double longitude_min,
+                                           double longitude_max) const
+{
+    std::vector<bool> rows (size(), false);
+
+    region (latitude_min, latitude_max, longitude_min, longitude_max, rows);
+
+    return rows;
+}
+
+size_t DBOSpatialIndex::region (double latitude_min, double latitude_max, double longitude_min,
+                                double longitude_max, std::vector<bool>& rows) const
+{
+    assert (rows.size() == size());
+
+    if (latitude_min > latitude_max || longitude_min > longitude_max)
+        return 0;
+
+    size_t num_rows {0};
+
+    forCells (cellIndex(latitude_min), cellIndex(latitude_max), cellIndex(longitude_min), cellIndex(longitude_max),
+              [&] (const std::vector<unsigned int>& cell_rows)
+    {
+        for (unsigned int row : cell_rows)
+        {
+            if (latitudes_[row] >= latitude_min && latitudes_[row] <= latitude_max
+                    && longitudes_[row] >= longitude_min && longitudes_[row] <= longitude_max)
+            {
+                rows[row] = true;
+                ++num_rows;
+            }
+        }
+    });
+
+    return num_rows;
+}
+
+bool DBOSpatialIndex::nearest (double latitude, double longitude, double max_distance_deg, size_t& row) const
+{
+    int latitude_index = cellIndex(latitude);
+    int longitude_index = cellIndex(longitude);
+
+    // longitude cells are narrower than latitude cells away from the equator
+    double cos_latitude = std::max(0.01, std::cos(latitude * M_PI / 180.0));
+    int max_ring = static_cast<int>(std::ceil(max_distance_deg / (cell_size_deg_ * cos_latitude))) + 1;
+
+    double best_distance = std::numeric_limits<double>::max();
+    bool found {false};
+
+    for (int ring=0; ring <= max_ring; ++ring)
+    {
+        // all rows in this ring are at least (ring-1) cells away
+        if (found && (ring-1) * cell_size_deg_ * cos_latitude > best_distance)
+            break;
+
+        for (int latitude_offset=-ring; latitude_offset <= ring; ++latitude_offset)
+        {
+            for (int longitude_offset=-ring; longitude_offset <= ring; ++longitude_offset)
+            {
+                if (std::abs(latitude_offset) != ring && std::abs(longitude_offset) != ring) // inner, already done
+                    continue;
+
+                auto cell_it = cells_.find(cellKey(latitude_index+latitude_offset, longitude_index+longitude_offset));
+
+                if (cell_it == cells_.end())
+                    continue;
+
+                for (unsigned int cell_row : cell_it->second)
+                {
+                    double row_distance = distance(latitude, longitude, latitudes_[cell_row],
+                                                   longitudes_[cell_row]);
+
+                    if (row_distance <= max_distance_deg && row_distance < best_distance)
+                    {
+                        best_distance = row_distance;
+                        row = cell_row;
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+std::vector<bool> DBOSpatialIndex::within (double latitude, double longitude, double distance_deg) const
+{
+    std::vector<bool> rows (size(), false);
+
+    double cos_latitude = std::max(0.01, std::cos(latitude * M_PI / 180.0));
+    double longitude_distance = distance_deg / cos_latitude;
+
+    forCells (cellIndex(latitude - distance_deg), cellIndex(latitude + distance_deg),
+              cellIndex(longitude - longitude_distance), cellIndex(longitude + longitude_distance),
+              [&] (const std::vector<unsigned int>& cell_rows)
+    {
+        for (unsigned int row : cell_rows)
+            if (distance(latitude, longitude, latitudes_[row], longitudes_[row]) <= distance_deg)
+                rows[row] = true;
+    });
+
+    return rows;
+}
+
+template <typename Function> void DBOSpatialIndex::forCells (int latitude_index_min, int latitude_index_max,
+                                                             int longitude_index_min, int longitude_index_max,
+                                                             Function function) const
+{
+    double num_box_cells = (static_cast<double>(latitude_index_max) - latitude_index_min + 1)
+            * (static_cast<double>(longitude_index_max) - longitude_index_min + 1);
+
+    if (num_box_cells > cells_.size()) // fewer cells exist than the box covers, check the existing ones
+    {
+        for (auto& cell_it : cells_)
+        {
+            int latitude_index = cellLatitudeIndex(cell_it.first);
+            int longitude_index = cellLongitudeIndex(cell_it.first);
+
+            if (latitude_index >= latitude_index_min && latitude_index <= latitude_index_max
+                    && longitude_index >= longitude_index_min && longitude_index <= longitude_index_max)
+                function(cell_it.second);
+        }
+
+        return;
+    }
+
+    for (int latitude_index = latitude_index_min; latitude_index <= latitude_index_max; ++latitude_index)
+    {
+        for (int longitude_index = longitude_index_min; longitude_index <= longitude_index_max; ++longitude_index)
+        {
+            auto cell_it = cells_.find(cellKey(latitude_index, longitude_index));
+
+            if (cell_it != cells_.end())
+                function(cell_it->second);
+        }
+    }
+}
+
+int DBOSpatialIndex::cellIndex (double value) const
+{
+    return static_cast<int>(std::floor(value / cell_size_deg_));
+}
+
+int64_t DBOSpatialIndex::cellKey (int latitude_index, int longitude_index)
+{
+    return (static_cast<int64_t>(latitude_index) << 32) | static_cast<uint32_t>(longitude_index);
+}
+
+double DBOSpatialIndex::distance (double latitude1, double longitude1, double latitude2, double longitude2)
+{
+    double cos_latitude = std::cos((latitude1 + latitude2) / 2.0 * M_PI / 180.0);
+    double latitude_diff = latitude2 - latitude1;
+    double longitude_diff = (longitude2 - longitude1) * cos_latitude;
+
+    return std::sqrt(latitude_diff*latitude_diff + longitude_diff*longitude_diff);
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOSPATIALINDEX_H
+#define DBOSPATIALINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+template <class T> class NullableVector;
+
+/**
+ * @brief Uniform grid index over the positions of loaded data
+ *
+ * Rows are assigned to square latitude/longitude cells of a fixed size. Positions are copied, so the index does not
+ * depend on the (possibly spilled) buffer, and the copies are part of the DBObject's memory usage. Rows are added
+ * incrementally as chunks arrive, positions and cells of a chunk are calculated and sorted in parallel. Rows without
+ * position are not indexed.
+ *
+ * Region queries return a bitmap over all rows, nearest-neighbour queries search the cells in growing rings around
+ * the query position. Distances are approximated in degrees, with longitudes scaled by the cosine of the latitude.
+ */
+class DBOSpatialIndex
+{
+public:
+    DBOSpatialIndex(double cell_size_deg);
+    virtual ~DBOSpatialIndex() {}
+
+    /// @brief Appends rows [from_index, to_index) of the given (buffer) columns as rows starting at size()
+    void add (NullableVector<double>& latitudes, NullableVector<double>& longitudes, size_t from_index,
+              size_t to_index);
+    void clear ();
+
+    /// @brief Returns number of bytes held
+    size_t memoryUsage () const;
+
+    /// @brief Returns number of rows covered, including rows without position
+    size_t size () const { return latitudes_.size(); }
+    size_t numCells () const { return cells_.size(); }
+    double cellSize () const { return cell_size_deg_; }
+
+    /// @brief Returns bitmap with rows inside the region set
+    std::vector<bool> region (double latitude_min, double latitude_max, double longitude_min,
+                              double longitude_max) const;
+    /// @brief Sets rows inside the region in the bitmap (which must have size() entries), returns number of rows
+    size_t region (double latitude_min, double latitude_max, double longitude_min, double longitude_max,
+                   std::vector<bool>& rows) const;
+
+    /// @brief Returns if a row within max_distance_deg was found, sets row to the nearest one
+    bool nearest (double latitude, double longitude, double max_distance_deg, size_t& row) const;
+    /// @brief Returns bitmap with rows within distance_deg of the position set
+    std::vector<bool> within (double latitude, double longitude, double distance_deg) const;
+
+protected:
+    double cell_size_deg_ {0.1};
+
+    /// positions per row, NaN if row has no position
+    std::vector<double> latitudes_;
+    std::vector<double> longitudes_;
+
+    /// cell key -> rows
+    std::unordered_map<int64_t, std::vector<unsigned int>> cells_;
+
+    int cellIndex (double value) const;
+    static int64_t cellKey (int latitude_index, int longitude_index);
+    static int cellLatitudeIndex (int64_t key) { return static_cast<int>(key >> 32); }
+    static int cellLongitudeIndex (int64_t key) { return static_cast<int32_t>(key & 0xFFFFFFFF); }
+
+    /// @brief Calls function with the rows of all existing cells in the given cell index range
+    template <typename Function> void forCells (int latitude_index_min, int latitude_index_max,
+                                                int longitude_index_min, int longitude_index_max,
+                                                Function function) const;
+    static double distance (double latitude1, double longitude1, double latitude2, double longitude2);
+};
+
+#endif // DBOSPATIALINDEX_H
@@ -0,0 +1,409 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbotimewindowpager.h"
+#include "dbotimewindowreadjob.h"
+#include "dbobjectmanager.h"
+#include "dbobject.h"
+#include "dbovariable.h"
+#include "metadbovariable.h"
+#include "dbinterface.h"
+#include "filtermanager.h"
+#include "jobmanager.h"
+#include "buffer.h"
+#include "atsdb.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+DBOTimeWindowPager::DBOTimeWindowPager(const std::string& class_id, const std::string& instance_id,
+                                       DBObjectManager* manager)
+    : Configurable (class_id, instance_id, manager), manager_(*manager)
+{
+    registerParameter("window_length_s", &window_length_s_, 300.0);
+    registerParameter("cache_size", &cache_size_, 5);
+    registerParameter("prefetch_windows", &prefetch_windows_, 1);
+    registerParameter("playback_update_ms", &playback_update_ms_, 100);
+
+    if (window_length_s_ <= 0)
+        window_length_s_ = 300.0;
+
+    cache_size_ = std::max(cache_size_, 1u);
+
+    connect (&playback_timer_, &QTimer::timeout, this, &DBOTimeWindowPager::playbackTimerSlot);
+}
+
+DBOTimeWindowPager::~DBOTimeWindowPager()
+{
+    playback_timer_.stop();
+
+    for (auto& dbo_it : read_jobs_)
+        for (auto& job_it : dbo_it.second)
+            JobManager::instance().cancelJob(job_it.second);
+}
+
+void DBOTimeWindowPager::readSet (const std::string& dbo_name, const DBOVariableSet& read_set)
+{
+    loginf << "DBOTimeWindowPager: readSet: " << dbo_name << " variables " << read_set.getSize();
+
+    assert (manager_.existsObject(dbo_name));
+
+    if (!manager_.existsMetaVariable("tod") || !manager_.metaVariable("tod").existsIn(dbo_name)
+            || !manager_.metaVariable("tod").getFor(dbo_name).existsInDB())
+    {
+        logwrn << "DBOTimeWindowPager: readSet: " << dbo_name << " has no tod variable in database, not paged";
+        removeReadSet(dbo_name);
+        return;
+    }
+
+    DBObject& object = manager_.object(dbo_name);
+
+    if (!object.loadable() || !object.existsInDB())
+    {
+        logwrn << "DBOTimeWindowPager: readSet: " << dbo_name << " not loadable or not in database, not paged";
+        removeReadSet(dbo_name);
+        return;
+    }
+
+    cancelReadJobs(dbo_name);
+
+    windows_.erase(dbo_name);
+    failed_windows_.erase(dbo_name);
+
+    read_sets_[dbo_name] = read_set;
+
+    updateWindows();
+}
+
+void DBOTimeWindowPager::removeReadSet (const std::string& dbo_name)
+{
+    cancelReadJobs(dbo_name);
+    windows_.erase(dbo_name);
+    failed_windows_.erase(dbo_name);
+    read_sets_.erase(dbo_name);
+}
+
+void DBOTimeWindowPager::reload ()
+{
+    loginf << "DBOTimeWindowPager: reload";
+
+    for (auto& set_it : read_sets_)
+        cancelReadJobs(set_it.first);
+
+    windows_.clear();
+    failed_windows_.clear();
+
+    updateWindows();
+}
+
+unsigned int DBOTimeWindowPager::windowFor (double tod) const
+{
+    return tod > 0 ? static_cast<unsigned int>(std::floor(tod / window_length_s_)) : 0;
+}
+
+void DBOTimeWindowPager::cursor (double tod)
+{
+    tod = std::max(time_begin_, std::min(time_end_, tod));
+
+    bool window_changed = windowFor(tod) != windowFor(cursor_);
+
+    cursor_ = tod;
+
+    if (window_changed)
+        updateWindows();
+
+    emit cursorChangedSignal(cursor_);
+}
+
+void DBOTimeWindowPager::play (double speed)
+{
+    assert (speed > 0);
+
+    loginf << "DBOTimeWindowPager: play: speed " << speed;
+
+    playback_speed_ = speed;
+    playback_time_ = boost::posix_time::microsec_clock::local_time();
+
+    if (!playback_timer_.isActive())
+    {
+        playback_timer_.start(playback_update_ms_);
+        emit playingChangedSignal(true);
+    }
+}
+
+void DBOTimeWindowPager::pause ()
+{
+    if (playback_timer_.isActive())
+    {
+        loginf << "DBOTimeWindowPager: pause: cursor " << cursor_;
+
+        playback_timer_.stop();
+        emit playingChangedSignal(false);
+    }
+}
+
+void DBOTimeWindowPager::playbackTimerSlot ()
+{
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::local_time();
+    double elapsed_s = (now - playback_time_).total_microseconds() / 1e6;
+    playback_time_ = now;
+
+    if (!cursorWindowLoaded()) // wait for data instead of playing through empty windows
+        return;
+
+    cursor(cursor_ + elapsed_s*playback_speed_);
+
+    if (cursor_ >= time_end_)
+        pause();
+}
+
+bool DBOTimeWindowPager::hasWindow (const std::string& dbo_name, unsigned int window) const
+{
+    return windows_.count(dbo_name) && windows_.at(dbo_name).count(window);
+}
+
+std::shared_ptr<Buffer> DBOTimeWindowPager::window (const std::string& dbo_name, unsigned int window) const
+{
+    assert (hasWindow(dbo_name, window));
+    return windows_.at(dbo_name).at(window);
+}
+
+bool DBOTimeWindowPager::windowFailed (const std::string& dbo_name, unsigned int window) const
+{
+    return failed_windows_.count(dbo_name) && failed_windows_.at(dbo_name).count(window);
+}
+
+bool DBOTimeWindowPager::cursorWindowLoaded () const
+{
+    unsigned int cursor_window = windowFor(cursor_);
+
+    for (auto& set_it : read_sets_)
+        if (!hasWindow(set_it.first, cursor_window) && !windowFailed(set_it.first, cursor_window))
+            return false;
+
+    return true;
+}
+
+size_t DBOTimeWindowPager::memoryUsage () const
+{
+    size_t bytes {0};
+
+    for (auto& dbo_it : windows_)
+        for (auto& window_it : dbo_it.second)
+            bytes += window_it.second->memoryUsage();
+
+    return bytes;
+}
+
+std::vector<unsigned int> DBOTimeWindowPager::wantedWindows () const
+{
+    unsigned int cursor_window = windowFor(cursor_);
+    unsigned int first_window = windowFor(time_begin_);
+    unsigned int last_window = windowFor(time_end_);
+
+    std::vector<unsigned int> windows {cursor_window};
+
+    // alternate after and before cursor, playback moves forward
+    for (unsigned int distance=1; windows.size() < cache_size_; ++distance)
+    {
+        bool after = cursor_window + distance <= last_window;
+        bool before = cursor_window >= first_window + distance;
+
+        if (!after && !before)
+            break;
+
+        if (after)
+            windows.push_back(cursor_window + distance);
+
+        if (before && windows.size() < cache_size_)
+            windows.push_back(cursor_window - distance);
+    }
+
+    return windows;
+}
+
+void DBOTimeWindowPager::updateWindows ()
+{
+    std::vector<unsigned int> wanted_windows = wantedWindows();
+    size_t num_read = std::min<size_t>(wanted_windows.size(), 1+2*prefetch_windows_);
+
+    for (auto& set_it : read_sets_)
+    {
+        const std::string& dbo_name = set_it.first;
+
+        // evict cached windows and cancel reads no longer wanted
+        std::map<unsigned int, std::shared_ptr<Buffer>>& windows = windows_[dbo_name];
+
+        for (auto window_it = windows.begin(); window_it != windows.end();)
+        {
+            if (std::find(wanted_windows.begin(), wanted_windows.end(), window_it->first) == wanted_windows.end())
+            {
+                logdbg << "DBOTimeWindowPager: updateWindows: evicting " << dbo_name << " window "
+                       << window_it->first;
+
+                window_it = windows.erase(window_it);
+            }
+            else
+                ++window_it;
+        }
+
+        // failed windows are read again when wanted later
+        std::set<unsigned int>& failed_windows = failed_windows_[dbo_name];
+
+        for (auto failed_it = failed_windows.begin(); failed_it != failed_windows.end();)
+        {
+            if (std::find(wanted_windows.begin(), wanted_windows.end(), *failed_it) == wanted_windows.end())
+                failed_it = failed_windows.erase(failed_it);
+            else
+                ++failed_it;
+        }
+
+        std::map<unsigned int, std::shared_ptr<DBOTimeWindowReadJob>>& jobs = read_jobs_[dbo_name];
+
+        for (auto job_it = jobs.begin(); job_it != jobs.end();)
+        {
+            if (std::find(wanted_windows.begin(), wanted_windows.end(), job_it->first) == wanted_windows.end())
+            {
+                JobManager::instance().cancelJob(job_it->second);
+                job_it = jobs.erase(job_it);
+            }
+            else
+                ++job_it;
+        }
+
+        // read missing windows in order of priority
+        for (size_t cnt=0; cnt < num_read; ++cnt)
+        {
+            unsigned int window = wanted_windows.at(cnt);
+
+            if (!windows.count(window) && !jobs.count(window) && !failed_windows.count(window))
+                readWindow(dbo_name, window);
+        }
+    }
+}
+
+void DBOTimeWindowPager::readWindow (const std::string& dbo_name, unsigned int window)
+{
+    logdbg << "DBOTimeWindowPager: readWindow: " << dbo_name << " window " << window;
+
+    assert (read_sets_.count(dbo_name));
+
+    DBObject& object = manager_.object(dbo_name);
+
+    if (!object.loadable() || !object.existsInDB()) // e.g. database content changed since readSet
+    {
+        logwrn << "DBOTimeWindowPager: readWindow: " << dbo_name << " not loadable or not in database";
+        failed_windows_[dbo_name].insert(window);
+        return;
+    }
+
+    DBOVariable& tod_variable = manager_.metaVariable("tod").getFor(dbo_name);
+
+    std::string custom_filter_clause;
+    std::vector <DBOVariable*> filtered_variables;
+
+    if (manager_.useFilters())
+        custom_filter_clause = ATSDB::instance().filterManager().getSQLCondition (dbo_name, filtered_variables);
+
+    bool create_index = indexed_objects_.count(dbo_name) == 0;
+    indexed_objects_.insert(dbo_name);
+
+    std::shared_ptr<DBOTimeWindowReadJob> read_job = std::make_shared<DBOTimeWindowReadJob> (
+                ATSDB::instance().interface(), object, read_sets_.at(dbo_name), tod_variable, window,
+                windowBegin(window), windowEnd(window), custom_filter_clause, filtered_variables, create_index);
+
+    connect (read_job.get(), &DBOTimeWindowReadJob::doneSignal, this, &DBOTimeWindowPager::readJobDoneSlot,
+             Qt::QueuedConnection);
+    connect (read_job.get(), &DBOTimeWindowReadJob::obsoleteSignal, this, &DBOTimeWindowPager::readJobObsoleteSlot,
+             Qt::QueuedConnection);
+
+    read_jobs_[dbo_name][window] = read_job;
+
+    JobManager::instance().addDBJob(read_job);
+}
+
+void DBOTimeWindowPager::cancelReadJobs (const std::string& dbo_name)
+{
+    if (!read_jobs_.count(dbo_name))
+        return;
+
+    for (auto& job_it : read_jobs_.at(dbo_name))
+        JobManager::instance().cancelJob(job_it.second);
+
+    read_jobs_.erase(dbo_name);
+}
+
+void DBOTimeWindowPager::readJobDoneSlot ()
+{
+    DBOTimeWindowReadJob* read_job = dynamic_cast<DBOTimeWindowReadJob*> (QObject::sender());
+
+    if (!read_job)
+    {
+        logwrn << "DBOTimeWindowPager: readJobDoneSlot: null sender, event on the loose";
+        return;
+    }
+
+    const std::string& dbo_name = read_job->dbObject().name();
+    unsigned int window = read_job->window();
+
+    if (!read_jobs_.count(dbo_name) || !read_jobs_.at(dbo_name).count(window)
+            || read_jobs_.at(dbo_name).at(window).get() != read_job) // cancelled
+        return;
+
+    std::shared_ptr<Buffer> buffer = read_job->buffer();
+
+    read_jobs_.at(dbo_name).erase(window);
+
+    if (!buffer)
+    {
+        logwrn << "DBOTimeWindowPager: readJobDoneSlot: " << dbo_name << " window " << window << " not read";
+        failed_windows_[dbo_name].insert(window);
+        return;
+    }
+
+    logdbg << "DBOTimeWindowPager: readJobDoneSlot: " << dbo_name << " window " << window << " rows "
+           << buffer->size();
+
+    windows_[dbo_name][window] = buffer;
+
+    manager_.checkMemoryBudget();
+
+    emit windowLoadedSignal(dbo_name, window);
+}
+
+void DBOTimeWindowPager::readJobObsoleteSlot ()
+{
+    logdbg << "DBOTimeWindowPager: readJobObsoleteSlot";
+
+    DBOTimeWindowReadJob* read_job = dynamic_cast<DBOTimeWindowReadJob*> (QObject::sender());
+
+    if (!read_job)
+        return;
+
+    const std::string& dbo_name = read_job->dbObject().name();
+    unsigned int window = read_job->window();
+
+    if (!read_jobs_.count(dbo_name) || !read_jobs_.at(dbo_name).count(window)
+            || read_jobs_.at(dbo_name).at(window).get() != read_job) // cancelled by the pager
+        return;
+
+    // made obsolete from outside, e.g. on shutdown
+    read_jobs_.at(dbo_name).erase(window);
+    failed_windows_[dbo_name].insert(window);
+}
@@ -0,0 +1,139 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOTIMEWINDOWPAGER_H
+#define DBOTIMEWINDOWPAGER_H
+
+#include <QObject>
+#include <QTimer>
+
+#include <map>
+#include <memory>
+#include <set>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+#include "configurable.h"
+#include "dbovariableset.h"
+
+class Buffer;
+class DBObjectManager;
+class DBOTimeWindowReadJob;
+
+/**
+ * @brief Time-windowed access to DBObject data with prefetching and a playback cursor
+ *
+ * The time of day is divided into windows of fixed length. For all objects with a read set, the window containing
+ * the playback cursor is read first, then the adjacent prefetch windows, using ordered reads on the tod meta
+ * variable (an index on the tod column is created before the first read). Per object, only the cache size windows
+ * closest to the cursor are held, all others are evicted. Windows which could not be read are marked as failed,
+ * so that playback does not wait for them, and are read again once they were not wanted any more.
+ *
+ * Views subscribe to cursorChangedSignal and windowLoadedSignal and access the buffers of the cached windows, so
+ * scrubbing through a day of data only holds a few windows in memory instead of the whole loaded data. Used by the
+ * ListBoxView in time window mode, window length, cache size and prefetch windows are configuration parameters.
+ */
+class DBOTimeWindowPager : public QObject, public Configurable
+{
+    Q_OBJECT
+
+signals:
+    /// @brief Emitted when the playback cursor moved
+    void cursorChangedSignal (double tod);
+    /// @brief Emitted when a window of an object was read
+    void windowLoadedSignal (const std::string& dbo_name, unsigned int window);
+    void playingChangedSignal (bool playing);
+
+public slots:
+    void readJobDoneSlot ();
+    void readJobObsoleteSlot ();
+    void playbackTimerSlot ();
+
+public:
+    DBOTimeWindowPager(const std::string& class_id, const std::string& instance_id, DBObjectManager* manager);
+    virtual ~DBOTimeWindowPager();
+
+    /// @brief Sets variables read for an object, removes its cached windows and reads them again
+    void readSet (const std::string& dbo_name, const DBOVariableSet& read_set);
+    void removeReadSet (const std::string& dbo_name);
+    /// @brief Removes all cached windows and reads the required ones again, e.g. after content changes
+    void reload ();
+
+    unsigned int windowFor (double tod) const;
+    double windowBegin (unsigned int window) const { return window*window_length_s_; }
+    double windowEnd (unsigned int window) const { return (window+1)*window_length_s_; }
+
+    double cursor () const { return cursor_; }
+    /// @brief Moves the cursor into [begin, end] of the time range, reads required and evicts other windows
+    void cursor (double tod);
+
+    double timeBegin () const { return time_begin_; }
+    double timeEnd () const { return time_end_; }
+
+    /// @brief Starts moving the cursor with wall clock time multiplied by speed, stops at end of time range
+    void play (double speed);
+    void pause ();
+    bool playing () const { return playback_timer_.isActive(); }
+
+    /// @brief Returns if window of object is cached
+    bool hasWindow (const std::string& dbo_name, unsigned int window) const;
+    /// @brief Returns buffer of cached window, rows are ordered by tod
+    std::shared_ptr<Buffer> window (const std::string& dbo_name, unsigned int window) const;
+
+    /// @brief Returns number of bytes held by cached windows
+    size_t memoryUsage () const;
+
+protected:
+    DBObjectManager& manager_;
+
+    double window_length_s_ {300.0};
+    unsigned int cache_size_ {5};
+    unsigned int prefetch_windows_ {1};
+    unsigned int playback_update_ms_ {100};
+
+    std::map<std::string, DBOVariableSet> read_sets_;
+    /// dbo name -> window -> buffer
+    std::map<std::string, std::map<unsigned int, std::shared_ptr<Buffer>>> windows_;
+    /// dbo name -> window -> read job
+    std::map<std::string, std::map<unsigned int, std::shared_ptr<DBOTimeWindowReadJob>>> read_jobs_;
+    /// dbo name -> windows which could not be read
+    std::map<std::string, std::set<unsigned int>> failed_windows_;
+    std::set<std::string> indexed_objects_;
+
+    double cursor_ {0};
+    double time_begin_ {0};
+    double time_end_ {24*3600.0};
+
+    QTimer playback_timer_;
+    double playback_speed_ {1.0};
+    boost::posix_time::ptime playback_time_; // wall clock time of last cursor update
+
+    /// @brief Returns if reading the window of object failed
+    bool windowFailed (const std::string& dbo_name, unsigned int window) const;
+    /// @brief Returns if the window at the cursor is cached or failed for all objects with read set
+    bool cursorWindowLoaded () const;
+
+    /// @brief Returns windows to be cached, ordered by priority: cursor window, then adjacent ones
+    std::vector<unsigned int> wantedWindows () const;
+    /// @brief Starts read jobs for missing wanted windows, evicts cached windows not wanted any more
+    void updateWindows ();
+    void readWindow (const std::string& dbo_name, unsigned int window);
+    void cancelReadJobs (const std::string& dbo_name);
+};
+
+#endif // DBOTIMEWINDOWPAGER_H
@@ -174,7 +174,7 @@ void DBODataSource::finalize ()
 
 // azimuth degrees, range nautical miles, altitude in meters
 bool DBODataSource::calculateOGRSystemCoordinates (double azimuth_rad, double slant_range_m, bool has_baro_altitude,
-                                                   double baro_altitude_ft, double &sys_x, double &sys_y)
+                                                   double baro_altitude_ft, double &sys_x, double &sys_y) const
 {
     if (!finalized_)
         logerr << "DBODataSource: calculateOGRSystemCoordinates: " << short_name_ << " not finalized";
@@ -229,7 +229,7 @@ bool DBODataSource::calculateOGRSystemCoordinates (double azimuth_rad, double sl
 
 // azimuth degrees, range nautical miles, altitude in meters
 bool DBODataSource::calculateSDLGRSCoordinates (double azimuth_rad, double slant_range_m, bool has_baro_altitude,
-                                                double baro_altitude_ft, t_CPos& grs_pos)
+                                                double baro_altitude_ft, t_CPos& grs_pos) const
 {
     if (!finalized_)
         logerr << "DBODataSource: calculateSDLSystemCoordinates: " << short_name_ << " not finalized";
@@ -448,7 +448,7 @@ void DBODataSource::initRS2G()
     rs2g_hi_ = altitude_;
 }
 
-double DBODataSource::rs2gAzimuth(double x, double y)
+double DBODataSource::rs2gAzimuth(double x, double y) const
 {
     double azimuth = 0.0;
 
@@ -490,7 +490,7 @@ double DBODataSource::rs2gAzimuth(double x, double y)
     return azimuth;
 }
 
-double DBODataSource::rs2gElevation(double z, double rho)
+double DBODataSource::rs2gElevation(double z, double rho) const
 {
     double elevation = 0.0;
 
@@ -515,7 +515,7 @@ double DBODataSource::rs2gElevation(double z, double rho)
 }
 
 
-void DBODataSource::radarSlant2LocalCart(VecB& local)
+void DBODataSource::radarSlant2LocalCart(VecB& local) const
 {
     logdbg << "radarSlant2LocalCart: in x: " << local[0] << " y: " << local[1] << " z: " << local[2];
 
@@ -541,7 +541,7 @@ void DBODataSource::radarSlant2LocalCart(VecB& local)
     logdbg << "radarSlant2LocalCart: out x: " << local[0] << " y: " << local[1] << " z: " << local[2];
 }
 
-void DBODataSource::sysCart2SysStereo(VecB& b, double* x, double* y)
+void DBODataSource::sysCart2SysStereo(VecB& b, double* x, double* y) const
 {
     double H = sqrt(pow(b[0], 2) + pow(b[1], 2) + pow(b[2] + rs2g_ho_ + rs2g_Rto_, 2)) - rs2g_Rto_;
     double k = 2 * rs2g_Rto_ / (2 * rs2g_Rto_ + rs2g_ho_ + b[2] + H);
@@ -550,7 +550,7 @@ void DBODataSource::sysCart2SysStereo(VecB& b, double* x, double* y)
     *y = k * b[1];
 }
 
-void DBODataSource::localCart2Geocentric(VecB& input)
+void DBODataSource::localCart2Geocentric(VecB& input) const
 {
     logdbg << "localCart2Geocentric: in x: " << input[0] << " y:" << input[1] << " z:" << input[2];
 
@@ -566,7 +566,7 @@ void DBODataSource::localCart2Geocentric(VecB& input)
     logdbg << "localCart2Geocentric: out x: " << input[0] << " y:" << input[1] << " z:" << input[2];
 }
 
-bool DBODataSource::calculateRadSlt2Geocentric (double x, double y, double z, Eigen::Vector3d& geoc_pos)
+bool DBODataSource::calculateRadSlt2Geocentric (double x, double y, double z, Eigen::Vector3d& geoc_pos) const
 {
     if (!finalized_)
         logerr << "DBODataSource: calculateRadSlt2Geocentric: " << short_name_ << " not finalized";
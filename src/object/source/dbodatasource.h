@@ -82,13 +82,14 @@ public:
     bool isFinalized () { return finalized_; } // returns false if projection can not be made because of error
 
     // azimuth degrees, range & altitude in meters
+    // projections only read the state set in finalize, so they can be called from several threads concurrently
     bool calculateOGRSystemCoordinates (double azimuth_rad, double slant_range_m, bool has_baro_altitude,
-                                        double baro_altitude_ft, double &sys_x, double &sys_y);
+                                        double baro_altitude_ft, double &sys_x, double &sys_y) const;
 
     bool calculateSDLGRSCoordinates (double azimuth_rad, double slant_range_m, bool has_baro_altitude,
-                                     double baro_altitude_ft, t_CPos& grs_pos);
+                                     double baro_altitude_ft, t_CPos& grs_pos) const;
 
-    bool calculateRadSlt2Geocentric (double x, double y, double z, Eigen::Vector3d& geoc_pos);
+    bool calculateRadSlt2Geocentric (double x, double y, double z, Eigen::Vector3d& geoc_pos) const;
 
     DBObject& object() { assert (object_); return *object_; }
     void updateInDatabase (); // not called automatically in setters
@@ -141,11 +142,11 @@ protected:
     VecB rs2g_b_p0q0_;
 
     void initRS2G ();
-    double rs2gAzimuth(double x, double y);
-    double rs2gElevation(double z, double rho);
-    void radarSlant2LocalCart(VecB& local);
-    void sysCart2SysStereo(VecB& b, double* x, double* y);
-    void localCart2Geocentric(VecB& input);
+    double rs2gAzimuth(double x, double y) const;
+    double rs2gElevation(double z, double rho) const;
+    void radarSlant2LocalCart(VecB& local) const;
+    void sysCart2SysStereo(VecB& b, double* x, double* y) const;
+    void localCart2Geocentric(VecB& input) const;
 
 };
 
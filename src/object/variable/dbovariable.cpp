@@ -479,6 +479,39 @@ std::string DBOVariable::getMaxString ()
     return max_;
 }
 
+PropertyDataType DBOVariable::narrowestDataType ()
+{
+    if (!Property::isInteger(data_type_) || hasDimension()) // unit transformed min/max not stored values
+        return data_type_;
+
+    std::string min_str = getMinString();
+    std::string max_str = getMaxString();
+
+    if (min_str == NULL_STRING || max_str == NULL_STRING)
+        return data_type_;
+
+    long long min, max;
+
+    try
+    {
+        min = std::stoll(min_str);
+        max = std::stoll(max_str);
+    }
+    catch (std::exception& e) // e.g. unsigned long int maxima exceeding long long, not narrowed
+    {
+        logdbg << "DBOVariable: narrowestDataType: object " << dboName() << " name " << name()
+               << " min/max not convertible: " << e.what();
+        return data_type_;
+    }
+
+    PropertyDataType type = Property::narrowestDataType(data_type_, min, max);
+
+    logdbg << "DBOVariable: narrowestDataType: object " << dboName() << " name " << name() << " min " << min_str
+           << " max " << max_str << " type " << Property::asString(type);
+
+    return type;
+}
+
 std::string DBOVariable::getMinStringRepresentation ()
 {
     if (representation_ == Representation::STANDARD)
@@ -577,6 +610,16 @@ std::string DBOVariable::getRepresentationStringFromValue (const std::string& va
         unsigned char value = std::stoul(value_str);
         return getAsSpecialRepresentationString (value);
     }
+    case PropertyDataType::SHORTINT:
+    {
+        short int value = std::stoi(value_str);
+        return getAsSpecialRepresentationString (value);
+    }
+    case PropertyDataType::USHORTINT:
+    {
+        unsigned short int value = std::stoul(value_str);
+        return getAsSpecialRepresentationString (value);
+    }
     case PropertyDataType::INT:
     {
         int value = std::stoi(value_str);
@@ -603,6 +646,7 @@ std::string DBOVariable::getRepresentationStringFromValue (const std::string& va
         return getAsSpecialRepresentationString (value);
     }
     case PropertyDataType::DOUBLE:
+    case PropertyDataType::TIMESTAMP: // value strings of timestamps are seconds
     {
         double value = std::stod(value_str);
         return getAsSpecialRepresentationString (value);
@@ -700,6 +744,20 @@ std::string DBOVariable::multiplyString (const std::string& value_str, double fa
         return_string = std::to_string(value);
         break;
     }
+    case PropertyDataType::SHORTINT:
+    {
+        short int value = std::stoi(value_str);
+        value *= factor;
+        return_string = std::to_string(value);
+        break;
+    }
+    case PropertyDataType::USHORTINT:
+    {
+        unsigned short int value = std::stoul(value_str);
+        value *= factor;
+        return_string = std::to_string(value);
+        break;
+    }
     case PropertyDataType::INT:
     {
         int value = std::stoi(value_str);
@@ -736,6 +794,7 @@ std::string DBOVariable::multiplyString (const std::string& value_str, double fa
         break;
     }
     case PropertyDataType::DOUBLE:
+    case PropertyDataType::TIMESTAMP:
     {
         double value = std::stod(value_str);
         value *= factor;
@@ -774,6 +833,7 @@ const
     {
     case PropertyDataType::BOOL:
     case PropertyDataType::UCHAR:
+    case PropertyDataType::USHORTINT:
     case PropertyDataType::UINT:
     case PropertyDataType::ULONGINT:
     {
@@ -783,6 +843,7 @@ const
             return value_b_str;
     }
     case PropertyDataType::CHAR:
+    case PropertyDataType::SHORTINT:
     case PropertyDataType::INT:
     {
         if (std::stoi(value_a_str) > std::stoi(value_b_str))
@@ -805,6 +866,7 @@ const
             return value_b_str;
     }
     case PropertyDataType::DOUBLE:
+    case PropertyDataType::TIMESTAMP:
     {
         if (std::stod(value_a_str) > std::stod(value_b_str))
             return value_a_str;
@@ -839,6 +901,7 @@ const
     {
     case PropertyDataType::BOOL:
     case PropertyDataType::UCHAR:
+    case PropertyDataType::USHORTINT:
     case PropertyDataType::UINT:
     case PropertyDataType::ULONGINT:
     {
@@ -848,6 +911,7 @@ const
             return value_b_str;
     }
     case PropertyDataType::CHAR:
+    case PropertyDataType::SHORTINT:
     case PropertyDataType::INT:
     {
         if (std::stoi(value_a_str) < std::stoi(value_b_str))
@@ -870,6 +934,7 @@ const
             return value_b_str;
     }
     case PropertyDataType::DOUBLE:
+    case PropertyDataType::TIMESTAMP:
     {
         if (std::stod(value_a_str) < std::stod(value_b_str))
             return value_a_str;
@@ -134,6 +134,8 @@ public:
     std::string getMaxString ();
     std::string getMinStringRepresentation ();
     std::string getMaxStringRepresentation ();
+    /// @brief Returns narrowest integer data type holding the range of the min/max table, data type if not applicable
+    PropertyDataType narrowestDataType ();
 
     DBOVariableWidget* widget ();
 
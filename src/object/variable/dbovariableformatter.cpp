@@ -0,0 +1,382 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbovariableformatter.h"
+#include "dbobject.h"
+#include "buffer.h"
+#include "stringconv.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+/// Digit pairs for two decimal, octal (6 bit) or hex (8 bit) digits at once
+struct FormatTables
+{
+    char decimal_[200];
+    char octal_[128];
+    char hex_[512];
+
+    FormatTables()
+    {
+        const char* hex_digits = "0123456789ABCDEF";
+
+        for (unsigned int cnt=0; cnt < 100; ++cnt)
+        {
+            decimal_[2*cnt] = '0'+cnt/10;
+            decimal_[2*cnt+1] = '0'+cnt%10;
+        }
+
+        for (unsigned int cnt=0; cnt < 64; ++cnt)
+        {
+            octal_[2*cnt] = '0'+cnt/8;
+            octal_[2*cnt+1] = '0'+cnt%8;
+        }
+
+        for (unsigned int cnt=0; cnt < 256; ++cnt)
+        {
+            hex_[2*cnt] = hex_digits[cnt/16];
+            hex_[2*cnt+1] = hex_digits[cnt%16];
+        }
+    }
+};
+
+const FormatTables tables;
+
+/// @brief Appends digits written backwards from end, removing leading zeros down to width, padded to width
+inline void appendDigits (std::string& str, char* begin, char* end, unsigned int width)
+{
+    while (end-begin > 1 && *begin == '0' && static_cast<unsigned int>(end-begin) > width)
+        ++begin;
+
+    for (size_t cnt=end-begin; cnt < width; ++cnt)
+        str += '0';
+
+    str.append(begin, end);
+}
+
+}
+
+DBOVariableFormatter::DBOVariableFormatter (const DBOVariable& variable)
+    : variable_(variable), representation_(variable.representation())
+{
+    if (representation_ == DBOVariable::Representation::DATA_SRC_NAME)
+    {
+        DBObject& object = variable_.dbObject();
+
+        if (object.hasDataSources())
+        {
+            for (auto ds_it = object.dsBegin(); ds_it != object.dsEnd(); ++ds_it)
+            {
+                if (ds_it->second.hasShortName())
+                    data_source_names_[ds_it->first] = ds_it->second.shortName();
+                else
+                    data_source_names_[ds_it->first] = ds_it->second.name();
+            }
+        }
+    }
+}
+
+void DBOVariableFormatter::format (Buffer& buffer, size_t begin, size_t end)
+{
+    const std::string& property_name = variable_.name();
+
+    assert (buffer.properties().hasProperty(property_name));
+    PropertyDataType data_type = buffer.properties().get(property_name).dataType(); // integers may be narrowed
+
+    switch (data_type)
+    {
+    case PropertyDataType::BOOL:
+        assert (buffer.has<bool>(property_name));
+        format(buffer.get<bool>(property_name), begin, end);
+        break;
+    case PropertyDataType::CHAR:
+        assert (buffer.has<char>(property_name));
+        format(buffer.get<char>(property_name), begin, end);
+        break;
+    case PropertyDataType::UCHAR:
+        assert (buffer.has<unsigned char>(property_name));
+        format(buffer.get<unsigned char>(property_name), begin, end);
+        break;
+    case PropertyDataType::SHORTINT:
+        assert (buffer.has<short int>(property_name));
+        format(buffer.get<short int>(property_name), begin, end);
+        break;
+    case PropertyDataType::USHORTINT:
+        assert (buffer.has<unsigned short int>(property_name));
+        format(buffer.get<unsigned short int>(property_name), begin, end);
+        break;
+    case PropertyDataType::INT:
+        assert (buffer.has<int>(property_name));
+        format(buffer.get<int>(property_name), begin, end);
+        break;
+    case PropertyDataType::UINT:
+        assert (buffer.has<unsigned int>(property_name));
+        format(buffer.get<unsigned int>(property_name), begin, end);
+        break;
+    case PropertyDataType::LONGINT:
+        assert (buffer.has<long int>(property_name));
+        format(buffer.get<long int>(property_name), begin, end);
+        break;
+    case PropertyDataType::ULONGINT:
+        assert (buffer.has<unsigned long int>(property_name));
+        format(buffer.get<unsigned long int>(property_name), begin, end);
+        break;
+    case PropertyDataType::FLOAT:
+        assert (buffer.has<float>(property_name));
+        format(buffer.get<float>(property_name), begin, end);
+        break;
+    case PropertyDataType::DOUBLE:
+        assert (buffer.has<double>(property_name));
+        format(buffer.get<double>(property_name), begin, end);
+        break;
+    case PropertyDataType::TIMESTAMP:
+        assert (buffer.has<Timestamp>(property_name));
+        format(buffer.get<Timestamp>(property_name), begin, end);
+        break;
+    case PropertyDataType::STRING:
+        assert (buffer.has<std::string>(property_name));
+        format(buffer.get<std::string>(property_name), begin, end);
+        break;
+    default:
+        logerr << "DBOVariableFormatter: format: unknown property type "
+               << Property::asString(variable_.dataType());
+        throw std::domain_error ("DBOVariableFormatter: format: unknown property data type");
+    }
+}
+
+void DBOVariableFormatter::formatBlock (Buffer& buffer, size_t row)
+{
+    if (contains(row))
+        return;
+
+    size_t begin = row - row % BLOCK_SIZE;
+    format(buffer, begin, std::min(begin+BLOCK_SIZE, std::max(buffer.size(), row+1)));
+}
+
+void DBOVariableFormatter::clear ()
+{
+    begin_ = 0;
+    end_ = 0;
+    arena_.clear();
+    offsets_.clear();
+}
+
+void DBOVariableFormatter::appendValue (bool value)
+{
+    appendInteger(value, value);
+}
+
+void DBOVariableFormatter::appendValue (char value)
+{
+    appendGeneric(value); // streamed as character
+}
+
+void DBOVariableFormatter::appendValue (unsigned char value)
+{
+    appendGeneric(value); // streamed as character
+}
+
+void DBOVariableFormatter::appendValue (short int value)
+{
+    appendInteger(value, static_cast<unsigned short int>(value));
+}
+
+void DBOVariableFormatter::appendValue (unsigned short int value)
+{
+    appendInteger(value, value);
+}
+
+void DBOVariableFormatter::appendValue (int value)
+{
+    appendInteger(value, static_cast<unsigned int>(value));
+}
+
+void DBOVariableFormatter::appendValue (unsigned int value)
+{
+    appendInteger(value, value);
+}
+
+void DBOVariableFormatter::appendValue (long int value)
+{
+    appendInteger(value, static_cast<unsigned long int>(value));
+}
+
+void DBOVariableFormatter::appendValue (unsigned long int value)
+{
+    if (value > LONG_MAX)
+        appendGeneric(value);
+    else
+        appendInteger(static_cast<long int>(value), value);
+}
+
+void DBOVariableFormatter::appendValue (float value)
+{
+    if (representation_ == DBOVariable::Representation::STANDARD)
+        appendGeneric(value); // keeps float precision
+    else
+        appendFloatingPoint(value);
+}
+
+void DBOVariableFormatter::appendValue (double value)
+{
+    if (representation_ == DBOVariable::Representation::STANDARD)
+        appendGeneric(value);
+    else
+        appendFloatingPoint(value);
+}
+
+void DBOVariableFormatter::appendValue (const Timestamp& value)
+{
+    if (representation_ == DBOVariable::Representation::STANDARD)
+        arena_ += Utils::String::getValueString(value);
+    else
+        appendFloatingPoint(value.seconds());
+}
+
+void DBOVariableFormatter::appendValue (const std::string& value)
+{
+    arena_ += value; // no representation for strings
+}
+
+void DBOVariableFormatter::appendInteger (long int value, unsigned long int unsigned_value)
+{
+    switch (representation_)
+    {
+    case DBOVariable::Representation::STANDARD:
+        arena_ += std::to_string(value);
+        break;
+    case DBOVariable::Representation::SECONDS_TO_TIME:
+        appendTime(value);
+        break;
+    case DBOVariable::Representation::DEC_TO_OCTAL:
+        appendOctal(unsigned_value, 4);
+        break;
+    case DBOVariable::Representation::DEC_TO_HEX:
+        appendHex(unsigned_value, 6);
+        break;
+    case DBOVariable::Representation::FEET_TO_FLIGHTLEVEL:
+        appendFlightLevel(value);
+        break;
+    case DBOVariable::Representation::DATA_SRC_NAME:
+    {
+        auto it = data_source_names_.find(value);
+
+        if (it != data_source_names_.end())
+            arena_ += it->second;
+        else
+            arena_ += std::to_string(value);
+        break;
+    }
+    default:
+        appendGeneric(value);
+    }
+}
+
+void DBOVariableFormatter::appendFloatingPoint (double value)
+{
+    if (representation_ == DBOVariable::Representation::SECONDS_TO_TIME)
+        appendTime(value);
+    else if (representation_ == DBOVariable::Representation::FEET_TO_FLIGHTLEVEL)
+        appendFlightLevel(value);
+    else
+        appendGeneric(value); // octal, hex and data source names of floating point values are rare
+}
+
+void DBOVariableFormatter::appendOctal (unsigned long int value, unsigned int width)
+{
+    char digits[24];
+    char* end = digits+sizeof(digits);
+    char* begin = end;
+
+    do
+    {
+        begin -= 2;
+        memcpy(begin, tables.octal_+2*(value & 0x3F), 2);
+        value >>= 6;
+    } while (value);
+
+    appendDigits(arena_, begin, end, width);
+}
+
+void DBOVariableFormatter::appendHex (unsigned long int value, unsigned int width)
+{
+    char digits[16];
+    char* end = digits+sizeof(digits);
+    char* begin = end;
+
+    do
+    {
+        begin -= 2;
+        memcpy(begin, tables.hex_+2*(value & 0xFF), 2);
+        value >>= 8;
+    } while (value);
+
+    appendDigits(arena_, begin, end, width);
+}
+
+void DBOVariableFormatter::appendTime (double value)
+{
+    if (!(value >= 0.0 && value < 100*3600.0)) // outside of two-digit hours, also nan
+    {
+        arena_ += Utils::String::timeStringFromDouble(value);
+        return;
+    }
+
+    // same split as in timeStringFromDouble
+    double seconds = value;
+    int hours = static_cast<int> (seconds / 3600.0);
+    int minutes = static_cast<int> (static_cast<double>(static_cast<int> (seconds)%3600)/60.0);
+    seconds = seconds-hours*3600.0-minutes*60.0;
+
+    double scaled = seconds*1000.0;
+    long int milliseconds = std::lrint(scaled);
+    int full_seconds = milliseconds/1000;
+    milliseconds %= 1000;
+
+    // near half a millisecond the multiplication may round other than printf, also keeps table access safe
+    if (std::fabs(std::fabs(scaled-std::floor(scaled))-0.5) < 1e-6 || full_seconds > 99)
+    {
+        arena_ += Utils::String::timeStringFromDouble(value);
+        return;
+    }
+
+    char time[12]; // HH:MM:SS.mmm
+    memcpy(time, tables.decimal_+2*hours, 2);
+    time[2] = ':';
+    memcpy(time+3, tables.decimal_+2*minutes, 2);
+    time[5] = ':';
+    memcpy(time+6, tables.decimal_+2*full_seconds, 2);
+    time[8] = '.';
+    time[9] = '0'+milliseconds/100;
+    memcpy(time+10, tables.decimal_+2*(milliseconds%100), 2);
+
+    arena_.append(time, sizeof(time));
+}
+
+void DBOVariableFormatter::appendFlightLevel (double feet)
+{
+    stream_.str("");
+    stream_ << feet/100.0;
+    arena_ += stream_.str();
+}
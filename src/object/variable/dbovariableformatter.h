@@ -0,0 +1,147 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOVARIABLEFORMATTER_H
+#define DBOVARIABLEFORMATTER_H
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dbovariable.h"
+#include "nullablevector.h"
+
+class Buffer;
+
+/**
+ * @brief Formats a range of rows of a variable column in its representation at once
+ *
+ * The formatted values are packed into one string arena with an offset per row, so callers format a block of rows
+ * once and then only index into it, instead of formatting every cell on its own. Octal, hex and time strings are
+ * written with lookup tables, data source names are looked up in a table cached at construction. The output is the
+ * same as from DBOVariable::getAsSpecialRepresentationString (or the plain value string for the standard
+ * representation); null rows are empty.
+ */
+class DBOVariableFormatter
+{
+public:
+    /// Number of rows formatted at once by formatBlock
+    static const size_t BLOCK_SIZE {4096};
+
+    explicit DBOVariableFormatter (const DBOVariable& variable);
+    virtual ~DBOVariableFormatter() {}
+
+    /// @brief Formats rows [begin, end) of the variable column in the buffer, replacing the previous content
+    void format (Buffer& buffer, size_t begin, size_t end);
+    template <typename T> void format (NullableVector<T>& values, size_t begin, size_t end)
+    {
+        assert (begin <= end);
+        clear ();
+        begin_ = begin;
+        end_ = end;
+
+        offsets_.reserve(end-begin+1);
+        offsets_.push_back(0);
+
+        for (size_t row=begin; row < end; ++row)
+        {
+            if (!values.isNull(row))
+                appendValue (values.get(row));
+
+            offsets_.push_back(arena_.size());
+        }
+    }
+
+    /// @brief Formats the aligned block of rows containing row, unless it is already contained
+    void formatBlock (Buffer& buffer, size_t row);
+    template <typename T> void formatBlock (NullableVector<T>& values, size_t row)
+    {
+        if (contains(row))
+            return;
+
+        size_t begin = row - row % BLOCK_SIZE;
+        format(values, begin, std::min(begin+BLOCK_SIZE, std::max(values.size(), row+1)));
+    }
+
+    bool contains (size_t row) const { return row >= begin_ && row < end_; }
+    size_t begin () const { return begin_; }
+    size_t end () const { return end_; }
+
+    /// @brief Returns formatted value of row, which has to be contained
+    std::string get (size_t row) const
+    {
+        assert (contains(row));
+        return arena_.substr(offsets_[row-begin_], offsets_[row-begin_+1]-offsets_[row-begin_]);
+    }
+    /// @brief Appends formatted value of row, which has to be contained, to str
+    void append (size_t row, std::string& str) const
+    {
+        assert (contains(row));
+        str.append(arena_, offsets_[row-begin_], offsets_[row-begin_+1]-offsets_[row-begin_]);
+    }
+
+    void clear ();
+
+protected:
+    const DBOVariable& variable_;
+    DBOVariable::Representation representation_;
+
+    std::unordered_map<long int, std::string> data_source_names_;
+    std::ostringstream stream_;
+
+    size_t begin_ {0};
+    size_t end_ {0};
+    std::string arena_;
+    std::vector<size_t> offsets_; // row-begin -> start in arena, one past last row -> end
+
+    void appendValue (bool value);
+    void appendValue (char value);
+    void appendValue (unsigned char value);
+    void appendValue (short int value);
+    void appendValue (unsigned short int value);
+    void appendValue (int value);
+    void appendValue (unsigned int value);
+    void appendValue (long int value);
+    void appendValue (unsigned long int value);
+    void appendValue (float value);
+    void appendValue (double value);
+    /// @brief Appends timestamp as seconds value
+    void appendValue (const Timestamp& value);
+    void appendValue (const std::string& value);
+
+    /// @brief Appends integer value, unsigned_value being its bits as unsigned type of the original width
+    void appendInteger (long int value, unsigned long int unsigned_value);
+    void appendFloatingPoint (double value);
+    /// @brief Appends value using the generic per-value formatting
+    template <typename T> void appendGeneric (T value)
+    {
+        if (representation_ == DBOVariable::Representation::STANDARD)
+            arena_ += Utils::String::getValueString(value);
+        else
+            arena_ += variable_.getAsSpecialRepresentationString(value);
+    }
+
+    void appendOctal (unsigned long int value, unsigned int width);
+    void appendHex (unsigned long int value, unsigned int width);
+    void appendTime (double value);
+    void appendFlightLevel (double feet);
+};
+
+#endif // DBOVARIABLEFORMATTER_H
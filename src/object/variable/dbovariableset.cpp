@@ -101,6 +101,7 @@ void DBOVariableSet::removeVariableAt (unsigned int index)
 {
     assert (index < set_.size());
 
+    read_data_types_.erase (set_.at(index));
     set_.erase (set_.begin()+index);
 
     changed_=true;
@@ -109,6 +110,7 @@ void DBOVariableSet::removeVariableAt (unsigned int index)
 void DBOVariableSet::removeVariable (const DBOVariable &var)
 {
     set_.erase(std::remove(set_.begin(), set_.end(), &var), set_.end());
+    read_data_types_.erase(&var);
 }
 
 //DBOVariableSet *DBOVariableSet::getFor (const std::string &dbo_type)
@@ -149,6 +151,8 @@ DBOVariableSet& DBOVariableSet::operator= (const DBOVariableSet &source)
         add (*(*it));
     }
 
+    read_data_types_.insert(source.read_data_types_.begin(), source.read_data_types_.end());
+
     return *this;
 }
 
@@ -199,9 +203,26 @@ void DBOVariableSet::print ()
 void DBOVariableSet::clear ()
 {
     set_.clear();
+    read_data_types_.clear();
     changed_=true;
 }
 
+void DBOVariableSet::readDataType (const DBOVariable &var, PropertyDataType type)
+{
+    assert (find (set_.begin(), set_.end(), &var) != set_.end());
+
+    if (type == var.dataType())
+        read_data_types_.erase(&var);
+    else
+        read_data_types_[&var] = type;
+}
+
+PropertyDataType DBOVariableSet::readDataType (const DBOVariable &var) const
+{
+    auto it = read_data_types_.find(&var);
+    return it != read_data_types_.end() ? it->second : var.dataType();
+}
+
 bool DBOVariableSet::hasVariable (DBOVariable &variable)
 {
     return find (set_.begin(), set_.end(), &variable) != set_.end();
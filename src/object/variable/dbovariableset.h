@@ -18,6 +18,8 @@
 #ifndef DBOVARIABLESET_H_
 #define DBOVARIABLESET_H_
 
+#include <map>
+
 #include "propertylist.h"
 
 class DBOVariable;
@@ -75,9 +77,16 @@ public:
   /// @brief Returns number of variables in the set
   unsigned int getSize () const { return set_.size(); }
 
+  /// @brief Sets data type variable is read as, e.g. a narrower integer type
+  void readDataType (const DBOVariable &var, PropertyDataType type);
+  /// @brief Returns data type variable is read as, its data type if not set
+  PropertyDataType readDataType (const DBOVariable &var) const;
+
 protected:
   /// Container with all variables in the set
   std::vector <DBOVariable*> set_;
+  /// Read data types differing from the variable data types
+  std::map <const DBOVariable*, PropertyDataType> read_data_types_;
 
   /// Change occurred flag
   bool changed_;
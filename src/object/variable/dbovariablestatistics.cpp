@@ -0,0 +1,130 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dbovariablestatistics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+DBOVariableStatistics::DBOVariableStatistics (const std::string& dbo_name, const std::string& variable_name,
+                                              Source source)
+    : dbo_name_(dbo_name), variable_name_(variable_name), source_(source)
+{
+}
+
+double DBOVariableStatistics::quantile (double fraction) const
+{
+    assert (numeric_);
+    assert (fraction >= 0 && fraction <= 1.0);
+
+    if (quantiles_.count(fraction))
+        return quantiles_.at(fraction);
+
+    // interpolate between known quantiles, including min/max
+    double lower_fraction {0}, lower_value {min_};
+    double upper_fraction {1.0}, upper_value {max_};
+
+    for (auto& quantile_it : quantiles_)
+    {
+        if (quantile_it.first < fraction)
+        {
+            lower_fraction = quantile_it.first;
+            lower_value = quantile_it.second;
+        }
+        else
+        {
+            upper_fraction = quantile_it.first;
+            upper_value = quantile_it.second;
+            break;
+        }
+    }
+
+    if (upper_fraction <= lower_fraction)
+        return lower_value;
+
+    return lower_value + (upper_value-lower_value) * (fraction-lower_fraction) / (upper_fraction-lower_fraction);
+}
+
+void DBOVariableStatistics::quantilesFromHistogram ()
+{
+    assert (numeric_);
+
+    quantiles_.clear();
+    exact_quantiles_ = false;
+
+    size_t total {0};
+
+    for (size_t bin_count : histogram_)
+        total += bin_count;
+
+    if (!total)
+        return;
+
+    size_t cumulative {0};
+    size_t bin {0};
+
+    for (double fraction : quantileFractions())
+    {
+        double target = fraction * total;
+
+        while (bin < histogram_.size() && cumulative + histogram_.at(bin) < target)
+            cumulative += histogram_.at(bin++);
+
+        if (bin == histogram_.size())
+        {
+            quantiles_[fraction] = max_;
+            continue;
+        }
+
+        double inside = histogram_.at(bin) ? (target - cumulative) / histogram_.at(bin) : 0;
+        double value = bin_begin_ + (bin + inside) * bin_width_;
+
+        quantiles_[fraction] = std::max(min_, std::min(max_, value));
+    }
+}
+
+double DBOVariableStatistics::binWidth (double min, double max, unsigned int num_bins, bool integral)
+{
+    assert (num_bins);
+    assert (max >= min);
+
+    if (integral && max - min + 1 <= num_bins)
+        return 1.0;
+
+    if (max == min)
+        return 1.0;
+
+    double width = (max - min) / num_bins;
+
+    if (integral)
+        width = std::ceil(width);
+
+    return width;
+}
+
+const std::vector<double>& DBOVariableStatistics::quantileFractions ()
+{
+    static const std::vector<double> fractions {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    return fractions;
+}
+
+std::string DBOVariableStatistics::sourceString (Source source)
+{
+    return source == Source::LOADED ? "loaded" : "database";
+}
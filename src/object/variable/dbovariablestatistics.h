@@ -0,0 +1,82 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOVARIABLESTATISTICS_H
+#define DBOVARIABLESTATISTICS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Value distribution of a DBOVariable
+ *
+ * Holds counts, minimum/maximum, a histogram and the most frequent values, all numeric values in the unit of the
+ * variable. Quantiles are exact when calculated from loaded data, and interpolated from the histogram when
+ * calculated by SQL aggregation in the database.
+ */
+class DBOVariableStatistics
+{
+public:
+    enum class Source { DATABASE, LOADED };
+
+    DBOVariableStatistics (const std::string& dbo_name, const std::string& variable_name, Source source);
+
+    std::string dbo_name_;
+    std::string variable_name_;
+    Source source_;
+    /// DBObjectManager content version at calculation
+    unsigned int content_version_ {0};
+
+    size_t count_ {0};
+    size_t null_count_ {0};
+    size_t distinct_count_ {0};
+
+    /// Set if minimum, maximum, histogram and quantiles are valid
+    bool numeric_ {false};
+    double min_ {0};
+    double max_ {0};
+    std::string min_string_;
+    std::string max_string_;
+
+    /// Bin i counts values in [bin_begin_ + i*bin_width_, bin_begin_ + (i+1)*bin_width_), last bin includes max
+    double bin_begin_ {0};
+    double bin_width_ {0};
+    std::vector<size_t> histogram_;
+
+    /// Most frequent values and their counts, descending
+    std::vector<std::pair<std::string, size_t>> top_values_;
+
+    bool exact_quantiles_ {false};
+    /// Fraction -> value, for quantileFractions()
+    std::map<double, double> quantiles_;
+
+    size_t notNullCount () const { return count_ - null_count_; }
+
+    /// @brief Returns value below which the given fraction of values lie, numeric only
+    double quantile (double fraction) const;
+    /// @brief Sets quantiles by linear interpolation in the histogram
+    void quantilesFromHistogram ();
+
+    /// @brief Returns histogram bin width used for num_bins bins, 1 for integral values with a small range
+    static double binWidth (double min, double max, unsigned int num_bins, bool integral);
+    static const std::vector<double>& quantileFractions ();
+    static std::string sourceString (Source source);
+};
+
+#endif // DBOVARIABLESTATISTICS_H
@@ -182,7 +182,7 @@ t_Real utl_distance (t_Real dx, t_Real dy, t_Real dz)
 /*----------------------------------------------------------------------------*/
 
 t_Retc geo_calc_elv
-(t_Mapping_Info *info_ptr, t_Real rng, t_Real hgt, t_Real *elv_ptr)
+(const t_Mapping_Info *info_ptr, t_Real rng, t_Real hgt, t_Real *elv_ptr)
 {
     t_Real elv;    // Elevation of plot above radar plane; radians
     t_Real er;     // Local "best" earth radius; metres
@@ -337,7 +337,7 @@ t_Retc geo_calc_info (t_GPos centre, t_Mapping_Info *info_ptr)
 /*----------------------------------------------------------------------------*/
 
 t_Retc geo_grs_to_lcl
-(t_Mapping_Info *info_ptr, t_CPos grs_pos, t_CPos *lcl_ptr)
+(const t_Mapping_Info *info_ptr, t_CPos grs_pos, t_CPos *lcl_ptr)
 {
     t_Real gx, gy, gz;
     // Auxiliaries
@@ -477,7 +477,7 @@ t_Retc geo_grs_to_llh (t_CPos grs_pos, t_GPos *gpos_ptr)
 /*----------------------------------------------------------------------------*/
 
 t_Retc geo_lcl_to_grs
-(t_Mapping_Info *info_ptr, t_CPos lcl_pos, t_CPos *grs_ptr)
+(const t_Mapping_Info *info_ptr, t_CPos lcl_pos, t_CPos *grs_ptr)
 {
     t_Real gx;     // GRS x coordinate; metres
     t_Real gy;     // GRS y coordinate; metres
@@ -133,17 +133,17 @@ extern void preset_gpos (t_GPos *item_ptr);
                    // Access functions:
                    // -----------------
 
-extern t_Retc geo_calc_elv (t_Mapping_Info *info_ptr,
+extern t_Retc geo_calc_elv (const t_Mapping_Info *info_ptr,
                             t_Real rng, t_Real hgt, t_Real *elv_ptr);
                    // Calculate elevation from height
 extern t_Retc geo_calc_info (t_GPos centre, t_Mapping_Info *info_ptr);
                    // Calculate geodetical mapping information
-extern t_Retc geo_grs_to_lcl (t_Mapping_Info *info_ptr,
+extern t_Retc geo_grs_to_lcl (const t_Mapping_Info *info_ptr,
                               t_CPos grs_pos, t_CPos *lcl_ptr);
                    // Map a GRS position to local coordinates
 extern t_Retc geo_grs_to_llh (t_CPos grs_pos, t_GPos *gpos_ptr);
                    // Map GRS coordinates to geodetical point
-extern t_Retc geo_lcl_to_grs (t_Mapping_Info *info_ptr,
+extern t_Retc geo_lcl_to_grs (const t_Mapping_Info *info_ptr,
                               t_CPos lcl_pos, t_CPos *grs_ptr);
                    // Map local coordinates to GRS coordinates
 extern t_Retc geo_llh_to_grs (t_GPos geo_pos, t_CPos *grs_ptr);
@@ -0,0 +1,83 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdexcept>
+
+#include "projectioncontext.h"
+#include "logger.h"
+
+ProjectionContext::ProjectionContext (unsigned int epsg_value, unsigned int generation)
+    : generation_(generation)
+{
+    logdbg << "ProjectionContext: constructor: epsg " << epsg_value << " generation " << generation_;
+
+    ogr_geo_.SetWellKnownGeogCS("WGS84");
+
+    OGRErr error = ogr_cart_.importFromEPSG(epsg_value);
+    if (error != OGRERR_NONE)
+        throw std::runtime_error ("ProjectionContext: constructor: cartesian EPSG value "
+                                  +std::to_string(epsg_value)+" caused OGR error "+std::to_string((int)error));
+
+    ogr_geo2cart_.reset(OGRCreateCoordinateTransformation(&ogr_geo_, &ogr_cart_));
+    assert (ogr_geo2cart_);
+
+    ogr_cart2geo_.reset(OGRCreateCoordinateTransformation(&ogr_cart_, &ogr_geo_));
+    assert (ogr_cart2geo_);
+}
+
+bool ProjectionContext::ogrGeo2Cart (double latitude, double longitude, double& x_pos, double& y_pos)
+{
+    logdbg << "ProjectionContext: ogrGeo2Cart: lat " << latitude << " long " << longitude;
+
+    x_pos = longitude;
+    y_pos = latitude;
+
+    bool ret = ogr_geo2cart_->Transform(1, &x_pos, &y_pos);
+
+    if (!ret)
+        logerr << "ProjectionContext: ogrGeo2Cart: error with longitude " << longitude << " latitude " << latitude;
+
+    return ret;
+}
+
+bool ProjectionContext::ogrCart2Geo (double x_pos, double y_pos, double& latitude, double& longitude)
+{
+    logdbg << "ProjectionContext: ogrCart2Geo: x_pos " << x_pos << " y_pos " << y_pos;
+
+    longitude = x_pos;
+    latitude = y_pos;
+
+    bool ret = ogr_cart2geo_->Transform(1, &longitude, &latitude);
+
+    if (!ret)
+        logerr << "ProjectionContext: ogrCart2Geo: error with x_pos " << x_pos << " y_pos " << y_pos;
+
+    return ret;
+}
+
+bool ProjectionContext::sdlGRS2Geo (t_CPos grs_pos, t_GPos& geo_pos)
+{
+    t_GPos tmp_geo_pos;
+
+    t_Retc lrtc = geo_grs_to_llh (grs_pos, &tmp_geo_pos);
+
+    assert (lrtc == RC_OKAY);
+    geo_pos = tmp_geo_pos;
+
+    return true;
+}
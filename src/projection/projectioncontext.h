@@ -0,0 +1,63 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROJECTIONCONTEXT_H
+#define PROJECTIONCONTEXT_H
+
+#include <memory>
+
+#include <ogr_spatialref.h>
+
+#include "geomap.h"
+
+/**
+ * @brief Coordinate projection state owned by one thread
+ *
+ * OGR coordinate transformations can not be used by several threads at the same time, so each thread uses its own
+ * context, see ProjectionManager::context(). SDL projections are stateless and RS2G state is held read-only per data
+ * source, so both are only forwarded.
+ */
+class ProjectionContext
+{
+public:
+    /// @brief Constructor, creates OGR transformations between WGS-84 and the cartesian EPSG system
+    ProjectionContext (unsigned int epsg_value, unsigned int generation);
+    virtual ~ProjectionContext() {}
+
+    /// @brief Projects geo-coordinate in WGS-84 to cartesian coordinate, returns false on error
+    bool ogrGeo2Cart (double latitude, double longitude, double& x_pos, double& y_pos);
+    /// @brief Projects cartesian coordinate to geo-coordinate in WGS-84, returns false on error
+    bool ogrCart2Geo (double x_pos, double y_pos, double& latitude, double& longitude);
+
+    /// @brief Projects cartesian coordinate to geo-coordinate in WGS-84, returns false on error
+    bool sdlGRS2Geo (t_CPos grs_pos, t_GPos& geo_pos);
+
+    /// @brief Returns ProjectionManager generation the context was created for
+    unsigned int generation () const { return generation_; }
+
+protected:
+    unsigned int generation_ {0};
+
+    OGRSpatialReference ogr_geo_;
+    OGRSpatialReference ogr_cart_;
+
+    std::unique_ptr<OGRCoordinateTransformation> ogr_geo2cart_;
+    std::unique_ptr<OGRCoordinateTransformation> ogr_cart2geo_;
+};
+
+#endif // PROJECTIONCONTEXT_H
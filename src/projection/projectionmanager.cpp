@@ -18,11 +18,13 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <cmath>
+#include <memory>
 
 #include "cpl_conv.h"
 
 #include "projectionmanager.h"
 #include "projectionmanagerwidget.h"
+#include "projectioncontext.h"
 #include "global.h"
 #include "logger.h"
 
@@ -69,14 +71,6 @@ ProjectionManager::ProjectionManager()
 
 ProjectionManager::~ProjectionManager()
 {
-    assert (ogr_geo2cart_);
-    delete ogr_geo2cart_;
-    ogr_geo2cart_=0;
-
-    assert (ogr_cart2geo_);
-    delete ogr_cart2geo_;
-    ogr_cart2geo_=0;
-
     if (widget_)
     {
         delete widget_;
@@ -95,53 +89,32 @@ void ProjectionManager::shutdown ()
     }
 }
 
-bool ProjectionManager::ogrGeo2Cart (double latitude, double longitude, double& x_pos, double& y_pos)
+ProjectionContext& ProjectionManager::context ()
 {
-    logdbg << "ProjectionManager: ogrGeo2Cart: lat " << latitude << " long " << longitude;
+    // destroyed when the thread exits
+    thread_local std::unique_ptr<ProjectionContext> context;
 
-    x_pos = longitude;
-    y_pos = latitude;
+    unsigned int generation = generation_;
 
-    bool ret = ogr_geo2cart_->Transform(1, &x_pos, &y_pos);
+    if (!context || context->generation() != generation)
+        context.reset(new ProjectionContext (epsg_value_, generation));
 
-    if (!ret)
-        logerr << "ProjectionManager: ogrGeo2Cart: error with longitude " << longitude << " latitude " << latitude;
+    return *context;
+}
 
-    return ret;
+bool ProjectionManager::ogrGeo2Cart (double latitude, double longitude, double& x_pos, double& y_pos)
+{
+    return context().ogrGeo2Cart(latitude, longitude, x_pos, y_pos);
 }
 
 bool ProjectionManager::ogrCart2Geo (double x_pos, double y_pos, double& latitude, double& longitude)
 {
-    logdbg << "ProjectionManager: ogrCart2Geo: x_pos " << x_pos << " y_pos " << y_pos;
-
-    longitude = x_pos;
-    latitude = y_pos;
-
-    bool ret = ogr_cart2geo_->Transform(1, &longitude, &latitude);
-
-    if (!ret)
-        logerr << "ProjectionManager: ogrCart2Geo: error with x_pos " << x_pos << " y_pos " << y_pos;
-
-    return ret;
+    return context().ogrCart2Geo(x_pos, y_pos, latitude, longitude);
 }
 
 bool ProjectionManager::sdlGRS2Geo (t_CPos grs_pos, t_GPos& geo_pos)
 {
-    //logdbg << "ProjectionManager: sdlGRS2Geo: x_pos " << x_pos << " y_pos " << y_pos;
-
-    t_Retc lrtc;
-    //    t_CPos lcl_pos;
-
-    //    lrtc = geo_grs_to_lcl (sdl_mapping_info_, grs_pos, &lcl_pos);
-
-    t_GPos tmp_geo_pos;
-
-    lrtc = geo_grs_to_llh (grs_pos, &tmp_geo_pos);
-
-    assert (lrtc == RC_OKAY);
-    geo_pos = tmp_geo_pos;
-
-    return true;
+    return context().sdlGRS2Geo(grs_pos, geo_pos);
 }
 
 std::string ProjectionManager::getWorldPROJ4Info ()
@@ -170,21 +143,7 @@ void ProjectionManager::createOGRProjection ()
                                   +std::to_string(epsg_value_)+" caused OGR error "
                                   +std::to_string((int)error));
 
-    if (ogr_geo2cart_)
-    {
-        delete ogr_geo2cart_;
-        ogr_geo2cart_=0;
-    }
-    ogr_geo2cart_ = OGRCreateCoordinateTransformation( &ogr_geo_, &ogr_cart_ );
-    assert (ogr_geo2cart_);
-
-    if (ogr_cart2geo_)
-    {
-        delete ogr_cart2geo_;
-        ogr_cart2geo_=0;
-    }
-    ogr_cart2geo_ = OGRCreateCoordinateTransformation( &ogr_cart_, &ogr_geo_ );
-    assert (ogr_cart2geo_);
+    ++generation_; // thread contexts are re-created on next use
 }
 
 std::string ProjectionManager::getCartesianPROJ4Info ()
@@ -18,6 +18,8 @@
 #ifndef PROJECTIONMANAGER_H_
 #define PROJECTIONMANAGER_H_
 
+#include <atomic>
+
 #include <ogr_spatialref.h>
 #include "geomap.h"
 #include "rs2g.h"
@@ -27,6 +29,7 @@
 #include "configurable.h"
 #include "singleton.h"
 
+class ProjectionContext;
 class ProjectionManagerWidget;
 
 //typedef mtl::matrix<double,
@@ -44,6 +47,9 @@ class ProjectionManagerWidget;
  * @brief Singleton for coordinate projection handling
  *
  * Currently handles projection from world coordinates to Cartesian coordinates using the WGS-84 method.
+ *
+ * Projections are done in a ProjectionContext of the calling thread, so they can be used from several threads
+ * concurrently. Code projecting many positions should fetch context() once and use it directly.
  */
 class ProjectionManager : public Singleton, public Configurable
 {
@@ -55,6 +61,9 @@ public:
     /// @brief Desctructor
     virtual ~ProjectionManager();
 
+    /// @brief Returns projection context of the calling thread, created or updated on first use
+    ProjectionContext& context ();
+
     /// @brief Projects cartesian coordinate to geo-coordinate in WGS-84, returns false on error
     bool sdlGRS2Geo (t_CPos grs_pos, t_GPos& geo_pos);
 
@@ -109,8 +118,8 @@ protected:
     OGRSpatialReference ogr_geo_;
     OGRSpatialReference ogr_cart_;
 
-    OGRCoordinateTransformation* ogr_geo2cart_ {nullptr};
-    OGRCoordinateTransformation* ogr_cart2geo_ {nullptr};
+    /// Incremented when the cartesian system changes, contexts of older generations are re-created
+    std::atomic<unsigned int> generation_ {0};
 
     ProjectionManagerWidget* widget_ {nullptr};
 };
@@ -16,6 +16,7 @@
  */
 
 #include <limits>
+#include <vector>
 #include <boost/assign/list_of.hpp>
 
 #include "property.h"
@@ -25,24 +26,30 @@ std::map<PropertyDataType,std::string> Property::data_types_2_strings_ = boost::
         (PropertyDataType::BOOL,       "BOOL")
         (PropertyDataType::CHAR,       "CHAR")
         (PropertyDataType::UCHAR,      "UCHAR")
+        (PropertyDataType::SHORTINT,   "SHORTINT")
+        (PropertyDataType::USHORTINT,  "USHORTINT")
         (PropertyDataType::INT,        "INT")
         (PropertyDataType::UINT,       "UINT")
         (PropertyDataType::LONGINT,    "LONGINT")
         (PropertyDataType::ULONGINT,   "ULONGINT")
         (PropertyDataType::FLOAT,      "FLOAT")
         (PropertyDataType::DOUBLE,     "DOUBLE")
+        (PropertyDataType::TIMESTAMP,  "TIMESTAMP")
         (PropertyDataType::STRING,     "STRING");
 
 std::map<std::string, PropertyDataType> Property::strings_2_data_types_ = boost::assign::map_list_of
         ("BOOL", PropertyDataType::BOOL)
         ("CHAR", PropertyDataType::CHAR)
         ("UCHAR", PropertyDataType::UCHAR)
+        ("SHORTINT", PropertyDataType::SHORTINT)
+        ("USHORTINT", PropertyDataType::USHORTINT)
         ("INT", PropertyDataType::INT)
         ("UINT", PropertyDataType::UINT)
         ("LONGINT", PropertyDataType::LONGINT)
         ("ULONGINT", PropertyDataType::ULONGINT)
         ("FLOAT", PropertyDataType::FLOAT)
         ("DOUBLE", PropertyDataType::DOUBLE)
+        ("TIMESTAMP", PropertyDataType::TIMESTAMP)
         ("STRING", PropertyDataType::STRING);
 
 Property::Property(std::string id, PropertyDataType type)
@@ -65,6 +72,84 @@ PropertyDataType &Property::asDataType (const std::string &type)
     return strings_2_data_types_.at(type);
 }
 
+bool Property::isInteger (PropertyDataType type)
+{
+    switch (type)
+    {
+    case PropertyDataType::CHAR:
+    case PropertyDataType::UCHAR:
+    case PropertyDataType::SHORTINT:
+    case PropertyDataType::USHORTINT:
+    case PropertyDataType::INT:
+    case PropertyDataType::UINT:
+    case PropertyDataType::LONGINT:
+    case PropertyDataType::ULONGINT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Unsigned types are only chosen if the original type is unsigned, so that narrowing never changes the signedness
+ * of a variable. Never returns a wider type than the given one.
+ */
+PropertyDataType Property::narrowestDataType (PropertyDataType type, long long min, long long max)
+{
+    if (!isInteger(type))
+        return type;
+
+    assert (min <= max);
+
+    bool is_unsigned = type == PropertyDataType::UCHAR || type == PropertyDataType::USHORTINT
+            || type == PropertyDataType::UINT || type == PropertyDataType::ULONGINT;
+
+    std::vector<PropertyDataType> candidates;
+
+    if (is_unsigned)
+        candidates = {PropertyDataType::UCHAR, PropertyDataType::USHORTINT, PropertyDataType::UINT,
+                      PropertyDataType::ULONGINT};
+    else
+        candidates = {PropertyDataType::CHAR, PropertyDataType::SHORTINT, PropertyDataType::INT,
+                      PropertyDataType::LONGINT};
+
+    for (PropertyDataType candidate : candidates)
+    {
+        if (candidate == type) // never wider than the original
+            return type;
+
+        if (fits(candidate, min, max))
+            return candidate;
+    }
+
+    return type;
+}
+
+bool Property::fits (PropertyDataType type, long long min, long long max)
+{
+    switch (type)
+    {
+    case PropertyDataType::CHAR:
+        return min >= std::numeric_limits<signed char>::min() && max <= std::numeric_limits<signed char>::max();
+    case PropertyDataType::UCHAR:
+        return min >= 0 && max <= std::numeric_limits<unsigned char>::max();
+    case PropertyDataType::SHORTINT:
+        return min >= std::numeric_limits<short>::min() && max <= std::numeric_limits<short>::max();
+    case PropertyDataType::USHORTINT:
+        return min >= 0 && max <= std::numeric_limits<unsigned short>::max();
+    case PropertyDataType::INT:
+        return min >= std::numeric_limits<int>::min() && max <= std::numeric_limits<int>::max();
+    case PropertyDataType::UINT:
+        return min >= 0 && max <= std::numeric_limits<unsigned int>::max();
+    case PropertyDataType::LONGINT:
+        return true;
+    case PropertyDataType::ULONGINT:
+        return min >= 0;
+    default:
+        return false;
+    }
+}
+
 
 //PROPERTY_DATA_TYPE Property::getDataType() const
 //{
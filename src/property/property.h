@@ -21,8 +21,10 @@
 #include <string>
 #include <map>
 
-enum class PropertyDataType { BOOL, CHAR, UCHAR, INT, UINT, LONGINT, ULONGINT,
-    FLOAT, DOUBLE, STRING }; // P_TYPE_POINTER and SENTINEL removed
+#include "timestamp.h"
+
+enum class PropertyDataType { BOOL, CHAR, UCHAR, SHORTINT, USHORTINT, INT, UINT, LONGINT, ULONGINT,
+    FLOAT, DOUBLE, TIMESTAMP, STRING }; // P_TYPE_POINTER and SENTINEL removed
 
 /**
  * @brief Base class for a data item identifier
@@ -51,6 +53,11 @@ public:
   static const std::string &asString (PropertyDataType type);
   static PropertyDataType &asDataType (const std::string &type);
 
+  /// @brief Returns if type is one of the integer types (not BOOL)
+  static bool isInteger (PropertyDataType type);
+  /// @brief Returns the smallest integer type holding all values in [min, max], type itself if not an integer type
+  static PropertyDataType narrowestDataType (PropertyDataType type, long long min, long long max);
+
   static const std::map<PropertyDataType,std::string> &dataTypes2Strings() {return data_types_2_strings_; }
   static const std::map<std::string, PropertyDataType> &strings2DataTypes() { return strings_2_data_types_; }
 
@@ -64,6 +71,9 @@ protected:
   /// Mappings from PropertyDataType to strings, and back.
   static std::map<PropertyDataType,std::string> data_types_2_strings_;
   static std::map<std::string, PropertyDataType> strings_2_data_types_;
+
+  /// @brief Returns if all values in [min, max] can be held by integer type
+  static bool fits (PropertyDataType type, long long min, long long max);
 };
 
 #endif /* PROPERTY_H_ */
@@ -0,0 +1,66 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <cmath>
+#include <ostream>
+
+/**
+ * @brief Fixed-point time value, data type of TIMESTAMP properties
+ *
+ * Held as signed 64-bit count of nanoseconds, which is exact for all decimal time values up to nanoseconds and for
+ * the 1/128 s ASTERIX time resolution, while float seconds already lose milliseconds at the end of a day. Converted
+ * to and from seconds wherever values leave the buffer (database, text, JSON).
+ */
+class Timestamp
+{
+public:
+    static const long long TICKS_PER_SECOND = 1000000000;
+
+    Timestamp () {}
+    /// @brief Constructor from seconds, rounded to the nearest tick
+    explicit Timestamp (double seconds) : ticks_(std::llround(seconds*TICKS_PER_SECOND)) {}
+
+    static Timestamp fromTicks (long long ticks) { Timestamp value; value.ticks_ = ticks; return value; }
+
+    long long ticks () const { return ticks_; }
+    double seconds () const { return static_cast<double> (ticks_) / TICKS_PER_SECOND; }
+
+    Timestamp& operator+= (const Timestamp& other) { ticks_ += other.ticks_; return *this; }
+    /// @brief Scales value, used for unit transformations
+    Timestamp& operator*= (double factor) { ticks_ = std::llround(ticks_*factor); return *this; }
+
+    bool operator== (const Timestamp& other) const { return ticks_ == other.ticks_; }
+    bool operator!= (const Timestamp& other) const { return ticks_ != other.ticks_; }
+    bool operator< (const Timestamp& other) const { return ticks_ < other.ticks_; }
+    bool operator> (const Timestamp& other) const { return ticks_ > other.ticks_; }
+    bool operator<= (const Timestamp& other) const { return ticks_ <= other.ticks_; }
+    bool operator>= (const Timestamp& other) const { return ticks_ >= other.ticks_; }
+
+private:
+    long long ticks_ {0};
+};
+
+inline std::ostream& operator<< (std::ostream& out, const Timestamp& value)
+{
+    return out << value.seconds();
+}
+
+#endif // TIMESTAMP_H
@@ -0,0 +1,217 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/program_options.hpp>
+
+#include "datagramrecording.h"
+
+namespace po = boost::program_options;
+
+using namespace std;
+using namespace Utils;
+
+/**
+ * Streams ASTERIX data to a UDP address, for testing the live import without a surveillance network.
+ *
+ * Datagram recordings (as written by the live import) are replayed with their original timing, scaled by the speed
+ * factor. Raw ASTERIX files (without framing) are sent one data block per datagram at a fixed rate.
+ */
+
+class Sender
+{
+public:
+    Sender (const string& address, unsigned int port, unsigned int ttl)
+    {
+        socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+
+        if (socket_ < 0)
+            throw runtime_error ("socket creation failed: "+string(strerror(errno)));
+
+        memset(&address_, 0, sizeof(address_));
+        address_.sin_family = AF_INET;
+        address_.sin_port = htons(port);
+
+        if (inet_pton(AF_INET, address.c_str(), &address_.sin_addr) != 1)
+            throw runtime_error ("invalid address '"+address+"'");
+
+        if (IN_MULTICAST(ntohl(address_.sin_addr.s_addr)))
+        {
+            unsigned char multicast_ttl = ttl;
+            setsockopt(socket_, IPPROTO_IP, IP_MULTICAST_TTL, &multicast_ttl, sizeof(multicast_ttl));
+        }
+    }
+
+    virtual ~Sender()
+    {
+        if (socket_ >= 0)
+            close(socket_);
+    }
+
+    void send (const char* data, size_t size)
+    {
+        if (sendto(socket_, data, size, 0, reinterpret_cast<sockaddr*>(&address_), sizeof(address_)) < 0)
+            throw runtime_error ("send failed: "+string(strerror(errno)));
+
+        ++num_datagrams_;
+        num_bytes_ += size;
+    }
+
+    size_t numDatagrams () const { return num_datagrams_; }
+    size_t numBytes () const { return num_bytes_; }
+
+protected:
+    int socket_ {-1};
+    sockaddr_in address_;
+
+    size_t num_datagrams_ {0};
+    size_t num_bytes_ {0};
+};
+
+void replayRecording (const string& filename, Sender& sender, double speed)
+{
+    DatagramRecordingReader reader (filename);
+
+    uint64_t time_us;
+    vector<char> data;
+
+    uint64_t first_time_us {0};
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+
+    while (reader.next(time_us, data))
+    {
+        if (!sender.numDatagrams())
+            first_time_us = time_us;
+
+        if (speed > 0 && time_us > first_time_us)
+            this_thread::sleep_until(start_time + chrono::microseconds(
+                                         static_cast<uint64_t>((time_us - first_time_us) / speed)));
+
+        sender.send(data.data(), data.size());
+    }
+}
+
+void replayASTERIX (const string& filename, Sender& sender, double speed, double rate)
+{
+    ifstream file (filename, ios::binary);
+
+    if (!file)
+        throw runtime_error ("unable to open file '"+filename+"'");
+
+    vector<char> data ((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    double period_us = speed > 0 && rate > 0 ? 1e6 / (rate * speed) : 0;
+    chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+
+    size_t index {0};
+
+    while (index + 3 <= data.size()) // category and 16-bit length of data block
+    {
+        size_t length = (static_cast<unsigned char>(data.at(index+1)) << 8)
+                + static_cast<unsigned char>(data.at(index+2));
+
+        if (length < 3 || index + length > data.size())
+            throw runtime_error ("invalid data block length "+to_string(length)+" at offset "+to_string(index)
+                                 +", file might be framed");
+
+        if (period_us > 0)
+            this_thread::sleep_until(start_time + chrono::microseconds(
+                                         static_cast<uint64_t>(sender.numDatagrams() * period_us)));
+
+        sender.send(data.data()+index, length);
+        index += length;
+    }
+}
+
+int main (int argc, char** argv)
+{
+    string filename;
+    string address {"127.0.0.1"};
+    unsigned int port {8600};
+    unsigned int ttl {1};
+    double speed {1.0};
+    double rate {1000.0};
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+            ("help", "produce help message")
+            ("file", po::value<string>(&filename), "datagram recording or raw ASTERIX file to replay")
+            ("address", po::value<string>(&address), "destination unicast or multicast address, default 127.0.0.1")
+            ("port", po::value<unsigned int>(&port), "destination port, default 8600")
+            ("ttl", po::value<unsigned int>(&ttl), "multicast time to live, default 1")
+            ("speed", po::value<double>(&speed), "replay speed factor, 0 sends as fast as possible, default 1")
+            ("rate", po::value<double>(&rate), "data blocks per second for raw ASTERIX files, default 1000")
+            ;
+
+    try
+    {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+
+        if (vm.count("help") || !filename.size())
+        {
+            cout << desc << endl;
+            return vm.count("help") ? 0 : 1;
+        }
+
+        if (!port || port > 65535 || speed < 0 || rate <= 0)
+        {
+            cerr << "atsdb_asterix_replay: invalid port, speed or rate" << endl;
+            return 1;
+        }
+
+        Sender sender (address, port, ttl);
+
+        bool recording = DatagramRecording::isRecording(filename);
+
+        cout << "atsdb_asterix_replay: sending " << (recording ? "recording" : "ASTERIX file") << " '" << filename
+             << "' to " << address << ":" << port << " speed " << speed << endl;
+
+        chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
+
+        if (recording)
+            replayRecording(filename, sender, speed);
+        else
+            replayASTERIX(filename, sender, speed, rate);
+
+        double elapsed_s = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+
+        cout << "atsdb_asterix_replay: sent " << sender.numDatagrams() << " datagrams with " << sender.numBytes()
+             << " bytes in " << elapsed_s << " s" << endl;
+    }
+    catch (exception& e)
+    {
+        cerr << "atsdb_asterix_replay: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -34,6 +34,7 @@
 #include "atsdb.h"
 #include "dbinterface.h"
 #include "buffer.h"
+#include "asterixnetworkdecodejob.h"
 
 #include <jasterix/jasterix.h>
 #include <jasterix/category.h>
@@ -57,6 +58,9 @@ const unsigned int limited_chunk_size = 5000;
 const unsigned int unlimited_num_json_jobs_ = 2;
 const unsigned int limited_num_json_jobs_ = 1;
 
+const size_t file_insert_batch_size = 10000;
+const size_t live_max_decode_batch_size = 1024*1024; // bytes of received datagrams decoded at once
+
 ASTERIXImporterTask::ASTERIXImporterTask(const std::string& class_id, const std::string& instance_id,
                                          TaskManager* task_manager)
     : Configurable (class_id, instance_id, task_manager)
@@ -65,6 +69,16 @@ ASTERIXImporterTask::ASTERIXImporterTask(const std::string& class_id, const std:
 
     registerParameter("debug_jasterix", &debug_jasterix_, false);
     registerParameter("limit_ram", &limit_ram_, false);
+    registerParameter("num_parallel_files", &num_parallel_files_, 4);
+    registerParameter("num_range_decoders", &num_range_decoders_, 0);
+    registerParameter("decode_range_size_kb", &decode_range_size_kb_, 2048);
+    registerParameter("live_address", &live_address_, "0.0.0.0");
+    registerParameter("live_port", &live_port_, 8600);
+    registerParameter("live_interface", &live_interface_, "");
+    registerParameter("live_commit_interval_ms", &live_commit_interval_ms_, 1000);
+    registerParameter("live_commit_records", &live_commit_records_, 1000);
+    registerParameter("live_refresh_interval_ms", &live_refresh_interval_ms_, 10000);
+    registerParameter("live_recording_filename", &live_recording_filename_, "");
     registerParameter("current_filename", &current_filename_, "");
     registerParameter("current_framing", &current_framing_, "");
 
@@ -94,6 +108,8 @@ ASTERIXImporterTask::ASTERIXImporterTask(const std::string& class_id, const std:
         loginf << "ASTERIXImporterTask: contructor: resetting to no framing";
         current_framing_ = "";
     }
+
+    connect (&live_commit_timer_, &QTimer::timeout, this, &ASTERIXImporterTask::liveCommitSlot);
 }
 
 
@@ -430,6 +446,27 @@ void ASTERIXImporterTask::limitRAM(bool limit_ram)
     }
 }
 
+unsigned int ASTERIXImporterTask::numParallelFiles() const
+{
+    return num_parallel_files_;
+}
+
+void ASTERIXImporterTask::numParallelFiles(unsigned int value)
+{
+    assert (value);
+    num_parallel_files_ = value;
+}
+
+unsigned int ASTERIXImporterTask::numRangeDecoders() const
+{
+    return num_range_decoders_;
+}
+
+void ASTERIXImporterTask::numRangeDecoders(unsigned int value)
+{
+    num_range_decoders_ = value;
+}
+
 bool ASTERIXImporterTask::canImportFile (const std::string& filename)
 {
     if (!Files::fileExists(filename))
@@ -443,11 +480,21 @@ bool ASTERIXImporterTask::canImportFile (const std::string& filename)
 
 void ASTERIXImporterTask::importFile(const std::string& filename)
 {
-    loginf << "ASTERIXImporterTask: importFile: filename " << filename << " test " << test_;
+    importFiles({filename});
+}
+
+void ASTERIXImporterTask::importFiles(const std::vector<std::string>& filenames)
+{
+    loginf << "ASTERIXImporterTask: importFiles: " << filenames.size() << " files test " << test_;
 
-    assert (canImportFile(filename));
+    assert (filenames.size());
+    assert (!live_job_);
 
-    filename_ = filename;
+    for (auto& filename : filenames)
+        assert (canImportFile(filename));
+
+    filenames_ = filenames;
+    queued_files_.assign(filenames.begin(), filenames.end());
 
     assert (!status_widget_);
 
@@ -455,14 +502,66 @@ void ASTERIXImporterTask::importFile(const std::string& filename)
 
     status_widget_ = nullptr;
 
-    status_widget_.reset(new ASTERIXStatusDialog (filename_, test_, create_mapping_stubs_));
+    status_widget_.reset(new ASTERIXStatusDialog (filenames_, test_, create_mapping_stubs_));
+    connect(status_widget_.get(), &ASTERIXStatusDialog::closeSignal, this, &ASTERIXImporterTask::closeStatusDialogSlot);
+    status_widget_->markStartTime();
+
+    key_count_ = 0;
+    insert_queue_.clear();
+    insert_queue_.batchSize(file_insert_batch_size);
+
+    all_done_ = false;
+    error_ = false;
+    error_message_.clear();
+
+    added_data_sources_.clear();
+
+    assert (schema_);
+
+    for (auto& map_it : *schema_)
+        if (!map_it.second.initialized())
+            map_it.second.initialize();
+
+    if (!test_ && !create_mapping_stubs_)
+        ATSDB::instance().interface().beginImport();
+
+    assert (decode_jobs_.empty());
+    startDecodeJobs();
+
+    return;
+}
+
+void ASTERIXImporterTask::startLiveImport ()
+{
+    loginf << "ASTERIXImporterTask: startLiveImport: address " << live_address_ << " port " << live_port_
+           << " interface '" << live_interface_ << "' commit interval " << live_commit_interval_ms_
+           << " ms records " << live_commit_records_;
+
+    assert (!live_job_);
+    assert (decode_jobs_.empty());
+    assert (!status_widget_);
+
+    test_ = false;
+    create_mapping_stubs_ = false;
+
+    live_job_ = make_shared<ASTERIXNetworkDecodeJob> (createjASTERIX(), live_address_, live_port_, live_interface_,
+                                                      live_commit_interval_ms_, live_max_decode_batch_size,
+                                                      live_recording_filename_);
+
+    filenames_ = {live_job_->filename()};
+    queued_files_.clear();
+
+    status_widget_.reset(new ASTERIXStatusDialog (filenames_, test_, create_mapping_stubs_));
     connect(status_widget_.get(), &ASTERIXStatusDialog::closeSignal, this, &ASTERIXImporterTask::closeStatusDialogSlot);
     status_widget_->markStartTime();
 
     key_count_ = 0;
-    insert_active_ = 0;
+    insert_queue_.clear();
+    insert_queue_.batchSize(live_commit_records_);
 
     all_done_ = false;
+    error_ = false;
+    error_message_.clear();
 
     added_data_sources_.clear();
 
@@ -472,128 +571,258 @@ void ASTERIXImporterTask::importFile(const std::string& filename)
         if (!map_it.second.initialized())
             map_it.second.initialize();
 
-    loginf << "ASTERIXImporterTask: importFile: setting categories";
+    addDecodeJob(live_job_);
+    status_widget_->setFileState(live_job_->filename(), "Receiving");
+
+    if (!ATSDB::instance().headless())
+        status_widget_->show();
+
+    live_last_refresh_time_ = boost::posix_time::microsec_clock::local_time();
+    live_commit_timer_.start(live_commit_interval_ms_);
+}
+
+void ASTERIXImporterTask::stopLiveImport ()
+{
+    loginf << "ASTERIXImporterTask: stopLiveImport";
+
+    assert (live_job_);
+
+    live_commit_timer_.stop();
+    live_job_->stop();
+
+    if (status_widget_)
+        status_widget_->setFileState(live_job_->filename(), "Stopping");
+}
+
+std::shared_ptr<jASTERIX::jASTERIX> ASTERIXImporterTask::createjASTERIX ()
+{
+    std::string jasterix_definition_path = HOME_DATA_DIRECTORY+"/jasterix_definitions";
+    assert (Files::directoryExists(jasterix_definition_path));
+
+    std::shared_ptr<jASTERIX::jASTERIX> jasterix =
+            std::make_shared<jASTERIX::jASTERIX> (jasterix_definition_path, false, debug_jasterix_, true);
+
+    loginf << "ASTERIXImporterTask: createjASTERIX: setting categories";
 
     jASTERIX::add_artas_md5_hash = true;
 
     // set category configs
-    jasterix_->decodeNoCategories();
+    jasterix->decodeNoCategories();
 
     for (auto& cat_it : category_configs_)
     {
-        //loginf << "ASTERIXImporterTask: importFile: setting category " << cat_it.first;
+        //loginf << "ASTERIXImporterTask: createjASTERIX: setting category " << cat_it.first;
 
-        loginf << "ASTERIXImporterTask: importFile: setting cat " << cat_it.first
+        loginf << "ASTERIXImporterTask: createjASTERIX: setting cat " << cat_it.first
                << " decode " <<  cat_it.second.decode()
                << " edition '" << cat_it.second.edition()
                << "' ref '" << cat_it.second.ref() << "'";
 
-        if (!jasterix_->hasCategory(cat_it.first))
+        if (!jasterix->hasCategory(cat_it.first))
         {
-            logwrn << "ASTERIXImporterTask: importFile: cat '" << cat_it.first << "' not defined in decoder";
+            logwrn << "ASTERIXImporterTask: createjASTERIX: cat '" << cat_it.first << "' not defined in decoder";
             continue;
         }
 
-        if (!jasterix_->category(cat_it.first)->hasEdition(cat_it.second.edition()))
+        if (!jasterix->category(cat_it.first)->hasEdition(cat_it.second.edition()))
         {
-            logwrn << "ASTERIXImporterTask: importFile: cat " << cat_it.first << " edition '"
+            logwrn << "ASTERIXImporterTask: createjASTERIX: cat " << cat_it.first << " edition '"
                    << cat_it.second.edition() << "' not defined in decoder";
             continue;
         }
 
         if (cat_it.second.ref().size() && // only if value set
-                !jasterix_->category(cat_it.first)->hasREFEdition(cat_it.second.ref()))
+                !jasterix->category(cat_it.first)->hasREFEdition(cat_it.second.ref()))
         {
-            logwrn << "ASTERIXImporterTask: importFile: cat " << cat_it.first << " ref '"
+            logwrn << "ASTERIXImporterTask: createjASTERIX: cat " << cat_it.first << " ref '"
                    << cat_it.second.ref() << "' not defined in decoder";
             continue;
         }
 
         if (cat_it.second.spf().size() && // only if value set
-                !jasterix_->category(cat_it.first)->hasSPFEdition(cat_it.second.spf()))
+                !jasterix->category(cat_it.first)->hasSPFEdition(cat_it.second.spf()))
         {
-            logwrn << "ASTERIXImporterTask: importFile: cat " << cat_it.first << " spf '"
+            logwrn << "ASTERIXImporterTask: createjASTERIX: cat " << cat_it.first << " spf '"
                    << cat_it.second.spf() << "' not defined in decoder";
             continue;
         }
 
-//        loginf << "ASTERIXImporterTask: importFile: setting cat " <<  cat_it.first
+//        loginf << "ASTERIXImporterTask: createjASTERIX: setting cat " <<  cat_it.first
 //               << " decode flag " << cat_it.second.decode();
-        jasterix_->setDecodeCategory(cat_it.first, cat_it.second.decode());
-//        loginf << "ASTERIXImporterTask: importFile: setting cat " <<  cat_it.first
+        jasterix->setDecodeCategory(cat_it.first, cat_it.second.decode());
+//        loginf << "ASTERIXImporterTask: createjASTERIX: setting cat " <<  cat_it.first
 //               << " edition " << cat_it.second.edition();
-        jasterix_->category(cat_it.first)->setCurrentEdition(cat_it.second.edition());
-        jasterix_->category(cat_it.first)->setCurrentREFEdition(cat_it.second.ref());
-        jasterix_->category(cat_it.first)->setCurrentSPFEdition(cat_it.second.spf());
+        jasterix->category(cat_it.first)->setCurrentEdition(cat_it.second.edition());
+        jasterix->category(cat_it.first)->setCurrentREFEdition(cat_it.second.ref());
+        jasterix->category(cat_it.first)->setCurrentSPFEdition(cat_it.second.spf());
 
         // TODO mapping?
     }
 
-    loginf << "ASTERIXImporterTask: importFile: filename " << filename;
+    return jasterix;
+}
+
+void ASTERIXImporterTask::startDecodeJobs ()
+{
+    // mapping stubs jobs can only run one at a time
+    unsigned int num_parallel = create_mapping_stubs_ ? 1 : std::max(num_parallel_files_, 1u);
+
+    while (decode_jobs_.size() < num_parallel && queued_files_.size())
+    {
+        std::string filename = queued_files_.front();
+        queued_files_.pop_front();
 
-    assert (decode_job_ == nullptr);
-    decode_job_ = make_shared<ASTERIXDecodeJob> (*this, filename, current_framing_, test_);
+        loginf << "ASTERIXImporterTask: startDecodeJobs: filename " << filename;
 
-    connect (decode_job_.get(), &ASTERIXDecodeJob::obsoleteSignal, this,
+        std::shared_ptr<ASTERIXDecodeJob> decode_job =
+                make_shared<ASTERIXDecodeJob> (createjASTERIX(), filename, current_framing_, test_);
+
+        // framed files are decoded as a whole by jASTERIX, unframed ones can be split at data block boundaries
+        if (!current_framing_.size())
+        {
+            unsigned int num_decoders = num_range_decoders_ ? num_range_decoders_
+                                                            : std::max(QThread::idealThreadCount(), 1) / num_parallel;
+
+            if (num_decoders > 1)
+            {
+                std::vector<std::shared_ptr<jASTERIX::jASTERIX>> decoders;
+
+                for (unsigned int cnt=0; cnt < num_decoders; ++cnt)
+                    decoders.push_back(createjASTERIX());
+
+                decode_job->rangeDecoders(decoders, std::max(decode_range_size_kb_, 1u) * 1024);
+            }
+        }
+
+        addDecodeJob(decode_job);
+
+        if (status_widget_)
+            status_widget_->setFileState(filename, "Decoding");
+    }
+}
+
+void ASTERIXImporterTask::addDecodeJob (std::shared_ptr<ASTERIXDecodeJob> decode_job)
+{
+    connect (decode_job.get(), &ASTERIXDecodeJob::obsoleteSignal, this,
              &ASTERIXImporterTask::decodeASTERIXObsoleteSlot, Qt::QueuedConnection);
-    connect (decode_job_.get(), &ASTERIXDecodeJob::doneSignal, this, &ASTERIXImporterTask::decodeASTERIXDoneSlot,
-             Qt::QueuedConnection);
-    connect (decode_job_.get(), &ASTERIXDecodeJob::decodedASTERIXSignal,
+    connect (decode_job.get(), &ASTERIXDecodeJob::doneSignal, this,
+             &ASTERIXImporterTask::decodeASTERIXDoneSlot, Qt::QueuedConnection);
+    connect (decode_job.get(), &ASTERIXDecodeJob::decodedASTERIXSignal,
              this, &ASTERIXImporterTask::addDecodedASTERIXSlot, Qt::QueuedConnection);
 
-    JobManager::instance().addBlockingJob(decode_job_);
+    decode_jobs_.push_back(decode_job);
 
-    return;
+    JobManager::instance().addLongRunningJob(decode_job); // waits while the insert queue is full
+}
+
+std::shared_ptr<ASTERIXDecodeJob> ASTERIXImporterTask::decodeJob (ASTERIXDecodeJob* job)
+{
+    auto job_it = std::find_if(decode_jobs_.begin(), decode_jobs_.end(),
+                               [job] (const std::shared_ptr<ASTERIXDecodeJob>& it) { return it.get() == job; });
+
+    return job_it == decode_jobs_.end() ? nullptr : *job_it;
+}
+
+void ASTERIXImporterTask::updateDecodeLoad ()
+{
+    bool max_load_reached = maxLoadReached();
+
+    for (auto& job_it : decode_jobs_)
+    {
+        if (max_load_reached)
+            job_it->pause();
+        else
+            job_it->unpause();
+    }
 }
 
 void ASTERIXImporterTask::decodeASTERIXDoneSlot ()
 {
     logdbg << "ASTERIXImporterTask: decodeASTERIXDoneSlot";
 
-    assert (decode_job_);
+    std::shared_ptr<ASTERIXDecodeJob> decode_job = decodeJob(static_cast<ASTERIXDecodeJob*>(sender()));
+    assert (decode_job);
 
-    if (decode_job_->error())
+    if (decode_job->error())
     {
-        error_ = decode_job_->error();
-        error_message_ = decode_job_->errorMessage();
+        error_ = decode_job->error();
+        error_message_ = decode_job->errorMessage();
+
+        logerr << "ASTERIXImporterTask: decodeASTERIXDoneSlot: decoding error in '" << decode_job->filename()
+               << "': '" << error_message_ << "'";
+
+        if (status_widget_)
+            status_widget_->setFileState(decode_job->filename(), "Error");
+
+        if (!ATSDB::instance().headless())
+        {
+            QMessageBox msgBox;
+            msgBox.setText(("Decoding error in '"+decode_job->filename()+"': "+error_message_
+                            +"\n\nPlease quit the application.").c_str());
+            msgBox.setIcon(QMessageBox::Warning);
+            msgBox.exec();
+        }
+    }
+    else if (status_widget_)
+        status_widget_->setFileState(decode_job->filename(), "Done");
 
-        QMessageBox msgBox;
-        msgBox.setText(("Decoding error: "+error_message_+"\n\nPlease quit the application.").c_str());
-        msgBox.setIcon(QMessageBox::Warning);
-        msgBox.exec();
+    decode_jobs_.remove(decode_job);
+
+    if (decode_job == live_job_)
+    {
+        live_commit_timer_.stop();
+        live_job_ = nullptr;
     }
 
-    decode_job_ = nullptr;
+    startDecodeJobs();
+
+    if (!test_ && !create_mapping_stubs_) // insert remaining buffers if mapping was done before decoding
+        insertData();
 
     checkAllDone();
 }
+
 void ASTERIXImporterTask::decodeASTERIXObsoleteSlot ()
 {
     logdbg << "ASTERIXImporterTask: decodeASTERIXObsoleteSlot";
-    decode_job_ = nullptr;
+
+    std::shared_ptr<ASTERIXDecodeJob> decode_job = decodeJob(static_cast<ASTERIXDecodeJob*>(sender()));
+
+    if (decode_job)
+        decode_jobs_.remove(decode_job);
+
+    if (decode_job && decode_job == live_job_)
+    {
+        live_commit_timer_.stop();
+        live_job_ = nullptr;
+    }
 }
 
 void ASTERIXImporterTask::addDecodedASTERIXSlot ()
 {
     logdbg << "ASTERIXImporterTask: addDecodedASTERIX";
 
-    assert (decode_job_);
+    std::shared_ptr<ASTERIXDecodeJob> decode_job = decodeJob(static_cast<ASTERIXDecodeJob*>(sender()));
+
+    if (!decode_job || decode_job->obsolete()) // cancelled, records are dropped
+        return;
+
     assert (status_widget_);
 
-    logdbg << "ASTERIXImporterTask: addDecodedASTERIX: errors " << decode_job_->numErrors();
+    logdbg << "ASTERIXImporterTask: addDecodedASTERIX: " << decode_job->filename()
+           << " errors " << decode_job->numErrors();
 
-    status_widget_->numFrames(jasterix_->numFrames());
-    status_widget_->numRecords(jasterix_->numRecords());
-    status_widget_->numErrors(jasterix_->numErrors());
-    status_widget_->setCategoryCounts(decode_job_->categoryCounts());
+    status_widget_->setFileCounts(decode_job->filename(), decode_job->numFrames(), decode_job->numRecords(),
+                                  decode_job->numErrors(), decode_job->categoryCounts());
 
-    status_widget_->show();
+    if (!ATSDB::instance().headless())
+        status_widget_->show();
 
-//    decode_job_->clearExtractedRecords();
+//    decode_job->clearExtractedRecords();
 
 //    return;
 
-    std::unique_ptr<std::vector<nlohmann::json>> extracted_records {std::move (decode_job_->extractedRecords())};
+    std::unique_ptr<std::vector<nlohmann::json>> extracted_records {std::move (decode_job->extractedRecords())};
 
     if (!create_mapping_stubs_) // test or import
     {
@@ -617,20 +846,13 @@ void ASTERIXImporterTask::addDecodedASTERIXSlot ()
 
         key_count_ += count;
 
-        if (decode_job_)
-        {
-            if (maxLoadReached())
-                decode_job_->pause();
-            else
-                decode_job_->unpause();
-        }
+        updateDecodeLoad();
     }
     else // create mappings
     {
         while (json_map_stub_job_) // only one can exist at a time
         {
-            if (decode_job_)
-                decode_job_->pause();
+            decode_job->pause();
 
             QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
             QThread::msleep(1);
@@ -649,8 +871,7 @@ void ASTERIXImporterTask::addDecodedASTERIXSlot ()
 
         JobManager::instance().addNonBlockingJob(json_map_stub_job_);
 
-        if (decode_job_)
-            decode_job_->unpause();
+        decode_job->unpause();
     }
 }
 
@@ -678,13 +899,7 @@ void ASTERIXImporterTask::mapJSONDoneSlot ()
 
     std::map <std::string, std::shared_ptr<Buffer>> job_buffers = std::move(map_job->buffers());
 
-    if (decode_job_)
-    {
-        if (maxLoadReached())
-            decode_job_->pause();
-        else
-            decode_job_->unpause();
-    }
+    updateDecodeLoad();
 
     if (test_) // ???
     {
@@ -692,37 +907,11 @@ void ASTERIXImporterTask::mapJSONDoneSlot ()
         return;
     }
 
-    for (auto& buf_it : job_buffers)
-    {
-        if (buf_it.second && buf_it.second->size())
-        {
-            std::shared_ptr<Buffer> job_buffer = buf_it.second;
+    ATSDB::instance().objectManager().addNewDataSources(map_job->dataSources(), added_data_sources_);
 
-            if (buffers_.count(buf_it.first) == 0)
-                buffers_[buf_it.first] = job_buffer;
-            else
-                buffers_.at(buf_it.first)->seizeBuffer(*job_buffer.get());
-        }
-    }
+    insert_queue_.add(job_buffers);
 
-    if (!insert_active_)
-    {
-        for (auto& buf_it : buffers_)
-        {
-            if (buf_it.second->size() > 10000)
-            {
-                logdbg << "ASTERIXImporterTask: mapJSONDoneSlot: inserting part of parsed objects";
-                insertData ();
-                return;
-            }
-        }
-    }
-
-    if (decode_job_ == nullptr && json_map_jobs_.unsafe_size() == 0)
-    {
-        logdbg << "ASTERIXImporterTask: mapJSONDoneSlot: inserting parsed objects at end";
-        insertData ();
-    }
+    insertData();
 }
 
 void ASTERIXImporterTask::mapJSONObsoleteSlot ()
@@ -752,36 +941,41 @@ void ASTERIXImporterTask::mapStubsObsoleteSlot ()
 
 void ASTERIXImporterTask::insertData ()
 {
-    loginf << "ASTERIXImporterTask: insertData: inserting into database";
+    logdbg << "ASTERIXImporterTask: insertData";
 
     assert (status_widget_);
 
-    while (insert_active_)
+    bool input_done = decodeDone() && json_map_jobs_.empty();
+
+    insert_queue_.commit(input_done);
+
+    if (insert_queue_.canPop())
     {
-        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        QThread::msleep (1);
+        DBOInsertQueue::Batch batch = insert_queue_.pop();
+        insertBatch(batch);
+
+        insert_queue_.commit(input_done); // filling batch might have waited for free slot
     }
 
-    bool has_sac_sic = false;
-    //bool emit_change = (decode_job_ == nullptr && json_map_jobs_.unsafe_size() == 0);
+    updateInsertQueueStatus();
+}
+
+void ASTERIXImporterTask::insertBatch (DBOInsertQueue::Batch& batch)
+{
+    loginf << "ASTERIXImporterTask: insertBatch: inserting into database, queue depth " << insert_queue_.depth();
+
+    //bool emit_change = (decodeDone() && json_map_jobs_.unsafe_size() == 0);
 
     assert (schema_);
 
     for (auto& parser_it : *schema_)
     {
-        if (buffers_.count(parser_it.second.dbObject().name()) != 0)
+        if (batch.count(parser_it.second.dbObject().name()) != 0)
         {
-            ++insert_active_;
-
             DBObject& db_object = parser_it.second.dbObject();
-            std::shared_ptr<Buffer> buffer = buffers_.at(parser_it.second.dbObject().name());
+            std::shared_ptr<Buffer> buffer = batch.at(parser_it.second.dbObject().name());
 
-            has_sac_sic = db_object.hasVariable("sac") && db_object.hasVariable("sic")
-                    && buffer->has<unsigned char>("sac") && buffer->has<unsigned char>("sic");
-
-            logdbg << "ASTERIXImporterTask: insertData: " << db_object.name() << " has sac/sic " << has_sac_sic;
-
-            logdbg << "ASTERIXImporterTask: insertData: " << db_object.name() << " buffer " << buffer->size();
+            logdbg << "ASTERIXImporterTask: insertBatch: " << db_object.name() << " buffer " << buffer->size();
 
             connect (&db_object, &DBObject::insertDoneSignal, this, &ASTERIXImporterTask::insertDoneSlot,
                      Qt::UniqueConnection);
@@ -789,100 +983,16 @@ void ASTERIXImporterTask::insertData ()
                      Qt::UniqueConnection);
 
 
-            if (parser_it.second.dataSourceVariableName() != "")
-            {
-                logdbg << "ASTERIXImporterTask: insertData: adding new data sources";
-
-                std::string data_source_var_name = parser_it.second.dataSourceVariableName();
-
-
-                // collect existing datasources
-                std::set <int> datasources_existing;
-                if (db_object.hasDataSources())
-                    for (auto ds_it = db_object.dsBegin(); ds_it != db_object.dsEnd(); ++ds_it)
-                        datasources_existing.insert(ds_it->first);
-
-                // getting key list and distinct values
-                assert (buffer->properties().hasProperty(data_source_var_name));
-                assert (buffer->properties().get(data_source_var_name).dataType() == PropertyDataType::INT);
-
-                assert(buffer->has<int>(data_source_var_name));
-                NullableVector<int>& data_source_key_list = buffer->get<int> (data_source_var_name);
-                std::set<int> data_source_keys = data_source_key_list.distinctValues();
-
-                std::map <int, std::pair<unsigned char, unsigned char>> sac_sics; // keyvar->(sac,sic)
-                // collect sac/sics
-                if (has_sac_sic)
-                {
-                    NullableVector<unsigned char>& sac_list = buffer->get<unsigned char> ("sac");
-                    NullableVector<unsigned char>& sic_list = buffer->get<unsigned char> ("sic");
-
-                    size_t size = buffer->size();
-                    int key_val;
-                    for (unsigned int cnt=0; cnt < size; ++cnt)
-                    {
-                        key_val = data_source_key_list.get(cnt);
-
-                        if (datasources_existing.count(key_val) != 0)
-                            continue;
-
-                        if (sac_sics.count(key_val) == 0)
-                        {
-                            logdbg << "ASTERIXImporterTask: insertData: found new ds " << key_val << " for sac/sic";
-
-                            assert (!sac_list.isNull(cnt) && !sic_list.isNull(cnt));
-                            sac_sics[key_val] = std::pair<unsigned char, unsigned char> (sac_list.get(cnt), sic_list.get(cnt));
-
-                            loginf << "ASTERIXImporterTask: insertData: source " << key_val
-                                   << " sac " << static_cast<int>(sac_list.get(cnt))
-                                   << " sic " << static_cast<int>(sic_list.get(cnt));
-                        }
-                    }
-
-                }
-
-                // adding datasources
-                std::map <int, std::pair<int,int>> datasources_to_add;
-
-                for (auto ds_key_it : data_source_keys)
-                    if (datasources_existing.count(ds_key_it) == 0 && added_data_sources_.count(ds_key_it) == 0)
-                    {
-                        if (datasources_to_add.count(ds_key_it) == 0)
-                        {
-                            logdbg << "ASTERIXImporterTask: insertData: adding new data source " << ds_key_it;
-                            if (sac_sics.count(ds_key_it) == 0)
-                                datasources_to_add[ds_key_it] = {-1,-1};
-                            else
-                                datasources_to_add[ds_key_it] = {sac_sics.at(ds_key_it).first,
-                                                                 sac_sics.at(ds_key_it).second};
-
-                            added_data_sources_.insert(ds_key_it);
-                        }
-                    }
-
-                if (datasources_to_add.size())
-                {
-                    db_object.addDataSources(datasources_to_add);
-                }
-            }
-
-            logdbg << "ASTERIXImporterTask: insertData: " << db_object.name() << " inserting";
+            logdbg << "ASTERIXImporterTask: insertBatch: " << db_object.name() << " inserting";
 
             DBOVariableSet set = parser_it.second.variableList();
             db_object.insertData(set, buffer, false);
-
-            status_widget_->addNumInserted(db_object.name(), buffer->size());
-
-            logdbg << "ASTERIXImporterTask: insertData: " << db_object.name() << " clearing";
-            buffers_.erase(parser_it.second.dbObject().name());
         }
         else
-            logdbg << "ASTERIXImporterTask: insertData: emtpy buffer for " << parser_it.second.dbObject().name();
+            logdbg << "ASTERIXImporterTask: insertBatch: emtpy buffer for " << parser_it.second.dbObject().name();
     }
 
-    assert (buffers_.size() == 0);
-
-    logdbg << "JSONImporterTask: insertData: done";
+    logdbg << "ASTERIXImporterTask: insertBatch: done";
 }
 
 void ASTERIXImporterTask::insertProgressSlot (float percent)
@@ -893,15 +1003,21 @@ void ASTERIXImporterTask::insertProgressSlot (float percent)
 void ASTERIXImporterTask::insertDoneSlot (DBObject& object)
 {
     logdbg << "ASTERIXImporterTask: insertDoneSlot";
-    --insert_active_;
 
-//    if (decode_job_)
-//    {
-//        if (maxLoadReached())
-//            decode_job_->pause();
-//        else
-//            decode_job_->unpause();
-//    }
+    size_t rows = insert_queue_.written(object.name());
+
+    if (status_widget_)
+        status_widget_->addNumInserted(object.name(), rows);
+
+    if (!insert_queue_.writing()) // start next batch
+    {
+        insertData();
+
+        if (live_job_)
+            refreshLiveContent();
+    }
+
+    updateDecodeLoad();
 
     checkAllDone ();
 
@@ -912,35 +1028,75 @@ void ASTERIXImporterTask::checkAllDone ()
 {
     logdbg << "ASTERIXImporterTask: checkAllDone";
 
-    loginf << "ASTERIXImporterTask: checkAllDone: all done " << all_done_ << " decode " << (decode_job_ == nullptr)
+    loginf << "ASTERIXImporterTask: checkAllDone: all done " << all_done_ << " decode " << decodeDone()
            << " map jobs " << json_map_jobs_.empty() << " map stubs " << (json_map_stub_job_ == nullptr)
-           << " buffers " << (buffers_.size() == 0) << " insert active " << (insert_active_ == 0);
+           << " insert queue " << insert_queue_.empty();
 
-    if (!all_done_ && decode_job_ == nullptr && json_map_jobs_.empty() && json_map_stub_job_ == nullptr
-            && buffers_.size() == 0 && insert_active_ == 0)
+    if (!all_done_ && decodeDone() && json_map_jobs_.empty() && json_map_stub_job_ == nullptr
+            && insert_queue_.empty())
     {
         loginf << "ASTERIXImporterTask: checkAllDone: all done";
 
         assert (status_widget_);
         status_widget_->setDone();
 
+        if (ATSDB::instance().headless()) // can not be closed by user
+            status_widget_ = nullptr;
+
         all_done_ = true;
 
+        if (!test_ && !create_mapping_stubs_)
+            ATSDB::instance().interface().endImport(); // rebuilds deferred indexes before content is read
+
         QApplication::restoreOverrideCursor();
 
-        buffers_.clear();
+        insert_queue_.clear();
         refreshjASTERIX();
 
-        assert (widget_);
-        widget_->importDone();
+        if (widget_)
+            widget_->importDone();
 
         if (!create_mapping_stubs_)
             emit ATSDB::instance().interface().databaseContentChangedSignal();
+
+        emit importDoneSignal();
     }
 
     logdbg << "ASTERIXImporterTask: checkAllDone: done";
 }
 
+void ASTERIXImporterTask::updateInsertQueueStatus ()
+{
+    if (status_widget_ && !test_ && !create_mapping_stubs_)
+        status_widget_->setInsertQueue(insert_queue_.depth(), insert_queue_.maxDepth(), insert_queue_.writeRate());
+}
+
+void ASTERIXImporterTask::refreshLiveContent ()
+{
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::local_time();
+
+    if ((now - live_last_refresh_time_).total_milliseconds() < live_refresh_interval_ms_)
+        return;
+
+    loginf << "ASTERIXImporterTask: refreshLiveContent: " << insert_queue_.rowsWritten() << " rows written";
+
+    live_last_refresh_time_ = now;
+
+    emit ATSDB::instance().interface().databaseContentChangedSignal();
+}
+
+void ASTERIXImporterTask::liveCommitSlot ()
+{
+    logdbg << "ASTERIXImporterTask: liveCommitSlot";
+
+    if (!live_job_ || !status_widget_)
+        return;
+
+    insert_queue_.commit(true); // bounds latency from reception to insert if fewer records are received
+
+    insertData();
+}
+
 void ASTERIXImporterTask::closeStatusDialogSlot()
 {
     assert (status_widget_);
@@ -950,8 +1106,14 @@ void ASTERIXImporterTask::closeStatusDialogSlot()
 
 bool ASTERIXImporterTask::maxLoadReached ()
 {
+    if (insert_queue_.full()) // writer is behind, mapping more would only grow the filling batch
+        return true;
+
+    // allow mapping jobs for each file being decoded
+    size_t num_files = std::max<size_t>(decode_jobs_.size(), 1);
+
     if (limit_ram_)
-        return json_map_jobs_.unsafe_size() > limited_num_json_jobs_;
+        return json_map_jobs_.unsafe_size() > limited_num_json_jobs_*num_files;
     else
-        return json_map_jobs_.unsafe_size() > unlimited_num_json_jobs_;
+        return json_map_jobs_.unsafe_size() > unlimited_num_json_jobs_*num_files;
 }
@@ -24,18 +24,25 @@
 #include "asterixdecodejob.h"
 #include "jsonmappingjob.h"
 #include "jsonmappingstubsjob.h"
+#include "dboinsertqueue.h"
 
 #include <QObject>
+#include <QTimer>
 
+#include <deque>
+#include <list>
 #include <memory>
 
 #include <tbb/concurrent_queue.h>
 
+#include "boost/date_time/posix_time/posix_time.hpp"
+
 class TaskManager;
 class ASTERIXImporterTaskWidget;
 class ASTERIXCategoryConfig;
 class ASTERIXStatusDialog;
 class SavedFile;
+class ASTERIXNetworkDecodeJob;
 //class QMessageBox;
 
 namespace jASTERIX
@@ -47,6 +54,9 @@ class ASTERIXImporterTask: public QObject, public Configurable
 {
     Q_OBJECT
 
+signals:
+    void importDoneSignal ();
+
 public slots:
     void decodeASTERIXDoneSlot ();
     void decodeASTERIXObsoleteSlot ();
@@ -63,6 +73,8 @@ public slots:
 
     void closeStatusDialogSlot();
 
+    void liveCommitSlot ();
+
 public:
     ASTERIXImporterTask(const std::string& class_id, const std::string& instance_id,
                         TaskManager* task_manager);
@@ -75,6 +87,18 @@ public:
 
     bool canImportFile (const std::string& filename);
     void importFile (const std::string& filename);
+    /// @brief Imports files, numParallelFiles of which are decoded concurrently, all mapped data is written in order
+    void importFiles (const std::vector<std::string>& filenames);
+
+    /// @brief Starts continuous import of ASTERIX datagrams received on the configured live address and port
+    void startLiveImport ();
+    /// @brief Stops receiving, remaining data is decoded and inserted before importDoneSignal is emitted
+    void stopLiveImport ();
+    bool liveImportActive () const { return live_job_ != nullptr; }
+
+    /// @brief Returns if decoding of a file of the last import failed, valid after importDoneSignal
+    bool error () const { return error_; }
+    const std::string& errorMessage () const { return error_message_; }
 
     const std::map <std::string, SavedFile*> &fileList () { return file_list_; }
     bool hasFile (const std::string &filename) { return file_list_.count (filename) > 0; }
@@ -114,16 +138,44 @@ public:
     bool limitRAM() const;
     void limitRAM(bool value);
 
+    unsigned int numParallelFiles() const;
+    void numParallelFiles(unsigned int value);
+
+    /// @brief Returns number of decoders per unframed file, 0 to share the ideal thread count between files
+    unsigned int numRangeDecoders() const;
+    void numRangeDecoders(unsigned int value);
+
+    const std::string& liveAddress() const { return live_address_; }
+    void liveAddress(const std::string& value) { live_address_ = value; }
+    unsigned int livePort() const { return live_port_; }
+    void livePort(unsigned int value) { live_port_ = value; }
+    const std::string& liveInterface() const { return live_interface_; }
+    void liveInterface(const std::string& value) { live_interface_ = value; }
+    const std::string& liveRecordingFilename() const { return live_recording_filename_; }
+    void liveRecordingFilename(const std::string& value) { live_recording_filename_ = value; }
+
 protected:
     bool debug_jasterix_;
     bool limit_ram_;
+    unsigned int num_parallel_files_ {4};
+    unsigned int num_range_decoders_ {0}; // decoders per unframed file, 0 for automatic, 1 to decode sequentially
+    unsigned int decode_range_size_kb_ {2048};
+
+    std::string live_address_;
+    unsigned int live_port_ {0};
+    std::string live_interface_;
+    unsigned int live_commit_interval_ms_ {1000}; // max time from reception to insert
+    unsigned int live_commit_records_ {1000}; // insert batch size during live import
+    unsigned int live_refresh_interval_ms_ {10000}; // min time between database content updates
+    std::string live_recording_filename_;
     std::shared_ptr<jASTERIX::jASTERIX> jasterix_;
 
     std::map <std::string, SavedFile*> file_list_;
     std::string current_filename_;
     std::string current_framing_;
 
-    std::string filename_;
+    std::vector<std::string> filenames_;
+    std::deque<std::string> queued_files_;
     bool test_ {false};
     bool create_mapping_stubs_ {false};
 
@@ -133,10 +185,14 @@ protected:
 
     std::shared_ptr<JSONParsingSchema> schema_;
 
-    std::shared_ptr<ASTERIXDecodeJob> decode_job_;
+    std::list<std::shared_ptr<ASTERIXDecodeJob>> decode_jobs_;
     tbb::concurrent_queue <std::shared_ptr <JSONMappingJob>> json_map_jobs_;
     std::shared_ptr <JSONMappingStubsJob> json_map_stub_job_;
-    std::map <std::string, std::shared_ptr<Buffer>> buffers_;
+    DBOInsertQueue insert_queue_;
+
+    std::shared_ptr<ASTERIXNetworkDecodeJob> live_job_;
+    QTimer live_commit_timer_;
+    boost::posix_time::ptime live_last_refresh_time_;
 
     bool error_ {false};
     std::string error_message_;
@@ -144,7 +200,6 @@ protected:
     std::unique_ptr<ASTERIXStatusDialog> status_widget_;
 
     size_t key_count_ {0};
-    size_t insert_active_ {0};
 
     std::set <int> added_data_sources_;
 
@@ -152,7 +207,23 @@ protected:
 
     virtual void checkSubConfigurables ();
 
+    /// @brief Returns new jASTERIX instance with the current category configuration
+    std::shared_ptr<jASTERIX::jASTERIX> createjASTERIX ();
+    /// @brief Starts decode jobs for queued files up to the number of parallel files
+    void startDecodeJobs ();
+    void addDecodeJob (std::shared_ptr<ASTERIXDecodeJob> decode_job);
+    std::shared_ptr<ASTERIXDecodeJob> decodeJob (ASTERIXDecodeJob* job);
+    /// @brief Returns if all files have been decoded
+    bool decodeDone () const { return decode_jobs_.empty() && queued_files_.empty(); }
+    /// @brief Pauses or unpauses all decode jobs depending on the mapping and insert load
+    void updateDecodeLoad ();
+
+    /// @brief Commits mapped buffers to the insert queue and starts writing the next batch if the writer is idle
     void insertData ();
+    void insertBatch (DBOInsertQueue::Batch& batch);
+    void updateInsertQueueStatus ();
+    /// @brief Emits database content changed during live import if the refresh interval has passed
+    void refreshLiveContent ();
     void checkAllDone ();
 
     //void updateMsgBox();
@@ -33,6 +33,8 @@
 #include <QInputDialog>
 #include <QStackedWidget>
 #include <QCheckBox>
+#include <QSpinBox>
+#include <QLineEdit>
 
 using namespace Utils;
 
@@ -85,7 +87,7 @@ ASTERIXImporterTaskWidget::ASTERIXImporterTaskWidget(ASTERIXImporterTask& task,
         file_list_->setWordWrap(true);
         file_list_->setTextElideMode (Qt::ElideNone);
         file_list_->setSelectionBehavior( QAbstractItemView::SelectItems );
-        file_list_->setSelectionMode( QAbstractItemView::SingleSelection );
+        file_list_->setSelectionMode( QAbstractItemView::ExtendedSelection ); // import of several files
         connect (file_list_, SIGNAL(itemClicked(QListWidgetItem*)), this, SLOT(selectedFileSlot()));
 
         updateFileListSlot ();
@@ -164,6 +166,17 @@ ASTERIXImporterTaskWidget::ASTERIXImporterTaskWidget(ASTERIXImporterTask& task,
         connect(limit_ram_check_, &QCheckBox::clicked, this, &ASTERIXImporterTaskWidget::limitRAMChangedSlot);
         left_layout->addWidget (limit_ram_check_);
 
+        QFormLayout* parallel_layout = new QFormLayout();
+
+        num_parallel_files_box_ = new QSpinBox ();
+        num_parallel_files_box_->setRange(1, 64);
+        num_parallel_files_box_->setValue(task_.numParallelFiles());
+        connect(num_parallel_files_box_, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+                this, &ASTERIXImporterTaskWidget::numParallelFilesChangedSlot);
+        parallel_layout->addRow("Files Decoded in Parallel", num_parallel_files_box_);
+
+        left_layout->addLayout (parallel_layout);
+
         create_mapping_stubs_button_ = new QPushButton ("Create Mapping Stubs");
         connect(create_mapping_stubs_button_, &QPushButton::clicked,
                 this, &ASTERIXImporterTaskWidget::createMappingsSlot);
@@ -178,6 +191,44 @@ ASTERIXImporterTaskWidget::ASTERIXImporterTaskWidget(ASTERIXImporterTask& task,
         left_layout->addWidget (import_button_);
     }
 
+    // live import stuff
+    {
+        QFrame *live_frame = new QFrame ();
+        live_frame->setFrameStyle(QFrame::Panel | QFrame::Raised);
+        live_frame->setLineWidth(frame_width_small);
+
+        QVBoxLayout* live_layout = new QVBoxLayout();
+
+        QLabel *live_label = new QLabel ("Live Import (UDP)");
+        live_label->setFont(font_bold);
+        live_layout->addWidget(live_label);
+
+        QFormLayout* live_form_layout = new QFormLayout();
+
+        live_address_edit_ = new QLineEdit (task_.liveAddress().c_str());
+        live_address_edit_->setToolTip("Unicast address to bind to or multicast group to join");
+        live_form_layout->addRow("Address", live_address_edit_);
+
+        live_port_box_ = new QSpinBox ();
+        live_port_box_->setRange(1, 65535);
+        live_port_box_->setValue(task_.livePort());
+        live_form_layout->addRow("Port", live_port_box_);
+
+        live_recording_edit_ = new QLineEdit (task_.liveRecordingFilename().c_str());
+        live_recording_edit_->setToolTip("File received datagrams are recorded into, none if empty");
+        live_form_layout->addRow("Recording File", live_recording_edit_);
+
+        live_layout->addLayout(live_form_layout);
+
+        live_import_button_ = new QPushButton ("Start Live Import");
+        connect(live_import_button_, &QPushButton::clicked, this, &ASTERIXImporterTaskWidget::liveImportSlot);
+        live_layout->addWidget (live_import_button_);
+
+        live_frame->setLayout (live_layout);
+
+        left_layout->addWidget (live_frame);
+    }
+
     //main_layout_->addLayout(left_layout);
     main_layout_->addWidget(left_frame);
 
@@ -393,50 +444,52 @@ void ASTERIXImporterTaskWidget::limitRAMChangedSlot ()
     task_.limitRAM(box->checkState() == Qt::Checked);
 }
 
-void ASTERIXImporterTaskWidget::createMappingsSlot()
+void ASTERIXImporterTaskWidget::numParallelFilesChangedSlot (int value)
 {
-    loginf << "ASTERIXImporterTaskWidget: createMappingsSlot";
+    assert (value > 0);
+    task_.numParallelFiles(static_cast<unsigned int>(value));
+}
 
-    if (!file_list_->currentItem())
-    {
-        QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Create Mapping Stubs Failed",
-                               "Please select a file in the list.",
-                               QMessageBox::Ok);
-        m_warning.exec();
-        return;
-    }
+bool ASTERIXImporterTaskWidget::selectedFilenames (const std::string& title, std::vector<std::string>& filenames)
+{
+    filenames.clear();
 
-    QString filename = file_list_->currentItem()->text();
-    if (filename.size() > 0)
+    for (auto item : file_list_->selectedItems())
     {
-        assert (task_.hasFile(filename.toStdString()));
+        std::string filename = item->text().toStdString();
+        assert (task_.hasFile(filename));
 
-        if (!task_.canImportFile(filename.toStdString()))
+        if (!task_.canImportFile(filename))
         {
-            QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Create Mapping Stubs Failed",
-                                   "File does not exist.",
+            QMessageBox m_warning (QMessageBox::Warning, title.c_str(),
+                                   ("File '"+filename+"' does not exist.").c_str(),
                                    QMessageBox::Ok);
             m_warning.exec();
-            return;
+            return false;
         }
 
-        task_.test(false);
-        task_.createMappingStubs(true);
-        task_.importFile(filename.toStdString());
+        filenames.push_back(filename);
+    }
 
-        create_mapping_stubs_button_->setDisabled(true);
-        test_button_->setDisabled(true);
-        import_button_->setDisabled(true);
+    if (!filenames.size())
+    {
+        QMessageBox m_warning (QMessageBox::Warning, title.c_str(),
+                               "Please select a file in the list.",
+                               QMessageBox::Ok);
+        m_warning.exec();
+        return false;
     }
+
+    return true;
 }
 
-void ASTERIXImporterTaskWidget::testImportSlot()
+void ASTERIXImporterTaskWidget::createMappingsSlot()
 {
-    loginf << "ASTERIXImporterTaskWidget: testImportSlot";
+    loginf << "ASTERIXImporterTaskWidget: createMappingsSlot";
 
     if (!file_list_->currentItem())
     {
-        QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Test Import Failed",
+        QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Create Mapping Stubs Failed",
                                "Please select a file in the list.",
                                QMessageBox::Ok);
         m_warning.exec();
@@ -450,35 +503,51 @@ void ASTERIXImporterTaskWidget::testImportSlot()
 
         if (!task_.canImportFile(filename.toStdString()))
         {
-            QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Test Import Failed",
+            QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Create Mapping Stubs Failed",
                                    "File does not exist.",
                                    QMessageBox::Ok);
             m_warning.exec();
             return;
         }
 
-        task_.test(true);
-        task_.createMappingStubs(false);
+        task_.test(false);
+        task_.createMappingStubs(true);
         task_.importFile(filename.toStdString());
 
         create_mapping_stubs_button_->setDisabled(true);
         test_button_->setDisabled(true);
         import_button_->setDisabled(true);
+        live_import_button_->setDisabled(true);
     }
+}
 
+void ASTERIXImporterTaskWidget::testImportSlot()
+{
+    loginf << "ASTERIXImporterTaskWidget: testImportSlot";
+
+    std::vector<std::string> filenames;
+
+    if (!selectedFilenames("ASTERIX File Test Import Failed", filenames))
+        return;
+
+    task_.test(true);
+    task_.createMappingStubs(false);
+    task_.importFiles(filenames);
+
+    create_mapping_stubs_button_->setDisabled(true);
+    test_button_->setDisabled(true);
+    import_button_->setDisabled(true);
+    live_import_button_->setDisabled(true);
 }
+
 void ASTERIXImporterTaskWidget::importSlot()
 {
     loginf << "ASTERIXImporterTaskWidget: importSlot";
 
-    if (!file_list_->currentItem())
-    {
-        QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Import Failed",
-                               "Please select a file in the list.",
-                               QMessageBox::Ok);
-        m_warning.exec();
+    std::vector<std::string> filenames;
+
+    if (!selectedFilenames("ASTERIX File Import Failed", filenames))
         return;
-    }
 
     float free_ram = System::getFreeRAMinGB();
 
@@ -515,28 +584,14 @@ void ASTERIXImporterTaskWidget::importSlot()
         }
     }
 
-    QString filename = file_list_->currentItem()->text();
-    if (filename.size() > 0)
-    {
-        assert (task_.hasFile(filename.toStdString()));
+    task_.test(false);
+    task_.createMappingStubs(false);
+    task_.importFiles(filenames);
 
-        if (!task_.canImportFile(filename.toStdString()))
-        {
-            QMessageBox m_warning (QMessageBox::Warning, "ASTERIX File Import Failed",
-                                   "File does not exist.",
-                                   QMessageBox::Ok);
-            m_warning.exec();
-            return;
-        }
-
-        task_.test(false);
-        task_.createMappingStubs(false);
-        task_.importFile(filename.toStdString());
-
-        create_mapping_stubs_button_->setDisabled(true);
-        test_button_->setDisabled(true);
-        import_button_->setDisabled(true);
-    }
+    create_mapping_stubs_button_->setDisabled(true);
+    test_button_->setDisabled(true);
+    import_button_->setDisabled(true);
+    live_import_button_->setDisabled(true);
 }
 
 void ASTERIXImporterTaskWidget::importDone ()
@@ -546,4 +601,31 @@ void ASTERIXImporterTaskWidget::importDone ()
     create_mapping_stubs_button_->setDisabled(false);
     test_button_->setDisabled(false);
     import_button_->setDisabled(false);
+
+    live_import_button_->setText("Start Live Import");
+    live_import_button_->setDisabled(false);
+}
+
+void ASTERIXImporterTaskWidget::liveImportSlot()
+{
+    loginf << "ASTERIXImporterTaskWidget: liveImportSlot: active " << task_.liveImportActive();
+
+    if (task_.liveImportActive())
+    {
+        task_.stopLiveImport();
+        live_import_button_->setDisabled(true); // until remaining data is inserted
+        return;
+    }
+
+    task_.liveAddress(live_address_edit_->text().toStdString());
+    task_.livePort(live_port_box_->value());
+    task_.liveRecordingFilename(live_recording_edit_->text().toStdString());
+
+    task_.startLiveImport();
+
+    create_mapping_stubs_button_->setDisabled(true);
+    test_button_->setDisabled(true);
+    import_button_->setDisabled(true);
+
+    live_import_button_->setText("Stop Live Import");
 }
@@ -31,6 +31,8 @@ class QPushButton;
 class QListWidget;
 class QStackedWidget;
 class QCheckBox;
+class QSpinBox;
+class QLineEdit;
 
 class ASTERIXImporterTaskWidget : public QWidget
 {
@@ -48,9 +50,11 @@ public slots:
 
     void debugChangedSlot ();
     void limitRAMChangedSlot ();
+    void numParallelFilesChangedSlot (int value);
     void createMappingsSlot();
     void testImportSlot();
     void importSlot();
+    void liveImportSlot();
 
 public:
     ASTERIXImporterTaskWidget(ASTERIXImporterTask& task, QWidget* parent=0, Qt::WindowFlags f=0);
@@ -77,11 +81,19 @@ protected:
 
     QCheckBox* debug_check_ {nullptr};
     QCheckBox* limit_ram_check_ {nullptr};
+    QSpinBox* num_parallel_files_box_ {nullptr};
     QPushButton* create_mapping_stubs_button_ {nullptr};
     QPushButton* test_button_ {nullptr};
     QPushButton* import_button_ {nullptr};
 
+    QLineEdit* live_address_edit_ {nullptr};
+    QSpinBox* live_port_box_ {nullptr};
+    QLineEdit* live_recording_edit_ {nullptr};
+    QPushButton* live_import_button_ {nullptr};
+
     void updateParserList ();
+    /// @brief Returns selected filenames, shows warning and returns false if none selected or a file does not exist
+    bool selectedFilenames (const std::string& title, std::vector<std::string>& filenames);
     void createObjectParserWidget();
 };
 
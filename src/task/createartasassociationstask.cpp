@@ -207,7 +207,9 @@ void CreateARTASAssociationsTask::run ()
     //    msg_box_->show();
 
     status_dialog_->setDBODoneFlags(dbo_loading_done_flags_);
-    status_dialog_->show();
+
+    if (!ATSDB::instance().headless())
+        status_dialog_->show();
 }
 
 void CreateARTASAssociationsTask::newDataSlot (DBObject& object)
@@ -290,8 +292,13 @@ void CreateARTASAssociationsTask::createDoneSlot ()
 
     QApplication::restoreOverrideCursor();
 
+    if (ATSDB::instance().headless()) // can not be closed by user
+        status_dialog_ = nullptr;
+
     if (widget_)
         widget_->runDoneSlot();
+
+    emit runDoneSignal();
 }
 
 void CreateARTASAssociationsTask::createObsoleteSlot ()
@@ -631,6 +638,16 @@ void CreateARTASAssociationsTask::associationStatusSlot (QString status)
 
 void CreateARTASAssociationsTask::saveAssociationsQuestionSlot (QString question_str)
 {
+    if (ATSDB::instance().headless())
+    {
+        logwrn << "CreateARTASAssociationsTask: saveAssociationsQuestionSlot: " << question_str.toStdString()
+               << " saving in batch mode";
+
+        assert (create_job_);
+        create_job_->setSaveQuestionAnswer(true);
+        return;
+    }
+
     QMessageBox::StandardButton reply;
     reply = QMessageBox::question(nullptr, "Malformed Associations", question_str, QMessageBox::Yes|QMessageBox::No);
 
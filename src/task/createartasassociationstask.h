@@ -20,6 +20,9 @@ class CreateARTASAssociationsTask : public QObject, public Configurable
 {
     Q_OBJECT
 
+signals:
+    void runDoneSignal ();
+
 public slots:
     void createDoneSlot ();
     void createObsoleteSlot ();
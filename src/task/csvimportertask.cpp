@@ -0,0 +1,460 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "csvimportertask.h"
+#include "csvimportertaskwidget.h"
+#include "csvparsejob.h"
+#include "taskmanager.h"
+#include "dbobject.h"
+#include "dbobjectmanager.h"
+#include "dbovariable.h"
+#include "dbodatasourcedefinition.h"
+#include "dbtablecolumn.h"
+#include "stringconv.h"
+#include "files.h"
+#include "buffer.h"
+#include "jobmanager.h"
+#include "atsdb.h"
+#include "dbinterface.h"
+#include "logger.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <fstream>
+
+#include <QMessageBox>
+#include <QApplication>
+
+using namespace Utils;
+
+CSVImporterTask::CSVImporterTask(const std::string& class_id, const std::string& instance_id,
+                                 TaskManager* task_manager)
+    : Configurable (class_id, instance_id, task_manager)
+{
+    registerParameter("current_filename", &current_filename_, "");
+    registerParameter("dbo_name", &dbo_name_, "");
+    registerParameter("separator", &separator_, ";");
+    registerParameter("use_presentation", &use_presentation_, false);
+    registerParameter("import_key_values", &import_key_values_, false);
+    registerParameter("chunk_size_mb", &chunk_size_mb_, 16);
+    registerParameter("max_parse_jobs", &max_parse_jobs_, 4);
+
+    if (!chunk_size_mb_)
+        chunk_size_mb_ = 1;
+
+    if (!max_parse_jobs_)
+        max_parse_jobs_ = 1;
+
+    createSubConfigurables();
+}
+
+CSVImporterTask::~CSVImporterTask()
+{
+    if (msg_box_)
+    {
+        delete msg_box_;
+        msg_box_ = nullptr;
+    }
+}
+
+void CSVImporterTask::generateSubConfigurable (const std::string &class_id, const std::string &instance_id)
+{
+    throw std::runtime_error ("CSVImporterTask: generateSubConfigurable: unknown class_id "+class_id );
+}
+
+CSVImporterTaskWidget* CSVImporterTask::widget()
+{
+    if (!widget_)
+        widget_.reset(new CSVImporterTaskWidget (*this));
+
+    assert (widget_);
+    return widget_.get();
+}
+
+bool CSVImporterTask::canImportFile (const std::string& filename)
+{
+    if (!Files::fileExists(filename))
+        return false;
+
+    if (separator_.size() != 1)
+        return false;
+
+    return dbo_name_.size() && ATSDB::instance().objectManager().existsObject(dbo_name_);
+}
+
+void CSVImporterTask::importFile (const std::string& filename, bool test)
+{
+    loginf << "CSVImporterTask: importFile: filename " << filename << " test " << test;
+
+    assert (canImportFile(filename));
+    assert (!parse_jobs_.size());
+
+    filename_ = filename;
+    test_ = test;
+    all_done_ = false;
+
+    bytes_to_read_ = 0;
+    bytes_parsed_ = 0;
+    lines_parsed_ = 0;
+    parse_errors_ = 0;
+    rows_created_ = 0;
+    rows_inserted_ = 0;
+
+    insert_queue_.clear();
+    added_data_sources_.clear();
+
+    try
+    {
+        file_.reset(new boost::iostreams::mapped_file_source (filename));
+    }
+    catch (std::exception& e)
+    {
+        logerr << "CSVImporterTask: importFile: unable to map file '" << filename << "': " << e.what();
+        file_ = nullptr;
+
+        if (!ATSDB::instance().headless())
+            QMessageBox::warning (nullptr, "CSV Import", ("Unable to open file '"+filename+"'").c_str());
+
+        return;
+    }
+
+    assert (file_);
+    bytes_to_read_ = file_->size();
+
+    if (!parseHeader())
+    {
+        logerr << "CSVImporterTask: importFile: no columns of '" << dbo_name_ << "' found in header of '"
+               << filename << "'";
+        file_ = nullptr;
+
+        if (!ATSDB::instance().headless())
+            QMessageBox::warning (nullptr, "CSV Import", ("No variables of '"+dbo_name_
+                                                          +"' found in header of file '"+filename+"'").c_str());
+        return;
+    }
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    start_time_ = boost::posix_time::microsec_clock::local_time();
+
+    if (!test_)
+        ATSDB::instance().interface().beginImport();
+
+    startParseJobs();
+    checkAllDone(); // in case file has no data lines
+    updateMsgBox();
+
+    logdbg << "CSVImporterTask: importFile: filename " << filename << " test " << test << " done";
+}
+
+bool CSVImporterTask::parseHeader ()
+{
+    assert (file_);
+
+    columns_.clear();
+    variable_set_.clear();
+    data_source_variable_name_ = "";
+
+    const char* data = file_->data();
+    size_t size = file_->size();
+
+    const char* line_end = static_cast<const char*>(memchr(data, '\n', size));
+    if (!line_end)
+        line_end = data + size;
+
+    read_position_ = line_end - data;
+    if (read_position_ < size)
+        ++read_position_; // skip newline
+
+    std::string header (data, line_end);
+    if (header.size() && header.back() == '\r')
+        header.pop_back();
+
+    std::vector<std::string> names = String::split(header, separator_.at(0));
+
+    DBObject& db_object = ATSDB::instance().objectManager().object(dbo_name_);
+
+    std::string data_source_column;
+    if (db_object.hasCurrentDataSourceDefinition())
+        data_source_column = db_object.currentDataSourceDefinition().localKey();
+
+    for (auto& name : names)
+    {
+        if (name == "Selected" || name == "UTN" || !db_object.hasVariable(name))
+        {
+            if (name != "Selected" && name != "UTN")
+                logwrn << "CSVImporterTask: parseHeader: unknown column '" << name << "' ignored";
+
+            columns_.push_back(nullptr);
+            continue;
+        }
+
+        DBOVariable& variable = db_object.variable(name);
+
+        if (variable.isKey() && !import_key_values_)
+        {
+            loginf << "CSVImporterTask: parseHeader: key column '" << name << "' ignored";
+            columns_.push_back(nullptr);
+            continue;
+        }
+
+        if (variable_set_.hasVariable(variable))
+        {
+            logwrn << "CSVImporterTask: parseHeader: duplicate column '" << name << "' ignored";
+            columns_.push_back(nullptr);
+            continue;
+        }
+
+        columns_.push_back(&variable);
+        variable_set_.add(variable);
+
+        if (data_source_column.size() && variable.currentDBColumn().name() == data_source_column)
+            data_source_variable_name_ = variable.name();
+    }
+
+    loginf << "CSVImporterTask: parseHeader: " << columns_.size() << " columns, " << variable_set_.getSize()
+           << " mapped, data source variable '" << data_source_variable_name_ << "'";
+
+    return variable_set_.getSize() > 0;
+}
+
+void CSVImporterTask::startParseJobs ()
+{
+    assert (file_);
+
+    const char* data = file_->data();
+    size_t size = file_->size();
+    size_t chunk_size = static_cast<size_t>(chunk_size_mb_)*1024*1024;
+
+    while (read_position_ < size && parse_jobs_.size() < max_parse_jobs_ && !insert_queue_.full())
+    {
+        size_t chunk_end = std::min(read_position_+chunk_size, size);
+
+        if (chunk_end < size) // extend to end of line
+        {
+            const char* line_end = static_cast<const char*>(memchr(data+chunk_end, '\n', size-chunk_end));
+            chunk_end = line_end ? line_end-data+1 : size;
+        }
+
+        logdbg << "CSVImporterTask: startParseJobs: chunk " << read_position_ << " to " << chunk_end;
+
+        std::shared_ptr<CSVParseJob> parse_job = std::make_shared<CSVParseJob> (
+                    data+read_position_, chunk_end-read_position_, separator_.at(0), dbo_name_, columns_,
+                    use_presentation_, data_source_variable_name_);
+
+        connect (parse_job.get(), SIGNAL(obsoleteSignal()), this, SLOT(parseJobObsoleteSlot()),
+                 Qt::QueuedConnection);
+        connect (parse_job.get(), SIGNAL(doneSignal()), this, SLOT(parseJobDoneSlot()), Qt::QueuedConnection);
+
+        parse_jobs_.push_back(parse_job);
+        JobManager::instance().addNonBlockingJob(parse_job);
+
+        read_position_ = chunk_end;
+    }
+}
+
+void CSVImporterTask::parseJobDoneSlot ()
+{
+    logdbg << "CSVImporterTask: parseJobDoneSlot";
+
+    CSVParseJob* parse_job = dynamic_cast<CSVParseJob*>(QObject::sender());
+    assert (parse_job);
+    assert (parse_jobs_.size() && parse_jobs_.front().get() == parse_job); // non-blocking jobs are done in order
+
+    std::shared_ptr<CSVParseJob> job = parse_jobs_.front();
+    parse_jobs_.pop_front();
+
+    bytes_parsed_ += job->size();
+    lines_parsed_ += job->numLines();
+    parse_errors_ += job->numParseErrors();
+
+    std::shared_ptr<Buffer> buffer = job->buffer();
+
+    if (buffer && buffer->size())
+    {
+        rows_created_ += buffer->size();
+
+        if (!test_)
+        {
+            ATSDB::instance().objectManager().addNewDataSources({{dbo_name_, job->dataSources()}},
+                                                                added_data_sources_);
+
+            DBOInsertQueue::Batch batch;
+            batch[dbo_name_] = buffer;
+            insert_queue_.add(batch);
+        }
+    }
+
+    if (!test_)
+        insertData();
+
+    startParseJobs();
+
+    checkAllDone();
+    updateMsgBox();
+
+    logdbg << "CSVImporterTask: parseJobDoneSlot: done";
+}
+
+void CSVImporterTask::parseJobObsoleteSlot ()
+{
+    logdbg << "CSVImporterTask: parseJobObsoleteSlot";
+}
+
+void CSVImporterTask::insertData ()
+{
+    logdbg << "CSVImporterTask: insertData";
+
+    bool input_done = file_ && read_position_ == file_->size() && parse_jobs_.size() == 0;
+
+    insert_queue_.commit(input_done);
+
+    if (insert_queue_.canPop())
+    {
+        DBOInsertQueue::Batch batch = insert_queue_.pop();
+
+        assert (batch.count(dbo_name_));
+        DBObject& db_object = ATSDB::instance().objectManager().object(dbo_name_);
+
+        loginf << "CSVImporterTask: insertData: inserting " << batch.at(dbo_name_)->size()
+               << " rows into database, queue depth " << insert_queue_.depth();
+
+        connect (&db_object, &DBObject::insertDoneSignal, this, &CSVImporterTask::insertDoneSlot,
+                 Qt::UniqueConnection);
+
+        db_object.insertData(variable_set_, batch.at(dbo_name_), false);
+
+        insert_queue_.commit(input_done); // filling batch might have waited for free slot
+    }
+}
+
+void CSVImporterTask::insertDoneSlot (DBObject& object)
+{
+    logdbg << "CSVImporterTask: insertDoneSlot";
+
+    if (object.name() != dbo_name_ || !insert_queue_.writing())
+        return;
+
+    rows_inserted_ += insert_queue_.written(object.name());
+
+    insertData();
+    startParseJobs(); // queue might have space again
+
+    checkAllDone();
+    updateMsgBox();
+
+    logdbg << "CSVImporterTask: insertDoneSlot: done";
+}
+
+void CSVImporterTask::checkAllDone ()
+{
+    logdbg << "CSVImporterTask: checkAllDone";
+
+    if (!all_done_ && file_ && read_position_ == file_->size() && parse_jobs_.size() == 0
+            && insert_queue_.empty())
+    {
+        stop_time_ = boost::posix_time::microsec_clock::local_time();
+
+        boost::posix_time::time_duration diff = stop_time_ - start_time_;
+
+        loginf << "CSVImporterTask: checkAllDone: import done after "
+               << String::timeStringFromDouble(diff.total_milliseconds()/1000.0, false) << ", " << lines_parsed_
+               << " lines, " << parse_errors_ << " parse errors, " << rows_inserted_ << " rows inserted";
+
+        all_done_ = true;
+        file_ = nullptr; // buffers own their data, mapping no longer needed
+
+        if (!test_)
+            ATSDB::instance().interface().endImport();
+
+        QApplication::restoreOverrideCursor();
+
+        if (!test_)
+            emit ATSDB::instance().interface().databaseContentChangedSignal();
+
+        if (widget_)
+            widget_->importDoneSlot(test_);
+
+        emit importDoneSignal();
+    }
+}
+
+void CSVImporterTask::updateMsgBox ()
+{
+    logdbg << "CSVImporterTask: updateMsgBox";
+
+    std::string msg;
+
+    if (test_)
+        msg = "Testing import of";
+    else
+        msg = "Importing";
+
+    msg += " file '"+filename_+"'\n";
+
+    boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - start_time_;
+    double elapsed_s = diff.total_milliseconds()/1000.0;
+
+    msg += "Elapsed Time: "+String::timeStringFromDouble(elapsed_s, false)+"\n";
+
+    msg += "Data parsed: "+String::doubleToStringPrecision(static_cast<double>(bytes_parsed_)*1e-6,2)+" MB";
+    if (bytes_to_read_)
+        msg += " ("+std::to_string(static_cast<int>(100.0*bytes_parsed_/bytes_to_read_))+"%)\n\n";
+    else
+        msg += "\n\n";
+
+    msg += "Lines parsed: "+std::to_string(lines_parsed_)+"\n";
+    msg += "Parse errors: "+std::to_string(parse_errors_)+"\n";
+    msg += "Rows created: "+std::to_string(rows_created_)+"\n";
+
+    if (!test_)
+    {
+        msg += "Rows inserted: "+std::to_string(rows_inserted_)+"\n";
+        msg += "Insert queue depth: "+std::to_string(insert_queue_.depth())+" / "
+                +std::to_string(insert_queue_.maxDepth())+"\n";
+        msg += "DB write rate: "+std::to_string(static_cast<int>(insert_queue_.writeRate()))+" e/s\n";
+    }
+
+    if (elapsed_s > 0)
+        msg += "\nRow rate: "+std::to_string(static_cast<int>((test_ ? rows_created_ : rows_inserted_)/elapsed_s))
+                +" e/s";
+
+    if (ATSDB::instance().headless())
+    {
+        if (all_done_)
+            loginf << "CSVImporterTask: updateMsgBox: " << msg;
+        return;
+    }
+
+    if (!msg_box_)
+    {
+        msg_box_ = new QMessageBox ();
+        assert (msg_box_);
+    }
+
+    msg_box_->setText(msg.c_str());
+
+    if (all_done_)
+        msg_box_->setStandardButtons(QMessageBox::Ok);
+    else
+        msg_box_->setStandardButtons(QMessageBox::NoButton);
+
+    msg_box_->show();
+}
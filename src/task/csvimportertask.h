@@ -0,0 +1,146 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CSVIMPORTERTASK_H
+#define CSVIMPORTERTASK_H
+
+#include "configurable.h"
+#include "dbovariableset.h"
+#include "dboinsertqueue.h"
+
+#include <QObject>
+
+#include <deque>
+#include <memory>
+#include <set>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+class TaskManager;
+class CSVImporterTaskWidget;
+class CSVParseJob;
+class DBObject;
+class QMessageBox;
+
+namespace boost { namespace iostreams { class mapped_file_source; } }
+
+/**
+ * @brief Imports CSV files as written by BufferCSVExportJob into one DBObject
+ *
+ * The file is memory-mapped and split at line boundaries into chunks, which are parsed by CSVParseJobs in parallel.
+ * Header names are mapped to the DBOVariables of the object, unknown columns (e.g. Selected, UTN) are ignored. Parsed
+ * buffers are written through the DBOInsertQueue, like in the JSONImporterTask. At most max_parse_jobs chunks are
+ * parsed at a time, and no new chunks are parsed while the insert queue is full, so memory usage stays bounded for
+ * large files.
+ */
+class CSVImporterTask : public QObject, public Configurable
+{
+    Q_OBJECT
+
+signals:
+    void importDoneSignal ();
+
+public slots:
+    void parseJobDoneSlot ();
+    void parseJobObsoleteSlot ();
+
+    void insertDoneSlot (DBObject& object);
+
+public:
+    CSVImporterTask(const std::string& class_id, const std::string& instance_id, TaskManager* task_manager);
+    virtual ~CSVImporterTask();
+
+    bool hasOpenWidget() { return widget_ != nullptr; }
+    CSVImporterTaskWidget* widget();
+
+    virtual void generateSubConfigurable (const std::string &class_id, const std::string &instance_id);
+
+    bool canImportFile (const std::string& filename);
+    void importFile (const std::string& filename, bool test);
+    /// @brief Returns if an import was started and is not done yet
+    bool importRunning () const { return file_ != nullptr && !all_done_; }
+
+    const std::string& currentFilename () const { return current_filename_; }
+    void currentFilename (const std::string& filename) { current_filename_ = filename; }
+
+    const std::string& dbObjectName () const { return dbo_name_; }
+    void dbObjectName (const std::string& dbo_name) { dbo_name_ = dbo_name; }
+
+    const std::string& separator () const { return separator_; }
+    void separator (const std::string& separator) { separator_ = separator; }
+
+    bool usePresentation () const { return use_presentation_; }
+    void usePresentation (bool value) { use_presentation_ = value; }
+
+    /// @brief Returns if key variable values are imported, otherwise the database assigns new keys
+    bool importKeyValues () const { return import_key_values_; }
+    void importKeyValues (bool value) { import_key_values_ = value; }
+
+protected:
+    std::string current_filename_;
+    std::string dbo_name_;
+    std::string separator_ {";"};
+    bool use_presentation_ {false};
+    bool import_key_values_ {false};
+    unsigned int chunk_size_mb_ {16};
+    unsigned int max_parse_jobs_ {4};
+
+    std::unique_ptr<CSVImporterTaskWidget> widget_;
+
+    std::unique_ptr<boost::iostreams::mapped_file_source> file_;
+    size_t read_position_ {0};
+
+    /// CSV column -> variable, nullptr if not imported
+    std::vector<DBOVariable*> columns_;
+    DBOVariableSet variable_set_;
+    std::string data_source_variable_name_;
+
+    std::deque<std::shared_ptr<CSVParseJob>> parse_jobs_;
+
+    DBOInsertQueue insert_queue_;
+    std::set<int> added_data_sources_;
+
+    std::string filename_;
+    bool test_ {false};
+    bool all_done_ {false};
+
+    boost::posix_time::ptime start_time_;
+    boost::posix_time::ptime stop_time_;
+
+    size_t bytes_to_read_ {0};
+    size_t bytes_parsed_ {0};
+    size_t lines_parsed_ {0};
+    size_t parse_errors_ {0};
+    size_t rows_created_ {0};
+    size_t rows_inserted_ {0};
+
+    QMessageBox* msg_box_ {nullptr};
+
+    /// @brief Maps header columns to variables of the DBObject, returns false if none could be mapped
+    bool parseHeader ();
+    /// @brief Starts parse jobs for the next chunks while below the limit and the insert queue is not full
+    void startParseJobs ();
+    void insertData ();
+
+    void checkAllDone ();
+    void updateMsgBox ();
+
+    virtual void checkSubConfigurables () {}
+};
+
+#endif // CSVIMPORTERTASK_H
@@ -0,0 +1,200 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "csvimportertaskwidget.h"
+#include "csvimportertask.h"
+#include "dbobjectcombobox.h"
+#include "logger.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGridLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QFileDialog>
+#include <QMessageBox>
+
+CSVImporterTaskWidget::CSVImporterTaskWidget(CSVImporterTask& task, QWidget* parent, Qt::WindowFlags f)
+    : QWidget (parent, f), task_(task)
+{
+    setWindowTitle ("Import CSV Data");
+    setMinimumSize(QSize(600, 300));
+
+    QFont font_big;
+    font_big.setPointSize(18);
+
+    QVBoxLayout *main_layout = new QVBoxLayout ();
+
+    QLabel *main_label = new QLabel ("Import CSV data");
+    main_label->setFont (font_big);
+    main_layout->addWidget (main_label);
+
+    QGridLayout *grid = new QGridLayout ();
+    int row_cnt=0;
+
+    grid->addWidget (new QLabel ("File"), row_cnt, 0);
+
+    QHBoxLayout* file_layout = new QHBoxLayout ();
+
+    filename_edit_ = new QLineEdit (task_.currentFilename().c_str());
+    connect (filename_edit_, &QLineEdit::textEdited, this, &CSVImporterTaskWidget::filenameEditedSlot);
+    file_layout->addWidget(filename_edit_);
+
+    QPushButton* select_button = new QPushButton ("Select");
+    connect (select_button, &QPushButton::clicked, this, &CSVImporterTaskWidget::selectFileSlot);
+    file_layout->addWidget(select_button);
+
+    grid->addLayout (file_layout, row_cnt, 1);
+
+    row_cnt++;
+    grid->addWidget (new QLabel ("DBObject"), row_cnt, 0);
+
+    object_box_ = new DBObjectComboBox (false);
+    if (task_.dbObjectName().size())
+        object_box_->setObjectName(task_.dbObjectName());
+    else
+        task_.dbObjectName(object_box_->getObjectName());
+    connect (object_box_, SIGNAL(changedObject()), this, SLOT(dbObjectChangedSlot()));
+    grid->addWidget (object_box_, row_cnt, 1);
+
+    row_cnt++;
+    grid->addWidget (new QLabel ("Separator"), row_cnt, 0);
+
+    separator_edit_ = new QLineEdit (task_.separator().c_str());
+    separator_edit_->setMaxLength(1);
+    connect (separator_edit_, &QLineEdit::textEdited, this, &CSVImporterTaskWidget::separatorEditedSlot);
+    grid->addWidget (separator_edit_, row_cnt, 1);
+
+    row_cnt++;
+    use_presentation_check_ = new QCheckBox ("Use Presentation");
+    use_presentation_check_->setChecked(task_.usePresentation());
+    connect (use_presentation_check_, &QCheckBox::clicked, this,
+             &CSVImporterTaskWidget::usePresentationChangedSlot);
+    grid->addWidget (use_presentation_check_, row_cnt, 1);
+
+    row_cnt++;
+    import_key_values_check_ = new QCheckBox ("Import Key Values");
+    import_key_values_check_->setChecked(task_.importKeyValues());
+    connect (import_key_values_check_, &QCheckBox::clicked, this,
+             &CSVImporterTaskWidget::importKeyValuesChangedSlot);
+    grid->addWidget (import_key_values_check_, row_cnt, 1);
+
+    main_layout->addLayout(grid);
+    main_layout->addStretch();
+
+    test_button_ = new QPushButton ("Test Import");
+    connect(test_button_, &QPushButton::clicked, this, &CSVImporterTaskWidget::testImportSlot);
+    main_layout->addWidget(test_button_);
+
+    import_button_ = new QPushButton ("Import");
+    connect(import_button_, &QPushButton::clicked, this, &CSVImporterTaskWidget::importSlot);
+    main_layout->addWidget(import_button_);
+
+    setLayout (main_layout);
+
+    show();
+}
+
+CSVImporterTaskWidget::~CSVImporterTaskWidget()
+{
+}
+
+void CSVImporterTaskWidget::selectFileSlot ()
+{
+    QString filename = QFileDialog::getOpenFileName(this, tr("Select CSV File"), "",
+                                                    tr("CSV Files (*.csv *.txt);;All Files (*)"));
+
+    if (filename.size() > 0)
+    {
+        assert (filename_edit_);
+        filename_edit_->setText(filename);
+        task_.currentFilename(filename.toStdString());
+    }
+}
+
+void CSVImporterTaskWidget::filenameEditedSlot (const QString& text)
+{
+    task_.currentFilename(text.toStdString());
+}
+
+void CSVImporterTaskWidget::dbObjectChangedSlot ()
+{
+    assert (object_box_);
+    task_.dbObjectName(object_box_->getObjectName());
+}
+
+void CSVImporterTaskWidget::separatorEditedSlot (const QString& text)
+{
+    task_.separator(text.toStdString());
+}
+
+void CSVImporterTaskWidget::usePresentationChangedSlot ()
+{
+    assert (use_presentation_check_);
+    task_.usePresentation(use_presentation_check_->checkState() == Qt::Checked);
+}
+
+void CSVImporterTaskWidget::importKeyValuesChangedSlot ()
+{
+    assert (import_key_values_check_);
+    task_.importKeyValues(import_key_values_check_->checkState() == Qt::Checked);
+}
+
+void CSVImporterTaskWidget::testImportSlot ()
+{
+    loginf << "CSVImporterTaskWidget: testImportSlot";
+    startImport(true);
+}
+
+void CSVImporterTaskWidget::importSlot ()
+{
+    loginf << "CSVImporterTaskWidget: importSlot";
+    startImport(false);
+}
+
+void CSVImporterTaskWidget::startImport (bool test)
+{
+    std::string filename = task_.currentFilename();
+
+    if (!task_.canImportFile(filename))
+    {
+        QMessageBox m_warning (QMessageBox::Warning, "CSV File Import Failed",
+                               "Please select an existing file, a DBObject and a one-character separator.",
+                               QMessageBox::Ok);
+        m_warning.exec();
+        return;
+    }
+
+    test_button_->setDisabled(true);
+    import_button_->setDisabled(true);
+
+    task_.importFile(filename, test);
+
+    if (!task_.importRunning())
+        importDoneSlot(test);
+}
+
+void CSVImporterTaskWidget::importDoneSlot (bool test)
+{
+    loginf << "CSVImporterTaskWidget: importDoneSlot: test " << test;
+
+    test_button_->setDisabled(false);
+    import_button_->setDisabled(false);
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CSVIMPORTERTASKWIDGET_H
+#define CSVIMPORTERTASKWIDGET_H
+
+#include <QWidget>
+
+class CSVImporterTask;
+class DBObjectComboBox;
+
+class QPushButton;
+class QCheckBox;
+class QLineEdit;
+
+class CSVImporterTaskWidget : public QWidget
+{
+    Q_OBJECT
+
+public slots:
+    void selectFileSlot ();
+    void filenameEditedSlot (const QString& text);
+    void dbObjectChangedSlot ();
+    void separatorEditedSlot (const QString& text);
+    void usePresentationChangedSlot ();
+    void importKeyValuesChangedSlot ();
+
+    void testImportSlot ();
+    void importSlot ();
+    void importDoneSlot (bool test);
+
+public:
+    CSVImporterTaskWidget(CSVImporterTask& task, QWidget* parent=0, Qt::WindowFlags f=0);
+    virtual ~CSVImporterTaskWidget();
+
+protected:
+    CSVImporterTask& task_;
+
+    QLineEdit* filename_edit_ {nullptr};
+    DBObjectComboBox* object_box_ {nullptr};
+    QLineEdit* separator_edit_ {nullptr};
+    QCheckBox* use_presentation_check_ {nullptr};
+    QCheckBox* import_key_values_check_ {nullptr};
+
+    QPushButton* test_button_ {nullptr};
+    QPushButton* import_button_ {nullptr};
+
+    void startImport (bool test);
+};
+
+#endif // CSVIMPORTERTASKWIDGET_H
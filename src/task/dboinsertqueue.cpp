@@ -0,0 +1,120 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dboinsertqueue.h"
+#include "buffer.h"
+#include "logger.h"
+
+DBOInsertQueue::DBOInsertQueue(size_t batch_size, size_t max_depth)
+    : batch_size_(batch_size), max_depth_(max_depth)
+{
+    assert (max_depth_);
+}
+
+void DBOInsertQueue::clear ()
+{
+    filling_.clear();
+    filling_rows_ = 0;
+
+    batches_.clear();
+    writing_.clear();
+
+    rows_written_ = 0;
+    write_time_ = boost::posix_time::time_duration();
+}
+
+void DBOInsertQueue::add (Batch& buffers)
+{
+    for (auto& buf_it : buffers)
+    {
+        if (!buf_it.second || !buf_it.second->size())
+            continue;
+
+        filling_rows_ += buf_it.second->size();
+
+        if (filling_.count(buf_it.first) == 0)
+            filling_[buf_it.first] = buf_it.second;
+        else
+            filling_.at(buf_it.first)->seizeBuffer(*buf_it.second);
+    }
+}
+
+void DBOInsertQueue::batchSize (size_t value)
+{
+    assert (value);
+    batch_size_ = value;
+}
+
+bool DBOInsertQueue::commit (bool force)
+{
+    if (!filling_.size() || full() || (!force && filling_rows_ < batch_size_))
+        return false;
+
+    logdbg << "DBOInsertQueue: commit: batch with " << filling_rows_ << " rows, depth " << batches_.size()+1;
+
+    batches_.push_back(std::move(filling_));
+    filling_.clear();
+    filling_rows_ = 0;
+
+    return true;
+}
+
+DBOInsertQueue::Batch DBOInsertQueue::pop ()
+{
+    assert (canPop());
+
+    Batch batch = std::move(batches_.front());
+    batches_.pop_front();
+
+    for (auto& buf_it : batch)
+        writing_[buf_it.first] = buf_it.second->size();
+
+    write_start_time_ = boost::posix_time::microsec_clock::local_time();
+
+    return batch;
+}
+
+size_t DBOInsertQueue::written (const std::string& dbo_name)
+{
+    if (!writing_.count(dbo_name))
+    {
+        logwrn << "DBOInsertQueue: written: no buffer being written for " << dbo_name;
+        return 0;
+    }
+
+    size_t rows = writing_.at(dbo_name);
+    writing_.erase(dbo_name);
+
+    rows_written_ += rows;
+
+    if (!writing_.size())
+        write_time_ += boost::posix_time::microsec_clock::local_time() - write_start_time_;
+
+    return rows;
+}
+
+double DBOInsertQueue::writeRate () const
+{
+    double write_time_s = write_time_.total_milliseconds()/1000.0;
+
+    if (writing_.size())
+        write_time_s += (boost::posix_time::microsec_clock::local_time()
+                         - write_start_time_).total_milliseconds()/1000.0;
+
+    return write_time_s > 0 ? rows_written_/write_time_s : 0.0;
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DBOINSERTQUEUE_H
+#define DBOINSERTQUEUE_H
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+class Buffer;
+
+/**
+ * @brief Bounded queue of per-DBObject buffer batches between mapping and database writing
+ *
+ * Mapped buffers are collected in a filling batch, which is committed to the queue once it is large enough. The
+ * writer takes one batch at a time, the buffers of which are inserted per DBObject. While a batch is being written,
+ * the next one can be filled, so that mapping never has to wait on the database. If the queue is full, the filling
+ * batch keeps growing until the writer has taken the next batch.
+ */
+class DBOInsertQueue
+{
+public:
+    using Batch = std::map<std::string, std::shared_ptr<Buffer>>; // dbo name -> buffer
+
+    DBOInsertQueue(size_t batch_size=10000, size_t max_depth=2);
+    virtual ~DBOInsertQueue() {}
+
+    /// @brief Removes all batches and resets the statistics
+    void clear ();
+
+    /// @brief Seizes the given non-empty buffers into the filling batch
+    void add (Batch& buffers);
+    /// @brief Moves the filling batch into the queue if it is large enough (or force is set) and the queue not full
+    bool commit (bool force);
+
+    /// @brief Returns if the writer can take the next batch
+    bool canPop () const { return !writing() && batches_.size(); }
+    /// @brief Takes the next batch for writing, all its buffers have to be marked written afterwards
+    Batch pop ();
+    /// @brief Marks write of buffer of given DBObject done, returns its number of rows
+    size_t written (const std::string& dbo_name);
+
+    /// @brief Returns if the writer is busy with a batch
+    bool writing () const { return writing_.size(); }
+    /// @brief Returns if nothing is being filled, queued or written
+    bool empty () const { return !filling_.size() && !batches_.size() && !writing_.size(); }
+    bool full () const { return batches_.size() >= max_depth_; }
+
+    size_t batchSize () const { return batch_size_; }
+    /// @brief Sets number of rows from which the filling batch is committed, e.g. small for low insert latency
+    void batchSize (size_t value);
+
+    size_t depth () const { return batches_.size(); }
+    size_t maxDepth () const { return max_depth_; }
+    size_t fillingRows () const { return filling_rows_; }
+
+    size_t rowsWritten () const { return rows_written_; }
+    /// @brief Returns rows per second written while the writer was busy
+    double writeRate () const;
+
+protected:
+    size_t batch_size_ {10000};
+    size_t max_depth_ {2};
+
+    Batch filling_;
+    size_t filling_rows_ {0};
+
+    std::deque<Batch> batches_;
+    std::map<std::string, size_t> writing_; // dbo name -> rows
+
+    size_t rows_written_ {0};
+    boost::posix_time::ptime write_start_time_;
+    boost::posix_time::time_duration write_time_;
+};
+
+#endif // DBOINSERTQUEUE_H
@@ -232,6 +232,9 @@ void JSONImporterTask::importFile(const std::string& filename, bool test)
     objects_created_ = 0;
     objects_inserted_ = 0;
 
+    insert_queue_.clear();
+    read_paused_ = false;
+
     assert (schemas_.count(current_schema_));
 
     for (auto& map_it : schemas_.at(current_schema_))
@@ -240,6 +243,9 @@ void JSONImporterTask::importFile(const std::string& filename, bool test)
 
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
+    if (!test_)
+        ATSDB::instance().interface().beginImport();
+
     read_json_job_ = std::shared_ptr<ReadJSONFilePartJob> (new ReadJSONFilePartJob (filename, false, 10000));
     connect (read_json_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(readJSONFilePartObsoleteSlot()),
              Qt::QueuedConnection);
@@ -277,6 +283,9 @@ void JSONImporterTask::importFileArchive (const std::string& filename, bool test
     objects_created_ = 0;
     objects_inserted_ = 0;
 
+    insert_queue_.clear();
+    read_paused_ = false;
+
     assert (schemas_.count(current_schema_));
 
     for (auto& map_it : schemas_.at(current_schema_))
@@ -285,6 +294,9 @@ void JSONImporterTask::importFileArchive (const std::string& filename, bool test
 
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
+    if (!test_)
+        ATSDB::instance().interface().beginImport();
+
     read_json_job_ = std::shared_ptr<ReadJSONFilePartJob> (new ReadJSONFilePartJob (filename, true, 10000));
     connect (read_json_job_.get(), SIGNAL(obsoleteSignal()), this, SLOT(readJSONFilePartObsoleteSlot()),
              Qt::QueuedConnection);
@@ -321,9 +333,18 @@ void JSONImporterTask::readJSONFilePartDoneSlot ()
     // restart read job
     if (!read_json_job_->fileReadDone())
     {
-        loginf << "JSONImporterTask: readJSONFilePartDoneSlot: read continue";
         read_json_job_->resetDone();
-        JobManager::instance().addNonBlockingJob(read_json_job_);
+
+        if (insert_queue_.full()) // writer is behind, reading more would only grow the filling batch
+        {
+            loginf << "JSONImporterTask: readJSONFilePartDoneSlot: read paused, insert queue full";
+            read_paused_ = true;
+        }
+        else
+        {
+            loginf << "JSONImporterTask: readJSONFilePartDoneSlot: read continue";
+            JobManager::instance().addNonBlockingJob(read_json_job_);
+        }
     }
     else
         read_json_job_ = nullptr;
@@ -424,39 +445,13 @@ void JSONImporterTask::mapJSONDoneSlot ()
         return;
     }
 
-    for (auto& buf_it : job_buffers)
-    {
-        if (buf_it.second && buf_it.second->size())
-        {
-            std::shared_ptr<Buffer> job_buffer = buf_it.second;
-
-            if (buffers_.count(buf_it.first) == 0)
-                buffers_[buf_it.first] = job_buffer;
-            else
-                buffers_.at(buf_it.first)->seizeBuffer(*job_buffer.get());
-        }
-    }
+    ATSDB::instance().objectManager().addNewDataSources(map_job->dataSources(), added_data_sources_);
 
-    updateMsgBox();
+    insert_queue_.add(job_buffers);
 
-    if (!insert_active_)
-    {
-        for (auto& buf_it : buffers_)
-        {
-            if (buf_it.second->size() > 10000)
-            {
-                loginf << "JSONImporterTask: mapJSONDoneSlot: inserting part of parsed objects";
-                insertData ();
-                return;
-            }
-        }
-    }
+    insertData();
 
-    if (read_json_job_ == nullptr && json_parse_jobs_.size() == 0 && json_map_jobs_.size() == 0)
-    {
-        loginf << "JSONImporterTask: mapJSONDoneSlot: inserting parsed objects at end";
-        insertData ();
-    }
+    updateMsgBox();
 
     logdbg << "JSONImporterTask: mapJSONDoneSlot: done";
 }
@@ -468,34 +463,52 @@ void JSONImporterTask::mapJSONObsoleteSlot ()
 
 void JSONImporterTask::insertData ()
 {
-    loginf << "JSONImporterTask: insertData: inserting into database";
+    logdbg << "JSONImporterTask: insertData";
 
-    while (insert_active_)
+    bool input_done = read_json_job_ == nullptr && json_parse_jobs_.size() == 0 && json_map_jobs_.size() == 0;
+
+    insert_queue_.commit(input_done);
+
+    if (insert_queue_.canPop())
     {
-        //QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        QThread::msleep (1);
+        DBOInsertQueue::Batch batch = insert_queue_.pop();
+        insertBatch(batch);
+
+        insert_queue_.commit(input_done); // filling batch might have waited for free slot
     }
 
-    bool has_sac_sic = false;
+    resumeRead();
+}
+
+void JSONImporterTask::resumeRead ()
+{
+    if (!read_paused_ || insert_queue_.full())
+        return;
+
+    assert (read_json_job_);
+
+    loginf << "JSONImporterTask: resumeRead: read continue, insert queue depth " << insert_queue_.depth();
+
+    read_paused_ = false;
+    JobManager::instance().addNonBlockingJob(read_json_job_);
+}
+
+void JSONImporterTask::insertBatch (DBOInsertQueue::Batch& batch)
+{
+    loginf << "JSONImporterTask: insertBatch: inserting into database, queue depth " << insert_queue_.depth();
+
     //bool emit_change = (read_json_job_ == nullptr && json_parse_jobs_.size() == 0 && json_map_jobs_.size() == 0);
 
     assert (schemas_.count(current_schema_));
 
     for (auto& parser_it : schemas_.at(current_schema_))
     {
-        if (buffers_.count(parser_it.second.dbObject().name()) != 0)
+        if (batch.count(parser_it.second.dbObject().name()) != 0)
         {
-            ++insert_active_;
-
             DBObject& db_object = parser_it.second.dbObject();
-            std::shared_ptr<Buffer> buffer = buffers_.at(parser_it.second.dbObject().name());
-
-            has_sac_sic = db_object.hasVariable("sac") && db_object.hasVariable("sic")
-                    && buffer->has<char>("sac") && buffer->has<char>("sic");
-
-            logdbg << "JSONImporterTask: insertData: " << db_object.name() << " has sac/sic " << has_sac_sic;
+            std::shared_ptr<Buffer> buffer = batch.at(parser_it.second.dbObject().name());
 
-            logdbg << "JSONImporterTask: insertData: " << db_object.name() << " buffer " << buffer->size();
+            logdbg << "JSONImporterTask: insertBatch: " << db_object.name() << " buffer " << buffer->size();
 
             connect (&db_object, &DBObject::insertDoneSignal, this, &JSONImporterTask::insertDoneSlot,
                      Qt::UniqueConnection);
@@ -503,99 +516,16 @@ void JSONImporterTask::insertData ()
                      Qt::UniqueConnection);
 
 
-            if (parser_it.second.dataSourceVariableName() != "")
-            {
-                logdbg << "JSONImporterTask: insertData: adding new data sources";
-
-                std::string data_source_var_name = parser_it.second.dataSourceVariableName();
-
-
-                // collect existing datasources
-                std::set <int> datasources_existing;
-                if (db_object.hasDataSources())
-                    for (auto ds_it = db_object.dsBegin(); ds_it != db_object.dsEnd(); ++ds_it)
-                        datasources_existing.insert(ds_it->first);
-
-                // getting key list and distinct values
-                assert (buffer->properties().hasProperty(data_source_var_name));
-                assert (buffer->properties().get(data_source_var_name).dataType() == PropertyDataType::INT);
-
-                assert(buffer->has<int>(data_source_var_name));
-                NullableVector<int>& data_source_key_list = buffer->get<int> (data_source_var_name);
-                std::set<int> data_source_keys = data_source_key_list.distinctValues();
-
-                std::map <int, std::pair<char, char>> sac_sics; // keyvar->(sac,sic)
-                // collect sac/sics
-                if (has_sac_sic)
-                {
-                    NullableVector<char>& sac_list = buffer->get<char> ("sac");
-                    NullableVector<char>& sic_list = buffer->get<char> ("sic");
-
-                    size_t size = buffer->size();
-                    int key_val;
-                    for (unsigned int cnt=0; cnt < size; ++cnt)
-                    {
-                        key_val = data_source_key_list.get(cnt);
-
-                        if (datasources_existing.count(key_val) != 0)
-                            continue;
-
-                        if (sac_sics.count(key_val) == 0)
-                        {
-                            logdbg << "JSONImporterTask: insertData: found new ds " << key_val << " for sac/sic";
-
-                            assert (!sac_list.isNull(cnt) && !sic_list.isNull(cnt));
-                            sac_sics[key_val] = std::pair<char, char> (sac_list.get(cnt), sic_list.get(cnt));
-
-                            loginf << "JSONImporterTask: insertData: source " << key_val
-                                   << " sac " << static_cast<int>(sac_list.get(cnt))
-                                   << " sic " << static_cast<int>(sic_list.get(cnt));
-                        }
-                    }
-
-                }
-
-                // adding datasources
-                std::map <int, std::pair<int,int>> datasources_to_add;
-
-                for (auto ds_key_it : data_source_keys)
-                    if (datasources_existing.count(ds_key_it) == 0 && added_data_sources_.count(ds_key_it) == 0)
-                    {
-                        if (datasources_to_add.count(ds_key_it) == 0)
-                        {
-                            logdbg << "JSONImporterTask: insertData: adding new data source " << ds_key_it;
-                            if (sac_sics.count(ds_key_it) == 0)
-                                datasources_to_add[ds_key_it] = {-1,-1};
-                            else
-                                datasources_to_add[ds_key_it] = {sac_sics.at(ds_key_it).first,
-                                                                 sac_sics.at(ds_key_it).second};
-
-                            added_data_sources_.insert(ds_key_it);
-                        }
-                    }
-
-                if (datasources_to_add.size())
-                {
-                    db_object.addDataSources(datasources_to_add);
-                }
-            }
-
-            logdbg << "JSONImporterTask: insertData: " << db_object.name() << " inserting";
+            logdbg << "JSONImporterTask: insertBatch: " << db_object.name() << " inserting";
 
             DBOVariableSet set = parser_it.second.variableList();
             db_object.insertData(set, buffer, false);
-            objects_inserted_ += buffer->size();
-
-            logdbg << "JSONImporterTask: insertData: " << db_object.name() << " clearing";
-            buffers_.erase(parser_it.second.dbObject().name());
         }
         else
-            logdbg << "JSONImporterTask: insertData: emtpy buffer for " << parser_it.second.dbObject().name();
+            logdbg << "JSONImporterTask: insertBatch: emtpy buffer for " << parser_it.second.dbObject().name();
     }
 
-    assert (buffers_.size() == 0);
-
-    logdbg << "JSONImporterTask: insertData: done";
+    logdbg << "JSONImporterTask: insertBatch: done";
 }
 
 void JSONImporterTask::checkAllDone ()
@@ -604,10 +534,10 @@ void JSONImporterTask::checkAllDone ()
 
     loginf << "JSONImporterTask: checkAllDone: all done " << all_done_ << " read " << (read_json_job_ == nullptr)
            << " parse jobs " << json_parse_jobs_.empty() << " map jobs " << json_map_jobs_.empty()
-           << " insert active " << (insert_active_ == 0);
+           << " insert queue " << insert_queue_.empty();
 
     if (!all_done_ && read_json_job_ == nullptr && json_parse_jobs_.size() == 0 && json_map_jobs_.size() == 0
-            && insert_active_ == 0)
+            && insert_queue_.empty())
     {
         stop_time_ = boost::posix_time::microsec_clock::local_time();
 
@@ -619,7 +549,9 @@ void JSONImporterTask::checkAllDone ()
         loginf << "JSONImporterTask: checkAllDone: read done after " << time_str;
 
         all_done_ = true;
-        assert (buffers_.size() == 0);
+
+        if (!test_)
+            ATSDB::instance().interface().endImport();
 
         QApplication::restoreOverrideCursor();
 
@@ -627,6 +559,8 @@ void JSONImporterTask::checkAllDone ()
 
         if (widget_)
             widget_->importDoneSlot(test_);
+
+        emit importDoneSignal();
     }
 
     logdbg << "JSONImporterTask: checkAllDone: done";
@@ -636,12 +570,6 @@ void JSONImporterTask::updateMsgBox ()
 {
     logdbg << "JSONImporterTask: updateMsgBox";
 
-    if (!msg_box_)
-    {
-        msg_box_ = new QMessageBox ();
-        assert (msg_box_);
-    }
-
     std::string msg;
 
     if (test_)
@@ -723,7 +651,16 @@ void JSONImporterTask::updateMsgBox ()
     msg += "Objects not mapped: "+std::to_string(objects_not_mapped_)+"\n\n";
 
     msg += "Objects created: "+std::to_string(objects_created_)+"\n";
-    msg += "Objects inserted: "+std::to_string(objects_inserted_)+"\n\n";
+    msg += "Objects inserted: "+std::to_string(objects_inserted_)+"\n";
+
+    if (!test_)
+    {
+        msg += "Insert queue depth: "+std::to_string(insert_queue_.depth())+" / "
+                +std::to_string(insert_queue_.maxDepth())+"\n";
+        msg += "DB write rate: "+std::to_string(static_cast<int>(insert_queue_.writeRate()))+" e/s\n";
+    }
+
+    msg += "\n";
 
     if (object_rate_str_.size())
         msg += "Object rate: "+object_rate_str_+" e/s";
@@ -731,6 +668,19 @@ void JSONImporterTask::updateMsgBox ()
     if (!all_done_ && remaining_time_str_.size())
         msg += "\nEstimated remaining time: "+remaining_time_str_;
 
+    if (ATSDB::instance().headless())
+    {
+        if (all_done_)
+            loginf << "JSONImporterTask: updateMsgBox: " << msg;
+        return;
+    }
+
+    if (!msg_box_)
+    {
+        msg_box_ = new QMessageBox ();
+        assert (msg_box_);
+    }
+
     msg_box_->setText(msg.c_str());
 
     if (all_done_)
@@ -751,7 +701,11 @@ void JSONImporterTask::insertProgressSlot (float percent)
 void JSONImporterTask::insertDoneSlot (DBObject& object)
 {
     logdbg << "JSONImporterTask: insertDoneSlot";
-    --insert_active_;
+
+    objects_inserted_ += insert_queue_.written(object.name());
+
+    if (!insert_queue_.writing()) // start next batch
+        insertData();
 
     checkAllDone();
     updateMsgBox();
@@ -22,6 +22,7 @@
 #include "json.hpp"
 #include "jsonparsingschema.h"
 #include "readjsonfilepartjob.h"
+#include "dboinsertqueue.h"
 
 #include <QObject>
 
@@ -42,6 +43,9 @@ class JSONImporterTask : public QObject, public Configurable
 
     using JSONParsingSchemaIterator = std::map<std::string, JSONParsingSchema>::iterator;
 
+signals:
+    void importDoneSignal ();
+
 public slots:
     void insertProgressSlot (float percent);
     void insertDoneSlot (DBObject& object);
@@ -96,11 +100,11 @@ protected:
     std::map <std::string, JSONParsingSchema> schemas_;
     size_t key_count_ {0};
 
-    size_t insert_active_ {0};
-
     std::set <int> added_data_sources_;
 
     std::shared_ptr <ReadJSONFilePartJob> read_json_job_;
+    /// Set if the read job is not restarted since the insert queue is full, restarted after a batch was popped
+    bool read_paused_ {false};
     std::vector<std::shared_ptr <JSONParseJob>> json_parse_jobs_;
     std::vector<std::shared_ptr <JSONMappingJob>> json_map_jobs_;
 
@@ -130,11 +134,15 @@ protected:
     std::string object_rate_str_;
     std::string remaining_time_str_;
 
-    std::map <std::string, std::shared_ptr<Buffer>> buffers_;
+    DBOInsertQueue insert_queue_;
 
     QMessageBox* msg_box_ {nullptr};
 
+    /// @brief Commits mapped buffers to the insert queue and starts writing the next batch if the writer is idle
     void insertData ();
+    /// @brief Restarts the paused read job if the insert queue has a free slot
+    void resumeRead ();
+    void insertBatch (DBOInsertQueue::Batch& batch);
 
     void checkAllDone ();
 
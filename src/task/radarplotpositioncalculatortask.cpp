@@ -20,21 +20,28 @@
 #include "dbodatasource.h"
 #include "dbobject.h"
 #include "dbobjectmanager.h"
+#include "dbinterface.h"
 #include "dbovariable.h"
 #include "dbovariableset.h"
+#include "dbtable.h"
 #include "dbtablecolumn.h"
 #include "radarplotpositioncalculatortask.h"
 #include "radarplotpositioncalculatortaskwidget.h"
+#include "jobmanager.h"
 #include "logger.h"
 #include "propertylist.h"
 #include "taskmanager.h"
 #include "projectionmanager.h"
+#include "projectioncontext.h"
 #include "stringconv.h"
+#include "updatebufferdbjob.h"
 
 #include <QCoreApplication>
 #include <QMessageBox>
 #include <QApplication>
 
+#include <algorithm>
+
 using namespace Utils;
 
 RadarPlotPositionCalculatorTask::RadarPlotPositionCalculatorTask(const std::string& class_id,
@@ -53,6 +60,8 @@ RadarPlotPositionCalculatorTask::RadarPlotPositionCalculatorTask(const std::stri
     registerParameter("altitude_var_str", &altitude_var_str_, "");
     registerParameter("latitude_var_str", &latitude_var_str_, "");
     registerParameter("longitude_var_str", &longitude_var_str_, "");
+    registerParameter("streaming", &streaming_, true);
+    registerParameter("read_chunk_size", &read_chunk_size_, 100000);
 }
 
 RadarPlotPositionCalculatorTask::~RadarPlotPositionCalculatorTask()
@@ -324,6 +333,11 @@ void RadarPlotPositionCalculatorTask::calculate ()
     QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
 
     num_loaded_=0;
+    num_processed_=0;
+    num_written_=0;
+    streaming_transformation_errors_=0;
+    loading_done_=false;
+    pending_update_buffer_=nullptr;
 
     if (db_object_str_.size())
     {
@@ -361,23 +375,55 @@ void RadarPlotPositionCalculatorTask::calculate ()
     assert (latitude_var_);
     assert (longitude_var_);
 
-    DBOVariableSet read_set;
-    read_set.add(*key_var_);
-    read_set.add(*datasource_var_);
-    read_set.add(*range_var_);
-    read_set.add(*azimuth_var_);
-    read_set.add(*altitude_var_);
-    read_set.add(*latitude_var_);
-    read_set.add(*longitude_var_);
+    read_set_.clear();
+    read_set_.add(*key_var_);
+    read_set_.add(*datasource_var_);
+    read_set_.add(*range_var_);
+    read_set_.add(*azimuth_var_);
+    read_set_.add(*altitude_var_);
+    read_set_.add(*latitude_var_);
+    read_set_.add(*longitude_var_);
 
     connect (db_object_, &DBObject::newDataSignal, this, &RadarPlotPositionCalculatorTask::newDataSlot);
     connect (db_object_, &DBObject::loadingDoneSignal, this, &RadarPlotPositionCalculatorTask::loadingDoneSlot);
 
-    db_object_->load (read_set, false, false, nullptr, false); //"0,100000"
+    if (streaming_)
+    {
+        has_last_key_ = false;
+        loadChunk();
+    }
+    else
+        db_object_->load (read_set_, false, false, nullptr, false); //"0,100000"
+}
+
+void RadarPlotPositionCalculatorTask::loadChunk ()
+{
+    std::string custom_filter_clause;
+
+    if (has_last_key_)
+    {
+        const DBTableColumn& key_column = key_var_->currentDBColumn();
+        custom_filter_clause = key_column.table().name()+"."+key_column.name()+" > "+std::to_string(last_key_);
+    }
+
+    chunk_loaded_ = 0;
+
+    logdbg << "RadarPlotPositionCalculatorTask: loadChunk: filter '" << custom_filter_clause << "' size "
+           << read_chunk_size_;
+
+    // queued after the update of the previous chunk, so the connection alternates between reading and writing
+    db_object_->load (read_set_, custom_filter_clause, {key_var_}, true, key_var_, true,
+                      std::to_string(std::max(read_chunk_size_, 1u)));
 }
 
 void RadarPlotPositionCalculatorTask::newDataSlot (DBObject& object)
 {
+    if (streaming_)
+    {
+        processChunk();
+        return;
+    }
+
     if (target_report_count_ != 0)
     {
         assert (msg_box_);
@@ -398,9 +444,41 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
     if (calculated_) // TODO: done signal comes twice?
         return;
 
+    if (streaming_)
+    {
+        if (db_object_->data()) // last part of the chunk
+            processChunk();
+
+        queuePendingUpdate();
+
+        if (chunk_loaded_ >= std::max(read_chunk_size_, 1u))
+        {
+            loadChunk();
+            return;
+        }
+    }
+
     disconnect (db_object_, &DBObject::newDataSignal, this, &RadarPlotPositionCalculatorTask::newDataSlot);
     disconnect (db_object_, &DBObject::loadingDoneSignal, this, &RadarPlotPositionCalculatorTask::loadingDoneSlot);
 
+    if (streaming_)
+    {
+        loading_done_ = true;
+
+        loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: streaming, " << update_jobs_.size()
+               << " chunk updates pending";
+
+        if (update_jobs_.empty())
+            streamingDone();
+        else
+        {
+            assert (msg_box_);
+            msg_box_->setText("Writing object data");
+        }
+
+        return;
+    }
+
     //
     //    std::pair<unsigned char, unsigned char> sac_sic_key;
     //
@@ -423,13 +501,99 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
 
     //    return;
 
+    std::shared_ptr<Buffer> read_buffer = db_object_->data();
+    assert (read_buffer->size());
+
+    size_t transformation_errors = 0;
+    num_processed_ = 0;
+
+    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: writing update_buffer";
+
+    std::shared_ptr<Buffer> update_buffer = calculatePositions (*read_buffer, transformation_errors);
+
+    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: update_buffer size " << update_buffer->size()
+           << ", " <<  transformation_errors << " transformation errors";
+
+    msg_box_->close();
+    delete msg_box_;
+    msg_box_ = nullptr;
+
+    if (!update_buffer->size())
+    {
+        std::string text = "There were "+std::to_string(transformation_errors)
+                +" skipped coordinates with transformation errors, no data available for insertion.";
+
+        logwrn << "RadarPlotPositionCalculatorTask: loadingDoneSlot: " << text;
+
+        if (!ATSDB::instance().headless())
+        {
+            QMessageBox msgBox;
+            msgBox.setText(text.c_str());
+            msgBox.exec();
+        }
+
+        calculated_ = true;
+        emit calculationDoneSignal();
+        return;
+    }
+
+    if (transformation_errors && !ATSDB::instance().headless()) // inserted without asking in batch mode
+    {
+        QApplication::restoreOverrideCursor();
+
+        QMessageBox::StandardButton reply;
+
+        std::string question = "There were "+std::to_string(transformation_errors)
+                +" skipped coordinates with transformation errors, "
+                +std::to_string(update_buffer->size())
+                +" coordinates were projected correctly. Do you want to insert the data?";
+
+        reply = QMessageBox::question(nullptr, "Insert Data", question.c_str(), QMessageBox::Yes|QMessageBox::No);
+
+        if (reply == QMessageBox::No)
+        {
+            loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: aborted by user because of errors";
+            calculated_ = true;
+            emit calculationDoneSignal();
+            return;
+        }
+
+        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    }
+
+    msg_box_ = new QMessageBox;
+    assert (msg_box_);
+    msg_box_->setWindowTitle("Calculating Radar Plot Positions");
+    msg_box_->setText("Writing object data");
+    msg_box_->setStandardButtons(QMessageBox::NoButton);
+    msg_box_->show();
+
+    DBOVariableSet list;
+    list.add(*latitude_var_);
+    list.add(*longitude_var_);
+    list.add(*key_var_);
+
+    db_object_->updateData(*key_var_, list, update_buffer);
+
+    connect (db_object_, &DBObject::updateDoneSignal, this, &RadarPlotPositionCalculatorTask::updateDoneSlot);
+    connect (db_object_, &DBObject::updateProgressSignal, this, &RadarPlotPositionCalculatorTask::updateProgressSlot);
+
+    calculated_ = true;
+    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: end";
+}
+
+std::shared_ptr<Buffer> RadarPlotPositionCalculatorTask::calculatePositions (Buffer& read_buffer,
+                                                                          size_t& transformation_errors)
+{
     ProjectionManager &proj_man = ProjectionManager::instance();
 
     bool use_ogr_proj = proj_man.useOGRProjection();
     bool use_sdl_proj = proj_man.useSDLProjection();
     bool use_rs2g_proj = proj_man.useRS2GProjection();
 
-    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: projection method sdl " << use_sdl_proj
+    ProjectionContext& proj_context = proj_man.context();
+
+    logdbg << "RadarPlotPositionCalculatorTask: calculatePositions: projection method sdl " << use_sdl_proj
            << " ogr " << use_ogr_proj << " rs2g " << use_rs2g_proj;
 
     assert (use_ogr_proj || use_sdl_proj || use_rs2g_proj);
@@ -437,9 +601,7 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
     for (auto ds_it = db_object_->dsBegin(); ds_it != db_object_->dsEnd(); ++ds_it)
         assert (ds_it->second.isFinalized()); // has to be done before
 
-    std::shared_ptr<Buffer> read_buffer = db_object_->data();
-    unsigned int read_size = read_buffer->size();
-    assert (read_size);
+    unsigned int read_size = read_buffer.size();
 
 //    std::string latitude_var_dbname = latitude_var_->currentDBColumn().name();
 //    std::string longitude_var_dbname = longitude_var_->currentDBColumn().name();
@@ -480,58 +642,55 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
     float done_percent;
     std::string msg;
 
-    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: writing update_buffer";
     bool ret;
 
-    size_t transformation_errors = 0;
-
     for (unsigned int cnt=0; cnt < read_size; cnt++)
     {
         if (cnt % 50000 == 0 && target_report_count_ != 0)
         {
-            done_percent = 100.0*cnt/target_report_count_;
+            done_percent = 100.0*(num_processed_+cnt)/target_report_count_;
             msg = "Processing object data: " + String::doubleToStringPrecision(done_percent, 2) + "%";
             msg_box_->setText(msg.c_str());
 
             QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         }
 
-        if (read_buffer->get<int>(key_var_str_).isNull(cnt))
+        if (read_buffer.get<int>(key_var_str_).isNull(cnt))
         {
-            logerr << "RadarPlotPositionCalculatorTask: loadingDoneSlot: key null";
+            logerr << "RadarPlotPositionCalculatorTask: calculatePositions: key null";
             continue;
         }
-        rec_num = read_buffer->get<int>(key_var_str_).get(cnt);
+        rec_num = read_buffer.get<int>(key_var_str_).get(cnt);
 
-        if (read_buffer->get<int>(datasource_var_str_).isNull(cnt))
+        if (read_buffer.get<int>(datasource_var_str_).isNull(cnt))
         {
-            logerr << "RadarPlotPositionCalculatorTask: loadingDoneSlot: data source null";
+            logerr << "RadarPlotPositionCalculatorTask: calculatePositions: data source null";
             continue;
         }
-        sensor_id = read_buffer->get<int>(datasource_var_str_).get(cnt);
+        sensor_id = read_buffer.get<int>(datasource_var_str_).get(cnt);
 
         //sac = *((unsigned char*)adresses->at(1));
         //sic = *((unsigned char*)adresses->at(2));
 
-        if (read_buffer->get<double>(azimuth_var_str_).isNull(cnt)
-                || read_buffer->get<double>(range_var_str_).isNull(cnt))
+        if (read_buffer.get<double>(azimuth_var_str_).isNull(cnt)
+                || read_buffer.get<double>(range_var_str_).isNull(cnt))
         {
-            logdbg << "RadarPlotPositionCalculatorTask: loadingDoneSlot: position null";
+            logdbg << "RadarPlotPositionCalculatorTask: calculatePositions: position null";
             continue;
         }
 
-        pos_azm_deg =  read_buffer->get<double>(azimuth_var_str_).get(cnt);
-        pos_range_nm =  read_buffer->get<double>(range_var_str_).get(cnt);
+        pos_azm_deg =  read_buffer.get<double>(azimuth_var_str_).get(cnt);
+        pos_range_nm =  read_buffer.get<double>(range_var_str_).get(cnt);
 
-        has_altitude = !read_buffer->get<int>(altitude_var_str_).isNull(cnt);
+        has_altitude = !read_buffer.get<int>(altitude_var_str_).isNull(cnt);
         if (has_altitude)
-            altitude_ft = read_buffer->get<int>(altitude_var_str_).get(cnt);
+            altitude_ft = read_buffer.get<int>(altitude_var_str_).get(cnt);
         else
             altitude_ft = 0.0; // has to assumed in projection later on
 
         if (!db_object_->hasDataSource(sensor_id))
         {
-            logerr << "RadarPlotPositionCalculatorTask: loadingDoneSlot: sensor id " << sensor_id << " unkown";
+            logerr << "RadarPlotPositionCalculatorTask: calculatePositions: sensor id " << sensor_id << " unkown";
             transformation_errors++;
             continue;
         }
@@ -555,7 +714,7 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
             ret = data_source.calculateOGRSystemCoordinates(pos_azm_rad, pos_range_m, has_altitude, altitude_ft,
                                                             sys_x, sys_y);
             if (ret)
-                ret = proj_man.ogrCart2Geo(sys_x, sys_y, lat, lon);
+                ret = proj_context.ogrCart2Geo(sys_x, sys_y, lat, lon);
         }
 
         if (use_sdl_proj)
@@ -567,7 +726,7 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
             {
                 t_GPos geo_pos;
 
-                ret = proj_man.sdlGRS2Geo(grs_pos, geo_pos);
+                ret = proj_context.sdlGRS2Geo(grs_pos, geo_pos);
 
                 if (ret)
                 {
@@ -622,69 +781,178 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot (DBObject& object)
         //loginf << "uga cnt " << update_cnt << " rec_num " << rec_num << " lat " << lat << " long " << lon;
     }
 
-    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: update_buffer size " << update_buffer->size()
-           << ", " <<  transformation_errors << " transformation errors";
+    num_processed_ += read_size;
 
-    msg_box_->close();
-    delete msg_box_;
-    msg_box_ = nullptr;
+    return update_buffer;
+}
 
-    if (!update_buffer->size())
-    {
-        std::string text = "There were "+std::to_string(transformation_errors)
-                +" skipped coordinates with transformation errors, no data available for insertion.";
+void RadarPlotPositionCalculatorTask::processChunk ()
+{
+    std::shared_ptr<Buffer> read_buffer = db_object_->data();
+    assert (read_buffer);
 
-        QMessageBox msgBox;
-        msgBox.setText(text.c_str());
-        msgBox.exec();
+    // detach the chunk first, events processed during calculation may deliver the next one into the object
+    db_object_->clearData();
 
-        calculated_ = true;
-        return;
-    }
+    num_loaded_ += read_buffer->size();
+    chunk_loaded_ += read_buffer->size();
 
-    if (transformation_errors)
+    // read ordered by key, so the last non-null key is the largest
+    NullableVector<int>& keys = read_buffer->get<int>(key_var_str_);
+    for (size_t cnt=read_buffer->size(); cnt > 0; --cnt)
     {
-        QApplication::restoreOverrideCursor();
+        if (!keys.isNull(cnt-1))
+        {
+            last_key_ = keys.get(cnt-1);
+            has_last_key_ = true;
+            break;
+        }
+    }
 
-        QMessageBox::StandardButton reply;
+    std::shared_ptr<Buffer> update_buffer = calculatePositions (*read_buffer, streaming_transformation_errors_);
 
-        std::string question = "There were "+std::to_string(transformation_errors)
-                +" skipped coordinates with transformation errors, "
-                +std::to_string(update_buffer->size())
-                +" coordinates were projected correctly. Do you want to insert the data?";
+    // drop the source chunk, only the much smaller update buffer is kept until written
+    read_buffer = nullptr;
 
-        reply = QMessageBox::question(nullptr, "Insert Data", question.c_str(), QMessageBox::Yes|QMessageBox::No);
+    logdbg << "RadarPlotPositionCalculatorTask: processChunk: loaded " << num_loaded_ << " update chunk size "
+           << update_buffer->size();
 
-        if (reply == QMessageBox::No)
-        {
-            loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: aborted by user because of errors";
-            calculated_ = true;
-            return;
-        }
+    if (update_buffer->size()) // collected until the chunk is read, at most read_chunk_size_ rows
+    {
+        if (pending_update_buffer_)
+            pending_update_buffer_->seizeBuffer(*update_buffer);
+        else
+            pending_update_buffer_ = update_buffer;
+    }
 
-        QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    if (target_report_count_ != 0)
+    {
+        assert (msg_box_);
+        float done_percent = 100.0*num_loaded_/target_report_count_;
+        std::string msg = "Processing object data: " + String::doubleToStringPrecision(done_percent, 2) + "%";
+        msg_box_->setText(msg.c_str());
+
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
     }
+}
 
-    msg_box_ = new QMessageBox;
-    assert (msg_box_);
-    msg_box_->setWindowTitle("Calculating Radar Plot Positions");
-    msg = "Writing object data";
-    msg_box_->setText(msg.c_str());
-    msg_box_->setStandardButtons(QMessageBox::NoButton);
-    msg_box_->show();
+void RadarPlotPositionCalculatorTask::queuePendingUpdate ()
+{
+    if (!pending_update_buffer_)
+        return;
 
+    queueUpdate (pending_update_buffer_);
+    pending_update_buffer_ = nullptr;
+}
+
+void RadarPlotPositionCalculatorTask::queueUpdate (std::shared_ptr<Buffer> update_buffer)
+{
     DBOVariableSet list;
     list.add(*latitude_var_);
     list.add(*longitude_var_);
     list.add(*key_var_);
 
-    db_object_->updateData(*key_var_, list, update_buffer);
+    DBInterface& db_interface = ATSDB::instance().interface();
 
-    connect (db_object_, &DBObject::updateDoneSignal, this, &RadarPlotPositionCalculatorTask::updateDoneSlot);
-    connect (db_object_, &DBObject::updateProgressSignal, this, &RadarPlotPositionCalculatorTask::updateProgressSlot);
+    if (!db_interface.checkUpdateBuffer(*db_object_, *key_var_, list, update_buffer))
+    {
+        logerr << "RadarPlotPositionCalculatorTask: queueUpdate: update buffer does not match the database";
+        throw std::runtime_error ("RadarPlotPositionCalculatorTask: queueUpdate: update buffer does not match the "
+                                  "database");
+    }
+
+    update_buffer->transformVariables(list, false); // back again
+
+    std::shared_ptr<UpdateBufferDBJob> job = std::make_shared<UpdateBufferDBJob> (db_interface, *db_object_,
+                                                                                  *key_var_, update_buffer);
+
+    connect (job.get(), &UpdateBufferDBJob::doneSignal, this, &RadarPlotPositionCalculatorTask::updateChunkDoneSlot,
+             Qt::QueuedConnection);
+
+    update_jobs_.push_back(job);
+
+    // db jobs share the connection and are run in order, written before the next chunk is read
+    JobManager::instance().addDBJob(job);
+}
+
+void RadarPlotPositionCalculatorTask::updateChunkDoneSlot ()
+{
+    UpdateBufferDBJob* sender = dynamic_cast <UpdateBufferDBJob*> (QObject::sender());
+    assert (sender);
+
+    auto job_it = std::find_if(update_jobs_.begin(), update_jobs_.end(),
+                               [sender] (const std::shared_ptr<UpdateBufferDBJob>& job)
+                               { return job.get() == sender; });
+    assert (job_it != update_jobs_.end());
+
+    num_written_ += sender->buffer()->size();
+    update_jobs_.erase(job_it);
+
+    logdbg << "RadarPlotPositionCalculatorTask: updateChunkDoneSlot: written " << num_written_ << ", "
+           << update_jobs_.size() << " chunk updates pending";
+
+    if (!loading_done_)
+        return;
+
+    if (update_jobs_.empty())
+    {
+        streamingDone();
+        return;
+    }
+
+    if (target_report_count_ != 0)
+    {
+        assert (msg_box_);
+        float done_percent = 100.0*num_written_/target_report_count_;
+        std::string msg = "Writing object data: " + String::doubleToStringPrecision(done_percent, 2) + "%";
+        msg_box_->setText(msg.c_str());
+    }
+}
+
+void RadarPlotPositionCalculatorTask::streamingDone ()
+{
+    loginf << "RadarPlotPositionCalculatorTask: streamingDone: processed " << num_processed_ << " written "
+           << num_written_ << ", " << streaming_transformation_errors_ << " transformation errors";
+
+    assert (update_jobs_.empty());
+    assert (!pending_update_buffer_);
 
     calculated_ = true;
-    loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: end";
+
+    db_object_->clearData();
+
+    assert (msg_box_);
+    msg_box_->close();
+    delete msg_box_;
+    msg_box_ = nullptr;
+
+    QApplication::restoreOverrideCursor();
+
+    if (!ATSDB::instance().headless())
+    {
+        std::string text = "Writing of object data done";
+
+        if (streaming_transformation_errors_)
+            text += ", there were "+std::to_string(streaming_transformation_errors_)
+                    +" skipped coordinates with transformation errors";
+
+        text += ".\nIt is recommended to force a post-processing step now.";
+
+        msg_box_ = new QMessageBox;
+        assert (msg_box_);
+        msg_box_->setWindowTitle("Calculating Radar Plot Positions");
+        msg_box_->setText(text.c_str());
+        msg_box_->setStandardButtons(QMessageBox::Ok);
+        msg_box_->exec();
+
+        delete msg_box_;
+        msg_box_ = nullptr;
+    }
+
+    if (widget_)
+        widget_->calculationDoneSlot();
+
+    emit calculationDoneSignal();
 }
 
 void RadarPlotPositionCalculatorTask::updateProgressSlot (float percent)
@@ -714,18 +982,23 @@ void RadarPlotPositionCalculatorTask::updateDoneSlot (DBObject& object)
 
     QApplication::restoreOverrideCursor();
 
-    msg_box_ = new QMessageBox;
-    assert (msg_box_);
-    msg_box_->setWindowTitle("Calculating Radar Plot Positions");
-    msg_box_->setText("Writing of object data done.\nIt is recommended to force a post-processing step now.");
-    msg_box_->setStandardButtons(QMessageBox::Ok);
-    msg_box_->exec();
+    if (!ATSDB::instance().headless())
+    {
+        msg_box_ = new QMessageBox;
+        assert (msg_box_);
+        msg_box_->setWindowTitle("Calculating Radar Plot Positions");
+        msg_box_->setText("Writing of object data done.\nIt is recommended to force a post-processing step now.");
+        msg_box_->setStandardButtons(QMessageBox::Ok);
+        msg_box_->exec();
 
-    delete msg_box_;
-    msg_box_ = nullptr;
+        delete msg_box_;
+        msg_box_ = nullptr;
+    }
 
     if (widget_)
         widget_->calculationDoneSlot();
+
+    emit calculationDoneSignal();
 }
 
 //void RadarPlotPositionCalculatorTask::updateBufferJobStatusSlot ()
@@ -20,8 +20,10 @@
 
 #include "configurable.h"
 #include "dbodatasource.h"
+#include "dbovariableset.h"
 
 #include <QObject>
+#include <list>
 #include <memory>
 
 class Buffer;
@@ -37,6 +39,9 @@ class RadarPlotPositionCalculatorTask : public QObject, public Configurable
 {
     Q_OBJECT
 
+signals:
+    void calculationDoneSignal ();
+
 public slots:
     //void newDataSlot (DBObject &object);
     void newDataSlot (DBObject& object);
@@ -44,6 +49,7 @@ public slots:
 
     void updateProgressSlot (float percent);
     void updateDoneSlot (DBObject& object);
+    void updateChunkDoneSlot ();
 
     //void updateBufferJobStatusSlot ();
 
@@ -85,6 +91,9 @@ public:
     std::string longitudeVarStr() const;
     void longitudeVarStr(const std::string& longitude_var_str);
 
+    bool streaming() const { return streaming_; }
+    void streaming(bool streaming) { streaming_ = streaming; }
+
 protected:
     std::string db_object_str_;
     DBObject* db_object_{nullptr};
@@ -112,6 +121,23 @@ protected:
 
     std::shared_ptr<UpdateBufferDBJob> job_ptr_;
 
+    /// read in bounded chunks ordered by key, process each one and queue its update, instead of all at the end.
+    /// db jobs share the connection and run in order, so the reads of the chunks are interleaved with their updates.
+    bool streaming_ {true};
+    bool loading_done_ {false};
+    /// maximum number of rows read per chunk when streaming
+    unsigned int read_chunk_size_ {100000};
+    DBOVariableSet read_set_;
+    /// key of the last read row, the next chunk starts after it
+    int last_key_ {0};
+    bool has_last_key_ {false};
+    size_t chunk_loaded_ {0};
+    std::list<std::shared_ptr<UpdateBufferDBJob>> update_jobs_;
+    std::shared_ptr<Buffer> pending_update_buffer_;
+    size_t num_processed_ {0};
+    size_t num_written_ {0};
+    size_t streaming_transformation_errors_ {0};
+
     bool calculating_ {false};
     bool calculated_ {false};
 
@@ -123,6 +149,16 @@ protected:
     size_t target_report_count_{0};
 
     void checkAndSetVariable (std::string &name_str, DBOVariable** var);
+
+    /// @brief Returns buffer with calculated positions and keys of all rows of read_buffer
+    std::shared_ptr<Buffer> calculatePositions (Buffer& read_buffer, size_t& transformation_errors);
+    /// @brief Loads the next chunk of at most read_chunk_size_ rows following the last key
+    void loadChunk ();
+    /// @brief Calculates positions of the currently loaded data, collects its update and drops the data
+    void processChunk ();
+    void queuePendingUpdate ();
+    void queueUpdate (std::shared_ptr<Buffer> update_buffer);
+    void streamingDone ();
 };
 
 #endif /* RADARPLOTPOSITIONCALCULATOR_H_ */
@@ -19,6 +19,8 @@
 #include "taskmanager.h"
 #include "jsonimportertask.h"
 #include "jsonimportertaskwidget.h"
+#include "csvimportertask.h"
+#include "csvimportertaskwidget.h"
 #include "radarplotpositioncalculatortask.h"
 #include "radarplotpositioncalculatortaskwidget.h"
 #include "createartasassociationstask.h"
@@ -40,6 +42,7 @@ TaskManager::TaskManager(const std::string &class_id, const std::string &instanc
 TaskManager::~TaskManager()
 {
     assert (!json_importer_task_);
+    assert (!csv_importer_task_);
     assert (!radar_plot_position_calculator_task_);
 
 #if USE_JASTERIX
@@ -53,6 +56,12 @@ JSONImporterTask* TaskManager::getJSONImporterTask()
     return json_importer_task_;
 }
 
+CSVImporterTask* TaskManager::getCSVImporterTask()
+{
+    assert (csv_importer_task_);
+    return csv_importer_task_;
+}
+
 RadarPlotPositionCalculatorTask* TaskManager::getRadarPlotPositionCalculatorTask()
 {
     assert (radar_plot_position_calculator_task_);
@@ -81,6 +90,12 @@ void TaskManager::generateSubConfigurable (const std::string &class_id, const st
         json_importer_task_ = new JSONImporterTask (class_id, instance_id, this);
         assert (json_importer_task_);
     }
+    else if (class_id.compare ("CSVImporterTask") == 0)
+    {
+        assert (!csv_importer_task_);
+        csv_importer_task_ = new CSVImporterTask (class_id, instance_id, this);
+        assert (csv_importer_task_);
+    }
     else if (class_id.compare ("RadarPlotPositionCalculatorTask") == 0)
     {
         assert (!radar_plot_position_calculator_task_);
@@ -113,6 +128,12 @@ void TaskManager::checkSubConfigurables ()
         assert (json_importer_task_);
     }
 
+    if (!csv_importer_task_)
+    {
+        csv_importer_task_ = new CSVImporterTask ("CSVImporterTask", "CSVImporterTask0", this);
+        assert (csv_importer_task_);
+    }
+
     if (!radar_plot_position_calculator_task_)
     {
         radar_plot_position_calculator_task_ = new RadarPlotPositionCalculatorTask (
@@ -142,6 +163,9 @@ void TaskManager::disable ()
     if (json_importer_task_ && json_importer_task_->hasOpenWidget())
         json_importer_task_->widget()->close();
 
+    if (csv_importer_task_ && csv_importer_task_->hasOpenWidget())
+        csv_importer_task_->widget()->close();
+
     if (radar_plot_position_calculator_task_ && radar_plot_position_calculator_task_->hasOpenWidget())
         radar_plot_position_calculator_task_->widget()->close();
 
@@ -165,6 +189,12 @@ void TaskManager::shutdown ()
         json_importer_task_ = nullptr;
     }
 
+    if (csv_importer_task_)
+    {
+        delete csv_importer_task_;
+        csv_importer_task_ = nullptr;
+    }
+
     if (radar_plot_position_calculator_task_)
     {
         delete radar_plot_position_calculator_task_;
@@ -24,6 +24,7 @@
 
 class ATSDB;
 class CreateARTASAssociationsTask;
+class CSVImporterTask;
 class JSONImporterTask;
 class RadarPlotPositionCalculatorTask;
 
@@ -39,6 +40,7 @@ public:
     virtual ~TaskManager();
 
     JSONImporterTask* getJSONImporterTask();
+    CSVImporterTask* getCSVImporterTask();
     RadarPlotPositionCalculatorTask* getRadarPlotPositionCalculatorTask();
     CreateARTASAssociationsTask* getCreateARTASAssociationsTask();
 
@@ -53,6 +55,7 @@ public:
 
 protected:
     JSONImporterTask* json_importer_task_ {nullptr};
+    CSVImporterTask* csv_importer_task_ {nullptr};
     RadarPlotPositionCalculatorTask* radar_plot_position_calculator_task_ {nullptr};
     CreateARTASAssociationsTask* create_artas_associations_task_{nullptr};
 
@@ -0,0 +1,96 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "asterixblockscanner.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+
+namespace Utils
+{
+
+std::vector<ASTERIXBlockScanner::Range> ASTERIXBlockScanner::scan (const std::string& filename, size_t range_size)
+{
+    assert (range_size);
+
+    std::ifstream file (filename, std::ios::binary | std::ios::ate);
+
+    if (!file)
+        throw std::runtime_error ("ASTERIXBlockScanner: scan: unable to open file '"+filename+"'");
+
+    const size_t file_size = file.tellg();
+    const size_t header_size = 3; // category and length
+
+    std::vector<Range> ranges;
+
+    // headers are read through a window, blocks are mostly much smaller than the window
+    std::vector<unsigned char> window (1024*1024);
+    size_t window_offset {0};
+    size_t window_size {0};
+
+    size_t range_offset {0};
+    size_t block_offset {0};
+    size_t num_blocks {0};
+
+    while (block_offset + header_size <= file_size)
+    {
+        if (block_offset + header_size > window_offset + window_size)
+        {
+            window_offset = block_offset;
+            window_size = std::min(window.size(), file_size - window_offset);
+
+            file.seekg(window_offset);
+            file.read(reinterpret_cast<char*>(window.data()), window_size);
+
+            if (!file)
+                throw std::runtime_error ("ASTERIXBlockScanner: scan: read error in file '"+filename+"'");
+        }
+
+        const unsigned char* header = &window[block_offset - window_offset];
+        size_t block_size = (header[1] << 8) | header[2];
+
+        if (block_size < header_size || block_offset + block_size > file_size)
+        {
+            logwrn << "ASTERIXBlockScanner: scan: invalid block length " << block_size << " at offset "
+                   << block_offset << " in '" << filename << "', remaining data is kept in one range";
+            break;
+        }
+
+        block_offset += block_size;
+        ++num_blocks;
+
+        if (block_offset - range_offset >= range_size)
+        {
+            ranges.emplace_back(range_offset, block_offset - range_offset);
+            range_offset = block_offset;
+        }
+    }
+
+    if (range_offset < file_size)
+        ranges.emplace_back(range_offset, file_size - range_offset);
+
+    loginf << "ASTERIXBlockScanner: scan: file '" << filename << "' size " << file_size << " blocks " << num_blocks
+           << " ranges " << ranges.size();
+
+    return ranges;
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ASTERIXBLOCKSCANNER_H
+#define ASTERIXBLOCKSCANNER_H
+
+#include <string>
+#include <vector>
+
+namespace Utils
+{
+
+/**
+ * @brief Splits unframed ASTERIX files into byte ranges at data block boundaries
+ *
+ * Each data block starts with a one byte category and a two byte big-endian length, which includes the header. Block
+ * boundaries are therefore found by reading only the block headers, and each range contains whole data blocks, so
+ * ranges can be decoded independently. If an invalid length is found, the rest of the file is put into the last
+ * range, where the decoder reports the error as it would for the whole file.
+ */
+class ASTERIXBlockScanner
+{
+public:
+    struct Range
+    {
+        Range (size_t offset, size_t size) : offset_(offset), size_(size) {}
+
+        size_t offset_;
+        size_t size_;
+    };
+
+    /// @brief Returns ranges of at least range_size bytes each (except the last one), throws if file is not readable
+    static std::vector<Range> scan (const std::string& filename, size_t range_size);
+};
+
+}
+
+#endif // ASTERIXBLOCKSCANNER_H
@@ -0,0 +1,137 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "datagramrecording.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace Utils
+{
+
+namespace
+{
+    template <typename T> void writeLE (std::ofstream& file, T value)
+    {
+        char bytes[sizeof(T)];
+
+        for (size_t cnt=0; cnt < sizeof(T); ++cnt)
+            bytes[cnt] = static_cast<char>((value >> (8*cnt)) & 0xFF);
+
+        file.write(bytes, sizeof(T));
+    }
+
+    template <typename T> bool readLE (std::ifstream& file, T& value)
+    {
+        unsigned char bytes[sizeof(T)];
+
+        if (!file.read(reinterpret_cast<char*>(bytes), sizeof(T)))
+            return false;
+
+        value = 0;
+
+        for (size_t cnt=0; cnt < sizeof(T); ++cnt)
+            value |= static_cast<T>(bytes[cnt]) << (8*cnt);
+
+        return true;
+    }
+}
+
+namespace DatagramRecording
+{
+    bool isRecording (const std::string& filename)
+    {
+        std::ifstream file (filename, std::ios::binary);
+
+        char file_magic[sizeof(magic)-1];
+
+        if (!file.read(file_magic, sizeof(file_magic)))
+            return false;
+
+        return std::memcmp(file_magic, magic, sizeof(file_magic)) == 0;
+    }
+}
+
+DatagramRecordingWriter::DatagramRecordingWriter (const std::string& filename)
+    : filename_(filename), file_(filename, std::ios::binary | std::ios::trunc)
+{
+    if (!file_)
+        throw std::runtime_error ("DatagramRecordingWriter: unable to open file '"+filename_+"'");
+
+    file_.write(DatagramRecording::magic, sizeof(DatagramRecording::magic)-1);
+    writeLE<uint32_t>(file_, DatagramRecording::version);
+}
+
+void DatagramRecordingWriter::write (uint64_t time_us, const char* data, uint32_t size)
+{
+    assert (data || !size);
+
+    writeLE<uint64_t>(file_, time_us);
+    writeLE<uint32_t>(file_, size);
+    file_.write(data, size);
+
+    if (!file_)
+        throw std::runtime_error ("DatagramRecordingWriter: write to file '"+filename_+"' failed");
+
+    ++num_datagrams_;
+}
+
+void DatagramRecordingWriter::flush ()
+{
+    file_.flush();
+}
+
+DatagramRecordingReader::DatagramRecordingReader (const std::string& filename)
+    : filename_(filename), file_(filename, std::ios::binary)
+{
+    if (!file_)
+        throw std::runtime_error ("DatagramRecordingReader: unable to open file '"+filename_+"'");
+
+    char file_magic[sizeof(DatagramRecording::magic)-1];
+    uint32_t file_version;
+
+    if (!file_.read(file_magic, sizeof(file_magic))
+            || std::memcmp(file_magic, DatagramRecording::magic, sizeof(file_magic)) != 0
+            || !readLE<uint32_t>(file_, file_version))
+        throw std::runtime_error ("DatagramRecordingReader: file '"+filename_+"' is no datagram recording");
+
+    if (file_version != DatagramRecording::version)
+        throw std::runtime_error ("DatagramRecordingReader: file '"+filename_+"' has unsupported version "
+                                  +std::to_string(file_version));
+}
+
+bool DatagramRecordingReader::next (uint64_t& time_us, std::vector<char>& data)
+{
+    if (!readLE<uint64_t>(file_, time_us))
+        return false;
+
+    uint32_t size;
+
+    if (!readLE<uint32_t>(file_, size))
+        throw std::runtime_error ("DatagramRecordingReader: file '"+filename_+"' is truncated");
+
+    data.resize(size);
+
+    if (size && !file_.read(data.data(), size))
+        throw std::runtime_error ("DatagramRecordingReader: file '"+filename_+"' is truncated");
+
+    return true;
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DATAGRAMRECORDING_H
+#define DATAGRAMRECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Utils
+{
+
+/**
+ * @brief Recording of received network datagrams with their receive times
+ *
+ * The file starts with the magic "ATSDBDGR" and a 32-bit version, followed by the datagrams, each stored as
+ * 64-bit receive time in microseconds since epoch, 32-bit size and the payload. All numbers are little-endian.
+ */
+namespace DatagramRecording
+{
+    const char magic[] = "ATSDBDGR";
+    const uint32_t version = 1;
+
+    /// @brief Returns if the given file starts with the recording magic
+    bool isRecording (const std::string& filename);
+}
+
+class DatagramRecordingWriter
+{
+public:
+    /// @brief Constructor, creates or truncates the given file, throws on errors
+    DatagramRecordingWriter (const std::string& filename);
+    virtual ~DatagramRecordingWriter() {}
+
+    void write (uint64_t time_us, const char* data, uint32_t size);
+    void flush ();
+
+    size_t numDatagrams () const { return num_datagrams_; }
+
+protected:
+    std::string filename_;
+    std::ofstream file_;
+    size_t num_datagrams_ {0};
+};
+
+class DatagramRecordingReader
+{
+public:
+    /// @brief Constructor, throws if the file can not be opened or is no recording
+    DatagramRecordingReader (const std::string& filename);
+    virtual ~DatagramRecordingReader() {}
+
+    /// @brief Reads next datagram, returns false at end of file, throws on truncated files
+    bool next (uint64_t& time_us, std::vector<char>& data);
+
+protected:
+    std::string filename_;
+    std::ifstream file_;
+};
+
+}
+
+#endif // DATAGRAMRECORDING_H
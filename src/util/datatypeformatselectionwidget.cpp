@@ -104,5 +104,5 @@ void DataTypeFormatSelectionWidget::triggerSlot( QAction* action )
         setText ("");
     }
 
-    //  emit selectionChanged();
+    emit selectionChanged();
 }
@@ -20,6 +20,10 @@ protected slots:
     /// @brief Shows the context menu
     void showMenuSlot();
 
+signals:
+    /// @brief Signal if format was changed
+    void selectionChanged();
+
 public:
     /// @brief Constructor, references directly used
     DataTypeFormatSelectionWidget (std::string& data_type_str, Format& format);
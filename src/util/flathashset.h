@@ -0,0 +1,148 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FLATHASHSET_H
+#define FLATHASHSET_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Utils
+{
+
+/**
+ * @brief Open-addressing hash set for integral values
+ *
+ * Values are stored in a flat power-of-two sized array with linear probing, so that collecting the distinct values
+ * of a large column needs neither a node allocation nor a pointer chase per element. Meant for few distinct values
+ * in many rows, e.g. data source keys.
+ */
+template <typename T>
+class FlatHashSet
+{
+    static_assert (std::is_integral<T>::value, "FlatHashSet only supports integral values");
+
+public:
+    explicit FlatHashSet (size_t expected_size=16)
+    {
+        size_t capacity = 16;
+        while (capacity < 2*expected_size)
+            capacity *= 2;
+
+        allocate(capacity);
+    }
+
+    /// @brief Inserts value, returns true if it was not contained before
+    bool insert (T value)
+    {
+        size_t index = find(value);
+
+        if (used_[index])
+            return false;
+
+        if (2*(size_+1) > values_.size()) // keep load factor at most 0.5
+        {
+            grow();
+            index = find(value);
+        }
+
+        values_[index] = value;
+        used_[index] = true;
+        ++size_;
+
+        return true;
+    }
+
+    bool contains (T value) const { return used_[find(value)]; }
+
+    size_t size () const { return size_; }
+    bool empty () const { return !size_; }
+
+    void clear ()
+    {
+        std::fill(used_.begin(), used_.end(), 0);
+        size_ = 0;
+    }
+
+    /// @brief Returns all contained values in unspecified order
+    std::vector<T> values () const
+    {
+        std::vector<T> values;
+        values.reserve(size_);
+
+        for (size_t cnt=0; cnt < values_.size(); ++cnt)
+            if (used_[cnt])
+                values.push_back(values_[cnt]);
+
+        return values;
+    }
+
+private:
+    std::vector<T> values_;
+    std::vector<unsigned char> used_;
+    size_t mask_ {0};
+    size_t size_ {0};
+
+    void allocate (size_t capacity)
+    {
+        assert (capacity && !(capacity & (capacity-1)));
+
+        values_.assign(capacity, T());
+        used_.assign(capacity, 0);
+        mask_ = capacity-1;
+        size_ = 0;
+    }
+
+    size_t find (T value) const
+    {
+        // fibonacci hashing, spreads consecutive keys over the table
+        uint64_t hash = static_cast<uint64_t>(value) * 0x9E3779B97F4A7C15ull;
+        size_t index = static_cast<size_t>(hash ^ (hash >> 32)) & mask_;
+
+        while (used_[index] && values_[index] != value)
+            index = (index+1) & mask_;
+
+        return index;
+    }
+
+    void grow ()
+    {
+        std::vector<T> old_values = std::move(values_);
+        std::vector<unsigned char> old_used = std::move(used_);
+
+        allocate(2*old_values.size());
+
+        for (size_t cnt=0; cnt < old_values.size(); ++cnt)
+        {
+            if (old_used[cnt])
+            {
+                size_t index = find(old_values[cnt]);
+                values_[index] = old_values[cnt];
+                used_[index] = true;
+                ++size_;
+            }
+        }
+    }
+};
+
+}
+
+#endif // FLATHASHSET_H
@@ -12,12 +12,15 @@ const std::map<PropertyDataType, std::vector<std::string>> Format::format_option
     {PropertyDataType::BOOL,       no_format},
     {PropertyDataType::CHAR,       integer_formats},
     {PropertyDataType::UCHAR,      integer_formats},
+    {PropertyDataType::SHORTINT,   integer_formats},
+    {PropertyDataType::USHORTINT,  integer_formats},
     {PropertyDataType::INT,        integer_formats},
     {PropertyDataType::UINT,       integer_formats},
     {PropertyDataType::LONGINT,    integer_formats},
     {PropertyDataType::ULONGINT,   integer_formats},
     {PropertyDataType::FLOAT,      no_format},
     {PropertyDataType::DOUBLE,     no_format},
+    {PropertyDataType::TIMESTAMP,  {"", "epoch_tod_ms", "epoch_tod_s"}},
     {PropertyDataType::STRING,     {"", "decimal", "hexadecimal", "octal", "epoch_tod_ms", "epoch_tod_s"}}};
 
 void Format::set(PropertyDataType data_type, const std::string& value)
@@ -28,4 +31,24 @@ void Format::set(PropertyDataType data_type, const std::string& value)
     assert (std::find(format_options_.at(data_type).begin(), format_options_.at(data_type).end(), value)
                       != format_options_.at(data_type).end());
     std::string::operator =(value);
+    type_ = typeFromString(value);
+}
+
+Format::Type Format::typeFromString (const std::string& value)
+{
+    if (value == "")
+        return Type::NONE;
+    else if (value == "decimal")
+        return Type::DECIMAL;
+    else if (value == "hexadecimal")
+        return Type::HEXADECIMAL;
+    else if (value == "octal")
+        return Type::OCTAL;
+    else if (value == "epoch_tod_ms")
+        return Type::EPOCH_TOD_MS;
+    else if (value == "epoch_tod_s")
+        return Type::EPOCH_TOD_S;
+
+    logerr << "Format: typeFromString: unknown format '" << value << "'";
+    throw std::runtime_error ("Format: typeFromString: unknown format '"+value+"'");
 }
@@ -10,17 +10,25 @@
 class Format : public std::string
 {
 public:
+    /// @brief Format type, resolved from the format name once when set
+    enum class Type { NONE, DECIMAL, HEXADECIMAL, OCTAL, EPOCH_TOD_MS, EPOCH_TOD_S };
+
     Format () = default;
     Format (PropertyDataType data_type, const std::string& value) { set (data_type, value); }
 
     void set(PropertyDataType data_type, const std::string& value);
 
+    Type type () const { return type_; }
+    static Type typeFromString (const std::string& value);
+
     const std::vector<std::string>& getFormatOptions (PropertyDataType data_type) {
         return format_options_.at(data_type); }
 
     const std::map<PropertyDataType, std::vector<std::string>>& getAllFormatOptions () { return format_options_; }
 
 private:
+    Type type_ {Type::NONE};
+
     static const std::map<PropertyDataType, std::vector<std::string>> format_options_;
 };
 
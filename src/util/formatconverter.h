@@ -0,0 +1,185 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FORMATCONVERTER_H
+#define FORMATCONVERTER_H
+
+#include <string>
+#include <stdexcept>
+
+#include "format.h"
+#include "stringconv.h"
+
+namespace Utils
+{
+
+/**
+ * @brief Allocation-free conversion kernels for value formats
+ *
+ * One kernel per Format::Type, each converting either an integer or a string value, so the format can be selected
+ * once (see Format::type) and values converted without name comparisons, date-time objects or temporary strings.
+ */
+namespace FormatConverter
+{
+
+const long long MS_PER_DAY = 86400000;
+
+/// @brief Returns decimal digits of value interpreted in base, up to the first digit invalid in base
+inline long long digitsInBase (long long value, unsigned int base)
+{
+    bool negative = value < 0;
+    unsigned long long decimal = negative ? -value : value;
+
+    unsigned char digits[20];
+    size_t num_digits = 0;
+
+    do
+    {
+        digits[num_digits++] = decimal % 10;
+        decimal /= 10;
+    } while (decimal);
+
+    long long result = 0;
+
+    while (num_digits)
+    {
+        --num_digits;
+
+        if (digits[num_digits] >= base)
+            break;
+
+        result = result*base + digits[num_digits];
+    }
+
+    return negative ? -result : result;
+}
+
+/// @brief Returns UTC time of day in seconds from milliseconds since epoch
+inline double todFromEpochMS (long long epoch_ms)
+{
+    long long tod_ms = epoch_ms % MS_PER_DAY;
+
+    if (tod_ms < 0)
+        tod_ms += MS_PER_DAY;
+
+    return tod_ms / 1000.0;
+}
+
+/// @brief Returns UTC time of day in seconds from seconds since epoch
+inline double todFromEpochS (long long epoch_s)
+{
+    return todFromEpochMS (epoch_s * 1000);
+}
+
+template <Format::Type F> struct Kernel;
+
+template <> struct Kernel<Format::Type::DECIMAL>
+{
+    typedef long long Result;
+    static Result fromInteger (long long value) { return value; }
+    static Result fromString (const char* first, const char* last)
+    {
+        return String::integerFromString(first, last, 10);
+    }
+};
+
+template <> struct Kernel<Format::Type::HEXADECIMAL>
+{
+    typedef long long Result;
+    static Result fromInteger (long long value) { return digitsInBase(value, 16); }
+    static Result fromString (const char* first, const char* last)
+    {
+        return String::integerFromString(first, last, 16);
+    }
+};
+
+template <> struct Kernel<Format::Type::OCTAL>
+{
+    typedef long long Result;
+    static Result fromInteger (long long value) { return digitsInBase(value, 8); }
+    static Result fromString (const char* first, const char* last)
+    {
+        return String::integerFromString(first, last, 8);
+    }
+};
+
+template <> struct Kernel<Format::Type::EPOCH_TOD_MS>
+{
+    typedef double Result;
+    static Result fromInteger (long long value) { return todFromEpochMS(value); }
+    static Result fromString (const char* first, const char* last)
+    {
+        return todFromEpochMS(String::integerFromString(first, last, 10));
+    }
+};
+
+template <> struct Kernel<Format::Type::EPOCH_TOD_S>
+{
+    typedef double Result;
+    static Result fromInteger (long long value) { return todFromEpochS(value); }
+    static Result fromString (const char* first, const char* last)
+    {
+        return todFromEpochS(String::integerFromString(first, last, 10));
+    }
+};
+
+/// @brief Converts kernel results to the buffer data types
+template <typename T> struct Cast
+{
+    template <typename R> static T from (R value) { return static_cast<T> (value); }
+};
+
+template <> struct Cast<std::string>
+{
+    template <typename R> static std::string from (R value) { return String::getValueString(value); }
+};
+
+/// @brief Timestamp kernel results are seconds
+template <> struct Cast<Timestamp>
+{
+    template <typename R> static Timestamp from (R value) { return Timestamp (static_cast<double> (value)); }
+};
+
+/// @brief Returns value converted from string in given format
+template <typename T> T fromString (Format::Type type, const std::string& value_str)
+{
+    const char* first = value_str.data();
+    const char* last = first + value_str.size();
+
+    switch (type)
+    {
+    case Format::Type::DECIMAL:
+        return Cast<T>::from(Kernel<Format::Type::DECIMAL>::fromString(first, last));
+    case Format::Type::HEXADECIMAL:
+        return Cast<T>::from(Kernel<Format::Type::HEXADECIMAL>::fromString(first, last));
+    case Format::Type::OCTAL:
+        return Cast<T>::from(Kernel<Format::Type::OCTAL>::fromString(first, last));
+    case Format::Type::EPOCH_TOD_MS:
+        return Cast<T>::from(Kernel<Format::Type::EPOCH_TOD_MS>::fromString(first, last));
+    case Format::Type::EPOCH_TOD_S:
+        return Cast<T>::from(Kernel<Format::Type::EPOCH_TOD_S>::fromString(first, last));
+    default:
+        throw std::runtime_error ("FormatConverter: fromString: no conversion for format type "
+                                  +std::to_string(static_cast<int> (type)));
+    }
+}
+
+}
+
+}
+
+#endif // FORMATCONVERTER_H
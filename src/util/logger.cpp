@@ -15,21 +15,35 @@
  * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <iostream>
+
 #include "log4cpp/FileAppender.hh"
 #include "log4cpp/OstreamAppender.hh"
 #include "log4cpp/Layout.hh"
 #include "log4cpp/BasicLayout.hh"
 #include "log4cpp/Priority.hh"
+#include "log4cpp/LoggingEvent.hh"
 #include "log4cpp/PropertyConfigurator.hh"
 
 #include "logger.h"
+#include "logrecordqueue.h"
 #include "config.h"
 
 //#define LOGGER_FIXED_LEVEL logINFO
 
+const size_t LOG_QUEUE_CAPACITY = 16384;
+const unsigned int LOG_DEFAULT_RATE_LIMIT = 0; // records per second per log statement, 0 for unlimited
+const std::chrono::milliseconds LOG_WRITER_PERIOD (20);
+
+std::atomic<int> Logger::levels_[MAX_MODULES];
+std::atomic<unsigned int> Logger::rate_limit_ {LOG_DEFAULT_RATE_LIMIT};
+
 Logger::Logger()
-: console_appender_(0), file_appender_(0)
+: console_appender_(0), file_appender_(0), queue_(new LogRecordQueue(LOG_QUEUE_CAPACITY))
 {
+  // construct log4cpp hierarchy first, so that it is destroyed after the logger
+  log4cpp::Category::getRoot();
 }
 
 void Logger::init (const std::string &log_config_filename)
@@ -48,10 +62,148 @@ void Logger::init (const std::string &log_config_filename)
 #else
   log4cpp::PropertyConfigurator::configure(log_config_filename);
 #endif
+
+  if (!writer_running_)
+  {
+    writer_running_ = true;
+    writer_thread_ = std::thread (&Logger::writerLoop, this);
+  }
+}
+
+void Logger::flush ()
+{
+  std::lock_guard<std::mutex> lock (write_mutex_);
+  writeQueued();
+}
+
+void Logger::shutdown ()
+{
+  if (writer_running_)
+  {
+    {
+      std::lock_guard<std::mutex> lock (writer_mutex_);
+      writer_running_ = false;
+    }
+    writer_condition_.notify_one();
+    writer_thread_.join();
+  }
+
+  flush();
+}
+
+void Logger::log (LogRecord& record)
+{
+  if (writer_running_ && record.priority_ > log4cpp::Priority::ERROR && queue_->push(record))
+    return;
+
+  // errors, full queue or no writer thread: write queued records and this one on the calling thread
+  std::lock_guard<std::mutex> lock (write_mutex_);
+  writeQueued();
+  write(record.priority_, record.time_stamp_, record.message());
+}
+
+void Logger::writerLoop ()
+{
+  while (writer_running_)
+  {
+    {
+      std::lock_guard<std::mutex> lock (write_mutex_);
+      writeQueued();
+    }
+
+    std::unique_lock<std::mutex> lock (writer_mutex_);
+    writer_condition_.wait_for(lock, LOG_WRITER_PERIOD, [this] { return !writer_running_; });
+  }
+}
+
+void Logger::writeQueued ()
+{
+  LogRecord record;
+
+  while (queue_->pop(record))
+    write(record.priority_, record.time_stamp_, record.message());
+}
+
+void Logger::write (int priority, const log4cpp::TimeStamp& time_stamp, const std::string& message)
+{
+  log4cpp::Category& root = log4cpp::Category::getRoot();
+
+  if (!root.isPriorityEnabled(priority))
+    return;
+
+  log4cpp::LoggingEvent event (root.getName(), message, "", priority);
+  event.timeStamp = time_stamp;
+
+  root.callAppenders(event);
+}
+
+unsigned int Logger::moduleIndex (const std::string& module)
+{
+  std::lock_guard<std::mutex> lock (modules_mutex_);
+
+  for (unsigned int cnt=0; cnt < modules_.size(); ++cnt)
+    if (modules_.at(cnt) == module)
+      return cnt;
+
+  if (modules_.size() == MAX_MODULES)
+  {
+    std::cerr << "Logger: moduleIndex: too many modules, '" << module << "' shares last module" << std::endl;
+    return MAX_MODULES-1;
+  }
+
+  levels_[modules_.size()].store(default_level_, std::memory_order_relaxed);
+  modules_.push_back(module);
+
+  return modules_.size()-1;
+}
+
+std::vector<std::string> Logger::modules ()
+{
+  std::lock_guard<std::mutex> lock (modules_mutex_);
+  return modules_;
+}
+
+void Logger::level (const std::string& module, int priority)
+{
+  if (!module.size())
+  {
+    std::lock_guard<std::mutex> lock (modules_mutex_);
+
+    default_level_ = priority;
+
+    for (unsigned int cnt=0; cnt < modules_.size(); ++cnt)
+      levels_[cnt].store(priority, std::memory_order_relaxed);
+  }
+  else
+    levels_[moduleIndex(module)].store(priority, std::memory_order_relaxed);
+
+  loginf << "Logger: level: module '" << module << "' level " << log4cpp::Priority::getPriorityName(priority);
+}
+
+void Logger::levels (const std::vector<std::string>& definitions)
+{
+  for (auto& def_it : definitions)
+  {
+    size_t pos = def_it.find('=');
+
+    if (pos == std::string::npos)
+      level ("", log4cpp::Priority::getPriorityValue(def_it));
+    else
+      level (def_it.substr(0, pos), log4cpp::Priority::getPriorityValue(def_it.substr(pos+1)));
+  }
+}
+
+void Logger::rateLimit (unsigned int records_per_second)
+{
+  rate_limit_ = records_per_second;
+
+  loginf << "Logger: rateLimit: " << records_per_second << " records per second";
 }
 
 Logger::~Logger()
 {
+  shutdown();
+
   if (console_appender_)
   {
     delete console_appender_;
@@ -63,3 +215,61 @@ Logger::~Logger()
     file_appender_=0;
   }
 }
+
+LogSite::LogSite (const char* file)
+  : module_index_ (Logger::getInstance().moduleIndex(moduleName(file)))
+{
+}
+
+std::string LogSite::moduleName (const std::string& file)
+{
+  size_t pos = file.rfind("/src/");
+
+  if (pos != std::string::npos || file.compare(0, 4, "src/") == 0)
+  {
+    pos = pos == std::string::npos ? 4 : pos+5;
+    size_t end = file.find('/', pos);
+
+    if (end == std::string::npos) // directly in src
+      return "atsdb";
+
+    return file.substr(pos, end-pos);
+  }
+
+  size_t end = file.rfind('/');
+
+  if (end == std::string::npos || end == 0)
+    return "atsdb";
+
+  size_t begin = file.rfind('/', end-1);
+
+  return file.substr(begin == std::string::npos ? 0 : begin+1, end-(begin == std::string::npos ? 0 : begin+1));
+}
+
+bool LogSite::allow ()
+{
+  long long second = std::chrono::duration_cast<std::chrono::seconds> (
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+  if (second_.load(std::memory_order_relaxed) != second)
+  {
+    second_.store(second, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+  }
+
+  if (count_.fetch_add(1, std::memory_order_relaxed) < Logger::rateLimit())
+    return true;
+
+  suppressed_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+LogStream::~LogStream ()
+{
+  unsigned int suppressed = site_.takeSuppressed();
+
+  if (suppressed)
+    *this << " (" << suppressed << " similar records suppressed)";
+
+  Logger::getInstance().log(record_);
+}
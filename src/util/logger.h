@@ -20,19 +20,50 @@
 
 #include "singleton.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "log4cpp/Appender.hh"
 #include "log4cpp/Category.hh"
+#include "log4cpp/Priority.hh"
+
+#include "logrecordqueue.h"
+
+class LogSite;
+
+/// @brief Returns the static log site of the calling code location
+#define LOG_SITE [] () -> LogSite& { static LogSite site (__FILE__); return site; } ()
 
-#define logerr log4cpp::Category::getRoot().errorStream()
-#define logwrn log4cpp::Category::getRoot().warnStream()
-#define loginf log4cpp::Category::getRoot().infoStream()
-//#define logdbg log4cpp::Category::getRoot().debugStream()
-#define logdbg if(false) log4cpp::Category::getRoot().debugStream() // for improved performance
+/// @brief Starts a log statement if priority is enabled for the module and not rate limited
+#define LOG_AT(priority) \
+    for (LogSite* log_site_ = LOG_SITE.check(priority); log_site_; log_site_ = nullptr) \
+        LogStream (*log_site_, priority)
+
+#define logerr LOG_AT(log4cpp::Priority::ERROR)
+#define logwrn LOG_AT(log4cpp::Priority::WARN)
+#define loginf LOG_AT(log4cpp::Priority::INFO)
+#define logdbg LOG_AT(log4cpp::Priority::DEBUG)
 
 /**
- * @brief Thread-safe logger
+ * @brief Thread-safe, asynchronous logger
+ *
+ * Uses log4cpp for layouts and appenders. Log statements collect their arguments unformatted and push them into a
+ * lock-free ring buffer, from which a background thread formats and writes them. Errors are written synchronously
+ * (after all queued records), so they are not lost when followed by an abort. If the ring buffer is full, the
+ * calling thread writes the queued records itself.
  *
- * Uses log4cpp.
+ * Every source directory is a module with its own level (default INFO), which can be changed at runtime, so a
+ * disabled statement (e.g. debug) only costs one level check. Each log statement can be rate limited to a number of
+ * records per second (off by default), suppressed records are counted and reported with the next written record
+ * of the same statement.
  */
 class Logger : public Singleton
 {
@@ -41,8 +72,30 @@ protected:
   log4cpp::Appender *console_appender_;
   log4cpp::Appender *file_appender_;
 
+  static const unsigned int MAX_MODULES = 64;
+  /// Level per module index, read by each log statement
+  static std::atomic<int> levels_[MAX_MODULES];
+  static std::atomic<unsigned int> rate_limit_;
+
+  std::mutex modules_mutex_;
+  std::vector<std::string> modules_;
+  int default_level_ {log4cpp::Priority::INFO};
+
+  std::unique_ptr<LogRecordQueue> queue_;
+  /// Held while writing to the appenders
+  std::mutex write_mutex_;
+  std::thread writer_thread_;
+  std::mutex writer_mutex_;
+  std::condition_variable writer_condition_;
+  std::atomic<bool> writer_running_ {false};
+
   Logger();
 
+  void writerLoop ();
+  /// @brief Writes all queued records, write_mutex_ has to be locked
+  void writeQueued ();
+  void write (int priority, const log4cpp::TimeStamp& time_stamp, const std::string& message);
+
 public:
   static Logger& getInstance()
   {
@@ -51,8 +104,130 @@ public:
   }
 
   void init (const std::string &log_config_filename);
+  /// @brief Writes all queued records
+  void flush ();
+  /// @brief Writes all queued records and stops the writer thread, later records are written synchronously
+  void shutdown ();
+
+  /// @brief Queues or writes a record
+  void log (LogRecord& record);
+
+  /// @brief Returns index of module, registering it if required
+  unsigned int moduleIndex (const std::string& module);
+  std::vector<std::string> modules ();
+
+  static int level (unsigned int module_index) { return levels_[module_index].load(std::memory_order_relaxed); }
+  /// @brief Sets level of one module, or of all modules if module is empty
+  void level (const std::string& module, int priority);
+  /// @brief Sets levels from list of "LEVEL" or "module=LEVEL" entries, throws on unknown level names
+  void levels (const std::vector<std::string>& definitions);
+
+  static unsigned int rateLimit () { return rate_limit_.load(std::memory_order_relaxed); }
+  /// @brief Sets maximum number of records per second of one log statement, 0 for unlimited
+  void rateLimit (unsigned int records_per_second);
 
   virtual ~Logger();
 };
 
+/**
+ * @brief Static state of one log statement
+ *
+ * Holds the module index, resolved once from the source file name, and the rate limiting counters.
+ */
+class LogSite
+{
+public:
+  explicit LogSite (const char* file);
+
+  /// @brief Returns this if a record of priority is to be written, nullptr otherwise
+  LogSite* check (int priority)
+  {
+    if (priority > Logger::level(module_index_))
+      return nullptr;
+
+    if (priority > log4cpp::Priority::ERROR && Logger::rateLimit() && !allow())
+      return nullptr;
+
+    return this;
+  }
+
+  /// @brief Returns and resets the number of suppressed records
+  unsigned int takeSuppressed () { return suppressed_.exchange(0, std::memory_order_relaxed); }
+
+  /// @brief Returns module name of source file, the directory below src
+  static std::string moduleName (const std::string& file);
+
+protected:
+  unsigned int module_index_ {0};
+
+  std::atomic<long long> second_ {-1};
+  std::atomic<unsigned int> count_ {0};
+  std::atomic<unsigned int> suppressed_ {0};
+
+  bool allow ();
+};
+
+/**
+ * @brief Collects the arguments of one log record, handed to the Logger when destroyed at the end of the statement
+ *
+ * Numbers, strings and pointers are stored unformatted, other types are formatted on the calling thread.
+ */
+class LogStream
+{
+public:
+  LogStream (LogSite& site, int priority) : site_(site) { record_.priority_ = priority; record_.arguments_.reserve(8); }
+  ~LogStream ();
+
+  template <typename T> LogStream& operator<< (const T& value)
+  {
+    add (value, std::integral_constant<bool, std::is_arithmetic<T>::value>(),
+         std::integral_constant<bool, std::is_pointer<typename std::decay<T>::type>::value
+         || std::is_same<T, std::string>::value>());
+    return *this;
+  }
+
+  LogStream& operator<< (LogArgument::Manipulator manipulator)
+  {
+    record_.arguments_.emplace_back(manipulator);
+    return *this;
+  }
+
+  LogStream& operator<< (LogArgument::BaseManipulator manipulator)
+  {
+    record_.arguments_.emplace_back(manipulator);
+    return *this;
+  }
+
+protected:
+  LogSite& site_;
+  LogRecord record_;
+
+  template <typename T> void add (const T& value, std::true_type is_arithmetic, std::false_type)
+  {
+    if (std::is_same<T, bool>::value)
+      record_.arguments_.emplace_back(static_cast<bool> (value));
+    else if (sizeof(T) == 1 && std::is_integral<T>::value) // printed as character by streams
+      record_.arguments_.emplace_back(static_cast<char> (value));
+    else if (std::is_floating_point<T>::value)
+      record_.arguments_.emplace_back(static_cast<double> (value));
+    else if (std::is_signed<T>::value)
+      record_.arguments_.emplace_back(static_cast<long long> (value));
+    else
+      record_.arguments_.emplace_back(static_cast<unsigned long long> (value));
+  }
+
+  /// @brief Strings and pointers, char pointers are copied as strings
+  template <typename T> void add (const T& value, std::false_type, std::true_type is_string_or_pointer)
+  {
+    record_.arguments_.emplace_back(value);
+  }
+
+  template <typename T> void add (const T& value, std::false_type, std::false_type)
+  {
+    std::ostringstream stream;
+    stream << value;
+    record_.arguments_.emplace_back(stream.str());
+  }
+};
+
 #endif /* LOGGER_H_ */
@@ -0,0 +1,135 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cassert>
+#include <sstream>
+
+#include "logrecordqueue.h"
+
+void LogArgument::format (std::ostream& stream) const
+{
+    switch (type_)
+    {
+    case Type::BOOL:
+        stream << value_.bool_;
+        break;
+    case Type::CHAR:
+        stream << value_.char_;
+        break;
+    case Type::SIGNED:
+        stream << value_.signed_;
+        break;
+    case Type::UNSIGNED:
+        stream << value_.unsigned_;
+        break;
+    case Type::DOUBLE:
+        stream << value_.double_;
+        break;
+    case Type::POINTER:
+        stream << value_.pointer_;
+        break;
+    case Type::STRING:
+        stream << string_;
+        break;
+    case Type::MANIPULATOR:
+        stream << value_.manipulator_;
+        break;
+    case Type::BASE_MANIPULATOR:
+        stream << value_.base_manipulator_;
+        break;
+    }
+}
+
+std::string LogRecord::message () const
+{
+    std::ostringstream stream;
+
+    for (const LogArgument& argument : arguments_)
+        argument.format(stream);
+
+    return stream.str();
+}
+
+LogRecordQueue::LogRecordQueue (size_t capacity)
+{
+    size_t size = 2;
+
+    while (size < capacity)
+        size *= 2;
+
+    cells_.reset(new Cell[size]);
+    mask_ = size-1;
+
+    for (size_t cnt=0; cnt < size; ++cnt)
+        cells_[cnt].sequence_.store(cnt, std::memory_order_relaxed);
+}
+
+bool LogRecordQueue::push (LogRecord& record)
+{
+    Cell* cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        cell = &cells_[pos & mask_];
+        size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos);
+
+        if (diff == 0) // free, try to claim
+        {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0) // full
+            return false;
+        else // claimed by other producer
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+
+    cell->record_ = std::move(record);
+    cell->sequence_.store(pos+1, std::memory_order_release);
+
+    return true;
+}
+
+bool LogRecordQueue::pop (LogRecord& record)
+{
+    Cell* cell;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        cell = &cells_[pos & mask_];
+        size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos+1);
+
+        if (diff == 0) // filled, try to claim
+        {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0) // empty
+            return false;
+        else // claimed by other consumer
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+
+    record = std::move(cell->record_);
+    cell->sequence_.store(pos+mask_+1, std::memory_order_release);
+
+    return true;
+}
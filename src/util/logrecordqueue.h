@@ -0,0 +1,121 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGRECORDQUEUE_H_
+#define LOGRECORDQUEUE_H_
+
+#include <atomic>
+#include <ios>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "log4cpp/TimeStamp.hh"
+
+/**
+ * @brief Unformatted argument of a log statement
+ *
+ * Numbers, characters, pointers and manipulators are stored by value, strings are copied. Formatting is done when
+ * the record is written.
+ */
+class LogArgument
+{
+public:
+    typedef std::ostream& (*Manipulator) (std::ostream&);
+    typedef std::ios_base& (*BaseManipulator) (std::ios_base&);
+
+    LogArgument (bool value) : type_(Type::BOOL) { value_.bool_ = value; }
+    LogArgument (char value) : type_(Type::CHAR) { value_.char_ = value; }
+    LogArgument (long long value) : type_(Type::SIGNED) { value_.signed_ = value; }
+    LogArgument (unsigned long long value) : type_(Type::UNSIGNED) { value_.unsigned_ = value; }
+    LogArgument (double value) : type_(Type::DOUBLE) { value_.double_ = value; }
+    LogArgument (const void* value) : type_(Type::POINTER) { value_.pointer_ = value; }
+    LogArgument (const char* value) : type_(Type::STRING), string_(value ? value : "(null)") {}
+    LogArgument (std::string&& value) : type_(Type::STRING), string_(std::move(value)) {}
+    LogArgument (const std::string& value) : type_(Type::STRING), string_(value) {}
+    LogArgument (Manipulator value) : type_(Type::MANIPULATOR) { value_.manipulator_ = value; }
+    LogArgument (BaseManipulator value) : type_(Type::BASE_MANIPULATOR) { value_.base_manipulator_ = value; }
+
+    void format (std::ostream& stream) const;
+
+protected:
+    enum class Type { BOOL, CHAR, SIGNED, UNSIGNED, DOUBLE, POINTER, STRING, MANIPULATOR, BASE_MANIPULATOR };
+
+    Type type_;
+    union
+    {
+        bool bool_;
+        char char_;
+        long long signed_;
+        unsigned long long unsigned_;
+        double double_;
+        const void* pointer_;
+        Manipulator manipulator_;
+        BaseManipulator base_manipulator_;
+    } value_;
+    std::string string_;
+};
+
+/// @brief Log statement waiting to be formatted and written
+struct LogRecord
+{
+    int priority_ {0};
+    log4cpp::TimeStamp time_stamp_;
+    std::vector<LogArgument> arguments_;
+
+    /// @brief Formats all arguments into one message
+    std::string message () const;
+};
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer ring buffer of log records
+ *
+ * Each cell carries a sequence number telling producers and consumers whether it is free or filled, so pushing and
+ * popping only need one compare-and-swap on the respective position. Capacity is rounded up to a power of two.
+ */
+class LogRecordQueue
+{
+public:
+    explicit LogRecordQueue (size_t capacity);
+    virtual ~LogRecordQueue() {}
+
+    /// @brief Moves record into queue, returns false if full
+    bool push (LogRecord& record);
+    /// @brief Moves oldest record out of queue, returns false if empty
+    bool pop (LogRecord& record);
+
+    size_t capacity () const { return mask_+1; }
+
+protected:
+    struct Cell
+    {
+        std::atomic<size_t> sequence_;
+        LogRecord record_;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ {0};
+
+    // positions on separate cache lines, so producers and consumers do not contend
+    char padding0_[64];
+    std::atomic<size_t> enqueue_pos_ {0};
+    char padding1_[64];
+    std::atomic<size_t> dequeue_pos_ {0};
+    char padding2_[64];
+};
+
+#endif /* LOGRECORDQUEUE_H_ */
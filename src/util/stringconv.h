@@ -82,14 +82,106 @@ inline std::string percentToString(double number)
     return out.str();
 }
 
-inline unsigned int intFromOctalString (std::string number)
+/// @brief Parses integer in base from [first, last) like std::strtoll, without allocations
+/// @return pointer after the last parsed character, first if no digits were found
+inline const char* parseInteger (const char* first, const char* last, unsigned int base, long long& value)
 {
-    return std::stoi (number, 0, 8);
+    const char* ptr = first;
+
+    while (ptr != last && (*ptr == ' ' || *ptr == '\t'))
+        ++ptr;
+
+    bool negative = false;
+
+    if (ptr != last && (*ptr == '-' || *ptr == '+'))
+    {
+        negative = *ptr == '-';
+        ++ptr;
+    }
+
+    if (base == 16 && last - ptr > 2 && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X'))
+        ptr += 2;
+
+    const char* digits_begin = ptr;
+    unsigned long long result = 0;
+    unsigned int digit;
+
+    for (; ptr != last; ++ptr)
+    {
+        if (*ptr >= '0' && *ptr <= '9')
+            digit = *ptr - '0';
+        else if (*ptr >= 'a' && *ptr <= 'z')
+            digit = *ptr - 'a' + 10;
+        else if (*ptr >= 'A' && *ptr <= 'Z')
+            digit = *ptr - 'A' + 10;
+        else
+            break;
+
+        if (digit >= base)
+            break;
+
+        result = result * base + digit;
+    }
+
+    if (ptr == digits_begin)
+        return first;
+
+    value = negative ? -static_cast<long long> (result) : static_cast<long long> (result);
+    return ptr;
+}
+
+/// @brief Parses unsigned decimal number with optional fraction ("12.345") from [first, last), without allocations
+/// @return pointer after the last parsed character, first if no digits were found
+inline const char* parseDecimal (const char* first, const char* last, double& value)
+{
+    const char* ptr = first;
+    double result = 0.0;
+    bool found = false;
+
+    for (; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr)
+    {
+        result = result * 10.0 + (*ptr - '0');
+        found = true;
+    }
+
+    if (ptr != last && *ptr == '.')
+    {
+        double scale = 0.1;
+
+        for (++ptr; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr)
+        {
+            result += (*ptr - '0') * scale;
+            scale *= 0.1;
+            found = true;
+        }
+    }
+
+    if (!found)
+        return first;
+
+    value = result;
+    return ptr;
+}
+
+/// @brief Returns integer in base parsed from the complete string, throws std::invalid_argument if not a number
+inline long long integerFromString (const char* first, const char* last, unsigned int base)
+{
+    long long value;
+
+    if (parseInteger(first, last, base, value) == first)
+        throw std::invalid_argument ("Util: integerFromString: no number in '"+std::string(first, last)+"'");
+
+    return value;
+}
+
+inline unsigned int intFromOctalString (const std::string& number)
+{
+    return integerFromString (number.data(), number.data()+number.size(), 8);
 }
 
-inline unsigned int intFromHexString (std::string number)
+inline unsigned int intFromHexString (const std::string& number)
 {
-    return std::stoi (number, 0, 16);
+    return integerFromString (number.data(), number.data()+number.size(), 16);
 }
 
 inline std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems)
@@ -208,18 +300,29 @@ inline int getLeadingInt (std::string text)
         throw std::runtime_error ("Util: getLeadingInt: no int found");
 }
 
-inline double doubleFromLatitudeString(std::string &latitude_str)
+/// @brief Returns degrees from degrees, minutes and seconds fields ("DDDMMSS.SSSS"), without allocations
+inline double degreesFromString (const char* str, unsigned int degree_digits, unsigned int seconds_length)
+{
+    long long degrees, minutes;
+    double seconds;
+
+    if (parseInteger(str, str+degree_digits, 10, degrees) != str+degree_digits
+            || parseInteger(str+degree_digits, str+degree_digits+2, 10, minutes) != str+degree_digits+2
+            || parseDecimal(str+degree_digits+2, str+degree_digits+2+seconds_length, seconds)
+            == str+degree_digits+2)
+        throw std::invalid_argument ("Util: degreesFromString: wrong format");
+
+    return degrees + minutes/60.0 + seconds/3600.0;
+}
+
+inline double doubleFromLatitudeString(const std::string &latitude_str)
 {
     unsigned int len = latitude_str.size();
     assert (len == 12);
     char last_char = latitude_str.at(len-1);
     assert (last_char == 'N' || last_char == 'S');
 
-    double x=0.0;
-
-    x = std::stod(latitude_str.substr(0, 2));
-    x += std::stod(latitude_str.substr(2, 2))/60.0;
-    x += std::stod(latitude_str.substr(4, 7))/3600.0;
+    double x = degreesFromString(latitude_str.data(), 2, 7);
 
     if (last_char == 'S')
         x *= -1.0;
@@ -227,18 +330,14 @@ inline double doubleFromLatitudeString(std::string &latitude_str)
     return x;
 }
 
-inline double doubleFromLongitudeString(std::string &longitude_str)
+inline double doubleFromLongitudeString(const std::string &longitude_str)
 {
     unsigned int len = longitude_str.size();
     assert (len == 13);
     char last_char = longitude_str.at(len-1);
     assert (last_char == 'E' || last_char == 'W');
 
-    double x=0.0;
-
-    x = std::stod(longitude_str.substr(0, 3));
-    x += std::stod(longitude_str.substr(3, 2))/60.0;
-    x += std::stod(longitude_str.substr(5, 7))/3600.0;
+    double x = degreesFromString(longitude_str.data(), 3, 7);
 
     if (last_char == 'W')
         x *= -1.0;
@@ -269,6 +368,12 @@ inline std::string getValueString (const double &value)
     return out.str();
 }
 
+/// @brief Returns timestamp as seconds
+inline std::string getValueString (const Timestamp &value)
+{
+    return getValueString (value.seconds());
+}
+
 template <typename T> std::string getValueString (T value)
 {
     return std::to_string(value);
@@ -30,11 +30,15 @@
 #include "listboxview.h"
 #include "listboxviewdatasource.h"
 #include "allbuffertablewidget.h"
+#include "buffercolumnaccessor.h"
 
 #include <QApplication>
 
+#include <algorithm>
+
 AllBufferTableModel::AllBufferTableModel(AllBufferTableWidget* table_widget, ListBoxViewDataSource& data_source)
-    : QAbstractTableModel(table_widget), table_widget_(table_widget), data_source_(data_source)
+    : QAbstractTableModel(table_widget), table_widget_(table_widget), data_source_(data_source),
+      row_cache_(ROW_CACHE_SIZE, ROW_PREFETCH_SIZE)
 {
     connect (data_source_.getSet(), &DBOVariableOrderedSet::setChangedSignal,
              this, &AllBufferTableModel::setChangedSlot);
@@ -47,6 +51,7 @@ AllBufferTableModel::~AllBufferTableModel()
 void AllBufferTableModel::setChangedSlot ()
 {
     beginResetModel();
+    updateColumnAccessors();
     endResetModel();
     assert (table_widget_);
     table_widget_->resizeColumns();
@@ -123,8 +128,6 @@ QVariant AllBufferTableModel::data(const QModelIndex &index, int role) const
 {
     logdbg << "AllBufferTableModel: data: row " << index.row()-1 << " col " << index.column()-1;
 
-    bool null=false;
-
     assert (index.row() >= 0);
     assert ((unsigned int)index.row() < row_indexes_.size());
     unsigned int dbo_num = row_indexes_.at(index.row()).first;
@@ -156,10 +159,6 @@ QVariant AllBufferTableModel::data(const QModelIndex &index, int role) const
     {
         assert (buffer);
 
-        std::string value_str;
-
-        const PropertyList &properties = buffer->properties();
-
         if (buffer_index >= buffer->size())
         {
             logerr << "AllBufferTableModel: data: index " << buffer_index << " too large for " << dbo_name << "  size " << buffer->size();
@@ -170,224 +169,140 @@ QVariant AllBufferTableModel::data(const QModelIndex &index, int role) const
 
         if (col == 0) // selected special case
             return QVariant();
-        if (col == 1) // selected special case
-            return QVariant(dbo_name.c_str());
 
-        if (show_associations_)
+        if (!row_cache_.has(index.row())) // format row and the following prefetch window
         {
-            if (col == 2)
+            unsigned int row_end = std::min<unsigned int> (index.row()+row_cache_.prefetch(), row_indexes_.size());
+
+            for (unsigned int row = index.row(); row < row_end; ++row)
             {
-                DBObjectManager& manager = ATSDB::instance().objectManager();
-                const DBOAssociationCollection& associations = manager.object(dbo_name).associations();
+                if (row != (unsigned int) index.row() && row_cache_.has(row))
+                    break;
 
-                assert (buffer->has<int>("rec_num"));
-                assert (!buffer->get<int>("rec_num").isNull(buffer_index));
-                unsigned int rec_num = buffer->get<int>("rec_num").get(buffer_index);
+                if (!formatRow(row_indexes_.at(row).first, row_indexes_.at(row).second, row_cache_.insert(row)))
+                    row_cache_.remove(row); // formatted again once the data is present
+            }
+        }
 
-                if (associations.count(rec_num))
-                {
-                    QString utns;
+        const std::vector<QVariant>& values = row_cache_.get(index.row());
+        assert (col < values.size());
+        return values.at(col);
+    }
+    return QVariant();
+}
 
-                    typedef DBOAssociationCollection::const_iterator MMAPIterator;
+bool AllBufferTableModel::formatRow (unsigned int dbo_num, unsigned int buffer_index,
+                                     std::vector<QVariant>& values) const
+{
+    logdbg << "AllBufferTableModel: formatRow: dbo " << dbo_num << " index " << buffer_index;
 
-                    // It returns a pair representing the range of elements with key equal to 'c'
-                    std::pair<MMAPIterator, MMAPIterator> result = associations.equal_range(rec_num);
+    assert (number_to_dbo_.count(dbo_num) == 1);
+    const std::string& dbo_name = number_to_dbo_.at(dbo_num);
 
-                    // Iterate over the range
-                    for (MMAPIterator it = result.first; it != result.second; it++)
-                        if (it == result.first)
-                            utns = QString::number(it->second.utn_);
-                        else
-                            utns += ","+QString::number(it->second.utn_);
+    assert (buffers_.count(dbo_name) == 1);
+    std::shared_ptr <Buffer> buffer = buffers_.at(dbo_name);
 
-                    return QVariant(utns);
-                }
-                else
-                    return QVariant();
+    if (buffer_index >= buffer->size()) // data not yet present
+        return false;
 
-            }
+    values.push_back(QVariant()); // selected special case
+    values.push_back(QVariant(dbo_name.c_str()));
 
-            col -= 3; // for the actual properties
-        }
-        else
-            col -= 2; // for the actual properties
+    if (show_associations_)
+    {
+        DBObjectManager& manager = ATSDB::instance().objectManager();
+        const DBOAssociationCollection& associations = manager.object(dbo_name).associations();
 
-//        loginf << "AllBufferTableModel: data: col " << col << " set size " << data_source_.getSet()->getSize()
-//               << " show assoc " << show_associations_;
-        assert (col < data_source_.getSet()->getSize());
+        assert (buffer->has<int>("rec_num"));
+        assert (!buffer->get<int>("rec_num").isNull(buffer_index));
+        unsigned int rec_num = buffer->get<int>("rec_num").get(buffer_index);
 
-        std::string variable_dbo_name = data_source_.getSet()->variableDefinition(col).dboName();
-        std::string variable_name = data_source_.getSet()->variableDefinition(col).variableName();
+        if (associations.count(rec_num))
+        {
+            QString utns;
 
-        DBObjectManager &manager = ATSDB::instance().objectManager();
+            typedef DBOAssociationCollection::const_iterator MMAPIterator;
 
-         // check if data & variables exist
-        if (variable_dbo_name == META_OBJECT_NAME)
-        {
-            assert (manager.existsMetaVariable(variable_name));
-            if (!manager.metaVariable(variable_name).existsIn(dbo_name)) // not data if not exist
-                return QString();
+            // It returns a pair representing the range of elements with key equal to 'c'
+            std::pair<MMAPIterator, MMAPIterator> result = associations.equal_range(rec_num);
+
+            // Iterate over the range
+            for (MMAPIterator it = result.first; it != result.second; it++)
+                if (it == result.first)
+                    utns = QString::number(it->second.utn_);
+                else
+                    utns += ","+QString::number(it->second.utn_);
+
+            values.push_back(QVariant(utns));
         }
         else
-        {
-            if (dbo_name != variable_dbo_name) // check if other dbo
-                return QString();
+            values.push_back(QVariant());
+    }
 
-            assert (manager.existsObject(dbo_name));
-            assert (manager.object(dbo_name).hasVariable(variable_name));
-        }
+    assert (column_accessors_.count(dbo_num));
 
-        DBOVariable& variable = (variable_dbo_name == META_OBJECT_NAME)
-                    ? manager.metaVariable(variable_name).getFor(dbo_name)
-                    : manager.object(dbo_name).variable(variable_name);
-        PropertyDataType data_type = variable.dataType();
+    for (auto& accessor_it : column_accessors_.at(dbo_num))
+    {
+        if (!accessor_it || accessor_it->isNull(buffer_index))
+            values.push_back(QVariant());
+        else
+            values.push_back(QString (accessor_it->getAsString(buffer_index, use_presentation_).c_str()));
+    }
+
+    return true;
+}
 
-        value_str = NULL_STRING;
+void AllBufferTableModel::updateColumnAccessors ()
+{
+    logdbg << "AllBufferTableModel: updateColumnAccessors";
 
-        if (!properties.hasProperty(variable.name()))
-        {
-            logdbg << "AllBufferTableModel: data: variable " << variable.name() << " not present in buffer";
-        }
-        else
+    column_accessors_.clear();
+    row_cache_.clear();
+
+    DBObjectManager &manager = ATSDB::instance().objectManager();
+    DBOVariableOrderedSet* set = data_source_.getSet();
+
+    for (auto& buf_it : buffers_)
+    {
+        const std::string& dbo_name = buf_it.first;
+
+        assert (dbo_to_number_.count(dbo_name) == 1);
+        std::vector<std::unique_ptr<BufferColumnAccessor>>& accessors = column_accessors_[dbo_to_number_.at(dbo_name)];
+
+        for (unsigned int col=0; col < set->getSize(); ++col)
         {
-            std::string property_name = variable.name();
+            std::string variable_dbo_name = set->variableDefinition(col).dboName();
+            std::string variable_name = set->variableDefinition(col).variableName();
 
-            if (data_type == PropertyDataType::BOOL)
-            {
-                assert (buffer->has<bool>(property_name));
-                null = buffer->get<bool>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<bool>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<bool>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::CHAR)
-            {
-                assert (buffer->has<char>(property_name));
-                null = buffer->get<char>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<char>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<char>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::UCHAR)
-            {
-                assert (buffer->has<unsigned char>(property_name));
-                null = buffer->get<unsigned char>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<unsigned char>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<unsigned char>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::INT)
-            {
-                assert (buffer->has<int>(property_name));
-                null = buffer->get<int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::UINT)
-            {
-                assert (buffer->has<unsigned int>(property_name));
-                null = buffer->get<unsigned int>(properties.at(col).name()).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<unsigned int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<unsigned int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::LONGINT)
-            {
-                assert (buffer->has<long int>(property_name));
-                null = buffer->get<long int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<long int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<long int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::ULONGINT)
-            {
-                assert (buffer->has<unsigned long int>(property_name));
-                null = buffer->get<unsigned long int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<unsigned long int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<unsigned long int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::FLOAT)
-            {
-                assert (buffer->has<float>(property_name));
-                null = buffer->get<float>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<float>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<float>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::DOUBLE)
+            // check if data & variables exist
+            if (variable_dbo_name == META_OBJECT_NAME)
             {
-                assert (buffer->has<double>(property_name));
-                null = buffer->get<double>(property_name).isNull(buffer_index);
-                if (!null)
+                assert (manager.existsMetaVariable(variable_name));
+                if (!manager.metaVariable(variable_name).existsIn(dbo_name)) // not data if not exist
                 {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer->get<double>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer->get<double>(property_name).getAsString(buffer_index);
+                    accessors.push_back(nullptr);
+                    continue;
                 }
             }
-            else if (data_type == PropertyDataType::STRING)
+            else
             {
-                assert (buffer->has<std::string>(property_name));
-                null = buffer->get<std::string>(property_name).isNull(buffer_index);
-                if (!null)
+                if (dbo_name != variable_dbo_name) // check if other dbo
                 {
-                    value_str = buffer->get<std::string>(property_name).getAsString(buffer_index);
+                    accessors.push_back(nullptr);
+                    continue;
                 }
+
+                assert (manager.existsObject(dbo_name));
+                assert (manager.object(dbo_name).hasVariable(variable_name));
             }
-            else
-                throw std::domain_error ("BufferTableWidget: show: unknown property data type");
 
-            if (null)
-                return QVariant();
-            else
-                return QString (value_str.c_str());
+            DBOVariable& variable = (variable_dbo_name == META_OBJECT_NAME)
+                    ? manager.metaVariable(variable_name).getFor(dbo_name)
+                    : manager.object(dbo_name).variable(variable_name);
+
+            accessors.push_back(BufferColumnAccessor::create(*buf_it.second, variable));
         }
     }
-    return QVariant();
 }
 
 bool AllBufferTableModel::setData(const QModelIndex& index, const QVariant & value,int role)
@@ -435,6 +350,7 @@ bool AllBufferTableModel::setData(const QModelIndex& index, const QVariant & val
 
             updateTimeIndexes ();
             rebuildRowIndexes ();
+            row_cache_.clear();
 
             endResetModel();
         }
@@ -454,6 +370,7 @@ void AllBufferTableModel::clearData ()
     time_to_indexes_.clear();
     row_indexes_.clear();
     buffers_.clear();
+    updateColumnAccessors();
 
     endResetModel();
 }
@@ -478,6 +395,7 @@ void AllBufferTableModel::setData (std::shared_ptr <Buffer> buffer)
 
     updateTimeIndexes();
     rebuildRowIndexes();
+    updateColumnAccessors();
 
 //    buffer = buffer;
 //    updateRows();
@@ -518,11 +436,11 @@ void AllBufferTableModel::updateTimeIndexes ()
 
             DBObjectManager& object_manager = ATSDB::instance().objectManager();
             const DBOVariable &tod_var = object_manager.metaVariable("tod").getFor(dbo_name);
-            assert (buf_it.second->has<float>(tod_var.name()));
-            NullableVector<float> &tods = buf_it.second->get<float> (tod_var.name());
+            assert (buf_it.second->has<Timestamp>(tod_var.name()));
+            NullableVector<Timestamp> &tods = buf_it.second->get<Timestamp> (tod_var.name());
 
             assert (buf_it.second->has<bool>("selected"));
-            NullableVector<bool> selected_vec = buf_it.second->get<bool>("selected");
+            NullableVector<bool>& selected_vec = buf_it.second->get<bool>("selected");
 
             for (; buffer_index < buffer_size; ++buffer_index)
             {
@@ -568,6 +486,7 @@ void AllBufferTableModel::rebuildRowIndexes ()
 void AllBufferTableModel::reset ()
 {
     beginResetModel();
+    updateColumnAccessors(); // variable representations may have changed
     endResetModel();
 }
 
@@ -611,6 +530,7 @@ void AllBufferTableModel::usePresentation (bool use_presentation)
     loginf << "AllBufferTableModel: usePresentation: " << use_presentation;
     beginResetModel();
     use_presentation_ = use_presentation;
+    row_cache_.clear();
     endResetModel();
 }
 
@@ -627,6 +547,7 @@ void AllBufferTableModel::showAssociations (bool value)
     loginf << "AllBufferTableModel: showAssociations: " << value;
     beginResetModel();
     show_associations_ = value;
+    row_cache_.clear();
     endResetModel();
 }
 
@@ -640,6 +561,7 @@ void AllBufferTableModel::updateToSelection()
 
     updateTimeIndexes ();
     rebuildRowIndexes ();
+    row_cache_.clear();
 
     endResetModel();
 }
@@ -19,6 +19,8 @@
 #define ALLBUFFERTABLEMODEL_H
 
 #include "dbovariableset.h"
+#include "formattedrowcache.h"
+#include "timestamp.h"
 
 #include <memory>
 
@@ -29,6 +31,7 @@ class DBObject;
 class AllBufferCSVExportJob;
 class ListBoxViewDataSource;
 class AllBufferTableWidget;
+class BufferColumnAccessor;
 
 class AllBufferTableModel : public QAbstractTableModel
 {
@@ -79,15 +82,27 @@ protected:
 
     std::map <std::string, unsigned int> dbo_last_processed_index_;
 
-    std::multimap<float, std::pair<unsigned int, unsigned int>> time_to_indexes_; // tod -> [dbo num,index]
+    std::multimap<Timestamp, std::pair<unsigned int, unsigned int>> time_to_indexes_; // tod -> [dbo num,index]
     std::vector <std::pair<unsigned int, unsigned int>> row_indexes_; // row index -> dbo num,index
 
     bool show_only_selected_ {true};
     bool use_presentation_ {true};
     bool show_associations_ {false};
 
+    /// dbo num -> accessors for set columns, resolved once per model reset, nullptr if not in dbo or buffer
+    std::map <unsigned int, std::vector<std::unique_ptr<BufferColumnAccessor>>> column_accessors_;
+
+    /// Formatted display values of recently shown rows, cleared on reset
+    mutable FormattedRowCache row_cache_;
+
+    static const unsigned int ROW_CACHE_SIZE {1024};
+    static const unsigned int ROW_PREFETCH_SIZE {64};
+
     void updateTimeIndexes ();
     void rebuildRowIndexes ();
+    void updateColumnAccessors ();
+    /// @brief Returns false if the buffer data is not yet present, values are then not to be used
+    bool formatRow (unsigned int dbo_num, unsigned int buffer_index, std::vector<QVariant>& values) const;
 };
 
 #endif // ALLBUFFERTABLEMODEL_H
@@ -0,0 +1,95 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffercolumnaccessor.h"
+#include "logger.h"
+
+std::unique_ptr<BufferColumnAccessor> BufferColumnAccessor::create (Buffer& buffer, const DBOVariable& variable)
+{
+    const std::string& property_name = variable.name();
+
+    if (!buffer.properties().hasProperty(property_name))
+    {
+        logdbg << "BufferColumnAccessor: create: variable " << property_name << " not present in buffer";
+        return nullptr;
+    }
+
+    switch (buffer.properties().get(property_name).dataType()) // loaded integers may be narrowed
+    {
+    case PropertyDataType::BOOL:
+        assert (buffer.has<bool>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<bool> (buffer.get<bool>(property_name), variable));
+    case PropertyDataType::CHAR:
+        assert (buffer.has<char>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<char> (buffer.get<char>(property_name), variable));
+    case PropertyDataType::UCHAR:
+        assert (buffer.has<unsigned char>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<unsigned char> (buffer.get<unsigned char>(property_name),
+                                                                      variable));
+    case PropertyDataType::SHORTINT:
+        assert (buffer.has<short int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<short int> (buffer.get<short int>(property_name), variable));
+    case PropertyDataType::USHORTINT:
+        assert (buffer.has<unsigned short int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<unsigned short int> (
+                        buffer.get<unsigned short int>(property_name), variable));
+    case PropertyDataType::INT:
+        assert (buffer.has<int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<int> (buffer.get<int>(property_name), variable));
+    case PropertyDataType::UINT:
+        assert (buffer.has<unsigned int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<unsigned int> (buffer.get<unsigned int>(property_name),
+                                                                     variable));
+    case PropertyDataType::LONGINT:
+        assert (buffer.has<long int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<long int> (buffer.get<long int>(property_name), variable));
+    case PropertyDataType::ULONGINT:
+        assert (buffer.has<unsigned long int>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<unsigned long int> (
+                        buffer.get<unsigned long int>(property_name), variable));
+    case PropertyDataType::FLOAT:
+        assert (buffer.has<float>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<float> (buffer.get<float>(property_name), variable));
+    case PropertyDataType::DOUBLE:
+        assert (buffer.has<double>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<double> (buffer.get<double>(property_name), variable));
+    case PropertyDataType::TIMESTAMP:
+        assert (buffer.has<Timestamp>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<Timestamp> (buffer.get<Timestamp>(property_name), variable));
+    case PropertyDataType::STRING:
+        assert (buffer.has<std::string>(property_name));
+        return std::unique_ptr<BufferColumnAccessor> (
+                    new BufferColumnAccessorTemplate<std::string> (buffer.get<std::string>(property_name),
+                                                                    variable));
+    default:
+        logerr << "BufferColumnAccessor: create: unknown property type "
+               << Property::asString(variable.dataType());
+        throw std::domain_error ("BufferColumnAccessor: create: unknown property data type");
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUFFERCOLUMNACCESSOR_H
+#define BUFFERCOLUMNACCESSOR_H
+
+#include <memory>
+#include <string>
+
+#include "buffer.h"
+#include "dbovariable.h"
+#include "dbovariableformatter.h"
+
+/**
+ * @brief Resolved, typed access to one DBOVariable column of a Buffer
+ *
+ * Created once per model reset, so that the property lookup, the data type switch and the map lookup of the
+ * NullableVector are not repeated for every displayed cell. Values in special representation are formatted in blocks
+ * of rows around the requested one. The representation is read at creation, so the accessors are re-created on
+ * every model reset.
+ */
+class BufferColumnAccessor
+{
+public:
+    virtual ~BufferColumnAccessor() {}
+
+    virtual bool isNull (unsigned int index) = 0;
+    virtual std::string getAsString (unsigned int index, bool use_presentation) = 0;
+
+    /// @brief Returns accessor for variable, nullptr if not contained in buffer
+    static std::unique_ptr<BufferColumnAccessor> create (Buffer& buffer, const DBOVariable& variable);
+};
+
+template <typename T> class BufferColumnAccessorTemplate : public BufferColumnAccessor
+{
+public:
+    BufferColumnAccessorTemplate (NullableVector<T>& values, const DBOVariable& variable)
+        : values_(values), variable_(variable),
+          special_representation_(variable.representation() != DBOVariable::Representation::STANDARD) {}
+    virtual ~BufferColumnAccessorTemplate() {}
+
+    virtual bool isNull (unsigned int index) { return values_.isNull(index); }
+
+    virtual std::string getAsString (unsigned int index, bool use_presentation)
+    {
+        if (use_presentation && special_representation_)
+        {
+            if (!formatter_)
+                formatter_.reset(new DBOVariableFormatter(variable_));
+
+            formatter_->formatBlock(values_, index);
+            return formatter_->get(index);
+        }
+        else
+            return values_.getAsString(index);
+    }
+
+protected:
+    NullableVector<T>& values_;
+    const DBOVariable& variable_;
+    bool special_representation_ {false};
+    std::unique_ptr<DBOVariableFormatter> formatter_;
+};
+
+template <>
+inline std::string BufferColumnAccessorTemplate<std::string>::getAsString (unsigned int index,
+                                                                            bool use_presentation)
+{
+    return values_.getAsString(index); // no representation for strings
+}
+
+#endif // BUFFERCOLUMNACCESSOR_H
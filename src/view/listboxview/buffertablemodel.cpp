@@ -28,11 +28,15 @@
 #include "atsdb.h"
 #include "dbobject.h"
 #include "dbobjectmanager.h"
+#include "buffercolumnaccessor.h"
 
 #include <QApplication>
 
+#include <algorithm>
+
 BufferTableModel::BufferTableModel(BufferTableWidget* table_widget, DBObject &object, ListBoxViewDataSource& data_source)
-    : QAbstractTableModel(table_widget), table_widget_(table_widget), object_(object), data_source_(data_source)
+    : QAbstractTableModel(table_widget), table_widget_(table_widget), object_(object), data_source_(data_source),
+      row_cache_(ROW_CACHE_SIZE, ROW_PREFETCH_SIZE)
 {
 }
 
@@ -110,8 +114,6 @@ QVariant BufferTableModel::data(const QModelIndex &index, int role) const
 {
     logdbg << "BufferTableModel: data: row " << index.row()-1 << " col " << index.column()-1;
 
-    bool null=false;
-
     assert (index.row() >= 0);
     assert ((unsigned int)index.row() < row_indexes_.size());
     unsigned int buffer_index = row_indexes_.at(index.row());
@@ -135,212 +137,90 @@ QVariant BufferTableModel::data(const QModelIndex &index, int role) const
     else if (role == Qt::DisplayRole)
     {
         assert (buffer_);
-
-        std::string value_str;
-
-        const PropertyList &properties = buffer_->properties();
-
         assert (buffer_index < buffer_->size());
 
         if (col == 0) // selected special case
             return QVariant();
 
-        if (show_associations_)
+        if (!row_cache_.has(index.row())) // format row and the following prefetch window
         {
-            if (col == 1)
+            unsigned int row_end = std::min<unsigned int> (index.row()+row_cache_.prefetch(), row_indexes_.size());
+
+            for (unsigned int row = index.row(); row < row_end; ++row)
             {
-                DBObjectManager& manager = ATSDB::instance().objectManager();
+                if (row != (unsigned int) index.row() && row_cache_.has(row))
+                    break;
 
-                std::string dbo_name = buffer_->dboName();
-                assert (dbo_name.size());
+                formatRow(row_indexes_.at(row), row_cache_.insert(row));
+            }
+        }
 
-                const DBOAssociationCollection& associations = manager.object(dbo_name).associations();
+        const std::vector<QVariant>& values = row_cache_.get(index.row());
+        assert (col < values.size());
+        return values.at(col);
+    }
+    return QVariant();
+}
 
-                assert (buffer_->has<int>("rec_num"));
-                assert (!buffer_->get<int>("rec_num").isNull(buffer_index));
-                unsigned int rec_num = buffer_->get<int>("rec_num").get(buffer_index);
+void BufferTableModel::formatRow (unsigned int buffer_index, std::vector<QVariant>& values) const
+{
+    logdbg << "BufferTableModel: formatRow: index " << buffer_index;
 
-                if (associations.count(rec_num))
-                {
-                    QString utns;
+    values.push_back(QVariant()); // selected special case
 
-                    typedef DBOAssociationCollection::const_iterator MMAPIterator;
+    if (show_associations_)
+    {
+        assert (rec_num_vec_);
+        assert (!rec_num_vec_->isNull(buffer_index));
+        unsigned int rec_num = rec_num_vec_->get(buffer_index);
 
-                    // It returns a pair representing the range of elements with key equal to 'c'
-                    std::pair<MMAPIterator, MMAPIterator> result = associations.equal_range(rec_num);
+        const DBOAssociationCollection& associations = object_.associations();
 
-                    // Iterate over the range
-                    for (MMAPIterator it = result.first; it != result.second; it++)
-                        if (it == result.first)
-                            utns = QString::number(it->second.utn_);
-                        else
-                            utns += ","+QString::number(it->second.utn_);
+        if (associations.count(rec_num))
+        {
+            QString utns;
 
-                    return QVariant(utns);
-                }
-                else
-                    return QVariant();
+            typedef DBOAssociationCollection::const_iterator MMAPIterator;
 
-            }
+            // It returns a pair representing the range of elements with key equal to 'c'
+            std::pair<MMAPIterator, MMAPIterator> result = associations.equal_range(rec_num);
 
-            col -= 2; // for the actual properties
+            // Iterate over the range
+            for (MMAPIterator it = result.first; it != result.second; it++)
+                if (it == result.first)
+                    utns = QString::number(it->second.utn_);
+                else
+                    utns += ","+QString::number(it->second.utn_);
+
+            values.push_back(QVariant(utns));
         }
         else
-            col -= 1; // for the actual properties
-
-        assert (col < read_set_.getSize());
-
-        DBOVariable& variable = read_set_.getVariable(col);
-        PropertyDataType data_type = variable.dataType();
+            values.push_back(QVariant());
+    }
 
-        value_str = NULL_STRING;
+    for (auto& accessor_it : column_accessors_)
+    {
+        if (!accessor_it || accessor_it->isNull(buffer_index))
+            values.push_back(QVariant());
+        else
+            values.push_back(QString (accessor_it->getAsString(buffer_index, use_presentation_).c_str()));
+    }
+}
 
-        //const DBTableColumn &column = variable.currentDBColumn ();
+void BufferTableModel::updateColumnAccessors ()
+{
+    column_accessors_.clear();
+    rec_num_vec_ = nullptr;
+    row_cache_.clear();
 
-        if (!properties.hasProperty(variable.name()))
-        {
-            logdbg << "BufferTableModel: data: variable " << variable.name() << " not present in buffer";
-        }
-        else
-        {
-            std::string property_name = variable.name();
+    if (!buffer_)
+        return;
 
-            if (data_type == PropertyDataType::BOOL)
-            {
-                assert (buffer_->has<bool>(property_name));
-                null = buffer_->get<bool>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<bool>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<bool>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::CHAR)
-            {
-                assert (buffer_->has<char>(property_name));
-                null = buffer_->get<char>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<char>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<char>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::UCHAR)
-            {
-                assert (buffer_->has<unsigned char>(property_name));
-                null = buffer_->get<unsigned char>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<unsigned char>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<unsigned char>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::INT)
-            {
-                assert (buffer_->has<int>(property_name));
-                null = buffer_->get<int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::UINT)
-            {
-                assert (buffer_->has<unsigned int>(property_name));
-                null = buffer_->get<unsigned int>(properties.at(col).name()).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<unsigned int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<unsigned int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::LONGINT)
-            {
-                assert (buffer_->has<long int>(property_name));
-                null = buffer_->get<long int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<long int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<long int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::ULONGINT)
-            {
-                assert (buffer_->has<unsigned long int>(property_name));
-                null = buffer_->get<unsigned long int>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<unsigned long int>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<unsigned long int>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::FLOAT)
-            {
-                assert (buffer_->has<float>(property_name));
-                null = buffer_->get<float>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<float>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<float>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::DOUBLE)
-            {
-                assert (buffer_->has<double>(property_name));
-                null = buffer_->get<double>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    if (use_presentation_)
-                        value_str = variable.getRepresentationStringFromValue(
-                                    buffer_->get<double>(property_name).getAsString(buffer_index));
-                    else
-                        value_str = buffer_->get<double>(property_name).getAsString(buffer_index);
-                }
-            }
-            else if (data_type == PropertyDataType::STRING)
-            {
-                assert (buffer_->has<std::string>(property_name));
-                null = buffer_->get<std::string>(property_name).isNull(buffer_index);
-                if (!null)
-                {
-                    value_str = buffer_->get<std::string>(property_name).getAsString(buffer_index);
-                }
-            }
-            else
-                throw std::domain_error ("BufferTableWidget: show: unknown property data type");
+    for (unsigned int col=0; col < read_set_.getSize(); ++col)
+        column_accessors_.push_back(BufferColumnAccessor::create(*buffer_, read_set_.getVariable(col)));
 
-            if (null)
-                return QVariant();
-            else
-                return QString (value_str.c_str());
-        }
-    }
-    return QVariant();
+    if (buffer_->has<int>("rec_num"))
+        rec_num_vec_ = &buffer_->get<int>("rec_num");
 }
 
 bool BufferTableModel::setData(const QModelIndex& index, const QVariant & value,int role)
@@ -376,6 +256,7 @@ bool BufferTableModel::setData(const QModelIndex& index, const QVariant & value,
             beginResetModel();
             row_indexes_.clear();
             updateRows();
+            row_cache_.clear();
             endResetModel();
         }
 
@@ -390,6 +271,7 @@ void BufferTableModel::clearData ()
 
     buffer_=nullptr;
     updateRows();
+    updateColumnAccessors();
 
     endResetModel();
 }
@@ -402,6 +284,7 @@ void BufferTableModel::setData (std::shared_ptr <Buffer> buffer)
     buffer_ = buffer;
     updateRows();
     read_set_ = data_source_.getSet()->getFor(object_.name());
+    updateColumnAccessors();
 
     endResetModel();
 }
@@ -418,7 +301,7 @@ void BufferTableModel::updateRows ()
     unsigned int buffer_size = buffer_->size();
 
     assert (buffer_->has<bool>("selected"));
-    NullableVector<bool> selected_vec = buffer_->get<bool>("selected");
+    NullableVector<bool>& selected_vec = buffer_->get<bool>("selected");
 
     if (row_indexes_.size()) // get last processed index
     {
@@ -450,6 +333,7 @@ void BufferTableModel::updateRows ()
 void BufferTableModel::reset ()
 {
     beginResetModel();
+    updateColumnAccessors(); // variable representations may have changed
     endResetModel();
 }
 
@@ -489,6 +373,7 @@ void BufferTableModel::usePresentation (bool use_presentation)
 {
     beginResetModel();
     use_presentation_ = use_presentation;
+    row_cache_.clear();
     endResetModel();
 }
 
@@ -505,6 +390,7 @@ void BufferTableModel::showAssociations (bool value)
     loginf << "BufferTableModel: showAssociations: " << value;
     beginResetModel();
     show_associations_ = value;
+    row_cache_.clear();
     endResetModel();
 }
 
@@ -514,6 +400,7 @@ void BufferTableModel::updateToSelection()
 
     row_indexes_.clear();
     updateRows ();
+    row_cache_.clear();
 
     endResetModel();
 }
@@ -19,6 +19,7 @@
 #define BUFFERTABLEMODEL_H
 
 #include "dbovariableset.h"
+#include "formattedrowcache.h"
 
 #include <memory>
 
@@ -29,6 +30,9 @@ class DBObject;
 class BufferCSVExportJob;
 class ListBoxViewDataSource;
 class BufferTableWidget;
+class BufferColumnAccessor;
+
+template <class T> class NullableVector;
 
 class BufferTableModel : public QAbstractTableModel
 {
@@ -82,7 +86,19 @@ protected:
     bool use_presentation_ {true};
     bool show_associations_ {false};
 
+    /// Accessors for read_set_ columns, resolved once per model reset, nullptr if not in buffer
+    std::vector<std::unique_ptr<BufferColumnAccessor>> column_accessors_;
+    NullableVector<int>* rec_num_vec_ {nullptr};
+
+    /// Formatted display values of recently shown rows, cleared on reset
+    mutable FormattedRowCache row_cache_;
+
+    static const unsigned int ROW_CACHE_SIZE {1024};
+    static const unsigned int ROW_PREFETCH_SIZE {64};
+
     void updateRows ();
+    void updateColumnAccessors ();
+    void formatRow (unsigned int buffer_index, std::vector<QVariant>& values) const;
 };
 
 #endif // BUFFERTABLEMODEL_H
@@ -0,0 +1,63 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "formattedrowcache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+const unsigned int FormattedRowCache::ROW_NONE = std::numeric_limits<unsigned int>::max();
+
+FormattedRowCache::FormattedRowCache(unsigned int capacity, unsigned int prefetch)
+    : capacity_(capacity), prefetch_(prefetch), rows_(capacity, ROW_NONE), values_(capacity)
+{
+    assert (capacity_);
+    assert (prefetch_ < capacity_);
+}
+
+bool FormattedRowCache::has (unsigned int row) const
+{
+    return rows_.at(row % capacity_) == row;
+}
+
+const std::vector<QVariant>& FormattedRowCache::get (unsigned int row) const
+{
+    assert (has(row));
+    return values_.at(row % capacity_);
+}
+
+std::vector<QVariant>& FormattedRowCache::insert (unsigned int row)
+{
+    unsigned int slot = row % capacity_;
+
+    rows_.at(slot) = row;
+    values_.at(slot).clear();
+
+    return values_.at(slot);
+}
+
+void FormattedRowCache::remove (unsigned int row)
+{
+    if (has(row))
+        rows_.at(row % capacity_) = ROW_NONE;
+}
+
+void FormattedRowCache::clear ()
+{
+    std::fill (rows_.begin(), rows_.end(), ROW_NONE);
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of ATSDB.
+ *
+ * ATSDB is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ATSDB is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with ATSDB.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FORMATTEDROWCACHE_H
+#define FORMATTEDROWCACHE_H
+
+#include <vector>
+
+#include <QVariant>
+
+/**
+ * @brief Small ring cache of formatted table rows
+ *
+ * Each row is stored in slot (row % capacity), so scrolling overwrites rows which are far away from the visible
+ * ones. Has to be cleared whenever the row indexes or the presentation of the model change.
+ */
+class FormattedRowCache
+{
+public:
+    FormattedRowCache (unsigned int capacity, unsigned int prefetch);
+
+    bool has (unsigned int row) const;
+    const std::vector<QVariant>& get (unsigned int row) const;
+    /// @brief Returns cleared value container for row, replacing the previously stored one
+    std::vector<QVariant>& insert (unsigned int row);
+    /// @brief Removes row if stored
+    void remove (unsigned int row);
+
+    void clear ();
+
+    unsigned int capacity () const { return capacity_; }
+    /// @brief Number of rows to be formatted in advance after a cache miss
+    unsigned int prefetch () const { return prefetch_; }
+
+protected:
+    unsigned int capacity_ {0};
+    unsigned int prefetch_ {0};
+
+    std::vector<unsigned int> rows_; // slot -> row, ROW_NONE if empty
+    std::vector<std::vector<QVariant>> values_; // slot -> formatted values
+
+    static const unsigned int ROW_NONE;
+};
+
+#endif // FORMATTEDROWCACHE_H
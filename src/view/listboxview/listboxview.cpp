@@ -134,6 +134,9 @@ DBOVariableSet ListBoxView::getSet (const std::string& dbo_name)
 {
     assert (data_source_);
 
+    if (data_source_->useTimeWindow()) // read through the time window pager, nothing to be loaded
+        return DBOVariableSet();
+
     return data_source_->getSet()->getExistingInDBFor(dbo_name);
 }
 
@@ -188,6 +191,23 @@ void ListBoxView::showOnlySelected(bool value)
     QApplication::restoreOverrideCursor();
 }
 
+size_t ListBoxView::selectRegion (double latitude_min, double latitude_max, double longitude_min,
+                                  double longitude_max)
+{
+    loginf << "ListBoxView: selectRegion";
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    size_t num_selected = ATSDB::instance().objectManager().selectRegion(latitude_min, latitude_max, longitude_min,
+                                                                          longitude_max);
+    emitSelectionChange();
+    updateSelection(); // not updated by self-emitted change
+
+    QApplication::restoreOverrideCursor();
+
+    return num_selected;
+}
+
 bool ListBoxView::showAssociations() const
 {
     return show_associations_;
@@ -88,6 +88,9 @@ public:
     bool showAssociations() const;
     void showAssociations(bool show_associations);
 
+    /// @brief Selects loaded data by position (using the spatial indexes) and updates all views, returns selected rows
+    size_t selectRegion (double latitude_min, double latitude_max, double longitude_min, double longitude_max);
+
 protected:
     /// For data display
     ListBoxViewWidget* widget_ {nullptr};
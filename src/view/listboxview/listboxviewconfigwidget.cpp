@@ -21,8 +21,14 @@
 #include <QLineEdit>
 #include <QLabel>
 #include <QMessageBox>
+#include <QGridLayout>
+#include <QDoubleValidator>
+#include <QHBoxLayout>
+#include <QSlider>
 
+#include "atsdb.h"
 #include "dbobjectmanager.h"
+#include "dbotimewindowpager.h"
 #include "dbovariableorderedsetwidget.h"
 #include "listboxview.h"
 #include "listboxviewconfigwidget.h"
@@ -59,6 +65,64 @@ ListBoxViewConfigWidget::ListBoxViewConfigWidget( ListBoxView* view, QWidget* pa
         associations_check_->setDisabled(true);
     vlayout->addWidget(associations_check_);
 
+    QGridLayout* region_layout = new QGridLayout ();
+
+    region_layout->addWidget(new QLabel ("Latitude Min/Max"), 0, 0);
+    latitude_min_edit_ = new QLineEdit ("-90");
+    latitude_min_edit_->setValidator(new QDoubleValidator(-90, 90, 6, this));
+    region_layout->addWidget(latitude_min_edit_, 0, 1);
+    latitude_max_edit_ = new QLineEdit ("90");
+    latitude_max_edit_->setValidator(new QDoubleValidator(-90, 90, 6, this));
+    region_layout->addWidget(latitude_max_edit_, 0, 2);
+
+    region_layout->addWidget(new QLabel ("Longitude Min/Max"), 1, 0);
+    longitude_min_edit_ = new QLineEdit ("-180");
+    longitude_min_edit_->setValidator(new QDoubleValidator(-180, 180, 6, this));
+    region_layout->addWidget(longitude_min_edit_, 1, 1);
+    longitude_max_edit_ = new QLineEdit ("180");
+    longitude_max_edit_->setValidator(new QDoubleValidator(-180, 180, 6, this));
+    region_layout->addWidget(longitude_max_edit_, 1, 2);
+
+    vlayout->addLayout(region_layout);
+
+    select_region_button_ = new QPushButton ("Select Region");
+    connect(select_region_button_, SIGNAL(clicked(bool)), this, SLOT(selectRegionSlot()));
+    vlayout->addWidget(select_region_button_);
+
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+
+    time_window_check_ = new QCheckBox("Show Time Window");
+    time_window_check_->setChecked(view_->getDataSource()->useTimeWindow());
+    connect(time_window_check_, &QCheckBox::clicked, this, &ListBoxViewConfigWidget::toggleTimeWindowSlot);
+    vlayout->addWidget(time_window_check_);
+
+    time_slider_ = new QSlider (Qt::Horizontal);
+    time_slider_->setRange(static_cast<int>(pager.timeBegin()), static_cast<int>(pager.timeEnd()));
+    time_slider_->setValue(static_cast<int>(pager.cursor()));
+    connect(time_slider_, &QSlider::valueChanged, this, &ListBoxViewConfigWidget::timeSliderMovedSlot);
+    vlayout->addWidget(time_slider_);
+
+    QHBoxLayout* playback_layout = new QHBoxLayout ();
+
+    time_label_ = new QLabel ();
+    playback_layout->addWidget(time_label_);
+
+    playback_layout->addWidget(new QLabel ("Speed"));
+    playback_speed_edit_ = new QLineEdit ("10");
+    playback_speed_edit_->setValidator(new QDoubleValidator(0.1, 1000, 1, this));
+    playback_layout->addWidget(playback_speed_edit_);
+
+    play_button_ = new QPushButton ("Play");
+    connect(play_button_, SIGNAL(clicked(bool)), this, SLOT(playSlot()));
+    playback_layout->addWidget(play_button_);
+
+    vlayout->addLayout(playback_layout);
+
+    connect(&pager, &DBOTimeWindowPager::cursorChangedSignal, this, &ListBoxViewConfigWidget::cursorChangedSlot);
+    connect(&pager, &DBOTimeWindowPager::playingChangedSignal, this, &ListBoxViewConfigWidget::playingChangedSlot);
+
+    updateTimeWidgets();
+
     vlayout->addStretch();
 
     overwrite_check_ = new QCheckBox("Overwrite Exported File");
@@ -111,6 +175,112 @@ void ListBoxViewConfigWidget::showAssociationsSlot()
     view_->showAssociations(checked);
 }
 
+void ListBoxViewConfigWidget::selectRegionSlot()
+{
+    assert (latitude_min_edit_);
+    assert (latitude_max_edit_);
+    assert (longitude_min_edit_);
+    assert (longitude_max_edit_);
+
+    bool latitude_min_ok, latitude_max_ok, longitude_min_ok, longitude_max_ok;
+
+    double latitude_min = latitude_min_edit_->text().toDouble(&latitude_min_ok);
+    double latitude_max = latitude_max_edit_->text().toDouble(&latitude_max_ok);
+    double longitude_min = longitude_min_edit_->text().toDouble(&longitude_min_ok);
+    double longitude_max = longitude_max_edit_->text().toDouble(&longitude_max_ok);
+
+    if (!latitude_min_ok || !latitude_max_ok || !longitude_min_ok || !longitude_max_ok)
+    {
+        QMessageBox msgBox;
+        msgBox.setText("Region limits are not valid numbers.");
+        msgBox.exec();
+        return;
+    }
+
+    size_t num_selected = view_->selectRegion(latitude_min, latitude_max, longitude_min, longitude_max);
+
+    loginf << "ListBoxViewConfigWidget: selectRegionSlot: selected " << num_selected << " rows";
+}
+
+void ListBoxViewConfigWidget::toggleTimeWindowSlot()
+{
+    assert (time_window_check_);
+    bool checked = time_window_check_->checkState() == Qt::Checked;
+    loginf  << "ListBoxViewConfigWidget: toggleTimeWindowSlot: setting to " << checked;
+    view_->getDataSource()->useTimeWindow(checked);
+
+    updateTimeWidgets();
+}
+
+void ListBoxViewConfigWidget::timeSliderMovedSlot(int value)
+{
+    ATSDB::instance().objectManager().timeWindowPager().cursor(value);
+}
+
+void ListBoxViewConfigWidget::playSlot()
+{
+    assert (playback_speed_edit_);
+
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+
+    if (pager.playing())
+    {
+        pager.pause();
+        return;
+    }
+
+    bool ok;
+    double speed = playback_speed_edit_->text().toDouble(&ok);
+
+    if (!ok || speed <= 0)
+    {
+        QMessageBox msgBox;
+        msgBox.setText("Playback speed is not a valid number.");
+        msgBox.exec();
+        return;
+    }
+
+    pager.play(speed);
+}
+
+void ListBoxViewConfigWidget::cursorChangedSlot(double tod)
+{
+    assert (time_slider_);
+
+    time_slider_->blockSignals(true);
+    time_slider_->setValue(static_cast<int>(tod));
+    time_slider_->blockSignals(false);
+
+    updateTimeWidgets();
+}
+
+void ListBoxViewConfigWidget::playingChangedSlot(bool playing)
+{
+    assert (play_button_);
+    play_button_->setText(playing ? "Pause" : "Play");
+}
+
+void ListBoxViewConfigWidget::updateTimeWidgets ()
+{
+    assert (time_slider_);
+    assert (time_label_);
+    assert (playback_speed_edit_);
+    assert (play_button_);
+
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+    bool use_time_window = view_->getDataSource()->useTimeWindow();
+
+    unsigned int window = pager.windowFor(pager.cursor());
+
+    time_label_->setText((String::timeStringFromDouble(pager.windowBegin(window), false)+" - "
+                          +String::timeStringFromDouble(pager.windowEnd(window), false)).c_str());
+
+    time_slider_->setEnabled(use_time_window);
+    time_label_->setEnabled(use_time_window);
+    playback_speed_edit_->setEnabled(use_time_window);
+    play_button_->setEnabled(use_time_window);
+}
+
 void ListBoxViewConfigWidget::exportSlot()
 {
     logdbg << "ListBoxViewConfigWidget: exportSlot";
@@ -24,8 +24,10 @@
 class DBOVariableOrderedSetWidget;
 class QCheckBox;
 class ListBoxView;
+class QLabel;
 class QLineEdit;
 class QPushButton;
+class QSlider;
 
 /**
  * @brief Widget with configuration elements for a ListBoxView
@@ -40,6 +42,12 @@ public slots:
     void toggleUsePresentation();
     void toggleUseOverwrite();
     void showAssociationsSlot();
+    void selectRegionSlot();
+    void toggleTimeWindowSlot();
+    void timeSliderMovedSlot(int value);
+    void playSlot();
+    void cursorChangedSlot(double tod);
+    void playingChangedSlot(bool playing);
     /// @brief Called when database view checkbox is un/checked
     //void toggleDatabaseView ();
     void exportSlot();
@@ -65,6 +73,20 @@ protected:
     QCheckBox* presentation_check_ {nullptr};
     QCheckBox* associations_check_ {nullptr};
 
+    QLineEdit* latitude_min_edit_ {nullptr};
+    QLineEdit* latitude_max_edit_ {nullptr};
+    QLineEdit* longitude_min_edit_ {nullptr};
+    QLineEdit* longitude_max_edit_ {nullptr};
+    QPushButton* select_region_button_ {nullptr};
+
+    QCheckBox* time_window_check_ {nullptr};
+    QSlider* time_slider_ {nullptr};
+    QLabel* time_label_ {nullptr};
+    QLineEdit* playback_speed_edit_ {nullptr};
+    QPushButton* play_button_ {nullptr};
+
+    void updateTimeWidgets ();
+
     QCheckBox* overwrite_check_ {nullptr};
 
     QPushButton *export_button_ {nullptr};
@@ -20,6 +20,7 @@
 #include "configurationmanager.h"
 #include "dbobject.h"
 #include "dbobjectmanager.h"
+#include "dbotimewindowpager.h"
 #include "atsdb.h"
 #include "listboxviewdatasource.h"
 #include "logger.h"
@@ -34,9 +35,14 @@ ListBoxViewDataSource::ListBoxViewDataSource(const std::string& class_id, const
       selection_entries_ (ViewSelection::getInstance().getEntries())
 {
     //registerParameter ("use_selection", &use_selection_, true);
+    registerParameter ("use_time_window", &use_time_window_, false);
 
     connect (&ATSDB::instance().objectManager(), SIGNAL(loadingStartedSignal()), this, SLOT(loadingStartedSlot()));
 
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+    connect (&pager, &DBOTimeWindowPager::windowLoadedSignal, this, &ListBoxViewDataSource::windowLoadedSlot);
+    connect (&pager, &DBOTimeWindowPager::cursorChangedSignal, this, &ListBoxViewDataSource::cursorChangedSlot);
+
     for (auto& obj_it : ATSDB::instance().objectManager())
     {
         connect (obj_it.second, SIGNAL (newDataSignal(DBObject&)), this, SLOT(newDataSlot(DBObject&)));
@@ -120,6 +126,13 @@ void ListBoxViewDataSource::checkSubConfigurables ()
 void ListBoxViewDataSource::loadingStartedSlot ()
 {
     logdbg << "ListBoxViewDataSource: loadingStartedSlot";
+
+    if (use_time_window_) // read set or filters might have changed
+    {
+        updatePagerReadSets();
+        return;
+    }
+
     emit loadingStartedSignal ();
 }
 
@@ -127,6 +140,9 @@ void ListBoxViewDataSource::newDataSlot (DBObject &object)
 {
     logdbg << "ListBoxViewDataSource: newDataSlot: object " << object.name();
 
+    if (use_time_window_) // loaded for other views
+        return;
+
     std::shared_ptr <Buffer> buffer = object.data();
     assert (buffer);
 
@@ -138,3 +154,90 @@ void ListBoxViewDataSource::loadingDoneSlot(DBObject &object)
     logdbg << "ListBoxViewDataSource: loadingDoneSlot: object " << object.name();
 }
 
+void ListBoxViewDataSource::useTimeWindow (bool value)
+{
+    loginf << "ListBoxViewDataSource: useTimeWindow: " << value;
+
+    use_time_window_ = value;
+
+    if (use_time_window_)
+    {
+        updatePagerReadSets();
+    }
+    else
+    {
+        DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+
+        pager.pause();
+
+        for (auto& obj_it : ATSDB::instance().objectManager())
+            pager.removeReadSet(obj_it.first);
+
+        shown_window_ = -1;
+
+        emit loadingStartedSignal (); // clears the tables until data is loaded again
+    }
+}
+
+void ListBoxViewDataSource::windowLoadedSlot (const std::string& dbo_name, unsigned int window)
+{
+    if (!use_time_window_)
+        return;
+
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+
+    if (window != pager.windowFor(pager.cursor())) // prefetched
+        return;
+
+    logdbg << "ListBoxViewDataSource: windowLoadedSlot: object " << dbo_name << " window " << window;
+
+    showCursorWindow(); // tables only append to their buffers, so all are set again
+}
+
+void ListBoxViewDataSource::cursorChangedSlot (double tod)
+{
+    if (!use_time_window_)
+        return;
+
+    if (static_cast<int>(ATSDB::instance().objectManager().timeWindowPager().windowFor(tod)) != shown_window_)
+        showCursorWindow();
+}
+
+void ListBoxViewDataSource::updatePagerReadSets ()
+{
+    assert (set_);
+
+    DBObjectManager& obj_man = ATSDB::instance().objectManager();
+    DBOTimeWindowPager& pager = obj_man.timeWindowPager();
+
+    for (auto& obj_it : obj_man)
+    {
+        DBOVariableSet read_set = set_->getExistingInDBFor(obj_it.first);
+
+        if (!obj_it.second->loadable() || !obj_it.second->loadingWanted() || !read_set.getSize())
+        {
+            pager.removeReadSet(obj_it.first);
+            continue;
+        }
+
+        pager.readSet(obj_it.first, read_set);
+    }
+
+    showCursorWindow(); // windows were removed, shown again when read
+}
+
+void ListBoxViewDataSource::showCursorWindow ()
+{
+    DBOTimeWindowPager& pager = ATSDB::instance().objectManager().timeWindowPager();
+
+    unsigned int window = pager.windowFor(pager.cursor());
+    shown_window_ = window;
+
+    logdbg << "ListBoxViewDataSource: showCursorWindow: window " << window;
+
+    emit loadingStartedSignal (); // clears the tables
+
+    for (auto& obj_it : ATSDB::instance().objectManager())
+        if (pager.hasWindow(obj_it.first, window))
+            emit updateData (*obj_it.second, pager.window(obj_it.first, window));
+}
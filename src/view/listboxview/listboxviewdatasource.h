@@ -35,6 +35,9 @@ class Job;
  * Creates database queries for all contained DBObjects when updateData () is called and
  * emits signal updateData() when resulting buffer is delivered by callback. Stores Buffers
  * and handles cleanup.
+ *
+ * In time window mode, nothing is loaded into the DBObjects. Instead the variables are read through the
+ * DBOTimeWindowPager, and the buffers of the window at its playback cursor are emitted.
  */
 class ListBoxViewDataSource : public QObject, public Configurable
 {
@@ -44,6 +47,9 @@ public slots:
     void newDataSlot (DBObject& object);
     void loadingDoneSlot (DBObject& object);
 
+    void windowLoadedSlot (const std::string& dbo_name, unsigned int window);
+    void cursorChangedSlot (double tod);
+
 signals:
     void loadingStartedSignal ();
     /// @brief Emitted when resulting buffer was delivered
@@ -67,6 +73,10 @@ public:
     /// @brief Returns use selection flag
     //bool getUseSelection () { return use_selection_; }
 
+    /// @brief Returns if only the time window at the playback cursor is shown
+    bool useTimeWindow () const { return use_time_window_; }
+    void useTimeWindow (bool value);
+
 protected:
     /// Variable read list
     DBOVariableOrderedSet* set_ {nullptr};
@@ -74,7 +84,16 @@ protected:
     /// Selected DBObject records
     ViewSelectionEntries& selection_entries_;
 
+    bool use_time_window_ {false};
+    /// Window of the emitted buffers in time window mode, -1 if none
+    int shown_window_ {-1};
+
     virtual void checkSubConfigurables ();
+
+    /// @brief Sets the read sets of the pager for all objects to be loaded, which reads their windows again
+    void updatePagerReadSets ();
+    /// @brief Clears the tables and emits the buffers of the window at the cursor
+    void showCursorWindow ();
 };
 
 #endif /* LISTBOXVIEWDATASOURCE_H_ */